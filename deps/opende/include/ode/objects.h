@@ -100,6 +100,33 @@ ODE_API void dWorldSetGravity (dWorldID, dReal x, dReal y, dReal z);
  */
 ODE_API void dWorldSetIslandThreads (dWorldID, int num_island_threads);
 
+/**
+ * @brief Get the number of thread pool threads for islands
+ *
+ * @ingroup world
+ * @return 0 if islands are stepped in the calling thread.
+ */
+ODE_API int dWorldGetIslandThreads (dWorldID);
+
+/**
+ * @brief Set the minimum island size, in bodies, scheduled on the island
+ * thread pool as a task of its own.
+ *
+ * Smaller islands are grouped into batches of at least this many bodies,
+ * so that worlds with many tiny islands do not pay the scheduling cost of
+ * one task per island. The default is 1.
+ *
+ * @ingroup world
+ */
+ODE_API void dWorldSetMinIslandSize (dWorldID, int min_island_size);
+
+/**
+ * @brief Get the minimum island size for the island thread pool.
+ *
+ * @ingroup world
+ */
+ODE_API int dWorldGetMinIslandSize (dWorldID);
+
 /**
  * @brief Set the number of thread pool threads for quickstep
  *
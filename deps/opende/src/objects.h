@@ -35,6 +35,7 @@
 #include <boost/threadpool.hpp>
 
 class dxStepWorkingMemory;
+class dxWorldProcessContext;
 
 // some body flags
 
@@ -184,6 +185,16 @@ struct dxBody : public dObject {
 };
 
 
+// one island to be stepped by dxProcessIslands
+struct dxIslandJob {
+  dxWorldProcessContext *context; // island working memory context
+  dxBody *const *body;            // first body of the island
+  int bcount;                     // number of bodies in the island
+  dxJoint *const *joint;          // first joint of the island
+  int jcount;                     // number of joints in the island
+};
+
+
 struct dxWorld : public dBase {
   dxBody *firstbody;    // body linked list
   dxJoint *firstjoint;    // joint linked list
@@ -203,6 +214,8 @@ struct dxWorld : public dBase {
   dReal max_angular_speed;      // limit the angular velocity to this magnitude
   boost::threadpool::pool *threadpool;
   boost::threadpool::pool *row_threadpool;
+  int min_island_size;   // islands with fewer bodies are stepped in batches
+  std::vector<dxIslandJob> island_jobs; // reused by dxProcessIslands
 };
 
 
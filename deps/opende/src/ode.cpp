@@ -1682,6 +1682,7 @@ dxWorld * dWorldCreate()
 
   w->threadpool = NULL; // new boost::threadpool::pool(0);
   w->row_threadpool = NULL; // new boost::threadpool::pool(0);
+  w->min_island_size = 1;
 
   return w;
 }
@@ -1782,6 +1783,24 @@ void dWorldSetIslandThreads (dWorldID w, int num_island_threads)
   }
 }
 
+int dWorldGetIslandThreads (dWorldID w)
+{
+  dAASSERT (w);
+  return w->threadpool ? (int)w->threadpool->size() : 0;
+}
+
+void dWorldSetMinIslandSize (dWorldID w, int min_island_size)
+{
+  dAASSERT (w);
+  w->min_island_size = (min_island_size > 1) ? min_island_size : 1;
+}
+
+int dWorldGetMinIslandSize (dWorldID w)
+{
+  dAASSERT (w);
+  return w->min_island_size;
+}
+
 void dWorldSetQuickStepThreads (dWorldID w, int num_quickstep_threads)
 {
   dAASSERT (w);
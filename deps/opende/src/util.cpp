@@ -28,6 +28,8 @@
 #include <boost/thread/recursive_mutex.hpp>
 #include <boost/bind.hpp>
 #include <ode/timer.h>
+#include <algorithm>
+#include <vector>
 
 #undef REPORT_THREAD_TIMING
 #undef TIMING
@@ -593,6 +595,27 @@ void dxProcessOneIsland(dxWorldProcessContext *island_context, dxWorld *world, d
 #endif
 }
 
+static void dxProcessIslandBatch(dxWorld *world, dReal stepsize, dstepper_fn_t stepper,
+                                 dxIslandJob const *jobs, int jobcount)
+{
+  for (int i = 0; i < jobcount; ++i) {
+    dxProcessOneIsland(jobs[i].context, world, stepsize, stepper,
+                       jobs[i].body, jobs[i].bcount, jobs[i].joint, jobs[i].jcount);
+  }
+}
+
+// order used to schedule islands on the thread pool: islands of at least
+// min_island_size bodies first, largest first, so that the longest tasks
+// start early. smaller islands keep their original order at the end.
+struct dxIslandJobScheduleOrder {
+  int min_size;
+  bool operator() (const dxIslandJob &a, const dxIslandJob &b) const {
+    int asize = (a.bcount >= min_size) ? a.bcount : 0;
+    int bsize = (b.bcount >= min_size) ? b.bcount : 0;
+    return asize > bsize;
+  }
+};
+
 void dxProcessIslands (dxWorld *world, dReal stepsize, dstepper_fn_t stepper)
 {
   const int sizeelements = 2;
@@ -624,6 +647,9 @@ void dxProcessIslands (dxWorld *world, dReal stepsize, dstepper_fn_t stepper)
   printf(">>>>>>>>>>>> start island spawn threads at time %f\n",cur_time);
 #endif
 
+  std::vector<dxIslandJob> &jobs = world->island_jobs;
+  jobs.clear();
+
   for (int const *sizescurr = islandsizes; sizescurr != sizesend; sizescurr += sizeelements) {
     int bcount = sizescurr[0];
     int jcount = sizescurr[1];
@@ -631,28 +657,47 @@ void dxProcessIslands (dxWorld *world, dReal stepsize, dstepper_fn_t stepper)
     // get working memory for each island
     dxStepWorkingMemory *island_wmem = world->island_wmems[island_index++];
     dIASSERT(island_wmem != NULL);
-    dxWorldProcessContext *island_context = island_wmem->GetWorldProcessingContext();
-
-#define USE_TPISLAND
-#ifdef USE_TPISLAND
-    IFTIMING(dTimerNow("scheduling island"));
-    //printf("debug opende tp %d\n",world->threadpool->size());
-    if (world->threadpool && world->threadpool->size() > 0)
-      world->threadpool->schedule(boost::bind(dxProcessOneIsland,island_context, world, stepsize, stepper,bodystart, bcount, jointstart, jcount));
-    else //automatically skip threadpool if only 1 thread allocated
-      dxProcessOneIsland(island_context, world, stepsize, stepper,bodystart, bcount, jointstart, jcount);
-#else
-    dxProcessOneIsland(island_context, world, stepsize, stepper,bodystart, bcount, jointstart, jcount);
-#endif
+
+    dxIslandJob job;
+    job.context = island_wmem->GetWorldProcessingContext();
+    job.body = bodystart;
+    job.bcount = bcount;
+    job.joint = jointstart;
+    job.jcount = jcount;
+    jobs.push_back(job);
 
     bodystart += bcount;
     jointstart += jcount;
   }
-#ifdef USE_TPISLAND
-  IFTIMING(dTimerNow("islands wait"));
-  if (world->threadpool && world->threadpool->size() > 0)
+
+  // islands share no bodies or joints, so the result does not depend on
+  // the order or the thread in which they are stepped.
+  if (world->threadpool && world->threadpool->size() > 0 && jobs.size() > 1) {
+    IFTIMING(dTimerNow("scheduling islands"));
+    dxIslandJobScheduleOrder order;
+    order.min_size = world->min_island_size;
+    std::stable_sort(jobs.begin(), jobs.end(), order);
+
+    size_t jobcount = jobs.size();
+    size_t batchstart = 0;
+    int batchbodies = 0;
+    for (size_t i = 0; i < jobcount; ++i) {
+      batchbodies += jobs[i].bcount;
+      if (batchbodies >= world->min_island_size || i + 1 == jobcount) {
+        world->threadpool->schedule(boost::bind(dxProcessIslandBatch, world,
+          stepsize, stepper, &jobs[batchstart], (int)(i + 1 - batchstart)));
+        batchstart = i + 1;
+        batchbodies = 0;
+      }
+    }
+
+    IFTIMING(dTimerNow("islands wait"));
     world->threadpool->wait();
-#endif
+  }
+  else {
+    dxProcessIslandBatch(world, stepsize, stepper,
+      jobs.empty() ? NULL : &jobs[0], (int)jobs.size());
+  }
   IFTIMING(dTimerEnd());
   IFTIMING(dTimerReport (stdout,1));
 
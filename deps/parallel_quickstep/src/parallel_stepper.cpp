@@ -577,6 +577,7 @@ void dxParallelQuickStepper( dxWorldProcessContext *context,
 
   if (m > 0) {
     dReal *cfm, *lo, *hi, *rhs, *Jcopy;
+    dReal *c_v_max;
     int *findex;
 
     {
@@ -606,6 +607,10 @@ void dxParallelQuickStepper( dxWorldProcessContext *context,
 
       rhs = context->AllocateArray<dReal> (mlocal);
 
+      // per row correcting velocity limit, init all to world max surface vel
+      c_v_max = context->AllocateArray<dReal> (mlocal);
+      dSetValue (c_v_max,mlocal,world->contactp.max_vel);
+
       Jcopy = context->AllocateArray<dReal> (mfb*12);
 
     }
@@ -646,6 +651,7 @@ void dxParallelQuickStepper( dxWorldProcessContext *context,
           Jinfo.J2a = Jrow + 9;
           Jinfo.c = c + ofsi;
           Jinfo.cfm = cfm + ofsi;
+          Jinfo.c_v_max = c_v_max + ofsi;
           Jinfo.lo = lo + ofsi;
           Jinfo.hi = hi + ofsi;
           Jinfo.findex = findex + ofsi;
@@ -719,7 +725,12 @@ void dxParallelQuickStepper( dxWorldProcessContext *context,
       } END_STATE_SAVE(context, tmp1state);
 
       // complete rhs
-      for (int i=0; i<m; i++) rhs[i] = c[i]*stepsize1 - rhs[i];
+      for (int i=0; i<m; i++) {
+        if (dFabs(c[i]) > c_v_max[i])
+          rhs[i] = c_v_max[i]*stepsize1 - rhs[i];
+        else
+          rhs[i] = c[i]*stepsize1 - rhs[i];
+      }
 
       // scale CFM
       for (int j=0; j<m; j++) cfm[j] *= stepsize1;
@@ -918,7 +929,7 @@ size_t dxEstimateParallelStepMemoryRequirements (
     size_t sub1_res2 = dEFFICIENT_SIZE(sizeof(dJointWithInfo1) * nj); // for shrunk jointiinfos
     if (m > 0) {
       sub1_res2 += dEFFICIENT_SIZE(sizeof(dReal) * 12 * m); // for J
-      sub1_res2 += 4 * dEFFICIENT_SIZE(sizeof(dReal) * m); // for cfm, lo, hi, rhs
+      sub1_res2 += 5 * dEFFICIENT_SIZE(sizeof(dReal) * m); // for cfm, lo, hi, rhs, c_v_max
       sub1_res2 += dEFFICIENT_SIZE(sizeof(int) * 12 * m); // for jb            FIXME: shoulbe be 2 not 12?
       sub1_res2 += dEFFICIENT_SIZE(sizeof(int) * m); // for findex
       sub1_res2 += dEFFICIENT_SIZE(sizeof(dReal) * 12 * mfb); // for Jcopy
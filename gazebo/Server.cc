@@ -41,6 +41,7 @@
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Events.hh"
+#include "gazebo/common/SdfSpec.hh"
 
 #include "gazebo/msgs/msgs.hh"
 
@@ -108,7 +109,7 @@ bool Server::ParseArgs(int _argc, char **_argv)
     ("play,p", po::value<std::string>(), "Play a log file.")
     ("record,r", "Record state data.")
     ("record_encoding", po::value<std::string>()->default_value("zlib"),
-     "Compression encoding format for log data (zlib|bz2|txt).")
+     "Compression encoding format for log data (zlib|bz2|txt|bin).")
     ("record_path", po::value<std::string>()->default_value(""),
      "Absolute path in which to store state data")
     ("seed",  po::value<double>(), "Start with a given random number seed.")
@@ -327,6 +328,7 @@ bool Server::LoadFile(const std::string &_filename,
     gzerr << "Unable to initialize sdf\n";
     return false;
   }
+  common::extendSdfSpec(sdf->Root());
 
   if (!sdf::readFile(common::find_file(_filename), sdf))
   {
@@ -347,6 +349,7 @@ bool Server::LoadString(const std::string &_sdfString)
     gzerr << "Unable to initialize sdf\n";
     return false;
   }
+  common::extendSdfSpec(sdf->Root());
 
   if (!sdf::readString(_sdfString, sdf))
   {
@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2015 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "gazebo/common/CacheFile.hh"
+#include "gazebo/common/Console.hh"
+
+using namespace gazebo;
+using namespace common;
+
+//////////////////////////////////////////////////
+uint64_t CacheFile::HashBytes(uint64_t _hash, const char *_data,
+    const size_t _size)
+{
+  for (size_t i = 0; i < _size; ++i)
+  {
+    _hash ^= static_cast<unsigned char>(_data[i]);
+    _hash *= 1099511628211ULL;
+  }
+  return _hash;
+}
+
+//////////////////////////////////////////////////
+bool CacheFile::HashFile(const std::string &_filename, uint64_t &_hash)
+{
+  std::ifstream file(_filename.c_str(), std::ios::in | std::ios::binary);
+  if (!file)
+    return false;
+
+  std::vector<char> buffer(65536);
+  while (file)
+  {
+    file.read(&buffer[0], buffer.size());
+    _hash = HashBytes(_hash, &buffer[0], file.gcount());
+  }
+  return file.eof();
+}
+
+//////////////////////////////////////////////////
+std::string CacheFile::Filename(const std::string &_path,
+    const uint64_t _hash, const std::string &_extension)
+{
+  std::ostringstream stream;
+  stream << std::hex << std::setw(16) << std::setfill('0') << _hash;
+
+  return (boost::filesystem::path(_path) /
+      (stream.str() + _extension)).string();
+}
+
+//////////////////////////////////////////////////
+void CacheFile::WriteHeader(const char *_magic, const uint32_t _version,
+    const uint64_t _hash, std::string &_data)
+{
+  uint32_t reserved = 0;
+  _data.append(_magic, MagicSize);
+  _data.append(reinterpret_cast<const char *>(&_version), sizeof(_version));
+  _data.append(reinterpret_cast<const char *>(&reserved), sizeof(reserved));
+  _data.append(reinterpret_cast<const char *>(&_hash), sizeof(_hash));
+}
+
+//////////////////////////////////////////////////
+bool CacheFile::CheckHeader(const char *_data, const size_t _size,
+    const char *_magic, const uint32_t _version, const uint64_t _hash)
+{
+  if (_size < HeaderSize)
+    return false;
+
+  uint32_t version;
+  uint64_t hash;
+  memcpy(&version, _data + MagicSize, sizeof(version));
+  memcpy(&hash, _data + MagicSize + 2 * sizeof(uint32_t), sizeof(hash));
+
+  return memcmp(_data, _magic, MagicSize) == 0 && version == _version &&
+    hash == _hash;
+}
+
+//////////////////////////////////////////////////
+bool CacheFile::Write(const std::string &_path,
+    const std::string &_filename, const std::string &_data)
+{
+  try
+  {
+    boost::filesystem::create_directories(_path);
+    boost::filesystem::path tmpPath = boost::filesystem::path(_path) /
+      boost::filesystem::unique_path("%%%%-%%%%-%%%%-%%%%.tmp");
+
+    {
+      std::ofstream out(tmpPath.string().c_str(),
+          std::ios::out | std::ios::binary | std::ios::trunc);
+      out.write(_data.data(), _data.size());
+      if (!out)
+      {
+        out.close();
+        boost::filesystem::remove(tmpPath);
+        gzwarn << "Unable to write cache file[" << tmpPath << "]\n";
+        return false;
+      }
+    }
+
+    boost::filesystem::rename(tmpPath, _filename);
+  }
+  catch(boost::filesystem::filesystem_error &_e)
+  {
+    gzwarn << "Unable to write cache file[" << _filename << "]: "
+      << _e.what() << "\n";
+    return false;
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+void CacheFile::Prune(const std::string &_path,
+    const std::string &_extension, const uint64_t _maxSize)
+{
+  // Cache files, with their last use time and size
+  std::vector<std::pair<std::time_t, std::pair<uint64_t,
+    boost::filesystem::path> > > files;
+  uint64_t totalSize = 0;
+
+  boost::system::error_code ec;
+  for (boost::filesystem::directory_iterator iter(_path, ec), end;
+       !ec && iter != end; iter.increment(ec))
+  {
+    const boost::filesystem::path &file = iter->path();
+    if (file.extension() != _extension)
+      continue;
+
+    boost::system::error_code fileEc;
+    uint64_t size = boost::filesystem::file_size(file, fileEc);
+    std::time_t time = boost::filesystem::last_write_time(file, fileEc);
+    if (fileEc)
+      continue;
+
+    files.push_back(std::make_pair(time, std::make_pair(size, file)));
+    totalSize += size;
+  }
+
+  if (totalSize <= _maxSize)
+    return;
+
+  // Remove the least recently used files first. Other processes may
+  // remove the same files, so errors are ignored.
+  std::sort(files.begin(), files.end());
+  for (auto const &file : files)
+  {
+    if (totalSize <= _maxSize)
+      break;
+    boost::filesystem::remove(file.second.second, ec);
+    totalSize -= file.second.first;
+  }
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2015 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef _GAZEBO_CACHEFILE_HH_
+#define _GAZEBO_CACHEFILE_HH_
+
+#include <stdint.h>
+#include <string>
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \internal
+    /// \brief Functions shared by the caches that store files in a
+    /// directory, such as MeshCache and HeightmapCache.
+    ///
+    /// A cache file starts with a header made of an 8 byte magic string,
+    /// the version of the format, 4 reserved bytes, and a 64 bit hash of
+    /// the data the file was made from.
+    class CacheFile
+    {
+      /// \brief Size of the magic string at the start of a cache file.
+      public: static const size_t MagicSize = 8;
+
+      /// \brief Size of the header of a cache file.
+      public: static const size_t HeaderSize = 24;
+
+      /// \brief Initial value of a hash.
+      public: static const uint64_t HashSeed = 14695981039346656037ULL;
+
+      /// \brief Add bytes to a 64 bit FNV-1a hash.
+      /// \param[in] _hash Current hash.
+      /// \param[in] _data Bytes to add.
+      /// \param[in] _size Number of bytes.
+      /// \return The new hash.
+      public: static uint64_t HashBytes(uint64_t _hash, const char *_data,
+                  const size_t _size);
+
+      /// \brief Add the contents of a file to a hash. The file is read in
+      /// chunks.
+      /// \param[in] _filename Path of the file.
+      /// \param[in,out] _hash The hash.
+      /// \return False if the file can't be read.
+      public: static bool HashFile(const std::string &_filename,
+                  uint64_t &_hash);
+
+      /// \brief Get the path of a cache file.
+      /// \param[in] _path Directory of the cache.
+      /// \param[in] _hash Hash of the data the file is made from.
+      /// \param[in] _extension Extension of the file, including the dot.
+      /// \return Path of the cache file.
+      public: static std::string Filename(const std::string &_path,
+                  const uint64_t _hash, const std::string &_extension);
+
+      /// \brief Append the header of a cache file.
+      /// \param[in] _magic Magic string, MagicSize bytes.
+      /// \param[in] _version Version of the format.
+      /// \param[in] _hash Hash of the data the file is made from.
+      /// \param[out] _data Contents of the file to append to.
+      public: static void WriteHeader(const char *_magic,
+                  const uint32_t _version, const uint64_t _hash,
+                  std::string &_data);
+
+      /// \brief Check the header of a cache file.
+      /// \param[in] _data Contents of the file.
+      /// \param[in] _size Size of the contents.
+      /// \param[in] _magic Expected magic string, MagicSize bytes.
+      /// \param[in] _version Expected version of the format.
+      /// \param[in] _hash Expected hash.
+      /// \return True if the header matches.
+      public: static bool CheckHeader(const char *_data, const size_t _size,
+                  const char *_magic, const uint32_t _version,
+                  const uint64_t _hash);
+
+      /// \brief Write a cache file. The contents are written to a
+      /// temporary file which is then renamed, so that other processes
+      /// never read a partial file.
+      /// \param[in] _path Directory of the cache. It is created if needed.
+      /// \param[in] _filename Path of the cache file.
+      /// \param[in] _data Contents of the file.
+      /// \return True if the file was written.
+      public: static bool Write(const std::string &_path,
+                  const std::string &_filename, const std::string &_data);
+
+      /// \brief Remove the least recently used cache files until the total
+      /// size of the cache is below a maximum size.
+      /// \param[in] _path Directory of the cache.
+      /// \param[in] _extension Extension of the cache files.
+      /// \param[in] _maxSize Maximum total size of the files (bytes).
+      public: static void Prune(const std::string &_path,
+                  const std::string &_extension, const uint64_t _maxSize);
+    };
+  }
+}
+#endif
@@ -251,55 +251,22 @@ void Dem::FillHeightMap(int _subSampling, unsigned int _vertSize,
     return;
   }
 
-  // Resize the vector to match the size of the vertices.
-  _heights.resize(_vertSize * _vertSize);
+  FillHeights(this->dataPtr->demData.empty() ?
+      NULL : &this->dataPtr->demData[0], this->dataPtr->side,
+      this->dataPtr->side, _subSampling, _vertSize,
+      std::max(0.0f, this->GetMinElevation()), _scale.Z(), _flipY, _heights);
 
-  // Iterate over all the vertices
-  for (unsigned int y = 0; y < _vertSize; ++y)
+  for (unsigned int i = 0; i < _heights.size(); ++i)
   {
-    double yf = y / static_cast<double>(_subSampling);
-    unsigned int y1 = floor(yf);
-    unsigned int y2 = ceil(yf);
-    if (y2 >= this->dataPtr->side)
-      y2 = this->dataPtr->side - 1;
-    double dy = yf - y1;
-
-    for (unsigned int x = 0; x < _vertSize; ++x)
-    {
-      double xf = x / static_cast<double>(_subSampling);
-      unsigned int x1 = floor(xf);
-      unsigned int x2 = ceil(xf);
-      if (x2 >= this->dataPtr->side)
-        x2 = this->dataPtr->side - 1;
-      double dx = xf - x1;
-
-      double px1 = this->dataPtr->demData[y1 * this->dataPtr->side + x1];
-      double px2 = this->dataPtr->demData[y1 * this->dataPtr->side + x2];
-      float h1 = (px1 - ((px1 - px2) * dx));
-
-      double px3 = this->dataPtr->demData[y2 * this->dataPtr->side + x1];
-      double px4 = this->dataPtr->demData[y2 * this->dataPtr->side + x2];
-      float h2 = (px3 - ((px3 - px4) * dx));
-
-      float h = (h1 - ((h1 - h2) * dy) - std::max(0.0f,
-          this->GetMinElevation())) * _scale.Z();
-
-      // Invert pixel definition so 1=ground, 0=full height,
-      // if the terrain size has a negative z component
-      // this is mainly for backward compatibility
-      if (_size.Z() < 0)
-        h *= -1;
-
-      // Convert to 0 if a NODATA value is found
-      if (_size.Z() >= 0 && h < 0)
-        h = 0;
-
-      // Store the height for future use
-      if (!_flipY)
-        _heights[y * _vertSize + x] = h;
-      else
-        _heights[(_vertSize - y - 1) * _vertSize + x] = h;
-    }
+    // Invert pixel definition so 1=ground, 0=full height,
+    // if the terrain size has a negative z component
+    // this is mainly for backward compatibility
+    if (_size.Z() < 0)
+      _heights[i] *= -1;
+
+    // Convert to 0 if a NODATA value is found
+    if (_size.Z() >= 0 && _heights[i] < 0)
+      _heights[i] = 0;
   }
 }
 
@@ -15,6 +15,9 @@
  *
  */
 
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Event.hh"
 
@@ -23,7 +26,7 @@ using namespace event;
 
 //////////////////////////////////////////////////
 EventPrivate::EventPrivate()
-  : signaled(false)
+  : signaled(false), parallel(false)
 {
 }
 
@@ -52,6 +55,30 @@ bool Event::GetSignaled() const
   return this->dataPtr->signaled;
 }
 
+//////////////////////////////////////////////////
+void Event::SetParallel(const bool _parallel)
+{
+  this->dataPtr->parallel = _parallel;
+}
+
+//////////////////////////////////////////////////
+bool Event::GetParallel() const
+{
+  return this->dataPtr->parallel;
+}
+
+//////////////////////////////////////////////////
+void Event::ParallelFor(const size_t _count,
+    const std::function<void (size_t)> &_func) const
+{
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, _count),
+      [&](const tbb::blocked_range<size_t> &_r)
+      {
+        for (size_t i = _r.begin(); i != _r.end(); ++i)
+          _func(i);
+      });
+}
+
 //////////////////////////////////////////////////
 ConnectionPrivate::ConnectionPrivate()
   : event(NULL), id(-1)
@@ -19,6 +19,8 @@
 #define _GAZEBO_EVENT_HH_
 
 #include <atomic>
+#include <algorithm>
+#include <functional>
 #include <iostream>
 #include <vector>
 #include <map>
@@ -54,6 +56,9 @@ namespace gazebo
 
       /// \brief True if the event has been signaled.
       public: bool signaled;
+
+      /// \brief True if subscribers are called in parallel.
+      public: std::atomic_bool parallel;
     };
 
     /// \class Event Event.hh common/common.hh
@@ -78,10 +83,28 @@ namespace gazebo
       /// \return True if the event has been signaled.
       public: bool GetSignaled() const;
 
+      /// \brief Call the subscribers of this event in parallel, on a
+      /// thread pool. Only enable this when the subscribers do not depend
+      /// on each other, and are safe to call from any thread. Signal
+      /// returns after all subscribers have been called.
+      /// \param[in] _parallel True to call subscribers in parallel.
+      public: void SetParallel(const bool _parallel);
+
+      /// \brief Get whether subscribers are called in parallel.
+      /// \return True if subscribers are called in parallel.
+      public: bool GetParallel() const;
+
       /// \brief Allow subclasses to initialize their own data pointer.
       /// \param[in] _d Reference to data pointer.
       protected: Event(EventPrivate &_d);
 
+      /// \brief Call a function for each index in [0, _count) on the
+      /// thread pool, and wait for all calls to finish.
+      /// \param[in] _count Number of indices.
+      /// \param[in] _func Function to call for each index.
+      protected: void ParallelFor(const size_t _count,
+                     const std::function<void (size_t)> &_func) const;
+
       /// \brief Data pointer.
       protected: EventPrivate *dataPtr;
     };
@@ -138,17 +161,23 @@ namespace gazebo
     class EventConnection
     {
       /// \brief Constructor
-      public: EventConnection(const bool _on,
-                  boost::function<T> *_cb)
-              : on(_on), callback(_cb)
+      /// \param[in] _id Id of the connection.
+      /// \param[in] _cb Callback function.
+      public: EventConnection(const int _id, const boost::function<T> &_cb)
+              : id(_id), on(true), callback(_cb)
       {
       }
 
-      /// \brief On/off value for the event callback
+      /// \brief Id of the connection.
+      public: const int id;
+
+      /// \brief On/off value for the event callback. It is shared by all
+      /// the connection arrays that contain this connection, so that a
+      /// callback disconnected during a signal is not called.
       public: std::atomic_bool on;
 
       /// \brief Callback function
-      public: std::shared_ptr<boost::function<T> > callback;
+      public: const boost::function<T> callback;
     };
 
     /// \internal
@@ -156,20 +185,37 @@ namespace gazebo
     template< typename T>
     class GZ_COMMON_VISIBLE EventTPrivate : public EventPrivate
     {
-      /// \def EvtConnectionMap
-      /// \brief Event Connection map typedef.
-      typedef std::map<int, std::shared_ptr<EventConnection<T> > >
-        EvtConnectionMap;
+      /// \def EvtConnectionArray
+      /// \brief Event connection array typedef.
+      public: typedef std::vector<std::shared_ptr<EventConnection<T> > >
+              EvtConnectionArray;
 
-      /// \brief Array of connection callbacks.
-      public: EvtConnectionMap connections;
+      /// \def EvtConnectionArrayPtr
+      /// \brief Shared pointer to a published event connection array.
+      public: typedef std::shared_ptr<const EvtConnectionArray>
+              EvtConnectionArrayPtr;
 
-      /// \brief A thread lock.
-      public: std::mutex mutex;
+      /// \brief Constructor
+      public: EventTPrivate()
+              : connections(std::make_shared<EvtConnectionArray>()), nextId(0)
+      {
+      }
+
+      /// \brief Array of connection callbacks, in the order they were
+      /// connected. The array is never modified once it is published.
+      /// Connect and Disconnect publish a new array, so a signal only
+      /// needs to load this pointer to get a stable array to iterate over.
+      /// Must be accessed with std::atomic_load and std::atomic_store.
+      /// These are not lock free for shared_ptr: libstdc++ guards the
+      /// pointer copy with a spinlock from a small shared pool. The lock
+      /// is only held for the copy, never while callbacks run.
+      public: EvtConnectionArrayPtr connections;
 
-      /// \brief List of connections to remove
-      public: std::list<typename EvtConnectionMap::const_iterator>
-              connectionsToRemove;
+      /// \brief Id of the next connection.
+      public: int nextId;
+
+      /// \brief Serializes changes to the connection array.
+      public: std::mutex mutex;
     };
 
     /// \class EventT Event.hh common/common.hh
@@ -353,14 +399,10 @@ namespace gazebo
       /// \brief Signal the event for all subscribers.
       public: void Signal()
       {
-        this->Cleanup();
-
-        this->myDataPtr->signaled = true;
-        for (auto iter: this->myDataPtr->connections)
+        this->Dispatch([&](const boost::function<T> &_cb)
         {
-          if (iter.second->on)
-            (*iter.second->callback)();
-        }
+          _cb();
+        });
       }
 
       /// \brief Signal the event with one parameter.
@@ -368,14 +410,10 @@ namespace gazebo
       public: template< typename P >
               void Signal(const P &_p)
       {
-        this->Cleanup();
-
-        this->myDataPtr->signaled = true;
-        for (auto iter: this->myDataPtr->connections)
+        this->Dispatch([&](const boost::function<T> &_cb)
         {
-          if (iter.second->on)
-            (*iter.second->callback)(_p);
-        }
+          _cb(_p);
+        });
       }
 
       /// \brief Signal the event with two parameter.
@@ -384,14 +422,10 @@ namespace gazebo
       public: template< typename P1, typename P2 >
               void Signal(const P1 &_p1, const P2 &_p2)
       {
-        this->Cleanup();
-
-        this->myDataPtr->signaled = true;
-        for (auto iter: this->myDataPtr->connections)
+        this->Dispatch([&](const boost::function<T> &_cb)
         {
-          if (iter.second->on)
-            (*iter.second->callback)(_p1, _p2);
-        }
+          _cb(_p1, _p2);
+        });
       }
 
       /// \brief Signal the event with three parameter.
@@ -401,14 +435,10 @@ namespace gazebo
       public: template< typename P1, typename P2, typename P3 >
               void Signal(const P1 &_p1, const P2 &_p2, const P3 &_p3)
       {
-        this->Cleanup();
-
-        this->myDataPtr->signaled = true;
-        for (auto iter: this->myDataPtr->connections)
+        this->Dispatch([&](const boost::function<T> &_cb)
         {
-          if (iter.second->on)
-            (*iter.second->callback)(_p1, _p2, _p3);
-        }
+          _cb(_p1, _p2, _p3);
+        });
       }
 
       /// \brief Signal the event with four parameter.
@@ -420,14 +450,10 @@ namespace gazebo
               void Signal(const P1 &_p1, const P2 &_p2, const P3 &_p3,
                           const P4 &_p4)
       {
-        this->Cleanup();
-
-        this->myDataPtr->signaled = true;
-        for (auto iter: this->myDataPtr->connections)
+        this->Dispatch([&](const boost::function<T> &_cb)
         {
-          if (iter.second->on)
-            (*iter.second->callback)(_p1, _p2, _p3, _p4);
-        }
+          _cb(_p1, _p2, _p3, _p4);
+        });
       }
 
       /// \brief Signal the event with five parameter.
@@ -441,14 +467,10 @@ namespace gazebo
               void Signal(const P1 &_p1, const P2 &_p2, const P3 &_p3,
                           const P4 &_p4, const P5 &_p5)
       {
-        this->Cleanup();
-
-        this->myDataPtr->signaled = true;
-        for (auto iter: this->myDataPtr->connections)
+        this->Dispatch([&](const boost::function<T> &_cb)
         {
-          if (iter.second->on)
-            (*iter.second->callback)(_p1, _p2, _p3, _p4, _p5);
-        }
+          _cb(_p1, _p2, _p3, _p4, _p5);
+        });
       }
 
       /// \brief Signal the event with six parameter.
@@ -463,14 +485,10 @@ namespace gazebo
               void Signal(const P1 &_p1, const P2 &_p2, const P3 &_p3,
                   const P4 &_p4, const P5 &_p5, const P6 &_p6)
       {
-        this->Cleanup();
-
-        this->myDataPtr->signaled = true;
-        for (auto iter: this->myDataPtr->connections)
+        this->Dispatch([&](const boost::function<T> &_cb)
         {
-          if (iter.second->on)
-            (*iter.second->callback)(_p1, _p2, _p3, _p4, _p5, _p6);
-        }
+          _cb(_p1, _p2, _p3, _p4, _p5, _p6);
+        });
       }
 
       /// \brief Signal the event with seven parameter.
@@ -486,14 +504,10 @@ namespace gazebo
               void Signal(const P1 &_p1, const P2 &_p2, const P3 &_p3,
                   const P4 &_p4, const P5 &_p5, const P6 &_p6, const P7 &_p7)
       {
-        this->Cleanup();
-
-        this->myDataPtr->signaled = true;
-        for (auto iter: this->myDataPtr->connections.begin())
+        this->Dispatch([&](const boost::function<T> &_cb)
         {
-          if (iter.second->on)
-            (*iter.second->callback)(_p1, _p2, _p3, _p4, _p5, _p6, _p7);
-        }
+          _cb(_p1, _p2, _p3, _p4, _p5, _p6, _p7);
+        });
       }
 
       /// \brief Signal the event with eight parameter.
@@ -511,16 +525,10 @@ namespace gazebo
                   const P4 &_p4, const P5 &_p5, const P6 &_p6, const P7 &_p7,
                   const P8 &_p8)
       {
-        this->Cleanup();
-
-        this->myDataPtr->signaled = true;
-        for (auto iter: this->myDataPtr->connections)
+        this->Dispatch([&](const boost::function<T> &_cb)
         {
-          if (iter.second->on)
-          {
-            (*iter.second->callback)(_p1, _p2, _p3, _p4, _p5, _p6, _p7, _p8);
-          }
-        }
+          _cb(_p1, _p2, _p3, _p4, _p5, _p6, _p7, _p8);
+        });
       }
 
       /// \brief Signal the event with nine parameter.
@@ -540,17 +548,10 @@ namespace gazebo
                   const P4 &_p4, const P5 &_p5, const P6 &_p6, const P7 &_p7,
                   const P8 &_p8, const P9 &_p9)
       {
-        this->Cleanup();
-
-        this->myDataPtr->signaled = true;
-        for (auto iter: this->myDataPtr->connections)
+        this->Dispatch([&](const boost::function<T> &_cb)
         {
-          if (iter.second->on)
-          {
-            (*iter.second->callback)(
-                _p1, _p2, _p3, _p4, _p5, _p6, _p7, _p8, _p9);
-          }
-        }
+          _cb(_p1, _p2, _p3, _p4, _p5, _p6, _p7, _p8, _p9);
+        });
       }
 
       /// \brief Signal the event with ten parameter.
@@ -571,24 +572,48 @@ namespace gazebo
                   const P4 &_p4, const P5 &_p5, const P6 &_p6, const P7 &_p7,
                   const P8 &_p8, const P9 &_p9, const P10 &_p10)
       {
-        this->Cleanup();
+        this->Dispatch([&](const boost::function<T> &_cb)
+        {
+          _cb(_p1, _p2, _p3, _p4, _p5, _p6, _p7, _p8, _p9, _p10);
+        });
+      }
 
+      /// \brief Call a function with the callback of each connection that
+      /// is on. Signaling copies the connection array pointer once, which
+      /// takes the short atomic_load spinlock described in EventTPrivate,
+      /// then iterates the array without the event mutex and without
+      /// allocating.
+      /// \param[in] _f Function that calls a callback with the signal
+      /// parameters.
+      private: template<typename F>
+               void Dispatch(const F &_f)
+      {
         this->myDataPtr->signaled = true;
-        for (auto iter: this->myDataPtr->connections)
+
+        // Keep the array alive for the duration of the signal, even if a
+        // callback connects or disconnects.
+        const typename EventTPrivate<T>::EvtConnectionArrayPtr conns =
+          std::atomic_load(&this->myDataPtr->connections);
+
+        if (this->myDataPtr->parallel && conns->size() > 1)
         {
-          if (iter.second->on)
+          this->ParallelFor(conns->size(), [&](const size_t _i)
           {
-            (*iter.second->callback)(
-                _p1, _p2, _p3, _p4, _p5, _p6, _p7, _p8, _p9, _p10);
+            const EventConnection<T> &conn = *(*conns)[_i];
+            if (conn.on)
+              _f(conn.callback);
+          });
+        }
+        else
+        {
+          for (const auto &conn : *conns)
+          {
+            if (conn->on)
+              _f(conn->callback);
           }
         }
       }
 
-      /// \internal
-      /// \brief Removes queued connections.
-      /// We assume that this function is called from a Signal function.
-      private: void Cleanup();
-
       /// \brief Private data pointer.
       private: EventTPrivate<T> *myDataPtr;
     };
@@ -605,7 +630,9 @@ namespace gazebo
     template<typename T>
     EventT<T>::~EventT()
     {
-      this->myDataPtr->connections.clear();
+      std::atomic_store(&this->myDataPtr->connections,
+          typename EventTPrivate<T>::EvtConnectionArrayPtr(
+          new typename EventTPrivate<T>::EvtConnectionArray()));
     }
 
     /// \brief Adds a connection.
@@ -613,14 +640,20 @@ namespace gazebo
     template<typename T>
     ConnectionPtr EventT<T>::Connect(const boost::function<T> &_subscriber)
     {
-      int index = 0;
-      if (!this->myDataPtr->connections.empty())
-      {
-        auto const &iter = this->myDataPtr->connections.rbegin();
-        index = iter->first + 1;
-      }
-      this->myDataPtr->connections[index].reset(new EventConnection<T>(true,
-          new boost::function<T>(_subscriber)));
+      std::lock_guard<std::mutex> lock(this->myDataPtr->mutex);
+
+      int index = this->myDataPtr->nextId++;
+
+      // Copy the current array, and publish the copy with the new
+      // connection appended.
+      auto conns =
+        std::make_shared<typename EventTPrivate<T>::EvtConnectionArray>(
+            *this->myDataPtr->connections);
+      conns->push_back(
+          std::make_shared<EventConnection<T> >(index, _subscriber));
+      std::atomic_store(&this->myDataPtr->connections,
+          typename EventTPrivate<T>::EvtConnectionArrayPtr(conns));
+
       return ConnectionPtr(new Connection(this, index));
     }
 
@@ -642,7 +675,7 @@ namespace gazebo
     template<typename T>
     unsigned int EventT<T>::ConnectionCount() const
     {
-      return this->myDataPtr->connections.size();
+      return std::atomic_load(&this->myDataPtr->connections)->size();
     }
 
     /// \brief Removes a connection.
@@ -650,27 +683,37 @@ namespace gazebo
     template<typename T>
     void EventT<T>::Disconnect(int _id)
     {
+      std::lock_guard<std::mutex> lock(this->myDataPtr->mutex);
+
+      // Only the mutex holder publishes new arrays, so the current array
+      // can be read directly.
+      const auto &current = *this->myDataPtr->connections;
+
       // Find the connection
-      auto const &it = this->myDataPtr->connections.find(_id);
+      auto const &it = std::find_if(current.begin(), current.end(),
+          [_id](const std::shared_ptr<EventConnection<T> > &_conn)
+          {
+            return _conn->id == _id;
+          });
 
-      if (it != this->myDataPtr->connections.end())
+      if (it == current.end())
+        return;
+
+      // Turn the connection off, in case a signal in progress still has
+      // an array that contains it.
+      (*it)->on = false;
+
+      auto conns =
+        std::make_shared<typename EventTPrivate<T>::EvtConnectionArray>();
+      conns->reserve(current.size() - 1);
+      for (auto const &conn : current)
       {
-        it->second->on = false;
-        this->myDataPtr->connectionsToRemove.push_back(it);
+        if (conn->id != _id)
+          conns->push_back(conn);
       }
+      std::atomic_store(&this->myDataPtr->connections,
+          typename EventTPrivate<T>::EvtConnectionArrayPtr(conns));
     }
-
-    /////////////////////////////////////////////
-    template<typename T>
-    void EventT<T>::Cleanup()
-    {
-      std::lock_guard<std::mutex> lock(this->myDataPtr->mutex);
-      // Remove all queue connections.
-      for (auto &conn : this->myDataPtr->connectionsToRemove)
-        this->myDataPtr->connections.erase(conn);
-      this->myDataPtr->connectionsToRemove.clear();
-    }
-
     /// \}
   }
 }
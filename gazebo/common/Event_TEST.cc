@@ -16,6 +16,7 @@
 */
 
 #include <gtest/gtest.h>
+#include <atomic>
 #include <boost/bind.hpp>
 #include <gazebo/common/Time.hh>
 #include <gazebo/common/Event.hh>
@@ -220,6 +221,87 @@ TEST_F(EventTest, ManyChanges)
   EXPECT_EQ(g_callback1, 2);
 }
 
+/////////////////////////////////////////////////
+TEST_F(EventTest, ConnectionCount)
+{
+  event::EventT<void ()> evt;
+  EXPECT_EQ(evt.ConnectionCount(), 0u);
+
+  event::ConnectionPtr conn = evt.Connect(boost::bind(&callback));
+  event::ConnectionPtr conn1 = evt.Connect(boost::bind(&callback1));
+  EXPECT_EQ(evt.ConnectionCount(), 2u);
+
+  // Connection ids are not reused
+  EXPECT_NE(conn->GetId(), conn1->GetId());
+  int id1 = conn1->GetId();
+  conn1.reset();
+  EXPECT_EQ(evt.ConnectionCount(), 1u);
+  conn1 = evt.Connect(boost::bind(&callback1));
+  EXPECT_NE(conn1->GetId(), id1);
+
+  conn.reset();
+  conn1.reset();
+  EXPECT_EQ(evt.ConnectionCount(), 0u);
+}
+
+/////////////////////////////////////////////////
+TEST_F(EventTest, Parameters)
+{
+  int sum = 0;
+  event::EventT<void (int, const int &, int)> evt;
+  event::ConnectionPtr conn = evt.Connect(
+      [&sum](int _a, const int &_b, int _c) {sum += _a + _b + _c;});
+
+  evt(1, 2, 3);
+  EXPECT_EQ(sum, 6);
+}
+
+/////////////////////////////////////////////////
+// Connecting to an event in a callback should not affect the signal in
+// progress.
+TEST_F(EventTest, CallbackConnect)
+{
+  int count = 0;
+  event::EventT<void ()> evt;
+  std::vector<event::ConnectionPtr> conns;
+  conns.push_back(evt.Connect([&]()
+      {
+        ++count;
+        conns.push_back(evt.Connect([&]() {++count;}));
+      }));
+
+  evt();
+  EXPECT_EQ(count, 1);
+  EXPECT_EQ(evt.ConnectionCount(), 2u);
+
+  // The callback connected during the first signal is called now, and
+  // the callback it connects during this signal is not.
+  evt();
+  EXPECT_EQ(count, 3);
+  EXPECT_EQ(evt.ConnectionCount(), 3u);
+}
+
+/////////////////////////////////////////////////
+TEST_F(EventTest, Parallel)
+{
+  event::EventT<void (int)> evt;
+  EXPECT_FALSE(evt.GetParallel());
+  evt.SetParallel(true);
+  EXPECT_TRUE(evt.GetParallel());
+
+  std::atomic<int> sum(0);
+  std::vector<event::ConnectionPtr> conns;
+  for (int i = 0; i < 100; ++i)
+    conns.push_back(evt.Connect([&sum](int _v) {sum += _v;}));
+
+  evt(2);
+  EXPECT_EQ(sum, 200);
+
+  conns.resize(50);
+  evt(1);
+  EXPECT_EQ(sum, 250);
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -262,7 +262,9 @@ namespace gazebo
       /// \brief An entity has been deleted
       public: static EventT<void (std::string)> deleteEntity;
 
-      /// \brief World update has started
+      /// \brief World update has started. Call
+      /// worldUpdateBegin.SetParallel(true) to call its subscribers in
+      /// parallel, when none of them depend on the others.
       public: static EventT<void (const common::UpdateInfo &)> worldUpdateBegin;
 
       /// \brief World update has ended
@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2015 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <stdint.h>
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+
+#include <boost/filesystem.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include "gazebo/common/CacheFile.hh"
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/HeightmapCache.hh"
+
+using namespace gazebo;
+using namespace common;
+
+/// \brief First bytes of a cache file.
+static const char HeightmapCacheMagic[CacheFile::MagicSize] =
+  {'G', 'Z', 'H', 'M', 'A', 'P', 'C', 0};
+
+/// \brief Version of the cache file format. Change it when the format, or
+/// the way heights are sampled, changes.
+static const uint32_t HeightmapCacheVersion = 2;
+
+//////////////////////////////////////////////////
+HeightmapCache::HeightmapCache(const std::string &_path,
+    const uint64_t _maxSize)
+  : path(_path), maxSize(_maxSize)
+{
+}
+
+//////////////////////////////////////////////////
+HeightmapCache::~HeightmapCache()
+{
+}
+
+//////////////////////////////////////////////////
+std::string HeightmapCache::GetPath() const
+{
+  return this->path;
+}
+
+//////////////////////////////////////////////////
+uint64_t HeightmapCache::GetMaxSize() const
+{
+  return this->maxSize;
+}
+
+//////////////////////////////////////////////////
+std::string HeightmapCache::CacheFilename(const std::string &_filename,
+    int _subSampling, unsigned int _vertSize,
+    const ignition::math::Vector3d &_size,
+    const ignition::math::Vector3d &_scale, bool _flipY,
+    uint64_t &_hash) const
+{
+  if (this->path.empty())
+    return std::string();
+
+  // Hash the contents of the heightmap file, its path, the sampling
+  // parameters, and the format version
+  _hash = CacheFile::HashSeed;
+  if (!CacheFile::HashFile(_filename, _hash))
+    return std::string();
+
+  std::ostringstream params;
+  params << std::setprecision(17) << '\0' << _filename << '\0'
+    << _subSampling << ' ' << _vertSize << ' ' << _size << ' ' << _scale
+    << ' ' << _flipY << ' ' << HeightmapCacheVersion;
+  std::string key = params.str();
+  _hash = CacheFile::HashBytes(_hash, key.data(), key.size());
+
+  return CacheFile::Filename(this->path, _hash, ".gzheights");
+}
+
+//////////////////////////////////////////////////
+bool HeightmapCache::Load(const std::string &_filename, int _subSampling,
+    unsigned int _vertSize, const ignition::math::Vector3d &_size,
+    const ignition::math::Vector3d &_scale, bool _flipY,
+    std::vector<float> &_heights) const
+{
+  uint64_t hash = 0;
+  std::string cacheFilename = this->CacheFilename(_filename, _subSampling,
+      _vertSize, _size, _scale, _flipY, hash);
+  boost::system::error_code ec;
+  if (cacheFilename.empty() || !boost::filesystem::exists(cacheFilename, ec))
+    return false;
+
+  boost::iostreams::mapped_file_source file;
+  try
+  {
+    file.open(cacheFilename);
+  }
+  catch(std::exception &_e)
+  {
+    gzwarn << "Unable to open heightmap cache file[" << cacheFilename
+      << "]: " << _e.what() << "\n";
+    return false;
+  }
+
+  uint64_t count = 0;
+  if (!CacheFile::CheckHeader(file.data(), file.size(), HeightmapCacheMagic,
+        HeightmapCacheVersion, hash) ||
+      file.size() < CacheFile::HeaderSize + sizeof(count))
+  {
+    gzwarn << "Ignoring invalid heightmap cache file[" << cacheFilename
+      << "]\n";
+    return false;
+  }
+
+  const char *data = file.data() + CacheFile::HeaderSize;
+  memcpy(&count, data, sizeof(count));
+  data += sizeof(count);
+
+  if (count != static_cast<uint64_t>(_vertSize) * _vertSize ||
+      (file.size() - CacheFile::HeaderSize - sizeof(count)) / sizeof(float) <
+      count)
+  {
+    gzwarn << "Ignoring truncated heightmap cache file[" << cacheFilename
+      << "]\n";
+    return false;
+  }
+
+  _heights.resize(count);
+  if (count > 0)
+    memcpy(&_heights[0], data, sizeof(float) * count);
+
+  // Mark the file as recently used, so that Prune keeps it
+  boost::filesystem::last_write_time(cacheFilename, std::time(NULL), ec);
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool HeightmapCache::Save(const std::string &_filename, int _subSampling,
+    unsigned int _vertSize, const ignition::math::Vector3d &_size,
+    const ignition::math::Vector3d &_scale, bool _flipY,
+    const std::vector<float> &_heights) const
+{
+  uint64_t count = _heights.size();
+  if (count != static_cast<uint64_t>(_vertSize) * _vertSize)
+    return false;
+
+  uint64_t hash = 0;
+  std::string cacheFilename = this->CacheFilename(_filename, _subSampling,
+      _vertSize, _size, _scale, _flipY, hash);
+  if (cacheFilename.empty())
+    return false;
+
+  // The heights are stored with the same type they are filled with, so
+  // loading them gives exactly the filled values.
+  std::string data;
+  CacheFile::WriteHeader(HeightmapCacheMagic, HeightmapCacheVersion, hash,
+      data);
+  data.append(reinterpret_cast<const char *>(&count), sizeof(count));
+  if (count > 0)
+  {
+    data.append(reinterpret_cast<const char *>(&_heights[0]),
+        sizeof(float) * count);
+  }
+
+  if (!CacheFile::Write(this->path, cacheFilename, data))
+    return false;
+
+  CacheFile::Prune(this->path, ".gzheights", this->maxSize);
+
+  return true;
+}
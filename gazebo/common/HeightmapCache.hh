@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2015 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef _GAZEBO_HEIGHTMAPCACHE_HH_
+#define _GAZEBO_HEIGHTMAPCACHE_HH_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \addtogroup gazebo_common Common
+    /// \{
+
+    /// \class HeightmapCache HeightmapCache.hh common/common.hh
+    /// \brief A directory of terrain height lookup tables, as filled by
+    /// HeightmapData::FillHeightMap, so that later processes don't need to
+    /// sample the heightmap file again.
+    ///
+    /// Each table is stored in a file named after a hash of the contents
+    /// and path of the heightmap file and of the sampling parameters. The
+    /// heights are stored as the floats they are filled with, so a loaded
+    /// table is identical to a newly filled one. The least recently used
+    /// tables are removed when the cache grows above its maximum size.
+    class GZ_COMMON_VISIBLE HeightmapCache
+    {
+      /// \brief Constructor
+      /// \param[in] _path Directory of the cache. It is created when the
+      /// first table is saved. An empty path disables the cache.
+      /// \param[in] _maxSize Maximum total size of the cache files (bytes).
+      public: explicit HeightmapCache(const std::string &_path,
+                  const uint64_t _maxSize = 512 * 1024 * 1024);
+
+      /// \brief Destructor
+      public: virtual ~HeightmapCache();
+
+      /// \brief Get the directory of the cache.
+      /// \return The directory of the cache, empty if disabled.
+      public: std::string GetPath() const;
+
+      /// \brief Get the maximum total size of the cache files.
+      /// \return Maximum size (bytes).
+      public: uint64_t GetMaxSize() const;
+
+      /// \brief Load the cached heights of a heightmap file.
+      /// \param[in] _filename Full path of the heightmap file.
+      /// \param[in] _subSampling Subsampling used to fill the heights.
+      /// \param[in] _vertSize Number of points per row.
+      /// \param[in] _size Real dimensions of the terrain.
+      /// \param[in] _scale Scale of the terrain.
+      /// \param[in] _flipY Whether the rows are inverted.
+      /// \param[out] _heights The terrain heights.
+      /// \return True if the heights were in the cache.
+      public: bool Load(const std::string &_filename, int _subSampling,
+                  unsigned int _vertSize,
+                  const ignition::math::Vector3d &_size,
+                  const ignition::math::Vector3d &_scale, bool _flipY,
+                  std::vector<float> &_heights) const;
+
+      /// \brief Store the heights of a heightmap file in the cache.
+      /// \param[in] _filename Full path of the heightmap file.
+      /// \param[in] _subSampling Subsampling used to fill the heights.
+      /// \param[in] _vertSize Number of points per row.
+      /// \param[in] _size Real dimensions of the terrain.
+      /// \param[in] _scale Scale of the terrain.
+      /// \param[in] _flipY Whether the rows are inverted.
+      /// \param[in] _heights The terrain heights.
+      /// \return True if the heights were stored.
+      public: bool Save(const std::string &_filename, int _subSampling,
+                  unsigned int _vertSize,
+                  const ignition::math::Vector3d &_size,
+                  const ignition::math::Vector3d &_scale, bool _flipY,
+                  const std::vector<float> &_heights) const;
+
+      /// \brief Get the name of the cache file of a heightmap file.
+      /// \param[in] _filename Full path of the heightmap file.
+      /// \param[in] _subSampling Subsampling used to fill the heights.
+      /// \param[in] _vertSize Number of points per row.
+      /// \param[in] _size Real dimensions of the terrain.
+      /// \param[in] _scale Scale of the terrain.
+      /// \param[in] _flipY Whether the rows are inverted.
+      /// \param[out] _hash Hash of the heightmap file and the parameters.
+      /// \return Path of the cache file, or an empty string if the
+      /// heightmap file can't be read or the cache is disabled.
+      private: std::string CacheFilename(const std::string &_filename,
+                   int _subSampling, unsigned int _vertSize,
+                   const ignition::math::Vector3d &_size,
+                   const ignition::math::Vector3d &_scale,
+                   bool _flipY, uint64_t &_hash) const;
+
+      /// \brief Directory of the cache.
+      private: std::string path;
+
+      /// \brief Maximum total size of the cache files (bytes).
+      private: uint64_t maxSize;
+    };
+    /// \}
+  }
+}
+#endif
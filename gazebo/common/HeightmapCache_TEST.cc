@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2015 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+#include <ctime>
+#include <boost/filesystem.hpp>
+
+#include "test_config.h"
+#include "gazebo/common/CommonIface.hh"
+#include "gazebo/common/HeightmapCache.hh"
+#include "gazebo/common/ImageHeightmap.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class HeightmapCache : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(HeightmapCache, SaveLoad)
+{
+  boost::filesystem::path cachePath = boost::filesystem::temp_directory_path()
+    / boost::filesystem::unique_path("gazebo_heightmap_cache_%%%%-%%%%");
+  std::string filename =
+    common::find_file("file://media/materials/textures/heightmap_bowl.png");
+  ASSERT_FALSE(filename.empty());
+
+  common::ImageHeightmap img;
+  ASSERT_EQ(0, img.Load(filename));
+
+  int subSampling = 2;
+  unsigned int vertSize = (img.GetWidth() * subSampling) - 1;
+  ignition::math::Vector3d size(129, 129, 10);
+  ignition::math::Vector3d scale(size.X() / vertSize, size.Y() / vertSize,
+      size.Z() / img.GetMaxElevation());
+
+  std::vector<float> heights;
+  img.FillHeightMap(subSampling, vertSize, size, scale, false, heights);
+
+  common::HeightmapCache cache(cachePath.string());
+  EXPECT_EQ(cachePath.string(), cache.GetPath());
+
+  // Nothing is cached yet
+  std::vector<float> cached;
+  EXPECT_FALSE(cache.Load(filename, subSampling, vertSize, size, scale,
+      false, cached));
+
+  EXPECT_TRUE(cache.Save(filename, subSampling, vertSize, size, scale,
+      false, heights));
+  EXPECT_TRUE(cache.Load(filename, subSampling, vertSize, size, scale,
+      false, cached));
+  EXPECT_EQ(heights, cached);
+
+  // Different sampling parameters are cached separately
+  EXPECT_FALSE(cache.Load(filename, subSampling, vertSize, size, scale,
+      true, cached));
+  size.Z(20);
+  EXPECT_FALSE(cache.Load(filename, subSampling, vertSize, size, scale,
+      false, cached));
+
+  // The heights must match the number of points
+  EXPECT_FALSE(cache.Save(filename, subSampling, vertSize + 1, size, scale,
+      false, heights));
+
+  boost::filesystem::remove_all(cachePath);
+}
+
+/////////////////////////////////////////////////
+TEST_F(HeightmapCache, MaxSize)
+{
+  boost::filesystem::path cachePath = boost::filesystem::temp_directory_path()
+    / boost::filesystem::unique_path("gazebo_heightmap_cache_%%%%-%%%%");
+  std::string filename =
+    common::find_file("file://media/materials/textures/heightmap_bowl.png");
+  ASSERT_FALSE(filename.empty());
+
+  unsigned int vertSize = 5;
+  ignition::math::Vector3d size(129, 129, 10);
+  ignition::math::Vector3d scale(1, 1, 1);
+  std::vector<float> heights(vertSize * vertSize, 1.0f);
+  std::vector<float> cached;
+
+  // Store two tables in a cache without a practical limit
+  {
+    common::HeightmapCache cache(cachePath.string());
+    EXPECT_EQ(512u * 1024 * 1024, cache.GetMaxSize());
+    EXPECT_TRUE(cache.Save(filename, 1, vertSize, size, scale, false,
+        heights));
+    EXPECT_TRUE(cache.Save(filename, 1, vertSize, size, scale, true,
+        heights));
+  }
+
+  // Age both tables, then use the second one
+  std::vector<boost::filesystem::path> files;
+  for (boost::filesystem::directory_iterator iter(cachePath), end;
+       iter != end; ++iter)
+  {
+    files.push_back(iter->path());
+  }
+  ASSERT_EQ(2u, files.size());
+  uint64_t fileSize = boost::filesystem::file_size(files[0]);
+  std::time_t now = std::time(NULL);
+  for (auto const &file : files)
+    boost::filesystem::last_write_time(file, now - 200);
+
+  common::HeightmapCache cache(cachePath.string(), 2 * fileSize);
+  EXPECT_EQ(2 * fileSize, cache.GetMaxSize());
+  EXPECT_TRUE(cache.Load(filename, 1, vertSize, size, scale, true,
+      cached));
+
+  // A third table only leaves room for the most recently used one
+  size.Z(20);
+  EXPECT_TRUE(cache.Save(filename, 1, vertSize, size, scale, false,
+      heights));
+  EXPECT_TRUE(cache.Load(filename, 1, vertSize, size, scale, false,
+      cached));
+  size.Z(10);
+  EXPECT_TRUE(cache.Load(filename, 1, vertSize, size, scale, true,
+      cached));
+  EXPECT_FALSE(cache.Load(filename, 1, vertSize, size, scale, false,
+      cached));
+
+  boost::filesystem::remove_all(cachePath);
+}
+
+/////////////////////////////////////////////////
+TEST_F(HeightmapCache, Disabled)
+{
+  std::string filename =
+    common::find_file("file://media/materials/textures/heightmap_bowl.png");
+  ignition::math::Vector3d size(129, 129, 10);
+  std::vector<float> heights(9, 1.0f);
+
+  // An empty path disables the cache
+  common::HeightmapCache cache("");
+  EXPECT_FALSE(cache.Save(filename, 2, 3, size, size, false, heights));
+  EXPECT_FALSE(cache.Load(filename, 2, 3, size, size, false, heights));
+}
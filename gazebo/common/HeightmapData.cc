@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2015 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include "gazebo/common/HeightmapData.hh"
+
+using namespace gazebo;
+using namespace common;
+
+//////////////////////////////////////////////////
+/// \brief Fill a lookup table of heights by bilinear interpolation. The
+/// samples are read as doubles whatever their type, as the serial loops
+/// that this replaces did.
+/// \param[in] _data Samples, row by row.
+/// \param[in] _width Number of samples per row.
+/// \param[in] _height Number of rows.
+/// \param[in] _subSampling Multiplier used to increase the resolution.
+/// \param[in] _vertSize Number of points per row of the table.
+/// \param[in] _offset Value subtracted from the samples.
+/// \param[in] _scale Value used to scale the height.
+/// \param[in] _flipY If true, it inverts the order of the rows.
+/// \param[out] _heights Vector containing the terrain heights.
+template<typename T>
+static void FillHeightsT(const T *_data, unsigned int _width,
+    unsigned int _height, int _subSampling, unsigned int _vertSize,
+    double _offset, double _scale, bool _flipY, std::vector<float> &_heights)
+{
+  // Resize the vector to match the size of the vertices.
+  _heights.resize(_vertSize * _vertSize);
+
+  if (!_data || _width == 0 || _height == 0 || _subSampling <= 0)
+    return;
+
+  // Every row samples the same columns, so compute them once. This also
+  // keeps the inner loop free of branches, so that it can be vectorized.
+  std::vector<unsigned int> columns1(_vertSize);
+  std::vector<unsigned int> columns2(_vertSize);
+  std::vector<double> weights(_vertSize);
+  for (unsigned int x = 0; x < _vertSize; ++x)
+  {
+    double xf = x / static_cast<double>(_subSampling);
+    columns1[x] = std::min(static_cast<unsigned int>(floor(xf)), _width - 1);
+    columns2[x] = std::min(static_cast<unsigned int>(ceil(xf)), _width - 1);
+    weights[x] = xf - floor(xf);
+  }
+
+  const unsigned int *x1 = &columns1[0];
+  const unsigned int *x2 = &columns2[0];
+  const double *dx = &weights[0];
+
+  tbb::parallel_for(tbb::blocked_range<unsigned int>(0, _vertSize),
+      [&](const tbb::blocked_range<unsigned int> &_r)
+      {
+        for (unsigned int y = _r.begin(); y != _r.end(); ++y)
+        {
+          double yf = y / static_cast<double>(_subSampling);
+          unsigned int y1 =
+            std::min(static_cast<unsigned int>(floor(yf)), _height - 1);
+          unsigned int y2 =
+            std::min(static_cast<unsigned int>(ceil(yf)), _height - 1);
+          double dy = yf - floor(yf);
+
+          const T *row1 = _data + y1 * _width;
+          const T *row2 = _data + y2 * _width;
+          float *out = &_heights[0] +
+            (_flipY ? _vertSize - y - 1 : y) * _vertSize;
+
+          for (unsigned int x = 0; x < _vertSize; ++x)
+          {
+            double px1 = row1[x1[x]];
+            double px2 = row1[x2[x]];
+            float h1 = (px1 - ((px1 - px2) * dx[x]));
+
+            double px3 = row2[x1[x]];
+            double px4 = row2[x2[x]];
+            float h2 = (px3 - ((px3 - px4) * dx[x]));
+
+            out[x] = (h1 - ((h1 - h2) * dy) - _offset) * _scale;
+          }
+        }
+      });
+}
+
+//////////////////////////////////////////////////
+void HeightmapData::FillHeights(const float *_data, unsigned int _width,
+    unsigned int _height, int _subSampling, unsigned int _vertSize,
+    double _offset, double _scale, bool _flipY, std::vector<float> &_heights)
+{
+  FillHeightsT(_data, _width, _height, _subSampling, _vertSize, _offset,
+      _scale, _flipY, _heights);
+}
+
+//////////////////////////////////////////////////
+void HeightmapData::FillHeights(const double *_data, unsigned int _width,
+    unsigned int _height, int _subSampling, unsigned int _vertSize,
+    double _offset, double _scale, bool _flipY, std::vector<float> &_heights)
+{
+  FillHeightsT(_data, _width, _height, _subSampling, _vertSize, _offset,
+      _scale, _flipY, _heights);
+}
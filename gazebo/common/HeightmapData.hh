@@ -65,6 +65,39 @@ namespace gazebo
       /// \brief Get the maximum terrain's elevation.
       /// \return The maximum terrain's elevation.
       public: virtual float GetMaxElevation() const = 0;
+
+      /// \brief Fill a lookup table of the terrain's height by bilinear
+      /// interpolation of a grid of samples. Rows are filled in parallel.
+      /// Each height is (interpolated sample - _offset) * _scale.
+      /// \param[in] _data Samples, row by row.
+      /// \param[in] _width Number of samples per row.
+      /// \param[in] _height Number of rows.
+      /// \param[in] _subSampling Multiplier used to increase the resolution.
+      /// \param[in] _vertSize Number of points per row of the table.
+      /// \param[in] _offset Value subtracted from the samples.
+      /// \param[in] _scale Value used to scale the height.
+      /// \param[in] _flipY If true, it inverts the order of the rows.
+      /// \param[out] _heights Vector containing the terrain heights.
+      protected: static void FillHeights(const float *_data,
+          unsigned int _width, unsigned int _height, int _subSampling,
+          unsigned int _vertSize, double _offset, double _scale,
+          bool _flipY, std::vector<float> &_heights);
+
+      /// \brief Fill a lookup table of the terrain's height from double
+      /// precision samples.
+      /// \param[in] _data Samples, row by row.
+      /// \param[in] _width Number of samples per row.
+      /// \param[in] _height Number of rows.
+      /// \param[in] _subSampling Multiplier used to increase the resolution.
+      /// \param[in] _vertSize Number of points per row of the table.
+      /// \param[in] _offset Value subtracted from the samples.
+      /// \param[in] _scale Value used to scale the height.
+      /// \param[in] _flipY If true, it inverts the order of the rows.
+      /// \param[out] _heights Vector containing the terrain heights.
+      protected: static void FillHeights(const double *_data,
+          unsigned int _width, unsigned int _height, int _subSampling,
+          unsigned int _vertSize, double _offset, double _scale,
+          bool _flipY, std::vector<float> &_heights);
     };
     /// \}
   }
@@ -19,7 +19,10 @@
  * Date: 14 July 2008
  */
 
+#include <string.h>
 #include <boost/filesystem.hpp>
+#include <boost/thread/mutex.hpp>
+#include <algorithm>
 #include <string>
 
 #include "gazebo/common/Assert.hh"
@@ -34,13 +37,56 @@ using namespace common;
 
 int Image::count = 0;
 
+/// \brief Guards Image::count, since images are created and destroyed on
+/// several threads.
+static boost::mutex g_imageCountMutex;
+
+/// \brief Get the number of bytes per pixel of an 8 bit pixel format.
+/// \param[in] _format The pixel format.
+/// \return Number of channels, or 0 if the format is not supported.
+static unsigned int ChannelCount(Image::PixelFormat _format)
+{
+  switch (_format)
+  {
+    case Image::L_INT8:
+    case Image::BAYER_RGGB8:
+    case Image::BAYER_RGGR8:
+    case Image::BAYER_GBRG8:
+    case Image::BAYER_GRBG8:
+      return 1;
+    case Image::RGB_INT8:
+    case Image::BGR_INT8:
+      return 3;
+    case Image::RGBA_INT8:
+    case Image::BGRA_INT8:
+      return 4;
+    default:
+      return 0;
+  }
+}
+
+/// \brief Get the offsets of the red and blue channels in a pixel.
+/// \param[in] _format The pixel format.
+/// \param[out] _red Offset of red.
+/// \param[out] _blue Offset of blue.
+static void ChannelOffsets(Image::PixelFormat _format, unsigned int &_red,
+    unsigned int &_blue)
+{
+  bool bgr = _format == Image::BGR_INT8 || _format == Image::BGRA_INT8;
+  _red = bgr ? 2 : 0;
+  _blue = bgr ? 0 : 2;
+}
+
 //////////////////////////////////////////////////
 Image::Image(const std::string &_filename)
 {
-  if (count == 0)
-    FreeImage_Initialise();
+  {
+    boost::mutex::scoped_lock lock(g_imageCountMutex);
+    if (count == 0)
+      FreeImage_Initialise();
 
-  count++;
+    count++;
+  }
 
   this->bitmap = NULL;
   if (!_filename.empty())
@@ -56,12 +102,12 @@ Image::Image(const std::string &_filename)
 //////////////////////////////////////////////////
 Image::~Image()
 {
-  count--;
-
   if (this->bitmap)
     FreeImage_Unload(this->bitmap);
   this->bitmap = NULL;
 
+  boost::mutex::scoped_lock lock(g_imageCountMutex);
+  count--;
   if (count == 0)
     FreeImage_DeInitialise();
 }
@@ -109,6 +155,161 @@ void Image::SavePNG(const std::string &_filename)
   FreeImage_Save(FIF_PNG, this->bitmap, _filename.c_str(), 0);
 }
 
+//////////////////////////////////////////////////
+bool Image::Encode(const unsigned char *_data, unsigned int _width,
+    unsigned int _height, Image::PixelFormat _format, Image::Codec _codec,
+    int _quality, std::string &_out)
+{
+  unsigned int channels = ChannelCount(_format);
+  if (channels == 0 || !_data || _width == 0 || _height == 0)
+  {
+    gzerr << "Unable to encode an image with format["
+          << PixelFormatNames[_format] << "] and size[" << _width << " "
+          << _height << "]\n";
+    return false;
+  }
+
+  // JPEG has no alpha channel.
+  unsigned int outChannels = channels;
+  if (_codec == JPEG_CODEC && channels == 4)
+    outChannels = 3;
+
+  FIBITMAP *fiBitmap = FreeImage_Allocate(_width, _height, outChannels * 8);
+  if (!fiBitmap)
+    return false;
+
+  unsigned int red, blue;
+  ChannelOffsets(_format, red, blue);
+
+  // FreeImage stores rows from bottom to top, in its own channel order.
+  for (unsigned int y = 0; y < _height; ++y)
+  {
+    const unsigned char *src = _data + y * _width * channels;
+    BYTE *dst = FreeImage_GetScanLine(fiBitmap, _height - 1 - y);
+
+    if (channels == 1)
+    {
+      memcpy(dst, src, _width);
+      continue;
+    }
+
+    for (unsigned int x = 0; x < _width; ++x)
+    {
+      dst[FI_RGBA_RED] = src[red];
+      dst[FI_RGBA_GREEN] = src[1];
+      dst[FI_RGBA_BLUE] = src[blue];
+      if (outChannels == 4)
+        dst[FI_RGBA_ALPHA] = src[3];
+      src += channels;
+      dst += outChannels;
+    }
+  }
+
+  FREE_IMAGE_FORMAT fif = FIF_PNG;
+  int flags = PNG_Z_BEST_SPEED;
+  if (_codec == JPEG_CODEC)
+  {
+    fif = FIF_JPEG;
+    flags = std::max(1, std::min(100, _quality));
+  }
+
+  bool result = false;
+  FIMEMORY *memory = FreeImage_OpenMemory();
+  if (FreeImage_SaveToMemory(fif, fiBitmap, memory, flags))
+  {
+    BYTE *buffer = NULL;
+    DWORD size = 0;
+    if (FreeImage_AcquireMemory(memory, &buffer, &size))
+    {
+      _out.assign(reinterpret_cast<const char *>(buffer), size);
+      result = true;
+    }
+  }
+  FreeImage_CloseMemory(memory);
+  FreeImage_Unload(fiBitmap);
+
+  return result;
+}
+
+//////////////////////////////////////////////////
+bool Image::Decode(const std::string &_data, unsigned int _width,
+    unsigned int _height, Image::PixelFormat _format, std::string &_out)
+{
+  unsigned int channels = ChannelCount(_format);
+  if (channels == 0 || _data.empty())
+    return false;
+
+  FIMEMORY *memory = FreeImage_OpenMemory(
+      reinterpret_cast<BYTE *>(const_cast<char *>(_data.data())),
+      _data.size());
+  FREE_IMAGE_FORMAT fif = FreeImage_GetFileTypeFromMemory(memory, 0);
+  FIBITMAP *fiBitmap = NULL;
+  if (fif == FIF_PNG || fif == FIF_JPEG)
+    fiBitmap = FreeImage_LoadFromMemory(fif, memory, 0);
+  FreeImage_CloseMemory(memory);
+
+  if (!fiBitmap)
+  {
+    gzerr << "Unable to decode image data\n";
+    return false;
+  }
+
+  if (FreeImage_GetWidth(fiBitmap) != _width ||
+      FreeImage_GetHeight(fiBitmap) != _height)
+  {
+    gzerr << "Decoded image size[" << FreeImage_GetWidth(fiBitmap) << " "
+          << FreeImage_GetHeight(fiBitmap) << "] does not match the expected "
+          << "size[" << _width << " " << _height << "]\n";
+    FreeImage_Unload(fiBitmap);
+    return false;
+  }
+
+  // Make sure the bitmap has the layout of the requested format.
+  unsigned int bpp = channels == 1 ? 8 : 32;
+  if (FreeImage_GetBPP(fiBitmap) != bpp ||
+      (channels == 1 && FreeImage_GetColorType(fiBitmap) != FIC_MINISBLACK))
+  {
+    FIBITMAP *converted = channels == 1 ?
+      FreeImage_ConvertTo8Bits(fiBitmap) :
+      FreeImage_ConvertTo32Bits(fiBitmap);
+    FreeImage_Unload(fiBitmap);
+    fiBitmap = converted;
+    if (!fiBitmap)
+      return false;
+  }
+
+  unsigned int red, blue;
+  ChannelOffsets(_format, red, blue);
+
+  _out.resize(_width * _height * channels);
+  for (unsigned int y = 0; y < _height; ++y)
+  {
+    const BYTE *src = FreeImage_GetScanLine(fiBitmap, _height - 1 - y);
+    unsigned char *dst =
+      reinterpret_cast<unsigned char *>(&_out[y * _width * channels]);
+
+    if (channels == 1)
+    {
+      memcpy(dst, src, _width);
+      continue;
+    }
+
+    for (unsigned int x = 0; x < _width; ++x)
+    {
+      dst[red] = src[FI_RGBA_RED];
+      dst[1] = src[FI_RGBA_GREEN];
+      dst[blue] = src[FI_RGBA_BLUE];
+      if (channels == 4)
+        dst[3] = src[FI_RGBA_ALPHA];
+      src += 4;
+      dst += channels;
+    }
+  }
+
+  FreeImage_Unload(fiBitmap);
+  return true;
+}
+
 //////////////////////////////////////////////////
 void Image::SetFromData(const unsigned char *_data, unsigned int _width,
     unsigned int _height, PixelFormat _format)
@@ -93,6 +93,16 @@ namespace gazebo
               };
 
 
+      /// \brief Codecs used to compress image data in memory.
+      public: enum Codec
+              {
+                /// \brief Lossless PNG.
+                PNG_CODEC,
+
+                /// \brief Lossy JPEG.
+                JPEG_CODEC
+              };
+
       /// \brief Convert a string to a Image::PixelFormat.
       /// \param[in] _format Pixel format string. \sa Image::PixelFormatNames
       /// \return Image::PixelFormat
@@ -115,6 +125,37 @@ namespace gazebo
       /// \param[in] _filename The name of the saved image
       public: void SavePNG(const std::string &_filename);
 
+      /// \brief Compress raw image data. This does not use an Image
+      /// object, and can be called from any thread.
+      /// \param[in] _data Raw image data, rows from top to bottom without
+      /// padding.
+      /// \param[in] _width Width in pixels.
+      /// \param[in] _height Height in pixels.
+      /// \param[in] _format Pixel format of the data. Only 8 bit formats
+      /// are supported: L_INT8, RGB_INT8, BGR_INT8, RGBA_INT8, BGRA_INT8
+      /// and the bayer formats. JPEG drops the alpha channel.
+      /// \param[in] _codec Codec to use.
+      /// \param[in] _quality JPEG quality, from 1 to 100. Ignored by PNG.
+      /// \param[out] _out The compressed data.
+      /// \return True if the data was compressed.
+      public: static bool Encode(const unsigned char *_data,
+                  unsigned int _width, unsigned int _height,
+                  Image::PixelFormat _format, Image::Codec _codec,
+                  int _quality, std::string &_out);
+
+      /// \brief Decompress data produced by Image::Encode back to the raw
+      /// layout it was encoded from.
+      /// \param[in] _data The compressed data.
+      /// \param[in] _width Expected width in pixels.
+      /// \param[in] _height Expected height in pixels.
+      /// \param[in] _format Pixel format of the raw data. An alpha channel
+      /// dropped by JPEG is set to opaque.
+      /// \param[out] _out The raw image data.
+      /// \return True if the data was decompressed.
+      public: static bool Decode(const std::string &_data,
+                  unsigned int _width, unsigned int _height,
+                  Image::PixelFormat _format, std::string &_out);
+
       /// \brief Set the image from raw data
       /// \param[in] _data Pointer to the raw image data
       /// \param[in] _width Width in pixels
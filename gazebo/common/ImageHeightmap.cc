@@ -55,9 +55,6 @@ void ImageHeightmap::FillHeightMap(int _subSampling,
     const ignition::math::Vector3d &_scale, bool _flipY,
     std::vector<float> &_heights)
 {
-  // Resize the vector to match the size of the vertices.
-  _heights.resize(_vertSize * _vertSize);
-
   int imgHeight = this->GetHeight();
   int imgWidth = this->GetWidth();
 
@@ -73,50 +70,30 @@ void ImageHeightmap::FillHeightMap(int _subSampling,
   unsigned int count;
   this->img.GetData(&data, count);
 
-  // Iterate over all the vertices
-  for (unsigned int y = 0; y < _vertSize; ++y)
+  // Convert the first channel of the image to heights between 0 and 1.
+  // The samples are doubles, as in the interpolation.
+  std::vector<double> samples(imgWidth * imgHeight);
+  for (int y = 0; y < imgHeight; ++y)
   {
-    // yf ranges between 0 and 4
-    double yf = y / static_cast<double>(_subSampling);
-    int y1 = floor(yf);
-    int y2 = ceil(yf);
-    if (y2 >= imgHeight)
-      y2 = imgHeight-1;
-    double dy = yf - y1;
-
-    for (unsigned int x = 0; x < _vertSize; ++x)
+    for (int x = 0; x < imgWidth; ++x)
     {
-      double xf = x / static_cast<double>(_subSampling);
-      int x1 = floor(xf);
-      int x2 = ceil(xf);
-      if (x2 >= imgWidth)
-        x2 = imgWidth-1;
-      double dx = xf - x1;
-
-      double px1 = static_cast<int>(data[y1 * pitch + x1 * bpp]) / 255.0;
-      double px2 = static_cast<int>(data[y1 * pitch + x2 * bpp]) / 255.0;
-      float h1 = (px1 - ((px1 - px2) * dx));
-
-      double px3 = static_cast<int>(data[y2 * pitch + x1 * bpp]) / 255.0;
-      double px4 = static_cast<int>(data[y2 * pitch + x2 * bpp]) / 255.0;
-      float h2 = (px3 - ((px3 - px4) * dx));
-
-      float h = (h1 - ((h1 - h2) * dy)) * _scale.Z();
-
-      // invert pixel definition so 1=ground, 0=full height,
-      //   if the terrain size has a negative z component
-      //   this is mainly for backward compatibility
-      if (_size.Z() < 0)
-        h = 1.0 - h;
-
-      // Store the height for future use
-      if (!_flipY)
-        _heights[y * _vertSize + x] = h;
-      else
-        _heights[(_vertSize - y - 1) * _vertSize + x] = h;
+      samples[y * imgWidth + x] =
+        static_cast<int>(data[y * pitch + x * bpp]) / 255.0;
     }
   }
 
+  FillHeights(samples.empty() ? NULL : &samples[0], imgWidth, imgHeight,
+      _subSampling, _vertSize, 0.0, _scale.Z(), _flipY, _heights);
+
+  // invert pixel definition so 1=ground, 0=full height,
+  //   if the terrain size has a negative z component
+  //   this is mainly for backward compatibility
+  if (_size.Z() < 0)
+  {
+    for (unsigned int i = 0; i < _heights.size(); ++i)
+      _heights[i] = 1.0 - _heights[i];
+  }
+
   delete [] data;
 }
 
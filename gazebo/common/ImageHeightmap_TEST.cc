@@ -18,6 +18,7 @@
 #include <boost/filesystem.hpp>
 #include <gtest/gtest.h>
 
+#include "gazebo/common/Image.hh"
 #include "gazebo/common/ImageHeightmap.hh"
 #include "test_config.h"
 #include "test/util.hh"
@@ -103,6 +104,97 @@ TEST_F(ImageHeightmapTest, FillHeightmap)
   EXPECT_NEAR(5.0, elevations.at(elevations.size() / 2), ELEVATION_TOL);
 }
 
+/////////////////////////////////////////////////
+TEST_F(ImageHeightmapTest, FillHeightmapFlipY)
+{
+  common::ImageHeightmap img;
+  EXPECT_EQ(0, img.Load("file://media/materials/textures/heightmap_bowl.png"));
+
+  int subsampling = 2;
+  unsigned int vertSize = (img.GetWidth() * subsampling) - 1;
+  ignition::math::Vector3d size(129, 129, 10);
+  ignition::math::Vector3d scale(size.X() / vertSize, size.Y() / vertSize,
+      size.Z() / img.GetMaxElevation());
+
+  std::vector<float> elevations;
+  std::vector<float> flipped;
+  img.FillHeightMap(subsampling, vertSize, size, scale, false, elevations);
+  img.FillHeightMap(subsampling, vertSize, size, scale, true, flipped);
+  ASSERT_EQ(elevations.size(), flipped.size());
+
+  // Flipping only inverts the order of the rows
+  for (unsigned int y = 0; y < vertSize; ++y)
+  {
+    for (unsigned int x = 0; x < vertSize; ++x)
+    {
+      EXPECT_FLOAT_EQ(elevations[y * vertSize + x],
+          flipped[(vertSize - y - 1) * vertSize + x]);
+    }
+  }
+
+  // Points between samples are interpolated
+  EXPECT_FLOAT_EQ((elevations[0] + elevations[2]) / 2.0, elevations[1]);
+}
+
+/////////////////////////////////////////////////
+TEST_F(ImageHeightmapTest, FillHeightmapSerial)
+{
+  std::string filename = "file://media/materials/textures/heightmap_bowl.png";
+  common::ImageHeightmap img;
+  EXPECT_EQ(0, img.Load(filename));
+  common::Image image;
+  EXPECT_EQ(0, image.Load(filename));
+
+  int subsampling = 2;
+  unsigned int vertSize = (img.GetWidth() * subsampling) - 1;
+  ignition::math::Vector3d size(129, 129, 10);
+  ignition::math::Vector3d scale(size.X() / vertSize, size.Y() / vertSize,
+      size.Z() / img.GetMaxElevation());
+
+  std::vector<float> elevations;
+  img.FillHeightMap(subsampling, vertSize, size, scale, false, elevations);
+  ASSERT_EQ(vertSize * vertSize, elevations.size());
+
+  int imgHeight = image.GetHeight();
+  int imgWidth = image.GetWidth();
+  unsigned int pitch = image.GetPitch();
+  unsigned int bpp = pitch / imgWidth;
+  unsigned char *data = NULL;
+  unsigned int count;
+  image.GetData(&data, count);
+
+  // The parallel fill gives the same heights as a serial bilinear
+  // interpolation with double precision samples
+  for (unsigned int y = 0; y < vertSize; ++y)
+  {
+    double yf = y / static_cast<double>(subsampling);
+    int y1 = floor(yf);
+    int y2 = std::min(static_cast<int>(ceil(yf)), imgHeight - 1);
+    double dy = yf - y1;
+
+    for (unsigned int x = 0; x < vertSize; ++x)
+    {
+      double xf = x / static_cast<double>(subsampling);
+      int x1 = floor(xf);
+      int x2 = std::min(static_cast<int>(ceil(xf)), imgWidth - 1);
+      double dx = xf - x1;
+
+      double px1 = static_cast<int>(data[y1 * pitch + x1 * bpp]) / 255.0;
+      double px2 = static_cast<int>(data[y1 * pitch + x2 * bpp]) / 255.0;
+      float h1 = (px1 - ((px1 - px2) * dx));
+
+      double px3 = static_cast<int>(data[y2 * pitch + x1 * bpp]) / 255.0;
+      double px4 = static_cast<int>(data[y2 * pitch + x2 * bpp]) / 255.0;
+      float h2 = (px3 - ((px3 - px4) * dx));
+
+      float h = (h1 - ((h1 - h2) * dy)) * scale.Z();
+      EXPECT_EQ(h, elevations[y * vertSize + x]);
+    }
+  }
+
+  delete [] data;
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
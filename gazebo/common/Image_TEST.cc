@@ -51,6 +51,86 @@ TEST_F(ImageTest, Image)
                   common::Image::RGB_INT8);
 }
 
+/////////////////////////////////////////////////
+TEST_F(ImageTest, EncodeDecode)
+{
+  const unsigned int width = 16;
+  const unsigned int height = 8;
+
+  // A gradient, so that rows and channels can't be swapped unnoticed.
+  std::string rgb(width * height * 3, 0);
+  std::string rgba(width * height * 4, 0);
+  std::string gray(width * height, 0);
+  for (unsigned int y = 0; y < height; ++y)
+  {
+    for (unsigned int x = 0; x < width; ++x)
+    {
+      unsigned int i = y * width + x;
+      rgb[i*3] = rgba[i*4] = static_cast<char>(x * 16);
+      rgb[i*3+1] = rgba[i*4+1] = static_cast<char>(y * 32);
+      rgb[i*3+2] = rgba[i*4+2] = static_cast<char>(255 - x * 16);
+      rgba[i*4+3] = static_cast<char>(128);
+      gray[i] = static_cast<char>(x * 8 + y);
+    }
+  }
+  const unsigned char *rgbData =
+    reinterpret_cast<const unsigned char *>(rgb.data());
+
+  // PNG is lossless
+  std::string encoded, decoded;
+  EXPECT_TRUE(common::Image::Encode(rgbData, width, height,
+        common::Image::RGB_INT8, common::Image::PNG_CODEC, 90, encoded));
+  EXPECT_FALSE(encoded.empty());
+  EXPECT_TRUE(common::Image::Decode(encoded, width, height,
+        common::Image::RGB_INT8, decoded));
+  EXPECT_EQ(rgb, decoded);
+
+  EXPECT_TRUE(common::Image::Encode(rgbData, width, height,
+        common::Image::BGR_INT8, common::Image::PNG_CODEC, 90, encoded));
+  EXPECT_TRUE(common::Image::Decode(encoded, width, height,
+        common::Image::BGR_INT8, decoded));
+  EXPECT_EQ(rgb, decoded);
+
+  EXPECT_TRUE(common::Image::Encode(
+        reinterpret_cast<const unsigned char *>(rgba.data()), width, height,
+        common::Image::RGBA_INT8, common::Image::PNG_CODEC, 90, encoded));
+  EXPECT_TRUE(common::Image::Decode(encoded, width, height,
+        common::Image::RGBA_INT8, decoded));
+  EXPECT_EQ(rgba, decoded);
+
+  EXPECT_TRUE(common::Image::Encode(
+        reinterpret_cast<const unsigned char *>(gray.data()), width, height,
+        common::Image::L_INT8, common::Image::PNG_CODEC, 90, encoded));
+  EXPECT_TRUE(common::Image::Decode(encoded, width, height,
+        common::Image::L_INT8, decoded));
+  EXPECT_EQ(gray, decoded);
+
+  // JPEG is close, and drops the alpha channel
+  EXPECT_TRUE(common::Image::Encode(
+        reinterpret_cast<const unsigned char *>(rgba.data()), width, height,
+        common::Image::RGBA_INT8, common::Image::JPEG_CODEC, 100, encoded));
+  EXPECT_TRUE(common::Image::Decode(encoded, width, height,
+        common::Image::RGBA_INT8, decoded));
+  ASSERT_EQ(rgba.size(), decoded.size());
+  for (unsigned int i = 0; i < decoded.size(); ++i)
+  {
+    if (i % 4 == 3)
+    {
+      EXPECT_EQ(255, static_cast<unsigned char>(decoded[i]));
+    }
+    else
+    {
+      EXPECT_NEAR(static_cast<unsigned char>(rgba[i]),
+                  static_cast<unsigned char>(decoded[i]), 32);
+    }
+  }
+
+  // Wrong size and unsupported formats
+  EXPECT_FALSE(common::Image::Decode(encoded, width + 1, height,
+        common::Image::RGBA_INT8, decoded));
+  EXPECT_FALSE(common::Image::Encode(rgbData, width, height,
+        common::Image::RGB_FLOAT32, common::Image::PNG_CODEC, 90, encoded));
+}
 
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
@@ -26,7 +26,7 @@ using namespace gazebo;
 using namespace common;
 
 
-unsigned int Material::counter = 0;
+std::atomic<unsigned int> Material::counter(0);
 
 std::string Material::ShadeModeStr[SHADE_COUNT] = {"FLAT", "GOURAUD",
   "PHONG", "BLINN"};
@@ -187,7 +187,7 @@ void Material::SetBlendFactors(double _srcFactor, double _dstFactor)
 }
 
 //////////////////////////////////////////////////
-void Material::GetBlendFactors(double &_srcFactor, double &_dstFactor)
+void Material::GetBlendFactors(double &_srcFactor, double &_dstFactor) const
 {
   _srcFactor = this->srcBlendFactor;
   _dstFactor = this->dstBlendFactor;
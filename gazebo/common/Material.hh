@@ -17,6 +17,7 @@
 #ifndef _MATERIAL_HH_
 #define _MATERIAL_HH_
 
+#include <atomic>
 #include <string>
 #include <iostream>
 #include "gazebo/common/Color.hh"
@@ -126,7 +127,8 @@ namespace gazebo
       /// \brief Get the blend factors
       /// \param[in] _srcFactor Source factor is returned in this variable
       /// \param[in] _dstFactor Destination factor is returned in this variable
-      public: void GetBlendFactors(double &_srcFactor, double &_dstFactor);
+      public: void GetBlendFactors(double &_srcFactor,
+                  double &_dstFactor) const;
 
       /// \brief Set the blending mode
       /// \param[in] _b the blend mode
@@ -222,8 +224,9 @@ namespace gazebo
       /// \brief the shade mode
       protected: ShadeMode shadeMode;
 
-      /// \brief the total number of instanciated Material instances
-      private: static unsigned int counter;
+      /// \brief the total number of instanciated Material instances. Atomic
+      /// because meshes can be loaded on several threads.
+      private: static std::atomic<unsigned int> counter;
 
       /// \brief flag to perform depth buffer write
       private: bool depthWrite;
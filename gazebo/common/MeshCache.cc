@@ -0,0 +1,486 @@
+/*
+ * Copyright (C) 2015 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <cstring>
+#include <ctime>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include "gazebo/common/CacheFile.hh"
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/Material.hh"
+#include "gazebo/common/Mesh.hh"
+#include "gazebo/common/MeshCache.hh"
+
+using namespace gazebo;
+using namespace common;
+
+/// \brief First bytes of a cache file.
+static const char MeshCacheMagic[CacheFile::MagicSize] =
+  {'G', 'Z', 'M', 'E', 'S', 'H', 'C', 0};
+
+/// \brief Version of the cache file format. Change it when the format, or
+/// the output of the mesh loaders, changes.
+static const uint32_t MeshCacheVersion = 2;
+
+/// \brief Alignment of the arrays in a cache file.
+static const size_t MeshCacheAlignment = 8;
+
+/// \internal
+/// \brief Appends values to the contents of a cache file.
+class MeshCacheWriter
+{
+  /// \brief Constructor
+  /// \param[in] _data String to append to.
+  public: explicit MeshCacheWriter(std::string &_data)
+          : data(_data)
+  {
+  }
+
+  /// \brief Append a value.
+  /// \param[in] _value Value to append.
+  public: template<typename T>
+          void Write(const T &_value)
+  {
+    this->data.append(reinterpret_cast<const char *>(&_value), sizeof(T));
+  }
+
+  /// \brief Append a string, and align the data that follows.
+  /// \param[in] _str String to append.
+  public: void WriteString(const std::string &_str)
+  {
+    this->Write<uint64_t>(_str.size());
+    this->data.append(_str);
+    this->Align();
+  }
+
+  /// \brief Append an array, and align the data that follows.
+  /// \param[in] _values Values to append.
+  /// \param[in] _count Number of values.
+  public: template<typename T>
+          void WriteArray(const T *_values, const size_t _count)
+  {
+    this->data.append(reinterpret_cast<const char *>(_values),
+        sizeof(T) * _count);
+    this->Align();
+  }
+
+  /// \brief Pad the data to the alignment of the arrays.
+  private: void Align()
+  {
+    size_t padding = (MeshCacheAlignment -
+        this->data.size() % MeshCacheAlignment) % MeshCacheAlignment;
+    this->data.append(padding, '\0');
+  }
+
+  /// \brief Contents of the cache file.
+  private: std::string &data;
+};
+
+/// \internal
+/// \brief Reads values from the contents of a cache file, checking that
+/// they are within the file.
+class MeshCacheReader
+{
+  /// \brief Constructor
+  /// \param[in] _data Contents of the cache file.
+  /// \param[in] _size Size of the contents.
+  public: MeshCacheReader(const char *_data, const size_t _size)
+          : data(_data), size(_size), pos(0)
+  {
+  }
+
+  /// \brief Read a value.
+  /// \param[out] _value The value.
+  /// \return False if the file is too short.
+  public: template<typename T>
+          bool Read(T &_value)
+  {
+    if (this->size - this->pos < sizeof(T))
+      return false;
+    memcpy(&_value, this->data + this->pos, sizeof(T));
+    this->pos += sizeof(T);
+    return true;
+  }
+
+  /// \brief Read a string.
+  /// \param[out] _str The string.
+  /// \return False if the file is too short.
+  public: bool ReadString(std::string &_str)
+  {
+    uint64_t length;
+    if (!this->Read(length) || this->size - this->pos < length)
+      return false;
+    _str.assign(this->data + this->pos, length);
+    this->pos += length;
+    return this->Align();
+  }
+
+  /// \brief Get an array, without copying it.
+  /// \param[in] _count Number of values.
+  /// \return Pointer to the values in the file, or NULL if the file is too
+  /// short.
+  public: template<typename T>
+          const T *ReadArray(const uint64_t _count)
+  {
+    if ((this->size - this->pos) / sizeof(T) < _count)
+      return NULL;
+    const T *values = reinterpret_cast<const T *>(this->data + this->pos);
+    this->pos += sizeof(T) * _count;
+    return this->Align() ? values : NULL;
+  }
+
+  /// \brief Skip the padding after a string or an array.
+  /// \return False if the file is too short.
+  private: bool Align()
+  {
+    size_t padding = (MeshCacheAlignment -
+        this->pos % MeshCacheAlignment) % MeshCacheAlignment;
+    if (this->size - this->pos < padding)
+      return false;
+    this->pos += padding;
+    return true;
+  }
+
+  /// \brief Contents of the cache file.
+  private: const char *data;
+
+  /// \brief Size of the contents.
+  private: size_t size;
+
+  /// \brief Position of the next value.
+  private: size_t pos;
+};
+
+//////////////////////////////////////////////////
+/// \brief Write a color to a cache file.
+/// \param[in] _writer Cache file writer.
+/// \param[in] _color The color.
+static void WriteColor(MeshCacheWriter &_writer, const Color &_color)
+{
+  _writer.Write(_color.r);
+  _writer.Write(_color.g);
+  _writer.Write(_color.b);
+  _writer.Write(_color.a);
+}
+
+//////////////////////////////////////////////////
+/// \brief Read a color from a cache file.
+/// \param[in] _reader Cache file reader.
+/// \param[out] _color The color.
+/// \return False if the file is too short.
+static bool ReadColor(MeshCacheReader &_reader, Color &_color)
+{
+  float r, g, b, a;
+  if (!_reader.Read(r) || !_reader.Read(g) || !_reader.Read(b) ||
+      !_reader.Read(a))
+  {
+    return false;
+  }
+  _color.Set(r, g, b, a);
+  return true;
+}
+
+//////////////////////////////////////////////////
+MeshCache::MeshCache(const std::string &_path, const uint64_t _maxSize)
+  : path(_path), maxSize(_maxSize)
+{
+}
+
+//////////////////////////////////////////////////
+MeshCache::~MeshCache()
+{
+}
+
+//////////////////////////////////////////////////
+std::string MeshCache::GetPath() const
+{
+  return this->path;
+}
+
+//////////////////////////////////////////////////
+uint64_t MeshCache::GetMaxSize() const
+{
+  return this->maxSize;
+}
+
+//////////////////////////////////////////////////
+std::string MeshCache::CacheFilename(const std::string &_filename,
+    uint64_t &_hash) const
+{
+  if (this->path.empty())
+    return std::string();
+
+  // Hash the contents of the mesh file, its path, and the format version
+  _hash = CacheFile::HashSeed;
+  if (!CacheFile::HashFile(_filename, _hash))
+    return std::string();
+  _hash = CacheFile::HashBytes(_hash, _filename.c_str(), _filename.size());
+  _hash = CacheFile::HashBytes(_hash,
+      reinterpret_cast<const char *>(&MeshCacheVersion),
+      sizeof(MeshCacheVersion));
+
+  return CacheFile::Filename(this->path, _hash, ".gzmesh");
+}
+
+//////////////////////////////////////////////////
+Mesh *MeshCache::Load(const std::string &_filename) const
+{
+  uint64_t hash = 0;
+  std::string cacheFilename = this->CacheFilename(_filename, hash);
+  boost::system::error_code ec;
+  if (cacheFilename.empty() || !boost::filesystem::exists(cacheFilename, ec))
+    return NULL;
+
+  boost::iostreams::mapped_file_source file;
+  try
+  {
+    file.open(cacheFilename);
+  }
+  catch(std::exception &_e)
+  {
+    gzwarn << "Unable to open mesh cache file[" << cacheFilename << "]: "
+      << _e.what() << "\n";
+    return NULL;
+  }
+
+  if (!CacheFile::CheckHeader(file.data(), file.size(), MeshCacheMagic,
+        MeshCacheVersion, hash))
+  {
+    gzwarn << "Ignoring invalid mesh cache file[" << cacheFilename << "]\n";
+    return NULL;
+  }
+
+  // The header size keeps the arrays that follow it aligned
+  MeshCacheReader reader(file.data() + CacheFile::HeaderSize,
+      file.size() - CacheFile::HeaderSize);
+
+  Mesh *mesh = new Mesh();
+  bool valid = true;
+
+  std::string meshPath;
+  valid = reader.ReadString(meshPath);
+  mesh->SetPath(meshPath);
+
+  uint64_t materialCount = 0;
+  valid = valid && reader.Read(materialCount);
+  for (uint64_t i = 0; valid && i < materialCount; ++i)
+  {
+    std::string texImage;
+    Color ambient, diffuse, specular, emissive;
+    double transparency, shininess, srcFactor, dstFactor, pointSize;
+    uint32_t blendMode, shadeMode, lighting, depthWrite;
+
+    valid = reader.ReadString(texImage) &&
+      ReadColor(reader, ambient) && ReadColor(reader, diffuse) &&
+      ReadColor(reader, specular) && ReadColor(reader, emissive) &&
+      reader.Read(transparency) && reader.Read(shininess) &&
+      reader.Read(srcFactor) && reader.Read(dstFactor) &&
+      reader.Read(pointSize) && reader.Read(blendMode) &&
+      reader.Read(shadeMode) && reader.Read(lighting) &&
+      reader.Read(depthWrite) &&
+      blendMode < Material::BLEND_COUNT && shadeMode < Material::SHADE_COUNT;
+
+    if (valid)
+    {
+      Material *mat = new Material();
+      if (!texImage.empty())
+        mat->SetTextureImage(texImage);
+      mat->SetAmbient(ambient);
+      mat->SetDiffuse(diffuse);
+      mat->SetSpecular(specular);
+      mat->SetEmissive(emissive);
+      mat->SetTransparency(transparency);
+      mat->SetShininess(shininess);
+      mat->SetBlendFactors(srcFactor, dstFactor);
+      mat->SetPointSize(pointSize);
+      mat->SetBlendMode(static_cast<Material::BlendMode>(blendMode));
+      mat->SetShadeMode(static_cast<Material::ShadeMode>(shadeMode));
+      mat->SetLighting(lighting != 0);
+      mat->SetDepthWrite(depthWrite != 0);
+      mesh->AddMaterial(mat);
+    }
+  }
+
+  uint64_t subMeshCount = 0;
+  valid = valid && reader.Read(subMeshCount);
+  for (uint64_t i = 0; valid && i < subMeshCount; ++i)
+  {
+    std::string name;
+    uint32_t primitiveType, materialIndex;
+    uint64_t vertexCount, normalCount, texCoordCount, indexCount;
+
+    valid = reader.ReadString(name) && reader.Read(primitiveType) &&
+      reader.Read(materialIndex) && reader.Read(vertexCount) &&
+      reader.Read(normalCount) && reader.Read(texCoordCount) &&
+      reader.Read(indexCount) && primitiveType <= SubMesh::TRISTRIPS;
+    if (!valid)
+      break;
+
+    const double *vertices = reader.ReadArray<double>(vertexCount * 3);
+    const double *normals = reader.ReadArray<double>(normalCount * 3);
+    const double *texCoords = reader.ReadArray<double>(texCoordCount * 2);
+    const uint32_t *indices = reader.ReadArray<uint32_t>(indexCount);
+    valid = vertices && normals && texCoords && indices;
+    if (!valid)
+      break;
+
+    // The arrays are copied from the mapped file, without parsing.
+    SubMesh *subMesh = new SubMesh();
+    subMesh->SetName(name);
+    subMesh->SetPrimitiveType(
+        static_cast<SubMesh::PrimitiveType>(primitiveType));
+    subMesh->SetMaterialIndex(materialIndex);
+
+    subMesh->SetVertexCount(vertexCount);
+    for (uint64_t v = 0; v < vertexCount; ++v)
+    {
+      subMesh->SetVertex(v, ignition::math::Vector3d(vertices[v * 3],
+            vertices[v * 3 + 1], vertices[v * 3 + 2]));
+    }
+
+    subMesh->SetNormalCount(normalCount);
+    for (uint64_t n = 0; n < normalCount; ++n)
+    {
+      subMesh->SetNormal(n, ignition::math::Vector3d(normals[n * 3],
+            normals[n * 3 + 1], normals[n * 3 + 2]));
+    }
+
+    subMesh->SetTexCoordCount(texCoordCount);
+    for (uint64_t t = 0; t < texCoordCount; ++t)
+    {
+      subMesh->SetTexCoord(t, ignition::math::Vector2d(texCoords[t * 2],
+            texCoords[t * 2 + 1]));
+    }
+
+    for (uint64_t n = 0; n < indexCount; ++n)
+      subMesh->AddIndex(indices[n]);
+
+    mesh->AddSubMesh(subMesh);
+  }
+
+  if (!valid)
+  {
+    gzwarn << "Ignoring truncated mesh cache file[" << cacheFilename << "]\n";
+    delete mesh;
+    return NULL;
+  }
+
+  // Mark the file as recently used, so that Prune keeps it
+  boost::filesystem::last_write_time(cacheFilename, std::time(NULL), ec);
+
+  return mesh;
+}
+
+//////////////////////////////////////////////////
+bool MeshCache::Save(const std::string &_filename, const Mesh *_mesh) const
+{
+  // Skeletons and animations are not stored in the cache
+  if (!_mesh || _mesh->HasSkeleton())
+    return false;
+
+  uint64_t hash = 0;
+  std::string cacheFilename = this->CacheFilename(_filename, hash);
+  if (cacheFilename.empty())
+    return false;
+
+  std::string data;
+  CacheFile::WriteHeader(MeshCacheMagic, MeshCacheVersion, hash, data);
+
+  MeshCacheWriter writer(data);
+  writer.WriteString(_mesh->GetPath());
+
+  writer.Write<uint64_t>(_mesh->GetMaterialCount());
+  for (unsigned int i = 0; i < _mesh->GetMaterialCount(); ++i)
+  {
+    const Material *mat = _mesh->GetMaterial(i);
+    double srcFactor, dstFactor;
+    mat->GetBlendFactors(srcFactor, dstFactor);
+
+    writer.WriteString(mat->GetTextureImage());
+    WriteColor(writer, mat->GetAmbient());
+    WriteColor(writer, mat->GetDiffuse());
+    WriteColor(writer, mat->GetSpecular());
+    WriteColor(writer, mat->GetEmissive());
+    writer.Write(mat->GetTransparency());
+    writer.Write(mat->GetShininess());
+    writer.Write(srcFactor);
+    writer.Write(dstFactor);
+    writer.Write(mat->GetPointSize());
+    writer.Write<uint32_t>(mat->GetBlendMode());
+    writer.Write<uint32_t>(mat->GetShadeMode());
+    writer.Write<uint32_t>(mat->GetLighting());
+    writer.Write<uint32_t>(mat->GetDepthWrite());
+  }
+
+  writer.Write<uint64_t>(_mesh->GetSubMeshCount());
+  for (unsigned int i = 0; i < _mesh->GetSubMeshCount(); ++i)
+  {
+    const SubMesh *subMesh = _mesh->GetSubMesh(i);
+
+    writer.WriteString(subMesh->GetName());
+    writer.Write<uint32_t>(subMesh->GetPrimitiveType());
+    writer.Write<uint32_t>(subMesh->GetMaterialIndex());
+    writer.Write<uint64_t>(subMesh->GetVertexCount());
+    writer.Write<uint64_t>(subMesh->GetNormalCount());
+    writer.Write<uint64_t>(subMesh->GetTexCoordCount());
+    writer.Write<uint64_t>(subMesh->GetIndexCount());
+
+    std::vector<double> values;
+    values.reserve(subMesh->GetVertexCount() * 3);
+    for (unsigned int v = 0; v < subMesh->GetVertexCount(); ++v)
+    {
+      ignition::math::Vector3d vertex = subMesh->Vertex(v);
+      values.push_back(vertex.X());
+      values.push_back(vertex.Y());
+      values.push_back(vertex.Z());
+    }
+    writer.WriteArray(values.data(), values.size());
+
+    values.clear();
+    for (unsigned int n = 0; n < subMesh->GetNormalCount(); ++n)
+    {
+      ignition::math::Vector3d normal = subMesh->Normal(n);
+      values.push_back(normal.X());
+      values.push_back(normal.Y());
+      values.push_back(normal.Z());
+    }
+    writer.WriteArray(values.data(), values.size());
+
+    values.clear();
+    for (unsigned int t = 0; t < subMesh->GetTexCoordCount(); ++t)
+    {
+      ignition::math::Vector2d texCoord = subMesh->TexCoord(t);
+      values.push_back(texCoord.X());
+      values.push_back(texCoord.Y());
+    }
+    writer.WriteArray(values.data(), values.size());
+
+    std::vector<uint32_t> indices(subMesh->GetIndexCount());
+    for (unsigned int n = 0; n < subMesh->GetIndexCount(); ++n)
+      indices[n] = subMesh->GetIndex(n);
+    writer.WriteArray(indices.data(), indices.size());
+  }
+
+  if (!CacheFile::Write(this->path, cacheFilename, data))
+    return false;
+
+  CacheFile::Prune(this->path, ".gzmesh", this->maxSize);
+
+  return true;
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2015 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef _GAZEBO_MESHCACHE_HH_
+#define _GAZEBO_MESHCACHE_HH_
+
+#include <stdint.h>
+#include <string>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    class Mesh;
+
+    /// \addtogroup gazebo_common Common
+    /// \{
+
+    /// \class MeshCache MeshCache.hh common/common.hh
+    /// \brief A directory of meshes stored in a binary format, so that
+    /// mesh files don't need to be parsed again by later processes.
+    ///
+    /// Each mesh is stored in a file named after a hash of the contents
+    /// and the path of the mesh file it was loaded from, so editing or
+    /// moving a mesh file makes its cached copy unused. The arrays in a
+    /// cache file are aligned, and the file is memory mapped when read.
+    /// Meshes with a skeleton are not cached. When the cache grows past its
+    /// maximum size, the least recently used files are removed.
+    class GZ_COMMON_VISIBLE MeshCache
+    {
+      /// \brief Constructor
+      /// \param[in] _path Directory of the cache. It is created when the
+      /// first mesh is saved. An empty path disables the cache.
+      /// \param[in] _maxSize Maximum total size of the cache files (bytes).
+      public: explicit MeshCache(const std::string &_path,
+                  const uint64_t _maxSize = 512 * 1024 * 1024);
+
+      /// \brief Destructor
+      public: virtual ~MeshCache();
+
+      /// \brief Get the directory of the cache.
+      /// \return The directory of the cache, empty if disabled.
+      public: std::string GetPath() const;
+
+      /// \brief Get the maximum total size of the cache files.
+      /// \return Maximum size (bytes).
+      public: uint64_t GetMaxSize() const;
+
+      /// \brief Load the cached copy of a mesh file.
+      /// \param[in] _filename Full path of the mesh file.
+      /// \return A new mesh, or NULL if the mesh file is not in the cache.
+      /// The caller owns the mesh.
+      public: Mesh *Load(const std::string &_filename) const;
+
+      /// \brief Store a mesh loaded from a mesh file in the cache.
+      /// \param[in] _filename Full path of the mesh file.
+      /// \param[in] _mesh The mesh loaded from the file.
+      /// \return True if the mesh was stored.
+      public: bool Save(const std::string &_filename,
+                  const Mesh *_mesh) const;
+
+      /// \brief Get the name of the cache file of a mesh file.
+      /// \param[in] _filename Full path of the mesh file.
+      /// \param[out] _hash Hash of the contents and path of the mesh file.
+      /// \return Path of the cache file, or an empty string if the mesh
+      /// file can't be read or the cache is disabled.
+      private: std::string CacheFilename(const std::string &_filename,
+                   uint64_t &_hash) const;
+
+      /// \brief Directory of the cache.
+      private: std::string path;
+
+      /// \brief Maximum total size of the cache files (bytes).
+      private: uint64_t maxSize;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2015 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+
+#include "test_config.h"
+#include "gazebo/common/ColladaLoader.hh"
+#include "gazebo/common/Material.hh"
+#include "gazebo/common/Mesh.hh"
+#include "gazebo/common/MeshCache.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class MeshCache : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Check that two colors are equal.
+/// \param[in] _expected Expected color.
+/// \param[in] _actual Actual color.
+void ExpectColorEq(const common::Color &_expected,
+    const common::Color &_actual)
+{
+  EXPECT_FLOAT_EQ(_expected.r, _actual.r);
+  EXPECT_FLOAT_EQ(_expected.g, _actual.g);
+  EXPECT_FLOAT_EQ(_expected.b, _actual.b);
+  EXPECT_FLOAT_EQ(_expected.a, _actual.a);
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshCache, SaveLoad)
+{
+  boost::filesystem::path cachePath = boost::filesystem::temp_directory_path()
+    / boost::filesystem::unique_path("gazebo_mesh_cache_%%%%-%%%%");
+  std::string filename =
+    std::string(PROJECT_SOURCE_PATH) + "/test/data/box.dae";
+
+  common::MeshCache cache(cachePath.string());
+  EXPECT_EQ(cachePath.string(), cache.GetPath());
+
+  // Nothing is cached yet
+  EXPECT_TRUE(cache.Load(filename) == NULL);
+
+  common::ColladaLoader loader;
+  common::Mesh *mesh = loader.Load(filename);
+  ASSERT_TRUE(mesh != NULL);
+  EXPECT_TRUE(cache.Save(filename, mesh));
+
+  common::Mesh *cached = cache.Load(filename);
+  ASSERT_TRUE(cached != NULL);
+
+  EXPECT_EQ(filename, cached->GetPath());
+  EXPECT_EQ(mesh->Max(), cached->Max());
+  EXPECT_EQ(mesh->Min(), cached->Min());
+  EXPECT_EQ(mesh->GetVertexCount(), cached->GetVertexCount());
+  EXPECT_EQ(mesh->GetNormalCount(), cached->GetNormalCount());
+  EXPECT_EQ(mesh->GetIndexCount(), cached->GetIndexCount());
+  EXPECT_EQ(mesh->GetTexCoordCount(), cached->GetTexCoordCount());
+  ASSERT_EQ(mesh->GetSubMeshCount(), cached->GetSubMeshCount());
+  ASSERT_EQ(mesh->GetMaterialCount(), cached->GetMaterialCount());
+
+  for (unsigned int i = 0; i < mesh->GetSubMeshCount(); ++i)
+  {
+    const common::SubMesh *subMesh = mesh->GetSubMesh(i);
+    const common::SubMesh *cachedSubMesh = cached->GetSubMesh(i);
+    EXPECT_EQ(subMesh->GetName(), cachedSubMesh->GetName());
+    EXPECT_EQ(subMesh->GetMaterialIndex(),
+        cachedSubMesh->GetMaterialIndex());
+    ASSERT_EQ(subMesh->GetVertexCount(), cachedSubMesh->GetVertexCount());
+    ASSERT_EQ(subMesh->GetIndexCount(), cachedSubMesh->GetIndexCount());
+
+    for (unsigned int j = 0; j < subMesh->GetVertexCount(); ++j)
+    {
+      EXPECT_EQ(subMesh->Vertex(j), cachedSubMesh->Vertex(j));
+      EXPECT_EQ(subMesh->Normal(j), cachedSubMesh->Normal(j));
+    }
+    for (unsigned int j = 0; j < subMesh->GetIndexCount(); ++j)
+      EXPECT_EQ(subMesh->GetIndex(j), cachedSubMesh->GetIndex(j));
+  }
+
+  for (unsigned int i = 0; i < mesh->GetMaterialCount(); ++i)
+  {
+    const common::Material *material = mesh->GetMaterial(i);
+    const common::Material *cachedMaterial = cached->GetMaterial(i);
+    EXPECT_EQ(material->GetTextureImage(), cachedMaterial->GetTextureImage());
+    ExpectColorEq(material->GetAmbient(), cachedMaterial->GetAmbient());
+    ExpectColorEq(material->GetDiffuse(), cachedMaterial->GetDiffuse());
+    ExpectColorEq(material->GetSpecular(), cachedMaterial->GetSpecular());
+    ExpectColorEq(material->GetEmissive(), cachedMaterial->GetEmissive());
+    EXPECT_EQ(material->GetDepthWrite(), cachedMaterial->GetDepthWrite());
+    EXPECT_EQ(material->GetLighting(), cachedMaterial->GetLighting());
+  }
+
+  delete cached;
+  delete mesh;
+  boost::filesystem::remove_all(cachePath);
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshCache, DepthWrite)
+{
+  boost::filesystem::path cachePath = boost::filesystem::temp_directory_path()
+    / boost::filesystem::unique_path("gazebo_mesh_cache_%%%%-%%%%");
+  std::string filename =
+    std::string(PROJECT_SOURCE_PATH) + "/test/data/box.dae";
+
+  common::ColladaLoader loader;
+  common::Mesh *mesh = loader.Load(filename);
+  ASSERT_TRUE(mesh != NULL);
+  ASSERT_GT(mesh->GetMaterialCount(), 0u);
+
+  // Change the default, so that a missing field would be noticed
+  const_cast<common::Material *>(mesh->GetMaterial(0))->SetDepthWrite(
+      !mesh->GetMaterial(0)->GetDepthWrite());
+
+  common::MeshCache cache(cachePath.string());
+  EXPECT_TRUE(cache.Save(filename, mesh));
+
+  common::Mesh *cached = cache.Load(filename);
+  ASSERT_TRUE(cached != NULL);
+  ASSERT_GT(cached->GetMaterialCount(), 0u);
+  EXPECT_EQ(mesh->GetMaterial(0)->GetDepthWrite(),
+      cached->GetMaterial(0)->GetDepthWrite());
+
+  delete cached;
+  delete mesh;
+  boost::filesystem::remove_all(cachePath);
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshCache, MaxSize)
+{
+  boost::filesystem::path cachePath = boost::filesystem::temp_directory_path()
+    / boost::filesystem::unique_path("gazebo_mesh_cache_%%%%-%%%%");
+  std::string filename =
+    std::string(PROJECT_SOURCE_PATH) + "/test/data/box.dae";
+  std::string offsetFilename =
+    std::string(PROJECT_SOURCE_PATH) + "/test/data/box_offset.dae";
+
+  common::ColladaLoader loader;
+  common::Mesh *mesh = loader.Load(filename);
+  ASSERT_TRUE(mesh != NULL);
+  common::Mesh *offsetMesh = loader.Load(offsetFilename);
+  ASSERT_TRUE(offsetMesh != NULL);
+
+  // A cache that only has room for one of the meshes
+  common::MeshCache cache(cachePath.string(), 1);
+  EXPECT_EQ(1u, cache.GetMaxSize());
+  EXPECT_TRUE(cache.Save(filename, mesh));
+  EXPECT_TRUE(cache.Save(offsetFilename, offsetMesh));
+
+  unsigned int count = 0;
+  for (boost::filesystem::directory_iterator iter(cachePath), end;
+       iter != end; ++iter)
+  {
+    ++count;
+  }
+  EXPECT_LE(count, 1u);
+
+  delete offsetMesh;
+  delete mesh;
+  boost::filesystem::remove_all(cachePath);
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshCache, Disabled)
+{
+  std::string filename =
+    std::string(PROJECT_SOURCE_PATH) + "/test/data/box.dae";
+
+  common::ColladaLoader loader;
+  common::Mesh *mesh = loader.Load(filename);
+  ASSERT_TRUE(mesh != NULL);
+
+  // An empty path disables the cache
+  common::MeshCache cache("");
+  EXPECT_FALSE(cache.Save(filename, mesh));
+  EXPECT_TRUE(cache.Load(filename) == NULL);
+
+  // Missing mesh files are never cached
+  EXPECT_TRUE(cache.Load("/no/such/mesh.dae") == NULL);
+
+  delete mesh;
+}
@@ -15,9 +15,14 @@
  *
  */
 #include <sys/stat.h>
+#include <memory>
 #include <string>
 #include <map>
 
+#include <boost/filesystem.hpp>
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+
 #include "gazebo/math/Plane.hh"
 #include "gazebo/math/Matrix3.hh"
 #include "gazebo/math/Matrix4.hh"
@@ -27,6 +32,8 @@
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Mesh.hh"
+#include "gazebo/common/MeshCache.hh"
+#include "gazebo/common/SystemPaths.hh"
 #include "gazebo/common/ColladaLoader.hh"
 #include "gazebo/common/ColladaExporter.hh"
 #include "gazebo/common/STLLoader.hh"
@@ -48,6 +55,8 @@ MeshManager::MeshManager()
   this->colladaLoader = new ColladaLoader();
   this->colladaExporter = new ColladaExporter();
   this->stlLoader = new STLLoader();
+  this->meshCache.reset(new MeshCache((boost::filesystem::path(
+      SystemPaths::Instance()->GetLogPath()) / "mesh_cache").string()));
 
   // Create some basic shapes
   this->CreatePlane("unit_plane",
@@ -96,75 +105,126 @@ const Mesh *MeshManager::Load(const std::string &_filename)
     return NULL;
   }
 
-  Mesh *mesh = NULL;
+  boost::shared_ptr<MeshCache> cache;
+  {
+    boost::mutex::scoped_lock lock(this->mutex);
 
-  std::string extension;
+    // Wait if another thread is loading the same mesh
+    while (this->loading.find(_filename) != this->loading.end())
+      this->loadingCondition.wait(lock);
 
-  if (this->HasMesh(_filename))
-  {
-    return this->meshes[_filename];
-
-    // This breaks trimesh geom. Each new trimesh should have a unique name.
-    /*
-    // erase mesh from this->meshes. This allows a mesh to be modified and
-    // inserted into gazebo again without closing gazebo.
-    std::map<std::string, Mesh*>::iterator iter;
-    iter = this->meshes.find(_filename);
-    delete iter->second;
-    iter->second = NULL;
-    this->meshes.erase(iter);
-    */
+    std::map<std::string, Mesh*>::iterator iter =
+      this->meshes.find(_filename);
+    if (iter != this->meshes.end())
+      return iter->second;
+
+    this->loading.insert(_filename);
+    cache = this->meshCache;
   }
 
+  Mesh *mesh = NULL;
+
   std::string fullname = common::find_file(_filename);
 
-  if (!fullname.empty())
+  try
   {
-    extension = fullname.substr(fullname.rfind(".")+1, fullname.size());
-    std::transform(extension.begin(), extension.end(),
-        extension.begin(), ::tolower);
-    MeshLoader *loader = NULL;
-
-    if (extension == "stl" || extension == "stlb" || extension == "stla")
-      loader = this->stlLoader;
-    else if (extension == "dae")
-      loader = this->colladaLoader;
-    else
-      gzerr << "Unsupported mesh format for file[" << _filename << "]\n";
-
-    try
+    if (!fullname.empty())
     {
-      // This mutex prevents two threads from loading the same mesh at the
-      // same time.
-      boost::mutex::scoped_lock lock(this->mutex);
-      if (!this->HasMesh(_filename))
+      std::string extension;
+      extension = fullname.substr(fullname.rfind(".")+1, fullname.size());
+      std::transform(extension.begin(), extension.end(),
+          extension.begin(), ::tolower);
+
+      // Each load uses its own loader, so that different meshes can be
+      // loaded in parallel.
+      std::unique_ptr<MeshLoader> loader;
+      if (extension == "stl" || extension == "stlb" || extension == "stla")
+        loader.reset(new STLLoader());
+      else if (extension == "dae")
+        loader.reset(new ColladaLoader());
+      else
+        gzerr << "Unsupported mesh format for file[" << _filename << "]\n";
+
+      if (loader)
       {
-        if ((mesh = loader->Load(fullname)) != NULL)
+        mesh = cache->Load(fullname);
+        if (!mesh)
         {
-          mesh->SetName(_filename);
-          this->meshes.insert(std::make_pair(_filename, mesh));
+          if ((mesh = loader->Load(fullname)) != NULL)
+            cache->Save(fullname, mesh);
+          else
+            gzerr << "Unable to load mesh[" << fullname << "]\n";
         }
-        else
-          gzerr << "Unable to load mesh[" << fullname << "]\n";
-      }
-      else
-      {
-        mesh = this->meshes[_filename];
       }
     }
-    catch(gazebo::common::Exception &e)
+    else
+      gzerr << "Unable to find file[" << _filename << "]\n";
+  }
+  catch(gazebo::common::Exception &e)
+  {
     {
-      gzerr << "Error loading mesh[" << fullname << "]\n";
-      gzerr << e << "\n";
-      gzthrow(e);
+      boost::mutex::scoped_lock lock(this->mutex);
+      this->loading.erase(_filename);
     }
+    this->loadingCondition.notify_all();
+
+    gzerr << "Error loading mesh[" << fullname << "]\n";
+    gzerr << e << "\n";
+    gzthrow(e);
   }
-  else
-    gzerr << "Unable to find file[" << _filename << "]\n";
+
+  {
+    boost::mutex::scoped_lock lock(this->mutex);
+    if (mesh)
+    {
+      mesh->SetName(_filename);
+      this->meshes.insert(std::make_pair(_filename, mesh));
+    }
+    this->loading.erase(_filename);
+  }
+  this->loadingCondition.notify_all();
 
   return mesh;
 }
 
+//////////////////////////////////////////////////
+void MeshManager::Preload(const std::vector<std::string> &_filenames)
+{
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, _filenames.size()),
+      [&](const tbb::blocked_range<size_t> &_r)
+      {
+        for (size_t i = _r.begin(); i != _r.end(); ++i)
+        {
+          if (!this->IsValidFilename(_filenames[i]))
+            continue;
+
+          try
+          {
+            this->Load(_filenames[i]);
+          }
+          catch(gazebo::common::Exception &)
+          {
+            // Load has already printed the error. The mesh will be loaded
+            // again, and the error reported, by the entity that uses it.
+          }
+        }
+      });
+}
+
+//////////////////////////////////////////////////
+void MeshManager::SetCachePath(const std::string &_path)
+{
+  boost::mutex::scoped_lock lock(this->mutex);
+  this->meshCache.reset(new MeshCache(_path));
+}
+
+//////////////////////////////////////////////////
+std::string MeshManager::GetCachePath()
+{
+  boost::mutex::scoped_lock lock(this->mutex);
+  return this->meshCache->GetPath();
+}
+
 //////////////////////////////////////////////////
 void MeshManager::Export(const Mesh *_mesh, const std::string &_filename,
     const std::string &_extension, bool _exportTextures)
@@ -18,9 +18,12 @@
 #define _GAZEBO_MESHMANAGER_HH_
 
 #include <map>
+#include <set>
 #include <utility>
 #include <string>
 #include <vector>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/condition_variable.hpp>
 #include <boost/thread/mutex.hpp>
 
 #include <ignition/math/Plane.hh>
@@ -43,6 +46,7 @@ namespace gazebo
   {
     class ColladaLoader;
     class ColladaExporter;
+    class MeshCache;
     class STLLoader;
     class Mesh;
     class Plane;
@@ -63,11 +67,30 @@ namespace gazebo
       /// Destroys the collada loader, the stl loader and all the meshes
       private: virtual ~MeshManager();
 
-      /// \brief Load a mesh from a file
+      /// \brief Load a mesh from a file. Meshes without a skeleton are
+      /// stored in the mesh cache, and later loads of the same file read
+      /// the cache instead of parsing the file. Different meshes can be
+      /// loaded on several threads at the same time.
       /// \param[in] _filename the path to the mesh
       /// \return a pointer to the created mesh
       public: const Mesh *Load(const std::string &_filename);
 
+      /// \brief Load several mesh files in parallel, so that later calls
+      /// to Load for these files return immediately.
+      /// Files with an unsupported extension are skipped.
+      /// \param[in] _filenames Paths to the meshes.
+      public: void Preload(const std::vector<std::string> &_filenames);
+
+      /// \brief Set the directory of the mesh cache. The default is the
+      /// mesh_cache directory in the Gazebo log path.
+      /// \param[in] _path Directory of the cache. An empty path disables
+      /// the cache.
+      public: void SetCachePath(const std::string &_path);
+
+      /// \brief Get the directory of the mesh cache.
+      /// \return Directory of the cache, empty if the cache is disabled.
+      public: std::string GetCachePath();
+
       /// \brief Export a mesh to a file
       /// \param[in] _mesh Pointer to the mesh to be exported
       /// \param[in] _filename Exported file's path and name
@@ -279,6 +302,15 @@ namespace gazebo
       /// \brief Dictionary of meshes, indexed by name
       private: std::map<std::string, Mesh*> meshes;
 
+      /// \brief Binary cache of loaded mesh files.
+      private: boost::shared_ptr<MeshCache> meshCache;
+
+      /// \brief Names of the meshes being loaded by a thread.
+      private: std::set<std::string> loading;
+
+      /// \brief Notified when a thread has finished loading a mesh.
+      private: boost::condition_variable loadingCondition;
+
       /// \brief supported file extensions for meshes
       private: std::vector<std::string> fileExtensions;
 
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2015 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <boost/algorithm/string.hpp>
+
+#include "gazebo/common/SdfSpec.hh"
+
+using namespace gazebo;
+
+/// \brief An SDF element that gazebo reads beyond the sdformat spec.
+struct SdfSpecExtension
+{
+  /// \brief Names of the parent element and of its ancestors, outermost
+  /// first and separated by '/'. Only the end of the path must match.
+  const char *parent;
+
+  /// \brief Name of the element.
+  const char *name;
+
+  /// \brief Type of the value, empty for an element that only holds
+  /// other elements.
+  const char *type;
+
+  /// \brief Default value.
+  const char *defaultValue;
+
+  /// \brief Description of the element.
+  const char *description;
+};
+
+/// \brief The elements added to the spec.
+static const SdfSpecExtension kSdfSpecExtensions[] =
+{
+  {"physics", "model_update_threads", "unsigned int", "0",
+    "Number of threads that update the models of the world. 0 and 1 update "
+    "them on the world thread."},
+  {"physics/ode", "collision_threads", "unsigned int", "0",
+    "Number of threads of the ODE narrow phase collision detection. 0 and 1 "
+    "run it on the physics thread."},
+  {"physics/ode/solver", "island_threads", "int", "0",
+    "Number of threads that step disconnected islands of bodies. 0 steps "
+    "them on the physics thread."},
+  {"physics/ode/solver", "min_island_size", "int", "1",
+    "Islands with fewer bodies are batched together before they are handed "
+    "to the island threads."},
+  {"physics/bullet", "threads", "unsigned int", "0",
+    "Number of threads of the bullet solver. Values above 1 select the "
+    "multithreaded dynamics world, which is only possible before links are "
+    "added."},
+  {"sensor/camera", "compression", "", "",
+    "Compression of the images published by a camera sensor."},
+  {"sensor/camera/compression", "format", "string", "none",
+    "Image format: none, png or jpeg."},
+  {"sensor/camera/compression", "quality", "int", "90",
+    "JPEG quality, from 1 to 100."},
+};
+
+/// \brief Does a path of element names end with a parent path?
+/// \param[in] _path Names of an element and its ancestors, outermost first.
+/// \param[in] _parent Parent path of an extension.
+/// \return True if the path ends with the parent path.
+static bool PathEndsWith(const std::vector<std::string> &_path,
+    const std::string &_parent)
+{
+  std::vector<std::string> parent;
+  boost::split(parent, _parent, boost::is_any_of("/"));
+  if (parent.size() > _path.size())
+    return false;
+
+  return std::equal(parent.rbegin(), parent.rend(), _path.rbegin());
+}
+
+/// \brief Add the extensions to a description and to its children.
+/// \param[in] _desc The element description.
+/// \param[in,out] _path Names of the ancestors of the description.
+/// \param[in,out] _visited Descriptions already extended. The spec
+/// includes some descriptions in themselves.
+static void ExtendDescription(sdf::ElementPtr _desc,
+    std::vector<std::string> &_path, std::set<sdf::Element *> &_visited)
+{
+  if (!_desc || !_visited.insert(_desc.get()).second)
+    return;
+
+  _path.push_back(_desc->GetName());
+
+  for (const SdfSpecExtension &ext : kSdfSpecExtensions)
+  {
+    if (!PathEndsWith(_path, ext.parent) ||
+        _desc->HasElementDescription(ext.name))
+    {
+      continue;
+    }
+
+    sdf::ElementPtr elem(new sdf::Element);
+    elem->SetName(ext.name);
+    elem->SetRequired("0");
+    elem->SetDescription(ext.description);
+    if (ext.type[0] != '\0')
+      elem->AddValue(ext.type, ext.defaultValue, false, ext.description);
+    elem->SetParent(_desc);
+    _desc->AddElementDescription(elem);
+  }
+
+  // Children are visited after the additions, so that the children of an
+  // added element are added too.
+  for (unsigned int i = 0; i < _desc->GetElementDescriptionCount(); ++i)
+    ExtendDescription(_desc->GetElementDescription(i), _path, _visited);
+
+  _path.pop_back();
+}
+
+//////////////////////////////////////////////////
+void common::extendSdfSpec(sdf::ElementPtr _root)
+{
+  std::vector<std::string> path;
+  std::set<sdf::Element *> visited;
+  ExtendDescription(_root, path, visited);
+}
@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2015 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef _GAZEBO_SDFSPEC_HH_
+#define _GAZEBO_SDFSPEC_HH_
+
+#include <sdf/sdf.hh>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \addtogroup gazebo_common
+    /// \{
+
+    /// \brief Add the descriptions of the SDF elements that gazebo reads
+    /// but that the sdformat spec does not define, such as
+    /// <physics><model_update_threads>. The parser drops elements that
+    /// have no description, so this must be called on a description tree
+    /// created by sdf::init or sdf::initFile, before a file or string is
+    /// read into it. Elements that are already described are left as is.
+    /// \param[in] _root Root of the description tree.
+    GZ_COMMON_VISIBLE
+    void extendSdfSpec(sdf::ElementPtr _root);
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2015 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <string>
+
+#include "gazebo/common/SdfSpec.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class SdfSpecTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Read a world string into an extended description tree.
+/// \param[in] _world Content of the <world> element.
+/// \return The world element.
+sdf::ElementPtr ReadWorld(const std::string &_world)
+{
+  sdf::SDFPtr sdf(new sdf::SDF);
+  EXPECT_TRUE(sdf::init(sdf));
+  common::extendSdfSpec(sdf->Root());
+
+  std::string str = "<sdf version='" SDF_VERSION "'>"
+    "<world name='default'>" + _world + "</world></sdf>";
+  EXPECT_TRUE(sdf::readString(str, sdf));
+  return sdf->Root()->GetElement("world");
+}
+
+/////////////////////////////////////////////////
+TEST_F(SdfSpecTest, Physics)
+{
+  sdf::ElementPtr physicsElem = ReadWorld(
+      "<physics type='ode'>"
+      "<model_update_threads>4</model_update_threads>"
+      "</physics>")->GetElement("physics");
+
+  ASSERT_TRUE(physicsElem->HasElement("model_update_threads"));
+  EXPECT_EQ(4u, physicsElem->Get<unsigned int>("model_update_threads"));
+}
+
+/////////////////////////////////////////////////
+TEST_F(SdfSpecTest, ODE)
+{
+  sdf::ElementPtr odeElem = ReadWorld(
+      "<physics type='ode'><ode>"
+      "<collision_threads>3</collision_threads>"
+      "<solver><island_threads>2</island_threads>"
+      "<min_island_size>5</min_island_size></solver>"
+      "</ode></physics>")->GetElement("physics")->GetElement("ode");
+
+  ASSERT_TRUE(odeElem->HasElement("collision_threads"));
+  EXPECT_EQ(3u, odeElem->Get<unsigned int>("collision_threads"));
+
+  sdf::ElementPtr solverElem = odeElem->GetElement("solver");
+  ASSERT_TRUE(solverElem->HasElement("island_threads"));
+  EXPECT_EQ(2, solverElem->Get<int>("island_threads"));
+  ASSERT_TRUE(solverElem->HasElement("min_island_size"));
+  EXPECT_EQ(5, solverElem->Get<int>("min_island_size"));
+}
+
+/////////////////////////////////////////////////
+TEST_F(SdfSpecTest, Bullet)
+{
+  sdf::ElementPtr bulletElem = ReadWorld(
+      "<physics type='bullet'><bullet>"
+      "<threads>4</threads>"
+      "</bullet></physics>")->GetElement("physics")->GetElement("bullet");
+
+  ASSERT_TRUE(bulletElem->HasElement("threads"));
+  EXPECT_EQ(4u, bulletElem->Get<unsigned int>("threads"));
+
+  // Default value
+  bulletElem = ReadWorld("<physics type='bullet'><bullet/></physics>")->
+    GetElement("physics")->GetElement("bullet");
+  EXPECT_EQ(0u, bulletElem->Get<unsigned int>("threads"));
+}
+
+/////////////////////////////////////////////////
+TEST_F(SdfSpecTest, CameraCompression)
+{
+  sdf::ElementPtr cameraElem = ReadWorld(
+      "<model name='m'><link name='l'>"
+      "<sensor name='s' type='camera'><camera>"
+      "<compression><format>jpeg</format><quality>80</quality></compression>"
+      "</camera></sensor></link></model>")->GetElement("model")->
+    GetElement("link")->GetElement("sensor")->GetElement("camera");
+
+  ASSERT_TRUE(cameraElem->HasElement("compression"));
+  sdf::ElementPtr compressionElem = cameraElem->GetElement("compression");
+  EXPECT_EQ("jpeg", compressionElem->Get<std::string>("format"));
+  EXPECT_EQ(80, compressionElem->Get<int>("quality"));
+
+  // Default values
+  compressionElem = ReadWorld(
+      "<model name='m'><link name='l'>"
+      "<sensor name='s' type='camera'><camera><compression/>"
+      "</camera></sensor></link></model>")->GetElement("model")->
+    GetElement("link")->GetElement("sensor")->GetElement("camera")->
+    GetElement("compression");
+  EXPECT_EQ("none", compressionElem->Get<std::string>("format"));
+  EXPECT_EQ(90, compressionElem->Get<int>("quality"));
+}
+
+/////////////////////////////////////////////////
+TEST_F(SdfSpecTest, Idempotent)
+{
+  sdf::SDFPtr sdf(new sdf::SDF);
+  ASSERT_TRUE(sdf::init(sdf));
+  common::extendSdfSpec(sdf->Root());
+  common::extendSdfSpec(sdf->Root());
+
+  sdf::ElementPtr physicsDesc = sdf->Root()->GetElementDescription(
+      "world")->GetElementDescription("physics");
+  ASSERT_TRUE(physicsDesc != NULL);
+
+  unsigned int count = 0;
+  for (unsigned int i = 0; i < physicsDesc->GetElementDescriptionCount(); ++i)
+  {
+    if (physicsDesc->GetElementDescription(i)->GetName() ==
+        "model_update_threads")
+    {
+      ++count;
+    }
+  }
+  EXPECT_EQ(1u, count);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
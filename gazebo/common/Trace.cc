@@ -0,0 +1,323 @@
+/*
+ * Copyright (C) 2015 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "gazebo/common/Trace.hh"
+
+using namespace gazebo;
+using namespace common;
+
+/// \brief Number of spans kept per thread. Must be a power of two.
+static const uint64_t kTraceBufferSize = 1 << 16;
+
+/// \brief A slot of a ring buffer. The fields are atomics, because the
+/// exporter reads them while the thread may overwrite them. The sequence
+/// number tells the exporter whether its copy is consistent.
+struct TraceEvent
+{
+  /// \brief Constructor
+  TraceEvent()
+    : seq(0), id(0), start(0), end(0)
+  {
+  }
+
+  /// \brief Sequence number of the span plus one, or 0 while the slot is
+  /// written.
+  std::atomic<uint64_t> seq;
+
+  /// \brief Id of the span name.
+  std::atomic<uint32_t> id;
+
+  /// \brief Start time.
+  std::atomic<uint64_t> start;
+
+  /// \brief End time.
+  std::atomic<uint64_t> end;
+};
+
+/// \brief A span copied by the exporter.
+struct TraceRecord
+{
+  /// \brief Id of the thread in the trace.
+  uint32_t tid;
+
+  /// \brief Id of the span name.
+  uint32_t id;
+
+  /// \brief Start time.
+  uint64_t start;
+
+  /// \brief End time.
+  uint64_t end;
+};
+
+/// \brief Ring buffer of the spans of a thread. Only its thread writes
+/// events, the exporter reads them.
+class TraceBuffer
+{
+  /// \brief Constructor
+  /// \param[in] _tid Id of the thread in the trace.
+  public: explicit TraceBuffer(uint32_t _tid)
+          : events(kTraceBufferSize), head(0), tail(0), tid(_tid)
+          {
+          }
+
+  /// \brief The spans, indexed by their sequence number modulo the size.
+  public: std::vector<TraceEvent> events;
+
+  /// \brief Sequence number of the next span. Only written by the thread.
+  public: std::atomic<uint64_t> head;
+
+  /// \brief Sequence number of the first span kept, set by Trace::Clear.
+  public: std::atomic<uint64_t> tail;
+
+  /// \brief Id of the thread in the trace.
+  public: uint32_t tid;
+};
+
+/// \brief Names and buffers shared by all the threads.
+struct TraceRegistry
+{
+  /// \brief Guards the members.
+  std::mutex mutex;
+
+  /// \brief Span names, indexed by id.
+  std::vector<std::string> names;
+
+  /// \brief Ids of the span names.
+  std::map<std::string, uint32_t> ids;
+
+  /// \brief Buffers of all the threads that recorded a span. Buffers
+  /// outlive their thread, so that its spans can still be exported.
+  std::vector<std::shared_ptr<TraceBuffer>> buffers;
+};
+
+/// \brief Get the registry. It is never destroyed, since threads may
+/// record spans during static destruction.
+/// \return The registry.
+static TraceRegistry &Registry()
+{
+  static TraceRegistry *registry = new TraceRegistry;
+  return *registry;
+}
+
+/// \brief Buffer of the calling thread, created by its first span.
+static thread_local TraceBuffer *t_traceBuffer = NULL;
+
+std::atomic_bool Trace::enabled(getenv("GAZEBO_TRACE") != NULL);
+
+//////////////////////////////////////////////////
+uint32_t Trace::Intern(const std::string &_name)
+{
+  TraceRegistry &registry = Registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+
+  std::map<std::string, uint32_t>::iterator iter = registry.ids.find(_name);
+  if (iter != registry.ids.end())
+    return iter->second;
+
+  uint32_t id = static_cast<uint32_t>(registry.names.size());
+  registry.names.push_back(_name);
+  registry.ids[_name] = id;
+  return id;
+}
+
+//////////////////////////////////////////////////
+std::string Trace::Name(uint32_t _id)
+{
+  TraceRegistry &registry = Registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+
+  if (_id < registry.names.size())
+    return registry.names[_id];
+  return std::string();
+}
+
+//////////////////////////////////////////////////
+void Trace::SetEnabled(bool _enabled)
+{
+  enabled.store(_enabled);
+}
+
+//////////////////////////////////////////////////
+void Trace::Record(uint32_t _id, uint64_t _start, uint64_t _end)
+{
+  TraceBuffer *buffer = t_traceBuffer;
+  if (!buffer)
+  {
+    TraceRegistry &registry = Registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    std::shared_ptr<TraceBuffer> newBuffer(new TraceBuffer(
+          static_cast<uint32_t>(registry.buffers.size() + 1)));
+    registry.buffers.push_back(newBuffer);
+    buffer = t_traceBuffer = newBuffer.get();
+  }
+
+  // Mark the slot as being written before changing it, so that the
+  // exporter discards a copy that mixes two spans.
+  uint64_t head = buffer->head.load(std::memory_order_relaxed);
+  TraceEvent &event = buffer->events[head & (kTraceBufferSize - 1)];
+  event.seq.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  event.id.store(_id, std::memory_order_relaxed);
+  event.start.store(_start, std::memory_order_relaxed);
+  event.end.store(_end, std::memory_order_relaxed);
+  event.seq.store(head + 1, std::memory_order_release);
+  buffer->head.store(head + 1, std::memory_order_release);
+}
+
+//////////////////////////////////////////////////
+void Trace::Clear()
+{
+  TraceRegistry &registry = Registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+
+  // Threads keep their buffer, only the spans are dropped.
+  for (auto const &buffer : registry.buffers)
+  {
+    buffer->tail.store(buffer->head.load(std::memory_order_acquire),
+        std::memory_order_release);
+  }
+}
+
+//////////////////////////////////////////////////
+size_t Trace::SpanCount()
+{
+  TraceRegistry &registry = Registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+
+  size_t count = 0;
+  for (auto const &buffer : registry.buffers)
+  {
+    count += static_cast<size_t>(std::min(
+          buffer->head.load(std::memory_order_acquire) -
+          buffer->tail.load(std::memory_order_acquire), kTraceBufferSize));
+  }
+  return count;
+}
+
+/// \brief Write a string as a JSON string.
+/// \param[out] _out Stream to write to.
+/// \param[in] _str The string.
+static void WriteJSONString(std::ostream &_out, const std::string &_str)
+{
+  _out << '"';
+  for (std::string::const_iterator iter = _str.begin();
+       iter != _str.end(); ++iter)
+  {
+    if (*iter == '"' || *iter == '\\')
+      _out << '\\' << *iter;
+    else if (static_cast<unsigned char>(*iter) < 0x20)
+    {
+      char code[8];
+      snprintf(code, sizeof(code), "\\u%04x",
+          static_cast<unsigned int>(*iter));
+      _out << code;
+    }
+    else
+      _out << *iter;
+  }
+  _out << '"';
+}
+
+/// \brief Write a time in microseconds, the unit of the Chrome format.
+/// \param[out] _out Stream to write to.
+/// \param[in] _ns Time in nanoseconds.
+static void WriteMicroseconds(std::ostream &_out, uint64_t _ns)
+{
+  char text[32];
+  snprintf(text, sizeof(text), "%llu.%03u",
+      static_cast<unsigned long long>(_ns / 1000),
+      static_cast<unsigned int>(_ns % 1000));
+  _out << text;
+}
+
+//////////////////////////////////////////////////
+void Trace::WriteChromeTrace(std::ostream &_out)
+{
+  std::vector<std::string> names;
+  std::vector<std::shared_ptr<TraceBuffer>> buffers;
+  {
+    TraceRegistry &registry = Registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    names = registry.names;
+    buffers = registry.buffers;
+  }
+
+  // Copy the spans of each thread while it may keep recording. A copy is
+  // kept only if the sequence number of its slot is the expected one
+  // before and after the copy, otherwise the thread overwrote the slot.
+  std::vector<TraceRecord> spans;
+  for (auto const &buffer : buffers)
+  {
+    uint64_t head = buffer->head.load(std::memory_order_acquire);
+    uint64_t first = head > kTraceBufferSize ? head - kTraceBufferSize : 0;
+    first = std::max(first, buffer->tail.load(std::memory_order_acquire));
+
+    for (uint64_t i = first; i < head; ++i)
+    {
+      const TraceEvent &event = buffer->events[i & (kTraceBufferSize - 1)];
+      if (event.seq.load(std::memory_order_acquire) != i + 1)
+        continue;
+
+      TraceRecord record;
+      record.tid = buffer->tid;
+      record.id = event.id.load(std::memory_order_relaxed);
+      record.start = event.start.load(std::memory_order_relaxed);
+      record.end = event.end.load(std::memory_order_relaxed);
+
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (event.seq.load(std::memory_order_relaxed) == i + 1)
+        spans.push_back(record);
+    }
+  }
+
+  uint64_t epoch = 0;
+  for (auto const &span : spans)
+  {
+    if (epoch == 0 || span.start < epoch)
+      epoch = span.start;
+  }
+
+  _out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  bool first = true;
+  for (auto const &event : spans)
+  {
+    if (event.end < event.start)
+      continue;
+
+    if (!first)
+      _out << ",";
+    first = false;
+
+    _out << "\n{\"name\":";
+    WriteJSONString(_out, event.id < names.size() ?
+        names[event.id] : std::string("unknown"));
+    _out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.tid << ",\"ts\":";
+    WriteMicroseconds(_out, event.start - epoch);
+    _out << ",\"dur\":";
+    WriteMicroseconds(_out, event.end - event.start);
+    _out << "}";
+  }
+  _out << "\n]}\n";
+}
@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2015 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef _GAZEBO_TRACE_HH_
+#define _GAZEBO_TRACE_HH_
+
+#include <stdint.h>
+#include <atomic>
+#include <chrono>
+#include <ostream>
+#include <string>
+
+#include "gazebo/util/system.hh"
+
+/// \brief Helpers that give each span of a function a unique name.
+#define GZ_TRACE_SCOPE_IMPL2(_line, _name) \
+  GZ_TRACE_SPAN(gzTraceSpan##_line, _name)
+#define GZ_TRACE_SCOPE_IMPL(_line, _name) GZ_TRACE_SCOPE_IMPL2(_line, _name)
+
+/// \brief Trace the time from here to the end of the enclosing scope.
+/// \param[in] _name Name of the span, a string literal.
+#define GZ_TRACE_SCOPE(_name) GZ_TRACE_SCOPE_IMPL(__LINE__, _name)
+
+/// \brief Declare a span variable that traces the time from here to the end
+/// of the enclosing scope, and in which laps can be recorded.
+/// \param[in] _var Name of the span variable.
+/// \param[in] _name Name of the span, a string literal.
+#define GZ_TRACE_SPAN(_var, _name) \
+  static const uint32_t _var##Id = gazebo::common::Trace::Intern(_name); \
+  gazebo::common::TraceSpan _var(_var##Id)
+
+/// \brief Trace the time since the start of a span, or since its previous
+/// lap, as a span nested in it.
+/// \param[in] _var Span variable declared with GZ_TRACE_SPAN.
+/// \param[in] _name Name of the lap, a string literal.
+#define GZ_TRACE_LAP(_var, _name) \
+  do \
+  { \
+    static const uint32_t gzTraceLapId = \
+      gazebo::common::Trace::Intern(_name); \
+    _var.Lap(gzTraceLapId); \
+  } while (0)
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \addtogroup gazebo_common
+    /// \{
+
+    /// \class Trace Trace.hh common/common.hh
+    /// \brief Records timed spans from any thread, to be exported in the
+    /// Chrome trace event format, which chrome://tracing and Perfetto
+    /// open.
+    ///
+    /// Span names are interned once per call site, by the GZ_TRACE_*
+    /// macros. Each thread records its spans in its own ring buffer
+    /// without locking, and only the most recent spans of each thread
+    /// are kept. When tracing is disabled, a span costs an atomic load.
+    /// Tracing is enabled at startup if the GAZEBO_TRACE environment
+    /// variable is set.
+    class GZ_COMMON_VISIBLE Trace
+    {
+      /// \brief Get the id of a span name, adding the name if needed.
+      /// \param[in] _name Name of the span.
+      /// \return Id of the name.
+      public: static uint32_t Intern(const std::string &_name);
+
+      /// \brief Get the name of a span id.
+      /// \param[in] _id Id returned by Intern.
+      /// \return Name of the span, empty if the id is unknown.
+      public: static std::string Name(uint32_t _id);
+
+      /// \brief Enable or disable recording.
+      /// \param[in] _enabled True to record spans.
+      public: static void SetEnabled(bool _enabled);
+
+      /// \brief Is recording enabled?
+      /// \return True if spans are recorded.
+      public: static bool Enabled()
+              {
+                return enabled.load(std::memory_order_relaxed);
+              }
+
+      /// \brief Get the time used by spans.
+      /// \return Nanoseconds since an arbitrary epoch.
+      public: static uint64_t Now()
+              {
+                return static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      std::chrono::steady_clock::now().time_since_epoch())
+                    .count());
+              }
+
+      /// \brief Record a span on the calling thread.
+      /// \param[in] _id Id of the span name.
+      /// \param[in] _start Start time, from Now().
+      /// \param[in] _end End time, from Now().
+      public: static void Record(uint32_t _id, uint64_t _start,
+                                 uint64_t _end);
+
+      /// \brief Discard the recorded spans of all the threads.
+      public: static void Clear();
+
+      /// \brief Get the number of spans currently kept for all the
+      /// threads.
+      /// \return Number of spans.
+      public: static size_t SpanCount();
+
+      /// \brief Write the recorded spans in the Chrome trace event JSON
+      /// format. Threads can keep recording during the export. Spans they
+      /// overwrite during the export are skipped.
+      /// \param[out] _out Stream to write to.
+      public: static void WriteChromeTrace(std::ostream &_out);
+
+      /// \brief True if spans are recorded.
+      private: static std::atomic_bool enabled;
+    };
+
+    /// \class TraceSpan Trace.hh common/common.hh
+    /// \brief Records a span from its construction to its destruction.
+    /// Use the GZ_TRACE_SCOPE and GZ_TRACE_SPAN macros rather than this
+    /// class.
+    class GZ_COMMON_VISIBLE TraceSpan
+    {
+      /// \brief Constructor
+      /// \param[in] _id Id of the span name.
+      public: explicit TraceSpan(uint32_t _id)
+              : id(_id), start(Trace::Enabled() ? Trace::Now() : 0),
+                lapStart(start)
+              {
+              }
+
+      /// \brief Destructor, records the span.
+      public: ~TraceSpan()
+              {
+                if (this->start)
+                  Trace::Record(this->id, this->start, Trace::Now());
+              }
+
+      /// \brief Record the time since the start or the previous lap.
+      /// \param[in] _id Id of the lap name.
+      public: void Lap(uint32_t _id)
+              {
+                if (this->start)
+                {
+                  uint64_t now = Trace::Now();
+                  Trace::Record(_id, this->lapStart, now);
+                  this->lapStart = now;
+                }
+              }
+
+      /// \brief Id of the span name.
+      private: uint32_t id;
+
+      /// \brief Start time, 0 if tracing was disabled.
+      private: uint64_t start;
+
+      /// \brief Start time of the current lap.
+      private: uint64_t lapStart;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2015 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+#include <sstream>
+#include <string>
+
+#include "gazebo/common/Trace.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class TraceTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Record spans with laps.
+/// \param[in] _count Number of spans.
+void RecordSpans(int _count)
+{
+  for (int i = 0; i < _count; ++i)
+  {
+    GZ_TRACE_SPAN(span, "TraceTest::Span");
+    GZ_TRACE_LAP(span, "TraceTest::Lap");
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Count the occurrences of a string.
+/// \param[in] _str String to search.
+/// \param[in] _sub String to count.
+/// \return Number of occurrences.
+int Count(const std::string &_str, const std::string &_sub)
+{
+  int count = 0;
+  for (size_t pos = _str.find(_sub); pos != std::string::npos;
+       pos = _str.find(_sub, pos + 1))
+  {
+    ++count;
+  }
+  return count;
+}
+
+/////////////////////////////////////////////////
+TEST_F(TraceTest, Intern)
+{
+  uint32_t id = common::Trace::Intern("TraceTest::Intern");
+  EXPECT_EQ(id, common::Trace::Intern("TraceTest::Intern"));
+  EXPECT_NE(id, common::Trace::Intern("TraceTest::Other"));
+  EXPECT_EQ("TraceTest::Intern", common::Trace::Name(id));
+  EXPECT_EQ("", common::Trace::Name(1000000));
+}
+
+/////////////////////////////////////////////////
+TEST_F(TraceTest, Disabled)
+{
+  common::Trace::SetEnabled(false);
+  common::Trace::Clear();
+
+  RecordSpans(10);
+  EXPECT_EQ(0u, common::Trace::SpanCount());
+}
+
+/////////////////////////////////////////////////
+TEST_F(TraceTest, ChromeTrace)
+{
+  common::Trace::SetEnabled(true);
+  common::Trace::Clear();
+
+  // Spans from several threads
+  boost::thread thread1(boost::bind(&RecordSpans, 100));
+  boost::thread thread2(boost::bind(&RecordSpans, 100));
+  RecordSpans(100);
+  thread1.join();
+  thread2.join();
+
+  common::Trace::SetEnabled(false);
+  EXPECT_EQ(600u, common::Trace::SpanCount());
+
+  std::ostringstream stream;
+  common::Trace::WriteChromeTrace(stream);
+  std::string json = stream.str();
+
+  EXPECT_EQ(0u, json.find("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["));
+  EXPECT_EQ(300, Count(json, "\"name\":\"TraceTest::Span\""));
+  EXPECT_EQ(300, Count(json, "\"name\":\"TraceTest::Lap\""));
+  EXPECT_EQ(600, Count(json, "\"ph\":\"X\""));
+  EXPECT_NE(std::string::npos, json.find("\"tid\":"));
+
+  // Clearing drops the spans
+  common::Trace::Clear();
+  EXPECT_EQ(0u, common::Trace::SpanCount());
+  stream.str("");
+  common::Trace::WriteChromeTrace(stream);
+  EXPECT_EQ(0, Count(stream.str(), "\"ph\""));
+}
+
+/////////////////////////////////////////////////
+TEST_F(TraceTest, RingBuffer)
+{
+  common::Trace::SetEnabled(true);
+  common::Trace::Clear();
+
+  // Only the most recent spans of a thread are kept.
+  boost::thread thread(boost::bind(&RecordSpans, 100000));
+  thread.join();
+  common::Trace::SetEnabled(false);
+
+  size_t count = common::Trace::SpanCount();
+  EXPECT_GT(count, 0u);
+  EXPECT_LT(count, 200000u);
+
+  std::ostringstream stream;
+  common::Trace::WriteChromeTrace(stream);
+  EXPECT_EQ(static_cast<int>(count), Count(stream.str(), "\"ph\":\"X\""));
+}
+
+/////////////////////////////////////////////////
+TEST_F(TraceTest, ExportWhileRecording)
+{
+  common::Trace::SetEnabled(true);
+  common::Trace::Clear();
+
+  // A thread keeps recording, and wraps its ring buffer, during the
+  // exports. Every exported span must be complete.
+  boost::thread thread(boost::bind(&RecordSpans, 200000));
+  for (int i = 0; i < 20; ++i)
+  {
+    std::ostringstream stream;
+    common::Trace::WriteChromeTrace(stream);
+    std::string json = stream.str();
+    EXPECT_EQ(Count(json, "\"ph\":\"X\""), Count(json, "\"dur\":"));
+    EXPECT_EQ(std::string::npos, json.find("\"name\":\"unknown\""));
+  }
+  thread.join();
+  common::Trace::SetEnabled(false);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -51,7 +51,7 @@ void help()
   << "  -r [ --record ]               Record state data.\n"
   << "  --record_encoding arg (=zlib) Compression encoding format for log "
   << "data \n"
-  << "                                (zlib|bz2|txt).\n"
+  << "                                (zlib|bz2|txt|bin).\n"
   << "  --record_path arg             Absolute path in which to store "
   << "state data.\n"
   << "  --seed arg                    Start with a given random number seed.\n"
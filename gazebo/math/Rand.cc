@@ -25,6 +25,7 @@
 #else
   #include <unistd.h>
 #endif
+#include <atomic>
 #include <ctime>
 
 #include "gazebo/math/Rand.hh"
@@ -44,11 +45,15 @@ using namespace math;
 
 GeneratorType *Rand::randGenerator = new GeneratorType(seed);
 
+/// \brief Number of calls to SetSeed.
+static std::atomic<uint32_t> g_seedGeneration(0);
+
 //////////////////////////////////////////////////
 void Rand::SetSeed(uint32_t _seed)
 {
   seed = _seed;
   randGenerator->seed(seed);
+  ++g_seedGeneration;
 }
 
 //////////////////////////////////////////////////
@@ -57,6 +62,12 @@ uint32_t Rand::GetSeed()
   return seed;
 }
 
+//////////////////////////////////////////////////
+uint32_t Rand::GetSeedGeneration()
+{
+  return g_seedGeneration;
+}
+
 //////////////////////////////////////////////////
 double Rand::GetDblUniform(double _min, double _max)
 {
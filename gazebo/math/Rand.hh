@@ -69,6 +69,11 @@ namespace gazebo
       /// generator.
       public: static uint32_t GetSeed();
 
+      /// \brief Get a counter that increases every time the seed is set,
+      /// even if it is set to the same value again.
+      /// \return The number of times SetSeed was called.
+      public: static uint32_t GetSeedGeneration();
+
       /// \brief Get a double from a uniform distribution
       /// \param[in] _min Minimum bound for the random number
       /// \param[in] _max Maximum bound for the random number
@@ -75,3 +75,15 @@ TEST_F(RandTest, SetSeed)
     EXPECT_EQ(second[i], math::Rand::GetIntUniform(-10, 10));
   }
 }
+
+//////////////////////////////////////////////////
+TEST_F(RandTest, SeedGeneration)
+{
+  uint32_t generation = math::Rand::GetSeedGeneration();
+
+  // Setting the same seed again also changes the generation
+  math::Rand::SetSeed(math::Rand::GetSeed());
+  EXPECT_EQ(generation + 1, math::Rand::GetSeedGeneration());
+  math::Rand::SetSeed(math::Rand::GetSeed());
+  EXPECT_EQ(generation + 2, math::Rand::GetSeedGeneration());
+}
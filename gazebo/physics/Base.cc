@@ -41,6 +41,7 @@ Base::Base(BasePtr _parent)
   this->id = physics::getUniqueId();
   this->saveable = true;
   this->selected = false;
+  this->childGeneration = 0;
 
   this->sdf.reset(new sdf::Element);
   this->sdf->AddAttribute("name", "string", "__default__", true);
@@ -93,6 +94,9 @@ void Base::Load(sdf::ElementPtr _sdf)
   }
 
   this->ComputeScopedName();
+
+  if (this->world)
+    this->world->IndexEntity(shared_from_this());
 }
 
 //////////////////////////////////////////////////
@@ -113,6 +117,10 @@ void Base::Fini()
       (*iter)->Fini();
 
   this->children.clear();
+  ++this->childGeneration;
+
+  if (this->world)
+    this->world->UnindexEntity(this);
 
   this->world.reset();
   this->parent.reset();
@@ -196,6 +204,7 @@ void Base::AddChild(BasePtr _child)
 
   // Add this _child to our list
   this->children.push_back(_child);
+  ++this->childGeneration;
 }
 
 //////////////////////////////////////////////////
@@ -208,6 +217,7 @@ void Base::RemoveChild(unsigned int _id)
     {
       (*iter)->Fini();
       this->children.erase(iter);
+      ++this->childGeneration;
       break;
     }
   }
@@ -219,6 +229,12 @@ unsigned int Base::GetChildCount() const
   return this->children.size();
 }
 
+//////////////////////////////////////////////////
+unsigned int Base::ChildGeneration() const
+{
+  return this->childGeneration;
+}
+
 //////////////////////////////////////////////////
 void Base::AddType(Base::EntityType _t)
 {
@@ -256,6 +272,7 @@ void Base::RemoveChild(const std::string &_name)
   {
     (*iter)->Fini();
     this->children.erase(iter);
+    ++this->childGeneration;
   }
 }
 
@@ -263,11 +280,20 @@ void Base::RemoveChild(const std::string &_name)
 void Base::RemoveChildren()
 {
   this->children.clear();
+  ++this->childGeneration;
 }
 
 //////////////////////////////////////////////////
 BasePtr Base::GetById(unsigned int _id) const
 {
+  // Use the world's index when the entity is a child of this object.
+  if (this->world)
+  {
+    BasePtr indexed = this->world->GetIndexedEntity(_id);
+    if (indexed && indexed->GetParent().get() == this)
+      return indexed;
+  }
+
   BasePtr result;
   Base_V::const_iterator biter;
 
@@ -226,6 +226,12 @@ namespace gazebo
       /// \return The number of children.
       public: unsigned int GetChildCount() const;
 
+      /// \brief Get a counter that changes every time a child is added or
+      /// removed. Unlike the child count, it also detects a child that was
+      /// replaced by another one.
+      /// \return The child generation.
+      public: unsigned int ChildGeneration() const;
+
       /// \cond
       /// This is an internal function.
       /// \brief Get a child or self by id.
@@ -322,6 +328,9 @@ namespace gazebo
       /// \brief Children of this entity.
       protected: Base_V children;
 
+      /// \brief Incremented every time children are added or removed.
+      protected: unsigned int childGeneration;
+
       /// \brief Pointer to the world.
       protected: WorldPtr world;
 
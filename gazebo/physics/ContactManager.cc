@@ -21,7 +21,9 @@
 #endif
 
 #include <boost/algorithm/string.hpp>
+#include <boost/bind.hpp>
 
+#include "gazebo/common/Events.hh"
 #include "gazebo/transport/Node.hh"
 #include "gazebo/transport/Publisher.hh"
 #include "gazebo/transport/TransportIface.hh"
@@ -41,6 +43,7 @@ ContactManager::ContactManager()
 {
   this->contactIndex = 0;
   this->customMutex = new boost::recursive_mutex();
+  this->collisionIndexDirty = true;
 }
 
 /////////////////////////////////////////////////
@@ -49,6 +52,8 @@ ContactManager::~ContactManager()
   this->Clear();
   this->node.reset();
   this->contactPub.reset();
+  this->addEntityConnection.reset();
+  this->collisionIndex.clear();
 
   boost::unordered_map<std::string, ContactPublisher *>::iterator iter;
   for (iter = this->customContactPublishers.begin();
@@ -78,6 +83,58 @@ void ContactManager::Init(WorldPtr _world)
 
   this->contactPub =
     this->node->Advertise<msgs::Contacts>("~/physics/contacts", 50);
+
+  this->addEntityConnection = event::Events::ConnectAddEntity(
+      boost::bind(&ContactManager::OnAddEntity, this, _1));
+}
+
+/////////////////////////////////////////////////
+void ContactManager::OnAddEntity(const std::string &/*_name*/)
+{
+  boost::recursive_mutex::scoped_lock lock(*this->customMutex);
+  this->collisionIndexDirty = true;
+}
+
+/////////////////////////////////////////////////
+void ContactManager::RebuildCollisionIndex()
+{
+  // Keep the per collision vectors around so that their memory is reused.
+  for (auto &entry : this->collisionIndex)
+    entry.second.clear();
+
+  boost::unordered_map<std::string, ContactPublisher *>::iterator iter;
+  for (iter = this->customContactPublishers.begin();
+      iter != this->customContactPublishers.end(); ++iter)
+  {
+    ContactPublisher *contactPublisher = iter->second;
+
+    // A model can simply be loaded later, so convert ones that are not yet
+    // found
+    std::vector<std::string>::iterator it;
+    for (it = contactPublisher->collisionNames.begin();
+        it != contactPublisher->collisionNames.end();)
+    {
+      Collision *col = NULL;
+      if (this->world)
+      {
+        col = boost::dynamic_pointer_cast<Collision>(
+            this->world->GetByName(*it)).get();
+      }
+
+      if (!col)
+      {
+        ++it;
+        continue;
+      }
+      it = contactPublisher->collisionNames.erase(it);
+      contactPublisher->collisions.insert(col);
+    }
+
+    for (auto const &col : contactPublisher->collisions)
+      this->collisionIndex[col].push_back(contactPublisher);
+  }
+
+  this->collisionIndexDirty = false;
 }
 
 /////////////////////////////////////////////////
@@ -95,45 +152,25 @@ Contact *ContactManager::NewContact(Collision *_collision1,
   // This is a signal to the Physics engine that it can skip the extra
   // processing necessary to get back contact information.
 
-  std::vector<ContactPublisher *> publishers;
+  boost::recursive_mutex::scoped_lock lock(*this->customMutex);
+
+  if (this->collisionIndexDirty)
+    this->RebuildCollisionIndex();
+
+  const std::vector<ContactPublisher *> *publishers1 = NULL;
+  const std::vector<ContactPublisher *> *publishers2 = NULL;
+  if (!this->collisionIndex.empty())
   {
-    boost::recursive_mutex::scoped_lock lock(*this->customMutex);
-    boost::unordered_map<std::string, ContactPublisher *>::iterator iter;
-    for (iter = this->customContactPublishers.begin();
-        iter != this->customContactPublishers.end(); ++iter)
-    {
-      // A model can simply be loaded later, so convert ones that are not yet
-      // found
-      if (!iter->second->collisionNames.empty())
-      {
-        std::vector<std::string>::iterator it;
-        for (it = iter->second->collisionNames.begin();
-            it != iter->second->collisionNames.end();)
-        {
-          Collision *col = boost::dynamic_pointer_cast<Collision>(
-              this->world->GetByName(*it)).get();
-          if (!col)
-          {
-            ++it;
-            continue;
-          }
-          else
-            it = iter->second->collisionNames.erase(it);
-          iter->second->collisions.insert(col);
-        }
-      }
+    auto iter = this->collisionIndex.find(_collision1);
+    if (iter != this->collisionIndex.end() && !iter->second.empty())
+      publishers1 = &iter->second;
 
-      if (iter->second->collisions.find(_collision1) !=
-          iter->second->collisions.end() ||
-          iter->second->collisions.find(_collision2) !=
-          iter->second->collisions.end())
-      {
-        publishers.push_back(iter->second);
-      }
-    }
+    iter = this->collisionIndex.find(_collision2);
+    if (iter != this->collisionIndex.end() && !iter->second.empty())
+      publishers2 = &iter->second;
   }
 
-  if (this->contactPub->HasConnections() || !publishers.empty())
+  if (this->contactPub->HasConnections() || publishers1 || publishers2)
   {
     // Get or create a contact feedback object.
     if (this->contactIndex < this->contacts.size())
@@ -144,9 +181,22 @@ Contact *ContactManager::NewContact(Collision *_collision1,
       this->contacts.push_back(result);
       this->contactIndex = this->contacts.size();
     }
-    for (unsigned int i = 0; i < publishers.size(); ++i)
+
+    // Both collisions may belong to the same filter, so skip publishers
+    // that already received this contact.
+    for (auto const &publishers : {publishers1, publishers2})
     {
-      publishers[i]->contacts.push_back(result);
+      if (!publishers)
+        continue;
+
+      for (auto const &publisher : *publishers)
+      {
+        if (publisher->contacts.empty() ||
+            publisher->contacts.back() != result)
+        {
+          publisher->contacts.push_back(result);
+        }
+      }
     }
   }
 
@@ -223,7 +273,9 @@ void ContactManager::PublishContacts()
   // publish to default topic, ~/physics/contacts
   if (!transport::getMinimalComms())
   {
-    msgs::Contacts msg;
+    // Clear keeps the allocated contacts around for reuse.
+    msgs::Contacts &msg = this->contactsMsg;
+    msg.Clear();
     for (unsigned int i = 0; i < this->contactIndex; ++i)
     {
       if (this->contacts[i]->count == 0)
@@ -244,7 +296,8 @@ void ContactManager::PublishContacts()
       iter != this->customContactPublishers.end(); ++iter)
   {
     ContactPublisher *contactPublisher = iter->second;
-    msgs::Contacts msg2;
+    msgs::Contacts &msg2 = contactPublisher->msg;
+    msg2.Clear();
     for (unsigned int j = 0;
         j < contactPublisher->contacts.size(); ++j)
     {
@@ -303,6 +356,7 @@ std::string ContactManager::CreateFilter(const std::string &_name,
   {
     boost::recursive_mutex::scoped_lock lock(*this->customMutex);
     this->customContactPublishers[name] = contactPublisher;
+    this->collisionIndexDirty = true;
   }
 
   return topic;
@@ -347,6 +401,7 @@ std::string ContactManager::CreateFilter(const std::string &_name,
 
     // Let it know about collisions not yet found.
     this->customContactPublishers[name]->collisionNames = collisionNames;
+    this->collisionIndexDirty = true;
   }
 
   return topic;
@@ -366,6 +421,8 @@ void ContactManager::RemoveFilter(const std::string &_name)
     contactPublisher->collisions.clear();
     contactPublisher->publisher.reset();
     this->customContactPublishers.erase(iter);
+    delete contactPublisher;
+    this->collisionIndexDirty = true;
   }
 }
 
@@ -383,3 +440,46 @@ bool ContactManager::HasFilter(const std::string &_name)
   return this->customContactPublishers.find(_name) !=
       this->customContactPublishers.end();
 }
+
+/////////////////////////////////////////////////
+void ContactManager::RemoveModelCollisions(const std::string &_modelName)
+{
+  std::string prefix = _modelName + "::";
+  auto inModel = [&prefix](const Collision *_collision)
+  {
+    return _collision->GetScopedName().compare(0, prefix.size(), prefix) == 0;
+  };
+
+  boost::recursive_mutex::scoped_lock lock(*this->customMutex);
+
+  boost::unordered_map<std::string, ContactPublisher *>::iterator iter;
+  for (iter = this->customContactPublishers.begin();
+      iter != this->customContactPublishers.end(); ++iter)
+  {
+    ContactPublisher *contactPublisher = iter->second;
+    for (auto it = contactPublisher->collisions.begin();
+        it != contactPublisher->collisions.end();)
+    {
+      if (inModel(*it))
+      {
+        contactPublisher->collisionNames.push_back((*it)->GetScopedName());
+        it = contactPublisher->collisions.erase(it);
+      }
+      else
+        ++it;
+    }
+  }
+
+  // Drop the index entries too, a new collision may be allocated at the
+  // address of a removed one.
+  for (auto it = this->collisionIndex.begin();
+      it != this->collisionIndex.end();)
+  {
+    if (inModel(it->first))
+      it = this->collisionIndex.erase(it);
+    else
+      ++it;
+  }
+
+  this->collisionIndexDirty = true;
+}
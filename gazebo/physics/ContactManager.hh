@@ -26,6 +26,8 @@
 #include <boost/unordered/unordered_map.hpp>
 #include <boost/thread/recursive_mutex.hpp>
 
+#include "gazebo/common/CommonTypes.hh"
+#include "gazebo/msgs/msgs.hh"
 #include "gazebo/transport/TransportTypes.hh"
 
 #include "gazebo/physics/PhysicsTypes.hh"
@@ -54,6 +56,10 @@ namespace gazebo
 
       /// \brief A list of contacts associated to the collisions.
       public: std::vector<Contact *> contacts;
+
+      /// \internal
+      /// \brief Message reused by every publish to avoid allocations.
+      public: msgs::Contacts msg;
     };
 
     /// \addtogroup gazebo_physics
@@ -157,6 +163,23 @@ namespace gazebo
       /// return True if the filter exists.
       public: bool HasFilter(const std::string &_name);
 
+      /// \brief Stop monitoring the collisions of a model that is being
+      /// removed from the world. Filters that monitored them go back to
+      /// waiting for the collision names, so that they are found again if
+      /// the model is spawned again.
+      /// \param[in] _modelName Scoped name of the model.
+      public: void RemoveModelCollisions(const std::string &_modelName);
+
+      /// \brief Rebuild the collision to filter index. Resolves collision
+      /// names that were not loaded when their filter was created.
+      /// customMutex must be locked by the caller.
+      private: void RebuildCollisionIndex();
+
+      /// \brief Mark the collision index as out of date. Called when an
+      /// entity is added to the world.
+      /// \param[in] _name Name of the new entity.
+      private: void OnAddEntity(const std::string &_name);
+
       private: std::vector<Contact*> contacts;
 
       private: unsigned int contactIndex;
@@ -177,6 +200,21 @@ namespace gazebo
 
       /// \brief Mutex to protect the list of custom publishers.
       private: boost::recursive_mutex *customMutex;
+
+      /// \brief Custom publishers interested in each collision. Rebuilt
+      /// only when filters or models change, so that NewContact does
+      /// no name lookups and no allocations.
+      private: boost::unordered_map<Collision *,
+               std::vector<ContactPublisher *> > collisionIndex;
+
+      /// \brief True when collisionIndex needs to be rebuilt.
+      private: bool collisionIndexDirty;
+
+      /// \brief Message reused to publish to the default contact topic.
+      private: msgs::Contacts contactsMsg;
+
+      /// \brief Connection to the add entity event.
+      private: event::ConnectionPtr addEntityConnection;
     };
     /// \}
   }
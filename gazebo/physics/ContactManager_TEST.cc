@@ -24,6 +24,23 @@ class ContactManagerTest : public ServerFixture
 {
 };
 
+unsigned int g_contactsA = 0;
+unsigned int g_contactsB = 0;
+
+/////////////////////////////////////////////////
+void ContactsACallback(ConstContactsPtr &_msg)
+{
+  if (_msg->contact_size() > 0)
+    ++g_contactsA;
+}
+
+/////////////////////////////////////////////////
+void ContactsBCallback(ConstContactsPtr &_msg)
+{
+  if (_msg->contact_size() > 0)
+    ++g_contactsB;
+}
+
 /////////////////////////////////////////////////
 TEST_F(ContactManagerTest, CreateFilter)
 {
@@ -123,6 +140,97 @@ TEST_F(ContactManagerTest, RemoveFilter)
   }
 }
 
+/////////////////////////////////////////////////
+TEST_F(ContactManagerTest, FilterIndex)
+{
+  Load("worlds/empty.world", true);
+
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  physics::PhysicsEnginePtr physics = world->GetPhysicsEngine();
+  ASSERT_TRUE(physics != NULL);
+
+  physics::ContactManager *manager = physics->GetContactManager();
+  ASSERT_TRUE(manager != NULL);
+
+  // Create two filters on the same collision before it is loaded, they
+  // should both resolve once the model is spawned.
+  std::vector<std::string> collisions;
+  collisions.push_back("box::body::geom");
+  std::string topicA = manager->CreateFilter("filter_a", collisions);
+  std::string topicB = manager->CreateFilter("filter_b", collisions);
+  EXPECT_EQ(manager->GetFilterCount(), 2u);
+
+  transport::NodePtr node(new transport::Node());
+  node->Init();
+  transport::SubscriberPtr subA = node->Subscribe(topicA, &ContactsACallback);
+  transport::SubscriberPtr subB = node->Subscribe(topicB, &ContactsBCallback);
+
+  SpawnBox("box", math::Vector3(1, 1, 1), math::Vector3(0, 0, 0.5),
+      math::Vector3::Zero);
+
+  for (unsigned int i = 0; i < 100 && (g_contactsA == 0 || g_contactsB == 0);
+      ++i)
+  {
+    world->Step(1);
+    common::Time::MSleep(10);
+  }
+  EXPECT_GT(g_contactsA, 0u);
+  EXPECT_GT(g_contactsB, 0u);
+
+  // Removing one filter must not affect the other one.
+  manager->RemoveFilter("filter_a");
+  EXPECT_EQ(manager->GetFilterCount(), 1u);
+
+  g_contactsB = 0;
+  for (unsigned int i = 0; i < 100 && g_contactsB == 0; ++i)
+  {
+    world->Step(1);
+    common::Time::MSleep(10);
+  }
+  EXPECT_GT(g_contactsB, 0u);
+  EXPECT_GT(manager->GetContactCount(), 0u);
+}
+
+/////////////////////////////////////////////////
+TEST_F(ContactManagerTest, FilterRemoveModel)
+{
+  Load("worlds/empty.world", true);
+
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  physics::ContactManager *manager =
+      world->GetPhysicsEngine()->GetContactManager();
+  ASSERT_TRUE(manager != NULL);
+
+  std::string topic = manager->CreateFilter("filter_a", "box::body::geom");
+
+  transport::NodePtr node(new transport::Node());
+  node->Init();
+  transport::SubscriberPtr sub = node->Subscribe(topic, &ContactsACallback);
+
+  // The filter must find the collision again each time the model is
+  // spawned, even after the previous one was removed.
+  for (unsigned int spawn = 0; spawn < 2; ++spawn)
+  {
+    SpawnBox("box", math::Vector3(1, 1, 1), math::Vector3(0, 0, 0.5),
+        math::Vector3::Zero);
+
+    g_contactsA = 0;
+    for (unsigned int i = 0; i < 100 && g_contactsA == 0; ++i)
+    {
+      world->Step(1);
+      common::Time::MSleep(10);
+    }
+    EXPECT_GT(g_contactsA, 0u);
+
+    world->RemoveModel("box");
+    EXPECT_TRUE(world->GetModel("box") == NULL);
+  }
+}
+
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -38,10 +38,13 @@
 #include <algorithm>
 #include <cmath>
 #include <string>
+#include <boost/filesystem.hpp>
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
+#include "gazebo/common/HeightmapCache.hh"
 #include "gazebo/common/Image.hh"
 #include "gazebo/common/CommonIface.hh"
+#include "gazebo/common/SystemPaths.hh"
 #include "gazebo/common/SphericalCoordinates.hh"
 #include "gazebo/math/gzmath.hh"
 #include "gazebo/physics/HeightmapShape.hh"
@@ -201,6 +204,8 @@ void HeightmapShape::Load(sdf::ElementPtr _sdf)
     return;
   }
 
+  this->filename = filename;
+
   if (LoadTerrainFile(filename) != 0)
   {
     gzerr << "Heightmap data size must be square, with a size of 2^n+1\n";
@@ -247,9 +252,19 @@ void HeightmapShape::Init()
     this->scale.z = fabs(terrainSize.z) /
                     this->heightmapData->GetMaxElevation();
 
-  // Step 1: Construct the heightmap lookup table
-  this->heightmapData->FillHeightMap(this->subSampling, this->vertSize,
-      this->GetSize().Ign(), this->scale.Ign(), this->flipY, this->heights);
+  // Step 1: Construct the heightmap lookup table. Sampling a large
+  // heightmap takes a while, so the table is cached between runs.
+  common::HeightmapCache cache((boost::filesystem::path(
+      common::SystemPaths::Instance()->GetLogPath()) /
+      "heightmap_cache").string());
+  if (!cache.Load(this->filename, this->subSampling, this->vertSize,
+      this->GetSize().Ign(), this->scale.Ign(), this->flipY, this->heights))
+  {
+    this->heightmapData->FillHeightMap(this->subSampling, this->vertSize,
+        this->GetSize().Ign(), this->scale.Ign(), this->flipY, this->heights);
+    cache.Save(this->filename, this->subSampling, this->vertSize,
+        this->GetSize().Ign(), this->scale.Ign(), this->flipY, this->heights);
+  }
 }
 
 //////////////////////////////////////////////////
@@ -287,13 +302,15 @@ void HeightmapShape::FillMsg(msgs::Geometry &_msg)
   _msg.mutable_heightmap()->set_width(this->vertSize);
   _msg.mutable_heightmap()->set_height(this->vertSize);
 
+  // Copy the heights a row at a time, in inverted row order
+  google::protobuf::RepeatedField<float> *msgHeights =
+    _msg.mutable_heightmap()->mutable_heights();
+  msgHeights->Resize(this->vertSize * this->vertSize, 0.0f);
   for (unsigned int y = 0; y < this->vertSize; ++y)
   {
-    for (unsigned int x = 0; x < this->vertSize; ++x)
-    {
-      int index = (this->vertSize - y - 1) * this->vertSize + x;
-      _msg.mutable_heightmap()->add_heights(this->heights[index]);
-    }
+    std::copy(this->heights.begin() + (this->vertSize - y - 1) *
+        this->vertSize, this->heights.begin() + (this->vertSize - y) *
+        this->vertSize, msgHeights->begin() + y * this->vertSize);
   }
 
   msgs::Set(_msg.mutable_heightmap()->mutable_size(), this->GetSize().Ign());
@@ -171,6 +171,9 @@ namespace gazebo
       /// \brief File format of the heightmap
       private: std::string fileFormat;
 
+      /// \brief Full path of the heightmap file.
+      private: std::string filename;
+
       /// \brief Terrain size
       private: math::Vector3 heightmapSize;
 
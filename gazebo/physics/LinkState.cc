@@ -128,6 +128,25 @@ void LinkState::Load(const sdf::ElementPtr _elem)
     this->wrench.Set(0, 0, 0, 0, 0, 0);
 }
 
+/////////////////////////////////////////////////
+void LinkState::Load(const msgs::LinkState &_msg)
+{
+  this->name = _msg.name();
+
+  if (_msg.has_pose())
+    this->pose = msgs::ConvertIgn(_msg.pose());
+  else
+    this->pose.Set(0, 0, 0, 0, 0, 0);
+
+  if (_msg.has_velocity())
+    this->velocity = msgs::ConvertIgn(_msg.velocity());
+  else
+    this->velocity.Set(0, 0, 0, 0, 0, 0);
+
+  this->acceleration.Set(0, 0, 0, 0, 0, 0);
+  this->wrench.Set(0, 0, 0, 0, 0, 0);
+}
+
 /////////////////////////////////////////////////
 const math::Pose &LinkState::GetPose() const
 {
@@ -316,6 +335,14 @@ void LinkState::FillSDF(sdf::ElementPtr _sdf)
   // }
 }
 
+/////////////////////////////////////////////////
+void LinkState::FillMsg(msgs::LinkState &_msg) const
+{
+  _msg.set_name(this->name);
+  msgs::Set(_msg.mutable_pose(), this->pose.Ign());
+  msgs::Set(_msg.mutable_velocity(), this->velocity.Ign());
+}
+
 /////////////////////////////////////////////////
 void LinkState::SetWallTime(const common::Time &_time)
 {
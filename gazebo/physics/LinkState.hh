@@ -26,6 +26,7 @@
 
 #include <sdf/sdf.hh>
 
+#include "gazebo/msgs/msgs.hh"
 #include "gazebo/physics/State.hh"
 #include "gazebo/physics/CollisionState.hh"
 #include "gazebo/math/Pose.hh"
@@ -95,6 +96,12 @@ namespace gazebo
       /// \param[in] _elem Pointer to the SDF::Element containing state info.
       public: virtual void Load(const sdf::ElementPtr _elem);
 
+      /// \brief Load state from a message.
+      ///
+      /// Load the LinkState information that FillMsg stores.
+      /// \param[in] _msg Link state message.
+      public: void Load(const msgs::LinkState &_msg);
+
       /// \brief Get the link pose.
       /// \return The math::Pose of the Link.
       public: const math::Pose &GetPose() const;
@@ -148,6 +155,11 @@ namespace gazebo
       /// \param[out] _sdf SDF element to populate.
       public: void FillSDF(sdf::ElementPtr _sdf);
 
+      /// \brief Populate a state message with the link pose and velocity,
+      /// which are the parts of the state that are logged.
+      /// \param[out] _msg Message to populate.
+      public: void FillMsg(msgs::LinkState &_msg) const;
+
       /// \brief Set the wall time when this state was generated
       /// \param[in] _time The absolute clock time when the State
       /// data was recorded.
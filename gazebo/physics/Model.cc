@@ -1050,6 +1050,20 @@ void Model::StopAnimation()
   this->jointAnimations.clear();
 }
 
+//////////////////////////////////////////////////
+bool Model::HasJointAnimation() const
+{
+  if (!this->jointAnimations.empty())
+    return true;
+
+  for (auto const &model : this->models)
+  {
+    if (model->HasJointAnimation())
+      return true;
+  }
+  return false;
+}
+
 //////////////////////////////////////////////////
 void Model::AttachStaticModel(ModelPtr &_model, math::Pose _offset)
 {
@@ -1209,6 +1223,7 @@ void Model::RemoveLink(const std::string &_name)
     if ((*iter)->GetName() == _name || (*iter)->GetScopedName() == _name)
     {
       this->links.erase(iter);
+      ++this->childGeneration;
       break;
     }
   }
@@ -248,6 +248,12 @@ namespace gazebo
       /// \brief Stop the current animations.
       public: virtual void StopAnimation();
 
+      /// \brief Check whether this model, or one of its nested models, is
+      /// playing a joint animation.
+      /// \return True if a joint animation is running.
+      /// \sa SetJointAnimation
+      public: bool HasJointAnimation() const;
+
       /// \brief Attach a static model to this model
       ///
       /// This function takes as input a static Model, which is a Model that
@@ -184,6 +184,21 @@ void ModelState::Load(const sdf::ElementPtr _elem)
   }*/
 }
 
+/////////////////////////////////////////////////
+void ModelState::Load(const msgs::ModelState &_msg)
+{
+  this->name = _msg.name();
+
+  if (_msg.has_pose())
+    this->pose = msgs::ConvertIgn(_msg.pose());
+  else
+    this->pose.Set(0, 0, 0, 0, 0, 0);
+
+  this->linkStates.clear();
+  for (int i = 0; i < _msg.link_size(); ++i)
+    this->linkStates[_msg.link(i).name()].Load(_msg.link(i));
+}
+
 /////////////////////////////////////////////////
 const math::Pose &ModelState::GetPose() const
 {
@@ -483,6 +498,16 @@ void ModelState::FillSDF(sdf::ElementPtr _sdf)
   }
 }
 
+/////////////////////////////////////////////////
+void ModelState::FillMsg(msgs::ModelState &_msg) const
+{
+  _msg.set_name(this->name);
+  msgs::Set(_msg.mutable_pose(), this->pose.Ign());
+
+  for (auto const &linkState : this->linkStates)
+    linkState.second.FillMsg(*_msg.add_link());
+}
+
 /////////////////////////////////////////////////
 void ModelState::SetWallTime(const common::Time &_time)
 {
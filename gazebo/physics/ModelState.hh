@@ -27,6 +27,7 @@
 
 #include "gazebo/math/Pose.hh"
 
+#include "gazebo/msgs/msgs.hh"
 #include "gazebo/physics/State.hh"
 #include "gazebo/physics/LinkState.hh"
 #include "gazebo/physics/JointState.hh"
@@ -96,6 +97,12 @@ namespace gazebo
       /// \param[in] _elem Pointer to the SDF::Element containing state info.
       public: virtual void Load(const sdf::ElementPtr _elem);
 
+      /// \brief Load state from a message.
+      ///
+      /// Load the ModelState information that FillMsg stores.
+      /// \param[in] _msg Model state message.
+      public: void Load(const msgs::ModelState &_msg);
+
       /// \brief Get the stored model pose.
       /// \return The math::Pose of the Model.
       public: const math::Pose &GetPose() const;
@@ -177,6 +184,11 @@ namespace gazebo
       /// \param[out] _sdf SDF element to populate.
       public: void FillSDF(sdf::ElementPtr _sdf);
 
+      /// \brief Populate a state message with the model pose and the link
+      /// states. Joint states are not logged, so they are left out.
+      /// \param[out] _msg Message to populate.
+      public: void FillMsg(msgs::ModelState &_msg) const;
+
       /// \brief Set the wall time when this state was generated
       /// \param[in] _time The absolute clock time when the State
       /// data was recorded.
@@ -153,6 +153,25 @@ double MultiRayShape::GetRetro(unsigned int _index)
   return this->rays[_index]->GetRetro();
 }
 
+//////////////////////////////////////////////////
+void MultiRayShape::GetRanges(std::vector<double> &_ranges)
+{
+  // Add min range, because we measured from min range.
+  double minRange = this->GetMinRange();
+
+  _ranges.resize(this->rays.size());
+  for (size_t i = 0; i < this->rays.size(); ++i)
+    _ranges[i] = minRange + this->rays[i]->GetLength();
+}
+
+//////////////////////////////////////////////////
+void MultiRayShape::GetRetros(std::vector<double> &_retros)
+{
+  _retros.resize(this->rays.size());
+  for (size_t i = 0; i < this->rays.size(); ++i)
+    _retros[i] = this->rays[i]->GetRetro();
+}
+
 //////////////////////////////////////////////////
 int MultiRayShape::GetFiducial(unsigned int _index)
 {
@@ -64,6 +64,15 @@ namespace gazebo
       /// \return Retro value for the ray.
       public: double GetRetro(unsigned int _index);
 
+      /// \brief Get the detected ranges of all the rays at once.
+      /// \param[out] _ranges Range of each ray, in ray order.
+      public: void GetRanges(std::vector<double> &_ranges);
+
+      /// \brief Get the detected retro (intensity) values of all the rays
+      /// at once.
+      /// \param[out] _retros Retro value of each ray, in ray order.
+      public: void GetRetros(std::vector<double> &_retros);
+
       /// \brief Get detected fiducial value for a ray.
       /// \param[in] _index Index of the ray.
       /// \return Fiducial value for the ray.
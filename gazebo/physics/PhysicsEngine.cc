@@ -53,6 +53,7 @@ PhysicsEngine::PhysicsEngine(WorldPtr _world)
   this->targetRealTimeFactor = 0;
   this->realTimeUpdateRate = 0;
   this->maxStepSize = 0;
+  this->modelUpdateThreads = 0;
 
   this->node = transport::NodePtr(new transport::Node());
   this->node->Init(this->world->GetName());
@@ -83,6 +84,12 @@ void PhysicsEngine::Load(sdf::ElementPtr _sdf)
       this->sdf->GetElement("real_time_factor")->Get<double>();
   this->maxStepSize =
       this->sdf->GetElement("max_step_size")->Get<double>();
+
+  if (this->sdf->HasElement("model_update_threads"))
+  {
+    this->modelUpdateThreads =
+        this->sdf->Get<unsigned int>("model_update_threads");
+  }
 }
 
 //////////////////////////////////////////////////
@@ -193,6 +200,20 @@ void PhysicsEngine::SetMaxStepSize(double _stepSize)
   this->maxStepSize = _stepSize;
 }
 
+//////////////////////////////////////////////////
+unsigned int PhysicsEngine::ModelUpdateThreads() const
+{
+  return this->modelUpdateThreads;
+}
+
+//////////////////////////////////////////////////
+void PhysicsEngine::SetModelUpdateThreads(unsigned int _threads)
+{
+  if (this->sdf->HasElement("model_update_threads"))
+    this->sdf->GetElement("model_update_threads")->Set(_threads);
+  this->modelUpdateThreads = _threads;
+}
+
 //////////////////////////////////////////////////
 void PhysicsEngine::SetAutoDisableFlag(bool /*_autoDisable*/)
 {
@@ -231,6 +252,16 @@ bool PhysicsEngine::SetParam(const std::string &_key,
       this->SetRealTimeUpdateRate(boost::any_cast<double>(_value));
     else if (_key == "real_time_factor")
       this->SetTargetRealTimeFactor(boost::any_cast<double>(_value));
+    else if (_key == "model_update_threads")
+    {
+      int value = boost::any_cast<int>(_value);
+      if (value < 0)
+      {
+        gzerr << "model_update_threads must be non-negative" << std::endl;
+        return false;
+      }
+      this->SetModelUpdateThreads(static_cast<unsigned int>(value));
+    }
     else if (_key == "gravity")
     {
       boost::any copy = _value;
@@ -311,6 +342,8 @@ bool PhysicsEngine::GetParam(const std::string &_key,
     _value = this->GetRealTimeUpdateRate();
   else if (_key == "real_time_factor")
     _value = this->GetTargetRealTimeFactor();
+  else if (_key == "model_update_threads")
+    _value = static_cast<int>(this->ModelUpdateThreads());
   else if (_key == "gravity")
     _value = this->GetGravity();
   else if (_key == "magnetic_field")
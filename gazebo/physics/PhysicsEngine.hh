@@ -232,7 +232,8 @@ namespace gazebo
       /// \param[in] _key String key
       /// Below is a list of _key parameter definitions:
       ///       -# "solver_type" (string) - returns solver used by engine, e.g.
-      ///          "sequential_impulse' for Bullet, "quick" for ODE
+      ///          "sequential_impulse' for Bullet, "quick", "world" or
+      ///          "parallel_quick" for ODE,
       ///          "Featherstone and Lemkes" for DART and
       ///          "Spatial Algebra and Elastic Foundation" for Simbody.
       ///       -# "cfm" (double) - global CFM (ODE/Bullet)
@@ -255,6 +256,17 @@ namespace gazebo
       ///          (defined but not used in ode).
       ///       -# "max_step_size" (double) - maximum physics step size when
       ///          physics update step must return.
+      ///       -# "island_threads" (int) - number of threads used to step
+      ///          islands of connected bodies concurrently. 0 steps all
+      ///          islands in the physics thread. (ODE)
+      ///       -# "min_island_size" (int) - islands with fewer bodies are
+      ///          grouped into batches of at least this many bodies before
+      ///          they are handed to the island threads. (ODE)
+      ///       -# "collision_threads" (int) - number of threads used by the
+      ///          narrow phase collision detection. (ODE)
+      ///       -# "model_update_threads" (int) - number of threads used to
+      ///          update models in World::Update. Values less than 2 use the
+      ///          single threaded model update loop.
       ///
       /// \param[in] _value The value to set to
       /// \return true if SetParam is successful, false if operation fails.
@@ -278,6 +290,18 @@ namespace gazebo
       /// \brief Debug print out of the physic engine state.
       public: virtual void DebugPrint() const = 0;
 
+      /// \brief Get the number of threads used by World::Update to update
+      /// models concurrently.
+      /// \return Number of model update threads. A value less than 2 means
+      /// models are updated serially.
+      public: unsigned int ModelUpdateThreads() const;
+
+      /// \brief Set the number of threads used by World::Update to update
+      /// models concurrently.
+      /// \param[in] _threads Number of model update threads. A value less
+      /// than 2 selects the single threaded model update loop.
+      public: void SetModelUpdateThreads(unsigned int _threads);
+
       /// \brief Get a pointer to the contact manger.
       /// \return Pointer to the contact manager.
       public: ContactManager *GetContactManager() const;
@@ -332,6 +356,9 @@ namespace gazebo
 
       /// \brief Real time update rate.
       protected: double maxStepSize;
+
+      /// \brief Number of threads used to update models.
+      protected: unsigned int modelUpdateThreads;
     };
     /// \}
   }
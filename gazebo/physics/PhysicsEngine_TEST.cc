@@ -156,6 +156,18 @@ void PhysicsEngineTest::PhysicsEngineParam(const std::string &_physicsEngine)
       EXPECT_TRUE(physics->GetParam("magnetic_field", value));
       EXPECT_EQ(boost::any_cast<math::Vector3>(value),
                 math::Vector3(magneticField2));
+      gzdbg << "Set and Get model_update_threads" << std::endl;
+      EXPECT_TRUE(physics->SetParam("model_update_threads", 4));
+      EXPECT_TRUE(physics->GetParam("model_update_threads", value));
+      EXPECT_EQ(boost::any_cast<int>(value), 4);
+      EXPECT_EQ(physics->ModelUpdateThreads(), 4u);
+      EXPECT_FALSE(physics->SetParam("model_update_threads", -1));
+      EXPECT_EQ(physics->ModelUpdateThreads(), 4u);
+
+      // Step with the threaded model update, then switch back
+      world->Step(10);
+      EXPECT_TRUE(physics->SetParam("model_update_threads", 0));
+      world->Step(10);
     }
     catch(boost::bad_any_cast &_e)
     {
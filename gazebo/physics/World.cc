@@ -33,6 +33,7 @@
 
 #include <sdf/sdf.hh>
 
+#include <algorithm>
 #include <deque>
 #include <list>
 #include <set>
@@ -54,7 +55,10 @@
 #include "gazebo/common/Events.hh"
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Console.hh"
+#include "gazebo/common/MeshManager.hh"
 #include "gazebo/common/Plugin.hh"
+#include "gazebo/common/SdfSpec.hh"
+#include "gazebo/common/Trace.hh"
 
 #include "gazebo/math/Vector3.hh"
 
@@ -87,6 +91,47 @@ using namespace physics;
 /// This will be replaced with a class member variable in Gazebo 3.0
 bool g_clearModels;
 
+//////////////////////////////////////////////////
+/// \brief Collect the files of the collision meshes in an SDF element.
+/// \param[in] _sdf The SDF element to search.
+/// \param[out] _filenames Full paths of the mesh files.
+static void CollisionMeshFiles(sdf::ElementPtr _sdf,
+    std::vector<std::string> &_filenames)
+{
+  for (sdf::ElementPtr elem = _sdf->GetFirstElement(); elem;
+       elem = elem->GetNextElement())
+  {
+    if (elem->GetName() == "mesh" && elem->HasElement("uri") &&
+        _sdf->GetName() == "geometry" && _sdf->GetParent() &&
+        _sdf->GetParent()->GetName() == "collision")
+    {
+      std::string filename =
+        common::find_file(elem->Get<std::string>("uri"));
+      if (!filename.empty() && filename != "__default__")
+        _filenames.push_back(filename);
+    }
+    else
+      CollisionMeshFiles(elem, _filenames);
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Write a world state to the data of the world log. Log files with
+/// the "bin" encoding store the state as a message, the others as SDF.
+/// \param[in] _state State to write.
+/// \param[out] _stream Stream that receives the log data.
+static void WriteLogState(const WorldState &_state, std::ostream &_stream)
+{
+  if (util::LogRecord::Instance()->GetEncoding() == "bin")
+  {
+    msgs::WorldState msg;
+    _state.FillMsg(msg);
+    util::LogRecord::AppendState(msg, _stream);
+  }
+  else
+    _stream << "<sdf version='" << SDF_VERSION << "'>" << _state << "</sdf>";
+}
+
 class ModelUpdate_TBB
 {
   public: ModelUpdate_TBB(Model_V *_models) : models(_models) {}
@@ -108,9 +153,11 @@ World::World(const std::string &_name)
   g_clearModels = false;
   this->dataPtr->sdf.reset(new sdf::Element);
   sdf::initFile("world.sdf", this->dataPtr->sdf);
+  common::extendSdfSpec(this->dataPtr->sdf);
 
   this->dataPtr->factorySDF.reset(new sdf::SDF);
   sdf::initFile("root.sdf", this->dataPtr->factorySDF);
+  common::extendSdfSpec(this->dataPtr->factorySDF->Root());
 
   this->dataPtr->logPlayStateSDF.reset(new sdf::Element);
   sdf::initFile("state.sdf", this->dataPtr->logPlayStateSDF);
@@ -124,11 +171,19 @@ World::World(const std::string &_name)
   this->dataPtr->pause = false;
   this->dataPtr->thread = NULL;
   this->dataPtr->logThread = NULL;
+  this->dataPtr->traceThread = NULL;
   this->dataPtr->stop = false;
   this->dataPtr->seekPending = false;
 
+  this->dataPtr->modelUpdateFunc = &World::ModelUpdateSingleLoop;
+  this->dataPtr->modelUpdateThreads = 0;
+  this->dataPtr->modelUpdateArena = NULL;
+  this->dataPtr->compactPoseMsgs = false;
+  this->dataPtr->poseSubscriptionGeneration = 0;
+
   this->dataPtr->currentStateBuffer = 0;
-  this->dataPtr->stateToggle = 0;
+  this->dataPtr->logFullCapture = true;
+  this->dataPtr->logDirtyAll = false;
 
   this->dataPtr->pluginsLoaded = false;
 
@@ -243,6 +298,8 @@ void World::Load(sdf::ElementPtr _sdf)
 
   this->dataPtr->responsePub = this->dataPtr->node->Advertise<msgs::Response>(
       "~/response");
+  this->dataPtr->tracePub = this->dataPtr->node->Advertise<msgs::GzString>(
+      "~/trace");
   this->dataPtr->statPub =
     this->dataPtr->node->Advertise<msgs::WorldStatistics>(
         "~/world_stats", 100, 5);
@@ -286,6 +343,7 @@ void World::Load(sdf::ElementPtr _sdf)
   this->dataPtr->rootElement.reset(new Base(BasePtr()));
   this->dataPtr->rootElement->SetName(this->GetName());
   this->dataPtr->rootElement->SetWorld(shared_from_this());
+  this->IndexEntity(this->dataPtr->rootElement);
 
   // A special order is necessary when loading a world that contains state
   // information. The joints must be created last, otherwise they get
@@ -317,13 +375,8 @@ void World::Load(sdf::ElementPtr _sdf)
       this->GetModel(i)->LoadJoints();
   }
 
-  // TODO: Performance test to see if TBB model updating is necessary
-  // Choose threaded or unthreaded model updating depending on the number of
-  // models in the scene
-  // if (this->GetModelCount() < 20)
-  this->dataPtr->modelUpdateFunc = &World::ModelUpdateSingleLoop;
-  // else
-  // this->dataPtr->modelUpdateFunc = &World::ModelUpdateTBB;
+  // Choose threaded or unthreaded model updating
+  this->UpdateModelUpdateFunc();
 
   event::Events::worldCreated(this->GetName());
 
@@ -366,11 +419,11 @@ void World::Init()
   this->dataPtr->testRay = boost::dynamic_pointer_cast<RayShape>(
       this->GetPhysicsEngine()->CreateShape("ray", CollisionPtr()));
 
-  this->dataPtr->prevStates[0].SetWorld(shared_from_this());
-  this->dataPtr->prevStates[1].SetWorld(shared_from_this());
+  this->dataPtr->logState.SetWorld(shared_from_this());
+  this->dataPtr->loggedState.SetWorld(shared_from_this());
 
-  this->dataPtr->prevStates[0].SetName(this->GetName());
-  this->dataPtr->prevStates[1].SetName(this->GetName());
+  this->dataPtr->logState.SetName(this->GetName());
+  this->dataPtr->loggedState.SetName(this->GetName());
 
   this->dataPtr->updateInfo.worldName = this->GetName();
 
@@ -452,9 +505,9 @@ void World::RunLoop()
   this->dataPtr->prevStepWallTime = common::Time::GetWallTime();
 
   // Get the first state
-  this->dataPtr->prevStates[0] = WorldState(shared_from_this());
-  this->dataPtr->prevStates[1] = WorldState(shared_from_this());
-  this->dataPtr->stateToggle = 0;
+  this->dataPtr->logState = WorldState(shared_from_this());
+  this->dataPtr->loggedState = this->dataPtr->logState;
+  this->dataPtr->logFullCapture = false;
 
   this->dataPtr->logThread =
     new boost::thread(boost::bind(&World::LogWorker, this));
@@ -501,31 +554,32 @@ void World::LogStep()
 
   if (this->dataPtr->stepInc < 0)
   {
-    // Step back: This is implemented by going to the beginning of the log file,
-    // and then, step forward up to the target frame.
-    // ToDo: Use keyframes in the log file to speed up this process.
-    if (!util::LogPlay::Instance()->Rewind())
+    // Step back: Jump to the target entry, and step once to load it. The
+    // entry loaded last is the one before the current position.
+    int64_t target =
+      static_cast<int64_t>(util::LogPlay::Instance()->GetPosition()) - 1 +
+      this->dataPtr->stepInc;
+
+    if (!this->LogSeek(target))
     {
       gzerr << "Error processing a negative multi-step" << std::endl;
       this->dataPtr->stepInc = 0;
       return;
     }
 
-    this->dataPtr->stepInc = this->dataPtr->iterations + this->dataPtr->stepInc;
-
-    // For some reason, the first two chunks contains the same <iterations>
-    // value. If the log file contains <iterations> we will load the same
-    // iterations value twice and this will affect the way we're stepping back.
-    // ToDo: Fix the source of the problem for avoiding this extra step.
-    if (util::LogPlay::Instance()->HasIterations())
+    this->dataPtr->stepInc = 1;
+  }
+  else if (this->dataPtr->seekPending)
+  {
+    // Jump to the first entry at or after the target time. Stepping once
+    // loads it and completes the seek.
+    if (!this->LogSeek(util::LogPlay::Instance()->FindEntry(
+            this->dataPtr->targetSimTime)))
     {
-      this->dataPtr->stepInc +=
-        2 - util::LogPlay::Instance()->GetInitialIterations();
+      gzerr << "Error processing a seek" << std::endl;
+      this->dataPtr->seekPending = false;
+      return;
     }
-
-    if (this->dataPtr->stepInc < 1)
-      this->dataPtr->stepInc = 1;
-    this->dataPtr->iterations = 0;
   }
 
   {
@@ -547,20 +601,17 @@ void World::LogStep()
     boost::recursive_mutex::scoped_lock lk(*this->dataPtr->worldUpdateMutex);
 
     std::string data;
-    if (!util::LogPlay::Instance()->Step(data))
+    bool binary;
+    if (!util::LogPlay::Instance()->Step(data, binary) ||
+        !this->LogReadState(data, binary))
     {
-      // There are no more chunks, time to exit.
+      // There are no more chunks, or the state is unreadable. Time to exit.
       this->SetPaused(true);
       this->dataPtr->stepInc = 0;
       break;
     }
     else
     {
-      this->dataPtr->logPlayStateSDF->ClearElements();
-      sdf::readString(data, this->dataPtr->logPlayStateSDF);
-
-      this->dataPtr->logPlayState.Load(this->dataPtr->logPlayStateSDF);
-
       // If the log file does not contain iterations we have to manually
       // increase the iteration counter in logPlayState.
       if (!util::LogPlay::Instance()->HasIterations())
@@ -569,40 +620,7 @@ void World::LogStep()
           this->dataPtr->iterations + 1);
       }
 
-      // Process insertions
-      if (this->dataPtr->logPlayStateSDF->HasElement("insertions"))
-      {
-        sdf::ElementPtr modelElem =
-          this->dataPtr->logPlayStateSDF->GetElement(
-              "insertions")->GetElement("model");
-
-        while (modelElem)
-        {
-          ModelPtr model = this->LoadModel(modelElem,
-              this->dataPtr->rootElement);
-          model->Init();
-
-          // Disabling plugins on playback
-          // model->LoadPlugins();
-
-          modelElem = modelElem->GetNextElement("model");
-        }
-      }
-
-      // Process deletions
-      if (this->dataPtr->logPlayStateSDF->HasElement("deletions"))
-      {
-        sdf::ElementPtr nameElem =
-          this->dataPtr->logPlayStateSDF->GetElement(
-              "deletions")->GetElement("name");
-
-        while (nameElem)
-        {
-          transport::requestNoReply(this->GetName(), "entity_delete",
-                                    nameElem->Get<std::string>());
-          nameElem = nameElem->GetNextElement("name");
-        }
-      }
+      this->LogModelChanges();
 
       this->SetState(this->dataPtr->logPlayState);
       this->Update();
@@ -635,10 +653,129 @@ void World::LogStep()
   this->ProcessMessages();
 }
 
+//////////////////////////////////////////////////
+bool World::LogSeek(const int64_t _entry)
+{
+  util::LogPlay *logPlay = util::LogPlay::Instance();
+
+  // The first entry is the world description, which has no state. The
+  // entry count isn't needed, it would index the whole log file.
+  uint64_t entry =
+    static_cast<uint64_t>(std::max(_entry, static_cast<int64_t>(1)));
+  uint64_t position = logPlay->GetPosition();
+  if (entry == position)
+    return true;
+
+  // Every entry holds the state of all the models, so only the entries
+  // that insert or delete models have to be applied on the way to the
+  // target entry.
+  std::vector<uint64_t> changes;
+  if (entry > position)
+    changes = logPlay->GetModelChangeEntries(position, entry);
+  else if (!logPlay->GetModelChangeEntries(entry, position).empty())
+  {
+    // Insertions and deletions can't be undone, replay them from the
+    // beginning of the log file instead.
+    changes = logPlay->GetModelChangeEntries(0, entry);
+  }
+
+  for (auto const &change : changes)
+  {
+    std::string data;
+    bool binary;
+    if (!logPlay->SetPosition(change) || !logPlay->Step(data, binary) ||
+        !this->LogReadState(data, binary))
+    {
+      return false;
+    }
+
+    this->LogModelChanges();
+  }
+
+  // Log files without <iterations> count one iteration per entry.
+  if (!logPlay->HasIterations())
+    this->dataPtr->iterations = entry;
+
+  return logPlay->SetPosition(entry);
+}
+
+//////////////////////////////////////////////////
+bool World::LogReadState(const std::string &_data, const bool _binary)
+{
+  this->dataPtr->logPlayStateSDF->ClearElements();
+
+  if (!_binary)
+  {
+    sdf::readString(_data, this->dataPtr->logPlayStateSDF);
+    this->dataPtr->logPlayState.Load(this->dataPtr->logPlayStateSDF);
+    return true;
+  }
+
+  msgs::WorldState msg;
+  if (!msg.ParseFromString(_data))
+  {
+    gzerr << "Unable to decode a state in the log file\n";
+    return false;
+  }
+
+  this->dataPtr->logPlayState.Load(msg);
+
+  // Inserted models are described in SDF, so the rare entries that insert
+  // or delete models are still parsed for LogModelChanges.
+  if (msg.insertion_size() > 0 || msg.deletion_size() > 0)
+  {
+    std::ostringstream stream;
+    stream << "<sdf version='" << SDF_VERSION << "'>"
+           << this->dataPtr->logPlayState << "</sdf>";
+    sdf::readString(stream.str(), this->dataPtr->logPlayStateSDF);
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+void World::LogModelChanges()
+{
+  // Process insertions
+  if (this->dataPtr->logPlayStateSDF->HasElement("insertions"))
+  {
+    sdf::ElementPtr modelElem =
+      this->dataPtr->logPlayStateSDF->GetElement(
+          "insertions")->GetElement("model");
+
+    while (modelElem)
+    {
+      ModelPtr model = this->LoadModel(modelElem,
+          this->dataPtr->rootElement);
+      model->Init();
+
+      // Disabling plugins on playback
+      // model->LoadPlugins();
+
+      modelElem = modelElem->GetNextElement("model");
+    }
+  }
+
+  // Process deletions
+  if (this->dataPtr->logPlayStateSDF->HasElement("deletions"))
+  {
+    sdf::ElementPtr nameElem =
+      this->dataPtr->logPlayStateSDF->GetElement(
+          "deletions")->GetElement("name");
+
+    while (nameElem)
+    {
+      transport::requestNoReply(this->GetName(), "entity_delete",
+                                nameElem->Get<std::string>());
+      nameElem = nameElem->GetNextElement("name");
+    }
+  }
+}
+
 //////////////////////////////////////////////////
 void World::Step()
 {
-  DIAG_TIMER_START("World::Step");
+  GZ_TRACE_SPAN(span, "World::Step");
 
   /// need this because ODE does not call dxReallocateWorldProcessContext()
   /// until dWorld.*Step
@@ -651,12 +788,12 @@ void World::Step()
     this->dataPtr->pluginsLoaded = true;
   }
 
-  DIAG_TIMER_LAP("World::Step", "loadPlugins");
+  GZ_TRACE_LAP(span, "loadPlugins");
 
   // Send statistics about the world simulation
   this->PublishWorldStats();
 
-  DIAG_TIMER_LAP("World::Step", "publishWorldStats");
+  GZ_TRACE_LAP(span, "publishWorldStats");
 
   double updatePeriod = this->dataPtr->physicsEngine->GetUpdatePeriod();
   // sleep here to get the correct update rate
@@ -677,7 +814,7 @@ void World::Step()
   this->dataPtr->sleepOffset = (actualSleep - sleepTime) * 0.01 +
                       this->dataPtr->sleepOffset * 0.99;
 
-  DIAG_TIMER_LAP("World::Step", "sleepOffset");
+  GZ_TRACE_LAP(span, "sleepOffset");
 
   // throttling update rate, with sleepOffset as tolerance
   // the tolerance is needed as the sleep time is not exact
@@ -686,7 +823,7 @@ void World::Step()
   {
     boost::recursive_mutex::scoped_lock lock(*this->dataPtr->worldUpdateMutex);
 
-    DIAG_TIMER_LAP("World::Step", "worldUpdateMutex");
+    GZ_TRACE_LAP(span, "worldUpdateMutex");
 
     this->dataPtr->prevStepWallTime = common::Time::GetWallTime();
 
@@ -700,7 +837,7 @@ void World::Step()
       this->dataPtr->iterations++;
       this->Update();
 
-      DIAG_TIMER_LAP("World::Step", "update");
+      GZ_TRACE_LAP(span, "update");
 
       if (this->IsPaused() && this->dataPtr->stepInc > 0)
         this->dataPtr->stepInc--;
@@ -716,7 +853,7 @@ void World::Step()
 
   this->ProcessMessages();
 
-  DIAG_TIMER_STOP("World::Step");
+  GZ_TRACE_LAP(span, "processMessages");
 
   if (g_clearModels)
     this->ClearModels();
@@ -750,7 +887,7 @@ void World::Step(unsigned int _steps)
 //////////////////////////////////////////////////
 void World::Update()
 {
-  DIAG_TIMER_START("World::Update");
+  GZ_TRACE_SPAN(span, "World::Update");
 
   if (this->dataPtr->needsReset)
   {
@@ -762,23 +899,28 @@ void World::Update()
       this->ResetEntities(Base::MODEL);
     this->dataPtr->needsReset = false;
   }
-  DIAG_TIMER_LAP("World::Update", "needsReset");
+  GZ_TRACE_LAP(span, "needsReset");
 
   this->dataPtr->updateInfo.simTime = this->GetSimTime();
   this->dataPtr->updateInfo.realTime = this->GetRealTime();
   event::Events::worldUpdateBegin(this->dataPtr->updateInfo);
 
-  DIAG_TIMER_LAP("World::Update", "Events::worldUpdateBegin");
+  GZ_TRACE_LAP(span, "Events::worldUpdateBegin");
 
   // Update all the models
+  if (this->dataPtr->physicsEngine->ModelUpdateThreads() !=
+      this->dataPtr->modelUpdateThreads)
+  {
+    this->UpdateModelUpdateFunc();
+  }
   (*this.*dataPtr->modelUpdateFunc)();
 
-  DIAG_TIMER_LAP("World::Update", "Model::Update");
+  GZ_TRACE_LAP(span, "Model::Update");
 
   // This must be called before PhysicsEngine::UpdatePhysics.
   this->dataPtr->physicsEngine->UpdateCollision();
 
-  DIAG_TIMER_LAP("World::Update", "PhysicsEngine::UpdateCollision");
+  GZ_TRACE_LAP(span, "PhysicsEngine::UpdateCollision");
 
   // Wait for logging to finish, if it's running.
   if (util::LogRecord::Instance()->GetRunning())
@@ -801,7 +943,7 @@ void World::Update()
     // This must be called directly after PhysicsEngine::UpdateCollision.
     this->dataPtr->physicsEngine->UpdatePhysics();
 
-    DIAG_TIMER_LAP("World::Update", "PhysicsEngine::UpdatePhysics");
+    GZ_TRACE_LAP(span, "PhysicsEngine::UpdatePhysics");
 
     // do this after physics update as
     //   ode --> MoveCallback sets the dirtyPoses
@@ -819,22 +961,22 @@ void World::Update()
       this->dataPtr->dirtyPoses.clear();
     }
 
-    DIAG_TIMER_LAP("World::Update", "SetWorldPose(dirtyPoses)");
+    GZ_TRACE_LAP(span, "SetWorldPose(dirtyPoses)");
   }
 
   // Only update state information if logging data.
   if (util::LogRecord::Instance()->GetRunning())
     this->dataPtr->logCondition.notify_one();
-  DIAG_TIMER_LAP("World::Update", "LogRecordNotify");
+  GZ_TRACE_LAP(span, "LogRecordNotify");
 
   // Output the contact information
   this->dataPtr->physicsEngine->GetContactManager()->PublishContacts();
 
-  DIAG_TIMER_LAP("World::Update", "ContactManager::PublishContacts");
+  GZ_TRACE_LAP(span, "ContactManager::PublishContacts");
 
   event::Events::worldUpdateEnd();
 
-  DIAG_TIMER_STOP("World::Update");
+  GZ_TRACE_LAP(span, "Events::worldUpdateEnd");
 }
 
 //////////////////////////////////////////////////
@@ -844,6 +986,15 @@ void World::Fini()
   this->dataPtr->plugins.clear();
 
   this->dataPtr->publishModelPoses.clear();
+  this->dataPtr->posePublishEntities.clear();
+
+  if (this->dataPtr->traceThread)
+  {
+    this->dataPtr->traceThread->join();
+    delete this->dataPtr->traceThread;
+    this->dataPtr->traceThread = NULL;
+  }
+  this->dataPtr->tracePub.reset();
 
   this->dataPtr->node->Fini();
 
@@ -860,8 +1011,16 @@ void World::Fini()
   }
 
   this->dataPtr->models.clear();
-  this->dataPtr->prevStates[0].SetWorld(WorldPtr());
-  this->dataPtr->prevStates[1].SetWorld(WorldPtr());
+  this->dataPtr->parallelModelUpdates.clear();
+  this->dataPtr->serialModelUpdates.clear();
+
+  delete this->dataPtr->modelUpdateArena;
+  this->dataPtr->modelUpdateArena = NULL;
+  this->dataPtr->modelUpdateThreads = 0;
+
+  this->dataPtr->logState.SetWorld(WorldPtr());
+  this->dataPtr->loggedState.SetWorld(WorldPtr());
+  this->dataPtr->logDirtyModels.clear();
 
 #ifdef HAVE_OPENAL
   util::OpenAL::Instance()->Fini();
@@ -881,7 +1040,11 @@ void World::ClearModels()
   bool pauseState = this->IsPaused();
   this->SetPaused(true);
 
-  this->dataPtr->publishModelPoses.clear();
+  {
+    boost::recursive_mutex::scoped_lock lock(*this->dataPtr->receiveMutex);
+    this->dataPtr->publishModelPoses.clear();
+    this->dataPtr->posePublishEntities.clear();
+  }
 
   // Remove all models
   for (auto &model : this->dataPtr->models)
@@ -920,10 +1083,92 @@ common::SphericalCoordinatesPtr World::GetSphericalCoordinates() const
 //////////////////////////////////////////////////
 BasePtr World::GetByName(const std::string &_name)
 {
-  if (this->dataPtr->rootElement)
-    return this->dataPtr->rootElement->GetByName(_name);
-  else
+  if (!this->dataPtr->rootElement)
+    return BasePtr();
+
+  {
+    boost::mutex::scoped_lock lock(this->dataPtr->entityIndexMutex);
+    auto iter = this->dataPtr->entityNameIndex.find(_name);
+    if (iter != this->dataPtr->entityNameIndex.end())
+    {
+      BasePtr entity = iter->second.lock();
+      if (entity && entity->GetWorld().get() == this &&
+          entity->GetScopedName() == _name)
+      {
+        return entity;
+      }
+
+      // The entity was renamed or removed.
+      this->dataPtr->entityNameIndex.erase(iter);
+    }
+  }
+
+  // Unscoped names, and entities that were renamed after they were
+  // loaded, are found by walking the entity tree.
+  BasePtr result = this->dataPtr->rootElement->GetByName(_name);
+  if (result && result->GetScopedName() == _name)
+    this->IndexEntity(result);
+
+  return result;
+}
+
+//////////////////////////////////////////////////
+void World::IndexEntity(BasePtr _entity)
+{
+  boost::mutex::scoped_lock lock(this->dataPtr->entityIndexMutex);
+
+  // Keep the first entity with a given scoped name, which is the one
+  // Base::GetByName finds first.
+  boost::weak_ptr<Base> &named =
+    this->dataPtr->entityNameIndex[_entity->GetScopedName()];
+  BasePtr current = named.lock();
+  if (!current || current->GetWorld().get() != this ||
+      current->GetScopedName() != _entity->GetScopedName())
+  {
+    named = _entity;
+  }
+
+  this->dataPtr->entityIdIndex[_entity->GetId()] = _entity;
+}
+
+//////////////////////////////////////////////////
+void World::UnindexEntity(const Base *_entity)
+{
+  boost::mutex::scoped_lock lock(this->dataPtr->entityIndexMutex);
+
+  auto nameIter = this->dataPtr->entityNameIndex.find(
+      _entity->GetScopedName());
+  if (nameIter != this->dataPtr->entityNameIndex.end() &&
+      nameIter->second.lock().get() == _entity)
+  {
+    this->dataPtr->entityNameIndex.erase(nameIter);
+  }
+
+  auto idIter = this->dataPtr->entityIdIndex.find(_entity->GetId());
+  if (idIter != this->dataPtr->entityIdIndex.end() &&
+      idIter->second.lock().get() == _entity)
+  {
+    this->dataPtr->entityIdIndex.erase(idIter);
+  }
+}
+
+//////////////////////////////////////////////////
+BasePtr World::GetIndexedEntity(const uint32_t _id)
+{
+  boost::mutex::scoped_lock lock(this->dataPtr->entityIndexMutex);
+
+  auto iter = this->dataPtr->entityIdIndex.find(_id);
+  if (iter == this->dataPtr->entityIdIndex.end())
     return BasePtr();
+
+  BasePtr entity = iter->second.lock();
+  if (!entity || entity->GetWorld().get() != this)
+  {
+    this->dataPtr->entityIdIndex.erase(iter);
+    return BasePtr();
+  }
+
+  return entity;
 }
 
 /////////////////////////////////////////////////
@@ -1017,6 +1262,12 @@ void World::LoadEntities(sdf::ElementPtr _sdf, BasePtr _parent)
 
   if (_sdf->HasElement("model"))
   {
+    // Models are loaded one at a time, so parse their collision meshes
+    // in parallel first.
+    std::vector<std::string> meshFiles;
+    CollisionMeshFiles(_sdf, meshFiles);
+    common::MeshManager::Instance()->Preload(meshFiles);
+
     sdf::ElementPtr childElem = _sdf->GetElement("model");
 
     while (childElem)
@@ -1292,8 +1543,6 @@ void World::OnPlaybackControl(ConstLogPlaybackControlPtr &_data)
   if (_data->has_seek())
   {
     this->dataPtr->targetSimTime = msgs::Convert(_data->seek());
-    if (this->GetSimTime() > this->dataPtr->targetSimTime)
-      util::LogPlay::Instance()->Rewind();
     this->dataPtr->seekPending = true;
   }
 
@@ -1308,8 +1557,6 @@ void World::OnPlaybackControl(ConstLogPlaybackControlPtr &_data)
   if (_data->has_forward() && _data->forward())
   {
     this->dataPtr->targetSimTime = util::LogPlay::Instance()->GetLogEndTime();
-    if (this->GetSimTime() > this->dataPtr->targetSimTime)
-      util::LogPlay::Instance()->Rewind();
     this->dataPtr->seekPending = true;
   }
 }
@@ -1369,12 +1616,64 @@ void World::BuildSceneMsg(msgs::Scene &_scene, BasePtr _entity)
 
 
 //////////////////////////////////////////////////
-// void World::ModelUpdateTBB()
-// {
-//   tbb::parallel_for (tbb::blocked_range<size_t>(0,
-//   this->dataPtr->models.size(), 10),
-//       ModelUpdate_TBB(&this->dataPtr->models));
-// }
+void World::UpdateModelUpdateFunc()
+{
+  unsigned int threads = this->dataPtr->physicsEngine->ModelUpdateThreads();
+
+  delete this->dataPtr->modelUpdateArena;
+  this->dataPtr->modelUpdateArena = NULL;
+  this->dataPtr->modelUpdateThreads = threads;
+
+  if (threads < 2)
+  {
+    this->dataPtr->modelUpdateFunc = &World::ModelUpdateSingleLoop;
+  }
+  else
+  {
+    this->dataPtr->modelUpdateArena =
+      new tbb::task_arena(static_cast<int>(threads));
+    this->dataPtr->modelUpdateFunc = &World::ModelUpdateTBB;
+  }
+}
+
+//////////////////////////////////////////////////
+void World::ModelUpdateTBB()
+{
+  this->dataPtr->parallelModelUpdates.clear();
+  this->dataPtr->serialModelUpdates.clear();
+
+  // Each top level model only modifies its own links and joints during
+  // Model::Update, so the result does not depend on the order in which
+  // the pool schedules them. Everything that touches shared world state is
+  // kept out of the pool and updated in tree order.
+  for (unsigned int i = 0; i < this->dataPtr->rootElement->GetChildCount(); i++)
+  {
+    BasePtr child = this->dataPtr->rootElement->GetChild(i);
+    if (child->HasType(Base::MODEL) && !child->HasType(Base::ACTOR))
+    {
+      ModelPtr model = boost::static_pointer_cast<Model>(child);
+      if (model->IsStatic())
+        continue;
+
+      if (!model->HasJointAnimation())
+      {
+        this->dataPtr->parallelModelUpdates.push_back(model);
+        continue;
+      }
+    }
+    this->dataPtr->serialModelUpdates.push_back(child);
+  }
+
+  Model_V *models = &this->dataPtr->parallelModelUpdates;
+  this->dataPtr->modelUpdateArena->execute([models]()
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, models->size(), 1),
+        ModelUpdate_TBB(models));
+  });
+
+  for (auto const &entity : this->dataPtr->serialModelUpdates)
+    entity->Update();
+}
 
 //////////////////////////////////////////////////
 void World::ModelUpdateSingleLoop()
@@ -1600,6 +1899,35 @@ void World::ProcessRequestMsgs()
       sphereCoordMsg.SerializeToString(serializedData);
       response.set_type(sphereCoordMsg.GetTypeName());
     }
+    else if (requestMsg.request() == "trace_start")
+    {
+      common::Trace::Clear();
+      common::Trace::SetEnabled(true);
+    }
+    else if (requestMsg.request() == "trace_stop")
+    {
+      common::Trace::SetEnabled(false);
+
+      // The spans of the whole process are exported in the Chrome trace
+      // format on another thread, and published on ~/trace. The response
+      // only acknowledges the request.
+      if (this->dataPtr->traceThread)
+      {
+        this->dataPtr->traceThread->join();
+        delete this->dataPtr->traceThread;
+      }
+
+      transport::PublisherPtr tracePub = this->dataPtr->tracePub;
+      this->dataPtr->traceThread = new boost::thread([tracePub]()
+          {
+            std::ostringstream stream;
+            common::Trace::WriteChromeTrace(stream);
+
+            msgs::GzString msg;
+            msg.set_data(stream.str());
+            tracePub->Publish(msg);
+          });
+    }
     else
       send = false;
 
@@ -1963,11 +2291,7 @@ bool World::OnLog(std::ostringstream &_stream)
       this->dataPtr->currentStateBuffer ^= 1;
     }
     for (auto const &worldState : this->dataPtr->states[bufferIndex])
-    {
-      _stream << "<sdf version='" << SDF_VERSION << "'>"
-              << worldState
-              << "</sdf>";
-    }
+      WriteLogState(worldState, _stream);
 
     this->dataPtr->states[bufferIndex].clear();
   }
@@ -1983,26 +2307,26 @@ bool World::OnLog(std::ostringstream &_stream)
         i < this->dataPtr->states[this->dataPtr->currentStateBuffer^1].size();
         ++i)
     {
-      _stream << "<sdf version='" << SDF_VERSION << "'>"
-        << this->dataPtr->states[this->dataPtr->currentStateBuffer^1][i]
-        << "</sdf>";
+      WriteLogState(
+          this->dataPtr->states[this->dataPtr->currentStateBuffer^1][i],
+          _stream);
     }
 
     for (size_t i = 0;
         i < this->dataPtr->states[this->dataPtr->currentStateBuffer].size();
         ++i)
     {
-      _stream << "<sdf version='" << SDF_VERSION << "'>"
-        << this->dataPtr->states[this->dataPtr->currentStateBuffer][i]
-        << "</sdf>";
+      WriteLogState(
+          this->dataPtr->states[this->dataPtr->currentStateBuffer][i],
+          _stream);
     }
 
     // Clear everything.
     this->dataPtr->states[0].clear();
     this->dataPtr->states[1].clear();
-    this->dataPtr->stateToggle = 0;
-    this->dataPtr->prevStates[0] = WorldState();
-    this->dataPtr->prevStates[1] = WorldState();
+    this->dataPtr->logState = WorldState();
+    this->dataPtr->loggedState = WorldState();
+    this->dataPtr->logFullCapture = true;
   }
 
   return true;
@@ -2014,75 +2338,191 @@ void World::ProcessMessages()
   {
     boost::recursive_mutex::scoped_lock lock(*this->dataPtr->receiveMutex);
 
-    if ((this->dataPtr->posePub && this->dataPtr->posePub->HasConnections()) ||
-        (this->dataPtr->poseLocalPub &&
-         this->dataPtr->poseLocalPub->HasConnections()))
+    this->PublishPoses();
+    this->dataPtr->publishModelPoses.clear();
+  }
+
+  if (common::Time::GetWallTime() - this->dataPtr->prevProcessMsgsTime >
+      this->dataPtr->processMsgsPeriod)
+  {
+    this->ProcessEntityMsgs();
+    this->ProcessRequestMsgs();
+    this->ProcessFactoryMsgs();
+    this->ProcessModelMsgs();
+    this->dataPtr->prevProcessMsgsTime = common::Time::GetWallTime();
+  }
+}
+
+//////////////////////////////////////////////////
+void World::PublishPoses()
+{
+  bool posePubConnected =
+    this->dataPtr->posePub && this->dataPtr->posePub->HasConnections();
+  bool poseLocalPubConnected =
+    this->dataPtr->poseLocalPub &&
+    this->dataPtr->poseLocalPub->HasConnections();
+
+  if (!posePubConnected && !poseLocalPubConnected)
+    return;
+
+  // Clear keeps the allocated poses around for reuse.
+  msgs::PosesStamped &msg = this->dataPtr->posesMsg;
+  msg.Clear();
+
+  // Time stamp this PosesStamped message
+  msgs::Set(msg.mutable_time(), this->GetSimTime());
+
+  const bool compact = this->dataPtr->compactPoseMsgs;
+
+  // In compact mode names are sent only once, so send every entity with its
+  // name again when a subscription is added, including entities that are
+  // not published in this iteration.
+  if (compact)
+  {
+    unsigned int generation =
+      (this->dataPtr->posePub ?
+       this->dataPtr->posePub->GetSubscriptionGeneration() : 0) +
+      (this->dataPtr->poseLocalPub ?
+       this->dataPtr->poseLocalPub->GetSubscriptionGeneration() : 0);
+
+    if (generation != this->dataPtr->poseSubscriptionGeneration)
     {
-      msgs::PosesStamped msg;
+      this->dataPtr->poseSubscriptionGeneration = generation;
+      for (auto &entities : this->dataPtr->posePublishEntities)
+      {
+        for (auto &entity : entities.second)
+          entity.nameSent = false;
+      }
+    }
+  }
 
-      // Time stamp this PosesStamped message
-      msgs::Set(msg.mutable_time(), this->GetSimTime());
+  if (!this->dataPtr->publishModelPoses.empty())
+  {
+    for (auto const &model : this->dataPtr->publishModelPoses)
+    {
+      std::vector<PosePublishEntity> &entities =
+        this->dataPtr->posePublishEntities[model];
 
-      if (!this->dataPtr->publishModelPoses.empty())
+      // Rebuild the list if links or nested models were added or removed.
+      bool valid = !entities.empty();
+      for (auto const &entity : entities)
       {
-        for (auto const &model : this->dataPtr->publishModelPoses)
+        if (entity.isModel &&
+            entity.entity->ChildGeneration() != entity.childGeneration)
         {
-          std::list<ModelPtr> modelList;
-          modelList.push_back(model);
-          while (!modelList.empty())
-          {
-            ModelPtr m = modelList.front();
-            modelList.pop_front();
-            msgs::Pose *poseMsg = msg.add_pose();
-
-            // Publish the model's relative pose
-            poseMsg->set_name(m->GetScopedName());
-            poseMsg->set_id(m->GetId());
-            msgs::Set(poseMsg, m->GetRelativePose().Ign());
-
-            // Publish each of the model's child links relative poses
-            Link_V links = m->GetLinks();
-            for (auto const &link : links)
-            {
-              poseMsg = msg.add_pose();
-              poseMsg->set_name(link->GetScopedName());
-              poseMsg->set_id(link->GetId());
-              msgs::Set(poseMsg, link->GetRelativePose().Ign());
-            }
-
-            // add all nested models to the queue
-            Model_V models = m->NestedModels();
-            for (auto const &n : models)
-              modelList.push_back(n);
-          }
+          valid = false;
+          break;
         }
-
-        if (this->dataPtr->posePub && this->dataPtr->posePub->HasConnections())
-          this->dataPtr->posePub->Publish(msg);
       }
+      if (!valid)
+        this->BuildPosePublishEntities(model, entities);
 
-      if (this->dataPtr->poseLocalPub &&
-          this->dataPtr->poseLocalPub->HasConnections())
+      for (auto &entity : entities)
       {
-        // rendering::Scene depends on this timestamp, which is used by
-        // rendering sensors to time stamp their data
-        this->dataPtr->poseLocalPub->Publish(msg);
+        // Publish the model's and each of its links relative poses
+        ignition::math::Pose3d pose = entity.entity->GetRelativePose().Ign();
+        if (compact && entity.nameSent && pose == entity.lastPose)
+          continue;
+
+        msgs::Pose *poseMsg = msg.add_pose();
+        if (!compact || !entity.nameSent)
+          poseMsg->set_name(entity.name);
+        poseMsg->set_id(entity.id);
+        msgs::Set(poseMsg, pose);
+
+        entity.nameSent = true;
+        entity.lastPose = pose;
       }
     }
-    this->dataPtr->publishModelPoses.clear();
   }
 
-  if (common::Time::GetWallTime() - this->dataPtr->prevProcessMsgsTime >
-      this->dataPtr->processMsgsPeriod)
+  // Both topics publish the same message. Copy it once, and serialize it
+  // once if a subscriber needs it serialized, instead of once per topic.
+  bool publishPoses =
+    posePubConnected && !this->dataPtr->publishModelPoses.empty();
+
+  transport::MessagePtr sharedMsg(new msgs::PosesStamped(msg));
+  transport::SerializedMsgPtr sharedData;
+  if ((publishPoses && this->dataPtr->posePub->HasSerializedConnections()) ||
+      (poseLocalPubConnected &&
+       this->dataPtr->poseLocalPub->HasSerializedConnections()))
   {
-    this->ProcessEntityMsgs();
-    this->ProcessRequestMsgs();
-    this->ProcessFactoryMsgs();
-    this->ProcessModelMsgs();
-    this->dataPtr->prevProcessMsgsTime = common::Time::GetWallTime();
+    boost::shared_ptr<std::string> data(new std::string);
+    sharedMsg->SerializeToString(data.get());
+    sharedData = data;
+  }
+
+  if (publishPoses)
+    this->dataPtr->posePub->Publish(sharedMsg, sharedData);
+
+  if (poseLocalPubConnected)
+  {
+    // rendering::Scene depends on this timestamp, which is used by
+    // rendering sensors to time stamp their data
+    this->dataPtr->poseLocalPub->Publish(sharedMsg, sharedData);
   }
 }
 
+//////////////////////////////////////////////////
+void World::BuildPosePublishEntities(ModelPtr _model,
+    std::vector<PosePublishEntity> &_entities) const
+{
+  _entities.clear();
+
+  std::list<ModelPtr> modelList;
+  modelList.push_back(_model);
+  while (!modelList.empty())
+  {
+    ModelPtr m = modelList.front();
+    modelList.pop_front();
+
+    PosePublishEntity modelEntity;
+    modelEntity.entity = m;
+    modelEntity.name = m->GetScopedName();
+    modelEntity.id = m->GetId();
+    modelEntity.childGeneration = m->ChildGeneration();
+    modelEntity.isModel = true;
+    modelEntity.nameSent = false;
+    _entities.push_back(modelEntity);
+
+    for (auto const &link : m->GetLinks())
+    {
+      PosePublishEntity linkEntity;
+      linkEntity.entity = link;
+      linkEntity.name = link->GetScopedName();
+      linkEntity.id = link->GetId();
+      linkEntity.childGeneration = 0;
+      linkEntity.isModel = false;
+      linkEntity.nameSent = false;
+      _entities.push_back(linkEntity);
+    }
+
+    // add all nested models to the queue
+    for (auto const &n : m->NestedModels())
+      modelList.push_back(n);
+  }
+}
+
+//////////////////////////////////////////////////
+void World::SetCompactPoseMsgs(const bool _compact)
+{
+  boost::recursive_mutex::scoped_lock lock(*this->dataPtr->receiveMutex);
+  this->dataPtr->compactPoseMsgs = _compact;
+
+  // Send names again when switching modes.
+  for (auto &entities : this->dataPtr->posePublishEntities)
+  {
+    for (auto &entity : entities.second)
+      entity.nameSent = false;
+  }
+}
+
+//////////////////////////////////////////////////
+bool World::CompactPoseMsgs() const
+{
+  return this->dataPtr->compactPoseMsgs;
+}
+
 //////////////////////////////////////////////////
 void World::PublishWorldStats()
 {
@@ -2128,6 +2568,21 @@ void World::PublishModelPose(physics::ModelPtr _model)
 
   // Only add if the model name is not in the list
   this->dataPtr->publishModelPoses.insert(_model);
+
+  // Log state capture only reloads the models that moved. The set is
+  // emptied by LogWorker, which only runs while recording.
+  if (util::LogRecord::Instance()->GetRunning())
+  {
+    // WorldState holds the top level models, nested models are loaded
+    // with them.
+    ModelPtr model = _model;
+    while (model->GetParent() && model->GetParent()->HasType(Base::MODEL))
+      model = boost::static_pointer_cast<Model>(model->GetParent());
+
+    this->dataPtr->logDirtyModels.insert(model);
+  }
+  else
+    this->dataPtr->logDirtyAll = true;
 }
 
 //////////////////////////////////////////////////
@@ -2140,24 +2595,68 @@ void World::LogWorker()
 
   GZ_ASSERT(self, "Self pointer to World is invalid");
 
+  Model_V dirtyModels;
   while (!this->dataPtr->stop)
   {
-    int currState = (this->dataPtr->stateToggle + 1) % 2;
+    // Get the models that moved since the last capture.
+    dirtyModels.clear();
+    bool dirtyAll;
+    {
+      boost::recursive_mutex::scoped_lock lk(*this->dataPtr->receiveMutex);
+      dirtyModels.assign(this->dataPtr->logDirtyModels.begin(),
+          this->dataPtr->logDirtyModels.end());
+      this->dataPtr->logDirtyModels.clear();
+      dirtyAll = this->dataPtr->logDirtyAll;
+      this->dataPtr->logDirtyAll = false;
+    }
+
+    // Actors move their links without publishing their poses.
+    for (auto const &model : this->dataPtr->models)
+    {
+      if (model->HasType(ACTOR))
+        dirtyModels.push_back(model);
+    }
 
-    this->dataPtr->prevStates[currState].Load(self);
-    WorldState diffState = this->dataPtr->prevStates[currState] -
-      this->dataPtr->prevStates[this->dataPtr->stateToggle];
+    bool changed = false;
+    if (this->dataPtr->logFullCapture || dirtyAll ||
+        this->dataPtr->logState.GetModelStateCount() !=
+        this->dataPtr->models.size() ||
+        !this->dataPtr->logState.Load(self, dirtyModels))
+    {
+      // Models were inserted or deleted, or moved before the recording
+      // started, reload all of them.
+      this->dataPtr->logState.Load(self);
+      this->dataPtr->logFullCapture = false;
+      changed = !(this->dataPtr->logState -
+          this->dataPtr->loggedState).IsZero();
+    }
+    else
+    {
+      // Only the models that moved can differ from the logged state.
+      const ModelState_M &current = this->dataPtr->logState.GetModelStates();
+      const ModelState_M &logged =
+        this->dataPtr->loggedState.GetModelStates();
+      for (auto const &model : dirtyModels)
+      {
+        auto loggedIter = logged.find(model->GetName());
+        changed = loggedIter == logged.end() ||
+          !(current.find(model->GetName())->second -
+            loggedIter->second).IsZero();
+        if (changed)
+          break;
+      }
+    }
     this->dataPtr->logPrevIteration = this->dataPtr->iterations;
 
-    if (!diffState.IsZero())
+    if (changed)
     {
-      this->dataPtr->stateToggle = currState;
+      this->dataPtr->loggedState = this->dataPtr->logState;
       {
         // Store the entire current state (instead of the diffState). A slow
         // moving link may never be captured if only diff state is recorded.
         boost::mutex::scoped_lock bLock(this->dataPtr->logBufferMutex);
         this->dataPtr->states[this->dataPtr->currentStateBuffer].push_back(
-            this->dataPtr->prevStates[currState]);
+            this->dataPtr->logState);
         // Tell the logger to update, once the number of states exceeds 1000
         if (this->dataPtr->states[this->dataPtr->currentStateBuffer].size() >
             1000)
@@ -2190,17 +2689,14 @@ void World::RemoveModel(const std::string &_name)
 
   // Remove all the dirty poses from the delete entity.
   {
-    for (auto entity = this->dataPtr->dirtyPoses.begin();
-             entity != this->dataPtr->dirtyPoses.end(); ++entity)
-    {
-      if ((*entity)->GetName() == _name ||
-         ((*entity)->GetParent() && (*entity)->GetParent()->GetName() == _name))
-      {
-        this->dataPtr->dirtyPoses.erase(entity++);
-      }
-      else
-        ++entity;
-    }
+    this->dataPtr->dirtyPoses.erase(std::remove_if(
+          this->dataPtr->dirtyPoses.begin(), this->dataPtr->dirtyPoses.end(),
+          [&_name](Entity *_entity)
+          {
+            return _entity->GetName() == _name ||
+              (_entity->GetParent() &&
+               _entity->GetParent()->GetName() == _name);
+          }), this->dataPtr->dirtyPoses.end());
   }
 
   if (this->dataPtr->sdf->HasElement("model"))
@@ -2245,6 +2741,8 @@ void World::RemoveModel(const std::string &_name)
     {
       if ((*model)->GetName() == _name || (*model)->GetScopedName() == _name)
       {
+        this->dataPtr->physicsEngine->GetContactManager()->
+            RemoveModelCollisions((*model)->GetScopedName());
         this->dataPtr->models.erase(model);
         break;
       }
@@ -2263,6 +2761,27 @@ void World::RemoveModel(const std::string &_name)
         break;
       }
     }
+
+    for (auto model = this->dataPtr->posePublishEntities.begin();
+             model != this->dataPtr->posePublishEntities.end(); ++model)
+    {
+      if (model->first->GetName() == _name ||
+          model->first->GetScopedName() == _name)
+      {
+        this->dataPtr->posePublishEntities.erase(model);
+        break;
+      }
+    }
+
+    for (auto model = this->dataPtr->logDirtyModels.begin();
+             model != this->dataPtr->logDirtyModels.end(); ++model)
+    {
+      if ((*model)->GetName() == _name || (*model)->GetScopedName() == _name)
+      {
+        this->dataPtr->logDirtyModels.erase(model);
+        break;
+      }
+    }
   }
 }
 
@@ -53,6 +53,7 @@ namespace gazebo
   {
     /// Forward declare private data class.
     class WorldPrivate;
+    class PosePublishEntity;
 
     /// \addtogroup gazebo_physics
     /// \{
@@ -192,7 +193,9 @@ namespace gazebo
 
       /// \brief Get an element by name.
       /// Searches the list of entities, and return a pointer to the model
-      /// with a matching _name.
+      /// with a matching _name. Scoped names are looked up in constant time
+      /// through an index, and take precedence over an entity whose
+      /// unscoped name matches _name.
       /// \param[in] _name The name of the Model to find.
       /// \return A pointer to the entity, or NULL if no entity was found.
       public: BasePtr GetByName(const std::string &_name);
@@ -306,6 +309,21 @@ namespace gazebo
       /// \param[in] _model Pointer to the model to publish.
       public: void PublishModelPose(physics::ModelPtr _model);
 
+      /// \brief Set whether pose messages are compact. In compact mode
+      /// an entity's scoped name is only sent the first time its pose is
+      /// published, later messages only carry the entity id. Entities whose
+      /// pose did not change since they were last published are skipped.
+      /// Every name is sent again when a subscription to a pose topic is
+      /// added. Subscribers must map ids to names using ~/model/info, as
+      /// rendering::Scene does. Compact mode is disabled by default.
+      /// \param[in] _compact True to enable compact pose messages.
+      public: void SetCompactPoseMsgs(const bool _compact);
+
+      /// \brief Get whether pose messages are compact.
+      /// \return True if compact pose messages are enabled.
+      /// \sa SetCompactPoseMsgs
+      public: bool CompactPoseMsgs() const;
+
       /// \brief Get the total number of iterations.
       /// \return Number of iterations that simulation has taken.
       public: uint32_t GetIterations() const;
@@ -387,6 +405,26 @@ namespace gazebo
       /// \brief Step the world once by reading from a log file.
       private: void LogStep();
 
+      /// \brief Move the log file to a state entry, applying the model
+      /// insertions and deletions recorded on the way. The next call to
+      /// LogStep() loads the entry.
+      /// \param[in] _entry Index of the entry in the log file.
+      /// \return True if the log file was moved to the entry.
+      private: bool LogSeek(const int64_t _entry);
+
+      /// \brief Load a state entry of the log file into logPlayState, and
+      /// into logPlayStateSDF when LogModelChanges() needs it.
+      /// \param[in] _data Entry data from util::LogPlay::Step.
+      /// \param[in] _binary True if _data is a serialized msgs::WorldState,
+      /// false if it is SDF.
+      /// \return False if the entry could not be decoded.
+      private: bool LogReadState(const std::string &_data,
+                   const bool _binary);
+
+      /// \brief Apply the model insertions and deletions from the log
+      /// state in logPlayStateSDF.
+      private: void LogModelChanges();
+
       /// \brief Update the world.
       private: void Update();
 
@@ -427,9 +465,16 @@ namespace gazebo
       /// \param[in] _msg The model message.
       private: void OnModelMsg(ConstModelPtr &_msg);
 
-      /// \brief TBB version of model updating.
+      /// \brief TBB version of model updating. Top level models are
+      /// updated concurrently on a work-stealing thread pool. Actors and
+      /// models playing joint animations modify state shared across models,
+      /// and are updated sequentially afterwards.
       private: void ModelUpdateTBB();
 
+      /// \brief Select the model update function based on the
+      /// "model_update_threads" physics engine parameter.
+      private: void UpdateModelUpdateFunc();
+
       /// \brief Single loop version of model updating.
       private: void ModelUpdateSingleLoop();
 
@@ -464,6 +509,17 @@ namespace gazebo
       /// \brief Process all incoming messages.
       private: void ProcessMessages();
 
+      /// \brief Publish the poses of the models in publishModelPoses.
+      /// Must only be called from the World::ProcessMessages function.
+      private: void PublishPoses();
+
+      /// \brief Build the flattened list of entities whose pose is
+      /// published for a model.
+      /// \param[in] _model The model.
+      /// \param[out] _entities The model, its nested models and links.
+      private: void BuildPosePublishEntities(ModelPtr _model,
+                   std::vector<PosePublishEntity> &_entities) const;
+
       /// \brief Publish the world stats message.
       private: void PublishWorldStats();
 
@@ -474,6 +530,20 @@ namespace gazebo
       /// \param[in] _msg Pointer to the light message.
       private: void OnLightMsg(ConstLightPtr &_msg);
 
+      /// \brief Add an entity to the scoped name and id index. An entity
+      /// already indexed under the same scoped name is kept.
+      /// \param[in] _entity The entity to add.
+      private: void IndexEntity(BasePtr _entity);
+
+      /// \brief Remove an entity from the scoped name and id index.
+      /// \param[in] _entity The entity to remove.
+      private: void UnindexEntity(const Base *_entity);
+
+      /// \brief Get an entity from the id index.
+      /// \param[in] _id Id of the entity.
+      /// \return The entity, or NULL if it is not in the index.
+      private: BasePtr GetIndexedEntity(const uint32_t _id);
+
       /// \internal
       /// \brief Private data pointer.
       private: WorldPrivate *dataPtr;
@@ -483,6 +553,9 @@ namespace gazebo
 
       /// Friend SimbodyPhysics so that it has access to dataPtr->dirtyPoses
       private: friend class SimbodyPhysics;
+
+      /// Friend Base so that it can maintain the entity index
+      private: friend class Base;
     };
     /// \}
   }
@@ -18,11 +18,16 @@
 #define _GAZEBO_WORLD_PRIVATE_HH_
 
 #include <deque>
+#include <map>
 #include <vector>
 #include <list>
 #include <set>
+#include <unordered_map>
+#include <tbb/task_arena.h>
 #include <boost/thread.hpp>
+#include <boost/weak_ptr.hpp>
 #include <sdf/sdf.hh>
+#include <ignition/math/Pose3.hh>
 #include <string>
 
 #include "gazebo/common/Event.hh"
@@ -39,6 +44,33 @@ namespace gazebo
 {
   namespace physics
   {
+    /// \brief A model or link whose pose is published by the world.
+    class PosePublishEntity
+    {
+      /// \brief The model or link.
+      public: EntityPtr entity;
+
+      /// \brief Scoped name of the entity, computed once.
+      public: std::string name;
+
+      /// \brief Id of the entity.
+      public: uint32_t id;
+
+      /// \brief Child generation of a model when the list was built,
+      /// used to detect added or removed links and nested models.
+      /// Unused for links.
+      public: unsigned int childGeneration;
+
+      /// \brief True if the entity is a model.
+      public: bool isModel;
+
+      /// \brief True once the entity has been published with its name.
+      public: bool nameSent;
+
+      /// \brief Last relative pose published in compact mode.
+      public: ignition::math::Pose3d lastPose;
+    };
+
     /// \brief Private data class for World.
     class WorldPrivate
     {
@@ -97,6 +129,9 @@ namespace gazebo
       /// \brief Publisher for request response messages.
       public: transport::PublisherPtr responsePub;
 
+      /// \brief Publisher of the traces requested by trace_stop.
+      public: transport::PublisherPtr tracePub;
+
       /// \brief Publisher for model messages.
       public: transport::PublisherPtr modelPub;
 
@@ -142,6 +177,21 @@ namespace gazebo
       /// \brief Function pointer to the model update function.
       public: void (World::*modelUpdateFunc)();
 
+      /// \brief Number of threads used by the model update function.
+      /// Values less than 2 select World::ModelUpdateSingleLoop.
+      public: unsigned int modelUpdateThreads;
+
+      /// \brief Work-stealing thread pool used by World::ModelUpdateTBB.
+      public: tbb::task_arena *modelUpdateArena;
+
+      /// \brief Top level models that World::ModelUpdateTBB updates
+      /// concurrently. Rebuilt every update, kept here to reuse memory.
+      public: Model_V parallelModelUpdates;
+
+      /// \brief Top level entities that World::ModelUpdateTBB updates
+      /// sequentially, because they modify state shared across models.
+      public: Base_V serialModelUpdates;
+
       /// \brief Last time a world statistics message was sent.
       public: common::Time prevStatTime;
 
@@ -231,11 +281,25 @@ namespace gazebo
       /// \brief Keep track of current state buffer being updated
       public: int currentStateBuffer;
 
-      /// \brief Buffer of prev states
-      public: WorldState prevStates[2];
+      /// \brief Current state of the world for logging. Each capture only
+      /// reloads the models in logDirtyModels.
+      public: WorldState logState;
+
+      /// \brief The state that was logged last.
+      public: WorldState loggedState;
+
+      /// \brief Top level models that moved since the last capture of
+      /// logState. Filled by PublishModelPose, which runs for every pose
+      /// change, including the dirty poses set by the physics engine, but
+      /// only while a recording is running.
+      public: std::set<ModelPtr> logDirtyModels;
 
-      /// \brief Int used to toggle between prevStates
-      public: int stateToggle;
+      /// \brief True if models moved while no recording was running. The
+      /// next capture reloads every model. Protected by receiveMutex.
+      public: bool logDirtyAll;
+
+      /// \brief True if the next capture must reload every model.
+      public: bool logFullCapture;
 
       /// \brief State from from log file.
       public: sdf::ElementPtr logPlayStateSDF;
@@ -250,6 +314,24 @@ namespace gazebo
       /// \brief The list of models that need to publish their pose.
       public: std::set<ModelPtr> publishModelPoses;
 
+      /// \brief Flattened list of the model, nested models and links
+      /// published for each model in publishModelPoses. Built the first
+      /// time a model is published and rebuilt when its structure changes.
+      public: std::map<ModelPtr, std::vector<PosePublishEntity> >
+              posePublishEntities;
+
+      /// \brief Pose message reused by every pose publish.
+      public: msgs::PosesStamped posesMsg;
+
+      /// \brief True to only publish entity names the first time an
+      /// entity is published, and skip entities whose pose has not changed.
+      public: bool compactPoseMsgs;
+
+      /// \brief Subscription generation of the pose topics when poses
+      /// were last published. Names of every entity are sent again in
+      /// compact mode when it changes.
+      public: unsigned int poseSubscriptionGeneration;
+
       /// \brief Info passed through the WorldUpdateBegin event.
       public: common::UpdateInfo updateInfo;
 
@@ -278,12 +360,28 @@ namespace gazebo
       /// \brief Mutex to protect the log state buffers
       public: boost::mutex logBufferMutex;
 
+      /// \brief Entities indexed by scoped name. Entries of entities that
+      /// were renamed are removed when they are looked up.
+      public: std::unordered_map<std::string, boost::weak_ptr<Base>>
+              entityNameIndex;
+
+      /// \brief Entities indexed by id.
+      public: std::unordered_map<uint32_t, boost::weak_ptr<Base>>
+              entityIdIndex;
+
+      /// \brief Mutex to protect the entity indexes.
+      public: boost::mutex entityIndexMutex;
+
       /// \brief Mutex to protect the deleteEntity list.
       public: boost::mutex entityDeleteMutex;
 
       /// \brief Worker thread for logging.
       public: boost::thread *logThread;
 
+      /// \brief Thread that exports the trace requested by trace_stop, so
+      /// that the world thread doesn't build it.
+      public: boost::thread *traceThread;
+
       /// \brief A cached list of models. This is here for performance.
       public: Model_V models;
 
@@ -293,8 +391,9 @@ namespace gazebo
 
       /// \brief when physics engine makes an update and changes a link pose,
       /// this flag is set to trigger Entity::SetWorldPose on the
-      /// physics::Link in World::Update.
-      public: std::list<Entity*> dirtyPoses;
+      /// physics::Link in World::Update. Cleared every update, keeping its
+      /// memory.
+      public: std::vector<Entity*> dirtyPoses;
 
       /// \brief Class to manage preset simulation parameter profiles.
       public: PresetManagerPtr presetManager;
@@ -101,6 +101,31 @@ void WorldState::Load(const WorldPtr _world)
   }
 }
 
+/////////////////////////////////////////////////
+bool WorldState::Load(const WorldPtr _world, const Model_V &_models)
+{
+  for (auto const &model : _models)
+  {
+    if (this->modelStates.find(model->GetName()) == this->modelStates.end())
+      return false;
+  }
+
+  this->world = _world;
+  this->name = _world->GetName();
+  this->wallTime = common::Time::GetWallTime();
+  this->simTime = _world->GetSimTime();
+  this->realTime = _world->GetRealTime();
+  this->iterations = _world->GetIterations();
+
+  for (auto const &model : _models)
+  {
+    this->modelStates[model->GetName()].Load(model, this->realTime,
+        this->simTime, this->iterations);
+  }
+
+  return true;
+}
+
 /////////////////////////////////////////////////
 void WorldState::Load(const sdf::ElementPtr _elem)
 {
@@ -131,6 +156,30 @@ void WorldState::Load(const sdf::ElementPtr _elem)
   }
 }
 
+/////////////////////////////////////////////////
+void WorldState::Load(const msgs::WorldState &_msg)
+{
+  this->name = _msg.world_name();
+  this->simTime = msgs::Convert(_msg.sim_time());
+  this->wallTime = msgs::Convert(_msg.wall_time());
+  this->realTime = msgs::Convert(_msg.real_time());
+  this->iterations = _msg.iterations();
+
+  this->insertions.assign(_msg.insertion().begin(), _msg.insertion().end());
+  this->deletions.assign(_msg.deletion().begin(), _msg.deletion().end());
+
+  this->modelStates.clear();
+  for (int i = 0; i < _msg.model_size(); ++i)
+  {
+    ModelState &modelState = this->modelStates[_msg.model(i).name()];
+    modelState.Load(_msg.model(i));
+    modelState.SetSimTime(this->simTime);
+    modelState.SetWallTime(this->wallTime);
+    modelState.SetRealTime(this->realTime);
+    modelState.SetIterations(this->iterations);
+  }
+}
+
 /////////////////////////////////////////////////
 void WorldState::SetWorld(const WorldPtr _world)
 {
@@ -320,6 +369,25 @@ void WorldState::FillSDF(sdf::ElementPtr _sdf)
   }
 }
 
+/////////////////////////////////////////////////
+void WorldState::FillMsg(msgs::WorldState &_msg) const
+{
+  _msg.set_world_name(this->name);
+  msgs::Set(_msg.mutable_sim_time(), this->simTime);
+  msgs::Set(_msg.mutable_wall_time(), this->wallTime);
+  msgs::Set(_msg.mutable_real_time(), this->realTime);
+  _msg.set_iterations(this->iterations);
+
+  for (auto const &insertion : this->insertions)
+    _msg.add_insertion(insertion);
+
+  for (auto const &deletion : this->deletions)
+    _msg.add_deletion(deletion);
+
+  for (auto const &modelState : this->modelStates)
+    modelState.second.FillMsg(*_msg.add_model());
+}
+
 /////////////////////////////////////////////////
 void WorldState::SetWallTime(const common::Time &_time)
 {
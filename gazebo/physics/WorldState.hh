@@ -26,6 +26,7 @@
 
 #include <sdf/sdf.hh>
 
+#include "gazebo/msgs/msgs.hh"
 #include "gazebo/physics/State.hh"
 #include "gazebo/physics/ModelState.hh"
 #include "gazebo/util/system.hh"
@@ -69,12 +70,29 @@ namespace gazebo
       /// \param[in] _world Pointer to a world
       public: void Load(const WorldPtr _world);
 
+      /// \brief Update the times from a World, and reload the states of
+      /// some of its models. The states of the other models are left
+      /// unchanged.
+      /// \param[in] _world Pointer to a world.
+      /// \param[in] _models Models to reload.
+      /// \return False if one of the models has no state yet. Call
+      /// Load(const WorldPtr) in that case.
+      public: bool Load(const WorldPtr _world, const Model_V &_models);
+
       /// \brief Load state from SDF element.
       ///
       /// Set a WorldState from an SDF element containing WorldState info.
       /// \param[in] _elem Pointer to the WorldState SDF element.
       public: virtual void Load(const sdf::ElementPtr _elem);
 
+      /// \brief Load state from a message.
+      ///
+      /// Set a WorldState, including its model insertions and deletions,
+      /// from a message filled by FillMsg. This is much cheaper than
+      /// parsing the same state from SDF.
+      /// \param[in] _msg World state message.
+      public: void Load(const msgs::WorldState &_msg);
+
       /// \brief Set the world.
       /// \param[in] _world Pointer to the world.
       public: void SetWorld(const WorldPtr _world);
@@ -117,6 +135,11 @@ namespace gazebo
       /// \param[out] _sdf SDF element to populate.
       public: void FillSDF(sdf::ElementPtr _sdf);
 
+      /// \brief Populate a state message with the same data that the
+      /// stream insertion operator writes to a log file.
+      /// \param[out] _msg Message to populate.
+      public: void FillMsg(msgs::WorldState &_msg) const;
+
       /// \brief Set the wall time when this state was generated
       /// \param[in] _time The absolute clock time when the State
       /// data was recorded.
@@ -230,18 +230,63 @@ bool ContactProcessed(btManifoldPoint &/*_cp*/, void * /*_body0*/,
   return true;
 }
 
+#ifdef LIBBULLET_VERSION_GT_287
+//////////////////////////////////////////////////
+/// \brief Get the task scheduler of the multithreaded dynamics worlds,
+/// installing it on first use.
+/// \return The task scheduler.
+static btITaskScheduler *TaskScheduler()
+{
+  static btITaskScheduler *scheduler = NULL;
+  if (!scheduler)
+  {
+    // Each of these is NULL if bullet was built without it.
+    scheduler = btGetTBBTaskScheduler();
+    if (!scheduler)
+      scheduler = btCreateDefaultTaskScheduler();
+    if (!scheduler)
+    {
+      gzwarn << "Bullet was built without BT_THREADSAFE, the multithreaded "
+             << "dynamics world will step in the physics thread.\n";
+      scheduler = btGetSequentialTaskScheduler();
+    }
+    btSetTaskScheduler(scheduler);
+  }
+  return scheduler;
+}
+#endif
+
 //////////////////////////////////////////////////
 BulletPhysics::BulletPhysics(WorldPtr _world)
-    : PhysicsEngine(_world)
+    : PhysicsEngine(_world), broadPhase(NULL), collisionConfig(NULL),
+      dispatcher(NULL), solver(NULL), dynamicsWorld(NULL), solverMt(NULL),
+      filterCallback(NULL), multithreaded(false)
+{
+  this->CreateDynamicsWorld(false);
+
+  // TODO: Enable this to do custom contact setting
+  gContactAddedCallback = ContactCallback;
+  gContactProcessedCallback = ContactProcessed;
+
+  // Set random seed for physics engine based on gazebo's random seed.
+  // Note: this was moved from physics::PhysicsEngine constructor.
+  this->SetSeed(math::Rand::GetSeed());
+}
+
+//////////////////////////////////////////////////
+BulletPhysics::~BulletPhysics()
+{
+  this->DestroyDynamicsWorld();
+}
+
+//////////////////////////////////////////////////
+void BulletPhysics::CreateDynamicsWorld(bool _multithreaded)
 {
   // This function currently follows the pattern of bullet/Demos/HelloWorld
 
   // Default setup for memory and collisions
   this->collisionConfig = new btDefaultCollisionConfiguration();
 
-  // Default collision dispatcher, a multi-threaded dispatcher may be available
-  this->dispatcher = new btCollisionDispatcher(this->collisionConfig);
-
   // Broadphase collision detection uses axis-aligned bounding boxes (AABB)
   // to detect pairs of objects that may be in contact.
   // The narrow-phase collision detection evaluates each pair generated by the
@@ -254,51 +299,80 @@ BulletPhysics::BulletPhysics(WorldPtr _world)
   // Here we are using btDbvtBroadphase.
   this->broadPhase = new btDbvtBroadphase();
 
-  // Create btSequentialImpulseConstraintSolver, the default constraint solver.
-  // Note that a multi-threaded solver may be available.
-  this->solver = new btSequentialImpulseConstraintSolver;
+#ifdef LIBBULLET_VERSION_GT_287
+  if (_multithreaded)
+  {
+    btITaskScheduler *scheduler = TaskScheduler();
+
+    // The narrow phase of the broadphase pairs runs on the task scheduler.
+    this->dispatcher = new btCollisionDispatcherMt(this->collisionConfig);
 
-  // Create a btDiscreteDynamicsWorld, which is used for discrete rigid bodies.
-  // An alternative is btSoftRigidDynamicsWorld, which handles both soft and
-  // rigid bodies.
-  this->dynamicsWorld = new btDiscreteDynamicsWorld(this->dispatcher,
-      this->broadPhase, this->solver, this->collisionConfig);
+    // Islands are solved concurrently, each by a solver of the pool, and
+    // the largest islands are solved by a parallel solver.
+    btConstraintSolverPoolMt *solverPool =
+      new btConstraintSolverPoolMt(scheduler->getMaxNumThreads());
+    this->solver = solverPool;
+    this->solverMt = new btSequentialImpulseConstraintSolverMt();
 
-  btOverlapFilterCallback *filterCallback = new CollisionFilter();
+    this->dynamicsWorld = new btDiscreteDynamicsWorldMt(this->dispatcher,
+        this->broadPhase, solverPool, this->solverMt, this->collisionConfig);
+  }
+  else
+#else
+  if (_multithreaded)
+  {
+    gzwarn << "The multithreaded dynamics world requires bullet 2.88 or "
+           << "newer, using the single threaded world.\n";
+    _multithreaded = false;
+  }
+#endif
+  {
+    // Default collision dispatcher
+    this->dispatcher = new btCollisionDispatcher(this->collisionConfig);
+
+    // Create btSequentialImpulseConstraintSolver, the default constraint
+    // solver.
+    this->solver = new btSequentialImpulseConstraintSolver;
+
+    // Create a btDiscreteDynamicsWorld, which is used for discrete rigid
+    // bodies. An alternative is btSoftRigidDynamicsWorld, which handles both
+    // soft and rigid bodies.
+    this->dynamicsWorld = new btDiscreteDynamicsWorld(this->dispatcher,
+        this->broadPhase, this->solver, this->collisionConfig);
+  }
+  this->multithreaded = _multithreaded;
+
+  this->filterCallback = new CollisionFilter();
   btOverlappingPairCache* pairCache = this->dynamicsWorld->getPairCache();
   GZ_ASSERT(pairCache != NULL,
       "Bullet broadphase overlapping pair cache is NULL");
-  pairCache->setOverlapFilterCallback(filterCallback);
-
-  // TODO: Enable this to do custom contact setting
-  gContactAddedCallback = ContactCallback;
-  gContactProcessedCallback = ContactProcessed;
+  pairCache->setOverlapFilterCallback(this->filterCallback);
 
   this->dynamicsWorld->setInternalTickCallback(
       InternalTickCallback, static_cast<void *>(this));
 
-  // Set random seed for physics engine based on gazebo's random seed.
-  // Note: this was moved from physics::PhysicsEngine constructor.
-  this->SetSeed(math::Rand::GetSeed());
-
-  btGImpactCollisionAlgorithm::registerAlgorithm(dispatcher);
+  btGImpactCollisionAlgorithm::registerAlgorithm(this->dispatcher);
 }
 
 //////////////////////////////////////////////////
-BulletPhysics::~BulletPhysics()
+void BulletPhysics::DestroyDynamicsWorld()
 {
   // Delete in reverse-order of creation
   delete this->dynamicsWorld;
+  delete this->solverMt;
   delete this->solver;
   delete this->broadPhase;
   delete this->dispatcher;
   delete this->collisionConfig;
+  delete this->filterCallback;
 
   this->dynamicsWorld = NULL;
+  this->solverMt = NULL;
   this->solver = NULL;
   this->broadPhase = NULL;
   this->dispatcher = NULL;
   this->collisionConfig = NULL;
+  this->filterCallback = NULL;
 }
 
 //////////////////////////////////////////////////
@@ -308,6 +382,10 @@ void BulletPhysics::Load(sdf::ElementPtr _sdf)
 
   sdf::ElementPtr bulletElem = this->sdf->GetElement("bullet");
 
+  // Links are added to the dynamics world after this, so this is where
+  // the multithreaded world can be selected.
+  this->SetThreads(bulletElem->Get<unsigned int>("threads"));
+
   math::Vector3 g = this->sdf->Get<math::Vector3>("gravity");
   // ODEPhysics checks this, so we will too.
   if (g == math::Vector3(0, 0, 0))
@@ -407,6 +485,7 @@ void BulletPhysics::OnRequest(ConstRequestPtr &_msg)
     physicsMsg.set_real_time_update_rate(this->realTimeUpdateRate);
     physicsMsg.set_real_time_factor(this->targetRealTimeFactor);
     physicsMsg.set_max_step_size(this->maxStepSize);
+    physicsMsg.set_threads(this->GetThreads());
 
     response.set_type(physicsMsg.GetTypeName());
     physicsMsg.SerializeToString(serializedData);
@@ -462,6 +541,9 @@ void BulletPhysics::OnPhysicsMsg(ConstPhysicsPtr &_msg)
     this->SetMaxStepSize(_msg->max_step_size());
   }
 
+  if (_msg->has_threads())
+    this->SetParam("threads", _msg->threads());
+
   /// Make sure all models get at least one update cycle.
   this->world->EnableAllModels();
 }
@@ -590,6 +672,16 @@ bool BulletPhysics::SetParam(const std::string &_key, const boost::any &_value)
       double value = boost::any_cast<double>(_value);
       bulletElem->GetElement("solver")->GetElement("min_step_size")->Set(value);
     }
+    else if (_key == "threads")
+    {
+      int value = boost::any_cast<int>(_value);
+      if (value < 0)
+      {
+        gzerr << "threads must be non-negative" << std::endl;
+        return false;
+      }
+      return this->SetThreads(static_cast<unsigned int>(value));
+    }
     else
     {
       return PhysicsEngine::SetParam(_key, _value);
@@ -605,6 +697,58 @@ bool BulletPhysics::SetParam(const std::string &_key, const boost::any &_value)
   return true;
 }
 
+//////////////////////////////////////////////////
+bool BulletPhysics::SetThreads(unsigned int _threads)
+{
+  boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+
+  this->sdf->GetElement("bullet")->GetElement("threads")->Set(_threads);
+
+  bool multithreadedWorld = _threads > 1;
+  if (multithreadedWorld != this->multithreaded)
+  {
+    // Joints keep a pointer to the dynamics world, so it can only be
+    // replaced before any link is added.
+    if (this->dynamicsWorld->getNumCollisionObjects() > 0)
+    {
+      gzwarn << "The bullet dynamics world already has links, it can only "
+             << "switch between single and multithreaded when loaded.\n";
+      return false;
+    }
+
+    // Keep the settings of the current world.
+    btVector3 gravity = this->dynamicsWorld->getGravity();
+    btContactSolverInfo info = this->dynamicsWorld->getSolverInfo();
+
+    this->DestroyDynamicsWorld();
+    this->CreateDynamicsWorld(multithreadedWorld);
+
+    this->dynamicsWorld->setGravity(gravity);
+    this->dynamicsWorld->getSolverInfo() = info;
+  }
+
+#ifdef LIBBULLET_VERSION_GT_287
+  if (this->multithreaded)
+  {
+    btITaskScheduler *scheduler = btGetTaskScheduler();
+    scheduler->setNumThreads(std::min(static_cast<int>(_threads),
+          scheduler->getMaxNumThreads()));
+  }
+#endif
+
+  return multithreadedWorld == this->multithreaded;
+}
+
+//////////////////////////////////////////////////
+unsigned int BulletPhysics::GetThreads() const
+{
+#ifdef LIBBULLET_VERSION_GT_287
+  if (this->multithreaded)
+    return static_cast<unsigned int>(btGetTaskScheduler()->getNumThreads());
+#endif
+  return 1;
+}
+
 //////////////////////////////////////////////////
 boost::any BulletPhysics::GetParam(const std::string &_key) const
 {
@@ -646,6 +790,8 @@ bool BulletPhysics::GetParam(const std::string &_key, boost::any &_value) const
     _value = this->sdf->GetElement("max_contacts")->Get<int>();
   else if (_key == "min_step_size")
     _value = bulletElem->GetElement("solver")->Get<double>("min_step_size");
+  else if (_key == "threads")
+    _value = static_cast<int>(this->GetThreads());
   else
   {
     return PhysicsEngine::GetParam(_key, _value);
@@ -171,12 +171,50 @@ namespace gazebo
       // Documentation inherited
       public: virtual void SetSORPGSIters(unsigned int iters);
 
+      /// \brief Set the number of threads that step the dynamics world.
+      /// With two or more threads, a btDiscreteDynamicsWorldMt runs the
+      /// narrow phase in parallel, solves islands concurrently with a pool
+      /// of solvers and solves the largest islands with a parallel solver.
+      /// The kind of dynamics world can only change while it holds no
+      /// links, so this should be set through the <bullet><threads> SDF
+      /// parameter. Afterwards only the number of threads of a
+      /// multithreaded world can change.
+      /// \param[in] _threads Number of threads. Values less than 2 use the
+      /// single threaded btDiscreteDynamicsWorld.
+      /// \return True if the number of threads was applied.
+      public: bool SetThreads(unsigned int _threads);
+
+      /// \brief Get the number of threads that step the dynamics world.
+      /// \return Number of threads, 1 for the single threaded world.
+      /// \sa SetThreads
+      public: unsigned int GetThreads() const;
+
+      /// \brief Create the dynamics world and its collision and solver
+      /// objects.
+      /// \param[in] _multithreaded True to create a
+      /// btDiscreteDynamicsWorldMt.
+      private: void CreateDynamicsWorld(bool _multithreaded);
+
+      /// \brief Delete the dynamics world and its collision and solver
+      /// objects.
+      private: void DestroyDynamicsWorld();
+
       private: btBroadphaseInterface *broadPhase;
       private: btDefaultCollisionConfiguration *collisionConfig;
       private: btCollisionDispatcher *dispatcher;
-      private: btSequentialImpulseConstraintSolver *solver;
+      private: btConstraintSolver *solver;
       private: btDiscreteDynamicsWorld *dynamicsWorld;
 
+      /// \brief Parallel solver of the largest islands in the
+      /// multithreaded world, NULL otherwise.
+      private: btConstraintSolver *solverMt;
+
+      /// \brief Filter of the broadphase pairs.
+      private: btOverlapFilterCallback *filterCallback;
+
+      /// \brief True if the dynamics world is a btDiscreteDynamicsWorldMt.
+      private: bool multithreaded;
+
       private: common::Time lastUpdateTime;
 
       /// \brief The type of the solver.
@@ -180,6 +180,80 @@ TEST_F(BulletPhysics_TEST, PhysicsParam)
   EXPECT_DOUBLE_EQ(maxStepSize, maxStepSizeRet);
 }
 
+/////////////////////////////////////////////////
+/// Test selecting the multithreaded dynamics world
+TEST_F(BulletPhysics_TEST, Threads)
+{
+  Load("worlds/blank.world", true, "bullet");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  PhysicsEnginePtr physics = world->GetPhysicsEngine();
+  ASSERT_TRUE(physics != NULL);
+  EXPECT_EQ(boost::any_cast<int>(physics->GetParam("threads")), 1);
+  EXPECT_FALSE(physics->SetParam("threads", -1));
+
+#ifdef LIBBULLET_VERSION_GT_287
+  // The world is still empty, so it can become multithreaded.
+  EXPECT_TRUE(physics->SetParam("threads", 2));
+
+  // Bullet built without BT_THREADSAFE steps in the physics thread.
+  int threads = boost::any_cast<int>(physics->GetParam("threads"));
+  EXPECT_GE(threads, 1);
+  EXPECT_LE(threads, 2);
+#endif
+
+  SpawnBox("box", math::Vector3(1, 1, 1), math::Vector3(0, 0, 10),
+      math::Vector3::Zero);
+  physics::ModelPtr model = world->GetModel("box");
+  ASSERT_TRUE(model != NULL);
+
+  // Once links exist, the kind of dynamics world can't change.
+#ifdef LIBBULLET_VERSION_GT_287
+  EXPECT_FALSE(physics->SetParam("threads", 0));
+  EXPECT_TRUE(physics->SetParam("threads", 3));
+#else
+  EXPECT_FALSE(physics->SetParam("threads", 2));
+#endif
+
+  // The box falls the same in either world.
+  common::Time start = world->GetSimTime();
+  world->Step(500);
+  double t = (world->GetSimTime() - start).Double();
+  EXPECT_NEAR(model->GetWorldPose().pos.z, 10 + 0.5 * -9.8 * t * t, 0.05);
+}
+
+/////////////////////////////////////////////////
+/// Test selecting the multithreaded dynamics world in SDF
+TEST_F(BulletPhysics_TEST, ThreadsSDF)
+{
+  Load("worlds/bullet_threads.world", true, "bullet");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  PhysicsEnginePtr physics = world->GetPhysicsEngine();
+  ASSERT_TRUE(physics != NULL);
+  EXPECT_EQ(2u, physics->GetSDF()->GetElement("bullet")->Get<unsigned int>(
+        "threads"));
+
+#ifdef LIBBULLET_VERSION_GT_287
+  // Bullet built without BT_THREADSAFE steps in the physics thread.
+  int threads = boost::any_cast<int>(physics->GetParam("threads"));
+  EXPECT_GE(threads, 1);
+  EXPECT_LE(threads, 2);
+#else
+  EXPECT_EQ(boost::any_cast<int>(physics->GetParam("threads")), 1);
+#endif
+
+  // The box was added to the world selected by the SDF, and falls.
+  physics::ModelPtr model = world->GetModel("box");
+  ASSERT_TRUE(model != NULL);
+  common::Time start = world->GetSimTime();
+  world->Step(500);
+  double t = (world->GetSimTime() - start).Double();
+  EXPECT_NEAR(model->GetWorldPose().pos.z, 10 + 0.5 * -9.8 * t * t, 0.05);
+}
+
 /////////////////////////////////////////////////
 void BulletPhysics_TEST::OnPhysicsMsgResponse(ConstResponsePtr &_msg)
 {
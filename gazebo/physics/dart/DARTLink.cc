@@ -257,6 +257,9 @@ void DARTLink::Init()
 //////////////////////////////////////////////////
 void DARTLink::Fini()
 {
+  DARTPhysicsPtr dartPhysics = this->GetDARTPhysics();
+  if (dartPhysics)
+    dartPhysics->InvalidatePoseSync();
   Link::Fini();
 }
 
@@ -800,6 +803,12 @@ void DARTLink::updateDirtyPoseFromDARTTransformation()
   this->world->dataPtr->dirtyPoses.push_back(this);
 }
 
+//////////////////////////////////////////////////
+void DARTLink::SetDirtyPose(const math::Pose &_pose)
+{
+  this->dirtyPose = _pose;
+}
+
 //////////////////////////////////////////////////
 DARTPhysicsPtr DARTLink::GetDARTPhysics(void) const
 {
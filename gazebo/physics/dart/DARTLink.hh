@@ -155,6 +155,10 @@ namespace gazebo
       ///        Entity::SetWorldPose() for this link.
       public: void updateDirtyPoseFromDARTTransformation();
 
+      /// \brief Set the pose that World::Update applies to this link.
+      /// \param[in] _pose New world pose of the link.
+      public: void SetDirtyPose(const math::Pose &_pose);
+
       /// \brief Get pointer to DART Physics engine associated with this link.
       /// \return Pointer to the DART Physics engine.
       public: DARTPhysicsPtr GetDARTPhysics(void) const;
@@ -153,6 +153,9 @@ void DARTModel::Init()
   // Note: This function should be called after the skeleton is added to the
   //       world.
   this->BackupState();
+
+  // The links of this model are synced from the next step.
+  this->GetDARTPhysics()->InvalidatePoseSync();
 }
 
 
@@ -15,6 +15,9 @@
  *
 */
 
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Exception.hh"
@@ -228,27 +231,76 @@ void DARTPhysics::UpdatePhysics()
   this->dataPtr->dtWorld->step();
 
   // Update all the transformation of DART's links to gazebo's links
-  // TODO: How to visit all the links in the world?
-  unsigned int modelCount = this->world->GetModelCount();
-  ModelPtr modelItr;
+  this->SyncPoses();
 
-  for (unsigned int i = 0; i < modelCount; ++i)
-  {
-    modelItr = this->world->GetModel(i);
-    // TODO: need to improve speed
-    Link_V links = modelItr->GetLinks();
-    unsigned int linkCount = links.size();
-    DARTLinkPtr dartLinkItr;
+  // this->lastUpdateTime = currTime;
+}
 
-    for (unsigned int j = 0; j < linkCount; ++j)
+//////////////////////////////////////////////////
+void DARTPhysics::InvalidatePoseSync()
+{
+  boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+  this->dataPtr->poseSyncStale = true;
+}
+
+//////////////////////////////////////////////////
+void DARTPhysics::BuildPoseSync()
+{
+  this->dataPtr->poseSyncLinks.clear();
+
+  for (auto const &model : this->world->GetModels())
+  {
+    for (auto const &link : model->GetLinks())
     {
-      dartLinkItr
-          = boost::dynamic_pointer_cast<DARTLink>(links.at(j));
-      dartLinkItr->updateDirtyPoseFromDARTTransformation();
+      DARTPoseSync sync;
+      sync.link = boost::static_pointer_cast<DARTLink>(link).get();
+      sync.dtBodyNode = sync.link->GetDARTBodyNode();
+      sync.changed = false;
+      sync.synced = false;
+      this->dataPtr->poseSyncLinks.push_back(sync);
     }
   }
 
-  // this->lastUpdateTime = currTime;
+  this->dataPtr->poseSyncStale = false;
+}
+
+//////////////////////////////////////////////////
+void DARTPhysics::SyncPoses()
+{
+  if (this->dataPtr->poseSyncStale)
+    this->BuildPoseSync();
+
+  // Body node transforms are computed by the step, so links are copied
+  // concurrently, in chunks large enough to not pay for tasks in small
+  // worlds.
+  std::vector<DARTPoseSync, Eigen::aligned_allocator<DARTPoseSync> >
+    &poseSyncLinks = this->dataPtr->poseSyncLinks;
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, poseSyncLinks.size(), 128),
+      [&](const tbb::blocked_range<size_t> &_r)
+      {
+        for (size_t i = _r.begin(); i != _r.end(); ++i)
+        {
+          DARTPoseSync &sync = poseSyncLinks[i];
+          const Eigen::Isometry3d &transform =
+            sync.dtBodyNode->getTransform();
+
+          sync.changed = !sync.synced ||
+            transform.matrix() != sync.transform.matrix();
+          if (sync.changed)
+          {
+            sync.transform = transform;
+            sync.link->SetDirtyPose(DARTTypes::ConvPose(transform));
+            sync.synced = true;
+          }
+        }
+      });
+
+  // Only the links that moved update their world pose.
+  for (auto const &sync : poseSyncLinks)
+  {
+    if (sync.changed)
+      this->world->_AddDirty(sync.link);
+  }
 }
 
 //////////////////////////////////////////////////
@@ -146,6 +146,10 @@ namespace gazebo
       /// \return The pointer to DART World.
       public: dart::simulation::World *GetDARTWorld();
 
+      /// \brief Rebuild the list of links synced after each step before
+      /// the next sync. Called when links are added or removed.
+      public: void InvalidatePoseSync();
+
       // Documentation inherited
       protected: virtual void OnRequest(ConstRequestPtr &_msg);
 
@@ -158,6 +162,13 @@ namespace gazebo
       private: DARTLinkPtr FindDARTLink(
           const dart::dynamics::BodyNode *_dtBodyNode);
 
+      /// \brief Rebuild the list of links synced after each step, from
+      /// the models of the world.
+      private: void BuildPoseSync();
+
+      /// \brief Copy the body node transforms to the links that moved.
+      private: void SyncPoses();
+
       /// \internal
       /// \brief Pointer to private data.
       private: DARTPhysicsPrivate *dataPtr;
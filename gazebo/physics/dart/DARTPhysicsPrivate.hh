@@ -18,19 +18,46 @@
 #ifndef _GAZEBO_DARTPHYSICS_PRIVATE_HH_
 #define _GAZEBO_DARTPHYSICS_PRIVATE_HH_
 
+#include <vector>
+
+#include "gazebo/math/Pose.hh"
 #include "gazebo/physics/dart/dart_inc.h"
+#include "gazebo/physics/dart/DARTTypes.hh"
 
 namespace gazebo
 {
   namespace physics
   {
+    /// \internal
+    /// \brief A link whose pose is copied from its body node after each
+    /// step.
+    class DARTPoseSync
+    {
+      /// \brief The link.
+      public: DARTLink *link;
+
+      /// \brief The body node of the link.
+      public: dart::dynamics::BodyNode *dtBodyNode;
+
+      /// \brief Body node transform copied by the previous step.
+      public: Eigen::Isometry3d transform;
+
+      /// \brief True if the transform changed in the current step.
+      public: bool changed;
+
+      /// \brief True once the transform has been copied.
+      public: bool synced;
+
+      EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+    };
+
     /// \internal
     /// \brief Private data class for DARTPhysics
     class DARTPhysicsPrivate
     {
       /// \brief Constructor
       public: DARTPhysicsPrivate()
-        : dtWorld(new dart::simulation::World())
+        : dtWorld(new dart::simulation::World()), poseSyncStale(true)
       {
       }
 
@@ -45,6 +72,13 @@ namespace gazebo
 
       /// \brief Pointer to DART World associated with this DART Physics.
       public: dart::simulation::World *dtWorld;
+
+      /// \brief Links whose pose is copied after each step.
+      public: std::vector<DARTPoseSync,
+              Eigen::aligned_allocator<DARTPoseSync> > poseSyncLinks;
+
+      /// \brief True if poseSyncLinks must be rebuilt.
+      public: bool poseSyncStale;
     };
   }
 }
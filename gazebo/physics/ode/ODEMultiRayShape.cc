@@ -14,6 +14,11 @@
  * limitations under the License.
  *
  */
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+
+#include <algorithm>
+
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Exception.hh"
 
@@ -28,6 +33,40 @@
 using namespace gazebo;
 using namespace physics;
 
+//////////////////////////////////////////////////
+/// \brief Do two ODE bounding boxes overlap?
+/// \param[in] _a First bounding box.
+/// \param[in] _b Second bounding box.
+/// \return True if the boxes overlap.
+static bool AABBOverlap(const dReal *_a, const dReal *_b)
+{
+  return _a[0] <= _b[1] && _a[1] >= _b[0] &&
+         _a[2] <= _b[3] && _a[3] >= _b[2] &&
+         _a[4] <= _b[5] && _a[5] >= _b[4];
+}
+
+//////////////////////////////////////////////////
+/// \brief Can a geom be collided with rays on several threads at once?
+/// Heightfields and geom transforms write to internal buffers when they
+/// are collided, so they are not.
+/// \param[in] _geom The geom.
+/// \return True if the geom can be collided on several threads.
+static bool IsReentrant(dGeomID _geom)
+{
+  switch (dGeomGetClass(_geom))
+  {
+    case dSphereClass:
+    case dBoxClass:
+    case dCapsuleClass:
+    case dCylinderClass:
+    case dPlaneClass:
+    case dTriMeshClass:
+    case dConvexClass:
+      return true;
+    default:
+      return false;
+  }
+}
 
 //////////////////////////////////////////////////
 ODEMultiRayShape::ODEMultiRayShape(CollisionPtr _parent)
@@ -72,113 +111,156 @@ void ODEMultiRayShape::UpdateRays()
   if (ode == NULL)
     gzthrow("Invalid physics engine. Must use ODE.");
 
+  if (this->rays.empty())
+    return;
+
   // Do we need to lock the physics engine here? YES!
   // especially when spawning models with sensors
+  boost::recursive_mutex::scoped_lock lock(*ode->GetPhysicsUpdateMutex());
+
+  // Bring all the bounding boxes up to date, so that the parallel checks
+  // below only read the ODE geoms.
+  dSpaceClean(this->raySpaceId);
+  dSpaceClean(ode->GetSpaceId());
+
+  this->rayBounds.resize(6 * this->rays.size());
+  for (size_t i = 0; i < this->rays.size(); ++i)
+  {
+    dGeomGetAABB(boost::static_pointer_cast<ODERayShape>(
+          this->rays[i])->GetODEId(), &this->rayBounds[6 * i]);
+  }
+
+  dReal bounds[6];
+  dGeomGetAABB((dGeomID)this->raySpaceId, bounds);
+
+  this->targets.clear();
+  this->targetBounds.clear();
+  dSpaceID worldSpace = ode->GetSpaceId();
+  for (int i = 0; i < dSpaceGetNumGeoms(worldSpace); ++i)
+    this->CollectTargets(dSpaceGetGeom(worldSpace, i), bounds);
+
+  // Cast the rays in packets of neighboring rays, which point in similar
+  // directions. Most targets are culled by the bounding box of a packet
+  // before the rays are checked one by one.
+  const size_t packetSize = 64;
+  size_t packetCount = (this->rays.size() + packetSize - 1) / packetSize;
+
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, packetCount),
+      [&](const tbb::blocked_range<size_t> &_r)
+      {
+        // ODE keeps the trimesh collider caches per thread
+        dAllocateODEDataForThread(dAllocateMaskAll);
+
+        for (size_t p = _r.begin(); p != _r.end(); ++p)
+        {
+          size_t begin = p * packetSize;
+          size_t end = std::min(begin + packetSize, this->rays.size());
+
+          dReal packetBounds[6];
+          for (int k = 0; k < 6; ++k)
+            packetBounds[k] = this->rayBounds[6 * begin + k];
+          for (size_t i = begin + 1; i < end; ++i)
+          {
+            for (int k = 0; k < 6; k += 2)
+            {
+              packetBounds[k] = std::min(packetBounds[k],
+                  this->rayBounds[6 * i + k]);
+              packetBounds[k + 1] = std::max(packetBounds[k + 1],
+                  this->rayBounds[6 * i + k + 1]);
+            }
+          }
+
+          for (size_t t = 0; t < this->targets.size(); ++t)
+          {
+            const dReal *targetBox = &this->targetBounds[6 * t];
+            if (!IsReentrant(this->targets[t]) ||
+                !AABBOverlap(targetBox, packetBounds))
+            {
+              continue;
+            }
+
+            for (size_t i = begin; i < end; ++i)
+            {
+              if (AABBOverlap(targetBox, &this->rayBounds[6 * i]))
+                this->CollideRay(i, this->targets[t]);
+            }
+          }
+        }
+      });
+
+  // Geoms that ODE can't collide on several threads at once
+  for (size_t t = 0; t < this->targets.size(); ++t)
   {
-    boost::recursive_mutex::scoped_lock lock(*ode->GetPhysicsUpdateMutex());
+    if (IsReentrant(this->targets[t]))
+      continue;
 
-    // Do collision detection
-    dSpaceCollide2((dGeomID) (this->superSpaceId),
-        (dGeomID) (ode->GetSpaceId()),
-        this, &UpdateCallback);
+    for (size_t i = 0; i < this->rays.size(); ++i)
+    {
+      if (AABBOverlap(&this->targetBounds[6 * t], &this->rayBounds[6 * i]))
+        this->CollideRay(i, this->targets[t]);
+    }
   }
 }
 
 //////////////////////////////////////////////////
-void ODEMultiRayShape::UpdateCallback(void *_data, dGeomID _o1, dGeomID _o2)
+void ODEMultiRayShape::CollectTargets(dGeomID _geom, const dReal *_bounds)
 {
-  dContactGeom contact;
-  ODEMultiRayShape *self = NULL;
-
-  self = static_cast<ODEMultiRayShape*>(_data);
+  if (!dGeomIsEnabled(_geom))
+    return;
 
-  // Check space
-  if (dGeomIsSpace(_o1) || dGeomIsSpace(_o2))
+  // Apply the same collision bits as dSpaceCollide2 does
+  dGeomID raySpace = (dGeomID)this->raySpaceId;
+  if (!(dGeomGetCategoryBits(_geom) & dGeomGetCollideBits(raySpace)) &&
+      !(dGeomGetCollideBits(_geom) & dGeomGetCategoryBits(raySpace)))
   {
-    if (dGeomGetSpace(_o1) == self->superSpaceId ||
-        dGeomGetSpace(_o2) == self->superSpaceId)
-      dSpaceCollide2(_o1, _o2, self, &UpdateCallback);
+    return;
+  }
+
+  dReal aabb[6];
+  dGeomGetAABB(_geom, aabb);
+  if (!AABBOverlap(aabb, _bounds))
+    return;
 
-    if (dGeomGetSpace(_o1) == self->raySpaceId ||
-        dGeomGetSpace(_o2) == self->raySpaceId)
-      dSpaceCollide2(_o1, _o2, self, &UpdateCallback);
+  if (dGeomIsSpace(_geom))
+  {
+    dSpaceID space = (dSpaceID)_geom;
+    for (int i = 0; i < dSpaceGetNumGeoms(space); ++i)
+      this->CollectTargets(dSpaceGetGeom(space, i), _bounds);
   }
   else
   {
-    ODECollision *collision1 = NULL;
-    ODECollision *collision2 = NULL;
-
-    // Get pointers to the underlying collisions
-    if (dGeomGetClass(_o1) == dGeomTransformClass)
-    {
-      collision1 = static_cast<ODECollision*>(
-          dGeomGetData(dGeomTransformGetGeom(_o1)));
-    }
-    else
-      collision1 = static_cast<ODECollision*>(dGeomGetData(_o1));
-
-    if (dGeomGetClass(_o2) == dGeomTransformClass)
-    {
-      collision2 =
-        static_cast<ODECollision*>(dGeomGetData(dGeomTransformGetGeom(_o2)));
-    }
-    else
-    {
-      collision2 = static_cast<ODECollision*>(dGeomGetData(_o2));
-    }
+    this->targets.push_back(_geom);
+    this->targetBounds.insert(this->targetBounds.end(), aabb, aabb + 6);
+  }
+}
 
-    GZ_ASSERT(collision1, "collision1 is null");
-    GZ_ASSERT(collision2, "collision2 is null");
+//////////////////////////////////////////////////
+void ODEMultiRayShape::CollideRay(size_t _index, dGeomID _geom)
+{
+  ODERayShapePtr shape =
+    boost::static_pointer_cast<ODERayShape>(this->rays[_index]);
 
-    ODECollision *rayCollision = NULL;
-    ODECollision *hitCollision = NULL;
+  dContactGeom contact;
+  if (dCollide(shape->GetODEId(), _geom, 1, &contact, sizeof(contact)) <= 0 ||
+      contact.depth >= shape->GetLength())
+  {
+    return;
+  }
 
-    // Figure out which one is a ray; note that this assumes
-    // that the ODE dRayClass is used *soley* by the RayCollision.
-    if (dGeomGetClass(_o1) == dRayClass)
-    {
-      rayCollision = static_cast<ODECollision*>(collision1);
-      hitCollision = static_cast<ODECollision*>(collision2);
-      dGeomRaySetParams(_o1, 0, 0);
-      dGeomRaySetClosestHit(_o1, 1);
-    }
-    else if (dGeomGetClass(_o2) == dRayClass)
-    {
-      GZ_ASSERT(rayCollision == NULL, "rayCollision is not null");
-      rayCollision = static_cast<ODECollision*>(collision2);
-      hitCollision = static_cast<ODECollision*>(collision1);
-      dGeomRaySetParams(_o2, 0, 0);
-      dGeomRaySetClosestHit(_o2, 1);
-    }
+  // Get a pointer to the underlying collision
+  ODECollision *hitCollision = NULL;
+  if (dGeomGetClass(_geom) == dGeomTransformClass)
+  {
+    hitCollision = static_cast<ODECollision*>(
+        dGeomGetData(dGeomTransformGetGeom(_geom)));
+  }
+  else
+    hitCollision = static_cast<ODECollision*>(dGeomGetData(_geom));
 
-    // Check for ray/collision intersections
-    if (rayCollision && hitCollision)
-    {
-      int n = dCollide(_o1, _o2, 1, &contact, sizeof(contact));
+  GZ_ASSERT(hitCollision, "hitCollision is null");
 
-      if (n > 0)
-      {
-        RayShapePtr shape = boost::static_pointer_cast<RayShape>(
-            rayCollision->GetShape());
-        if (contact.depth < shape->GetLength())
-        {
-          // gzerr << "ODEMultiRayShape UpdateCallback dSpaceCollide2 "
-          //      << " depth[" << contact.depth << "]"
-          //      << " position[" << contact.pos[0]
-          //        << ", " << contact.pos[1]
-          //        << ", " << contact.pos[2]
-          //        << ", " << "]"
-          //      << " ray[" << rayCollision->GetScopedName() << "]"
-          //      << " pose[" << rayCollision->GetWorldPose() << "]"
-          //      << " hit[" << hitCollision->GetScopedName() << "]"
-          //      << " pose[" << hitCollision->GetWorldPose() << "]"
-          //      << "\n";
-          shape->SetLength(contact.depth);
-          shape->SetRetro(hitCollision->GetLaserRetro());
-        }
-      }
-    }
-  }
+  shape->SetLength(contact.depth);
+  shape->SetRetro(hitCollision->GetLaserRetro());
 }
 
 //////////////////////////////////////////////////
@@ -195,6 +277,10 @@ void ODEMultiRayShape::AddRay(const math::Vector3 &_start,
   ODERayShapePtr ray(new ODERayShape(odeCollision));
   odeCollision->SetShape(ray);
 
+  // Only the closest hit of each ray is needed
+  dGeomRaySetParams(ray->GetODEId(), 0, 0);
+  dGeomRaySetClosestHit(ray->GetODEId(), 1);
+
   ray->SetPoints(_start, _end);
   this->rays.push_back(ray);
 }
@@ -17,6 +17,9 @@
 #ifndef _ODEMULTIRAYSHAPE_HH_
 #define _ODEMULTIRAYSHAPE_HH_
 
+#include <vector>
+
+#include "gazebo/physics/ode/ode_inc.h"
 #include "gazebo/physics/MultiRayShape.hh"
 #include "gazebo/util/system.hh"
 
@@ -37,12 +40,16 @@ namespace gazebo
       // Documentation inherited.
       public: virtual void UpdateRays();
 
-      /// \brief Ray-intersection callback.
-      /// \param[in] _data Pointer to user data.
-      /// \param[in] _o1 First geom to check for collisions.
-      /// \param[in] _o2 Second geom to check for collisions.
-      private: static void UpdateCallback(void *_data, dGeomID _o1,
-                                          dGeomID _o2);
+      /// \brief Add the geoms in a space, or a single geom, that the rays
+      /// may hit to the list of targets.
+      /// \param[in] _geom Geom or space to add.
+      /// \param[in] _bounds Bounding box of all the rays.
+      private: void CollectTargets(dGeomID _geom, const dReal *_bounds);
+
+      /// \brief Shorten a ray if it hits a geom.
+      /// \param[in] _index Index of the ray.
+      /// \param[in] _geom Geom to check the ray against.
+      private: void CollideRay(size_t _index, dGeomID _geom);
 
       /// \brief Add a ray to the collision.
       /// \param[in] _start Start of a ray.
@@ -55,6 +62,15 @@ namespace gazebo
 
       /// \brief Ray space for collision detector.
       private: dSpaceID raySpaceId;
+
+      /// \brief Geoms that the rays may hit, gathered on each update.
+      private: std::vector<dGeomID> targets;
+
+      /// \brief Bounding boxes of the targets, six values per target.
+      private: std::vector<dReal> targetBounds;
+
+      /// \brief Bounding boxes of the rays, six values per ray.
+      private: std::vector<dReal> rayBounds;
     };
   }
 }
@@ -25,6 +25,7 @@
 #include <tbb/blocked_range.h>
 
 #include <sdf/sdf.hh>
+#include <parallel_quickstep/parallel_quickstep.h>
 
 #include <algorithm>
 #include <map>
@@ -32,7 +33,6 @@
 #include <utility>
 #include <vector>
 
-#include "gazebo/util/Diagnostics.hh"
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Exception.hh"
@@ -40,6 +40,7 @@
 #include "gazebo/math/Rand.hh"
 #include "gazebo/common/Time.hh"
 #include "gazebo/common/Timer.hh"
+#include "gazebo/common/Trace.hh"
 
 #include "gazebo/transport/Publisher.hh"
 
@@ -102,33 +103,6 @@ class ContactUpdate_TBB
 };
 */
 
-class Colliders_TBB
-{
-  public: Colliders_TBB(
-              std::vector<std::pair<ODECollision*, ODECollision*> > *_colliders,
-              ODEPhysics *_engine,
-              dContactGeom* _contactCollisions) :
-    colliders(_colliders),
-              engine(_engine), contactCollisions(_contactCollisions)
-  {
-    // dAllocateODEDataForThread(dAllocateMaskAll);
-  }
-
-  public: void operator() (const tbb::blocked_range<size_t> &_r) const
-  {
-    for (size_t i = _r.begin(); i != _r.end(); i++)
-    {
-      ODECollision *collision1 = (*this->colliders)[i].first;
-      ODECollision *collision2 = (*this->colliders)[i].second;
-      this->engine->Collide(collision1, collision2, contactCollisions);
-    }
-  }
-
-  private: std::vector< std::pair<ODECollision*, ODECollision*> > *colliders;
-  private: ODEPhysics *engine;
-  private: dContactGeom* contactCollisions;
-};
-
 //////////////////////////////////////////////////
 ODEPhysics::ODEPhysics(WorldPtr _world)
     : PhysicsEngine(_world), dataPtr(new ODEPhysicsPrivate)
@@ -150,6 +124,9 @@ ODEPhysics::ODEPhysics(WorldPtr _world)
 
   this->dataPtr->colliders.resize(100);
 
+  this->dataPtr->collisionThreads = 0;
+  this->dataPtr->collisionArena = NULL;
+
   // Set random seed for physics engine based on gazebo's random seed.
   // Note: this was moved from physics::PhysicsEngine constructor.
   this->SetSeed(math::Rand::GetSeed());
@@ -182,6 +159,10 @@ ODEPhysics::~ODEPhysics()
 
   this->dataPtr->spaceId = NULL;
   this->dataPtr->worldId = NULL;
+
+  delete this->dataPtr->collisionArena;
+  this->dataPtr->collisionArena = NULL;
+
   delete this->dataPtr;
   this->dataPtr = NULL;
 }
@@ -251,6 +232,21 @@ void ODEPhysics::Load(sdf::ElementPtr _sdf)
     this->GetSORPGSIters());
   dWorldSetQuickStepW(this->dataPtr->worldId, this->GetSORPGSW());
 
+  if (odeElem->HasElement("collision_threads"))
+    this->SetCollisionThreads(odeElem->Get<unsigned int>("collision_threads"));
+
+  // Step disconnected islands of bodies concurrently.
+  if (solverElem->HasElement("island_threads"))
+  {
+    dWorldSetIslandThreads(this->dataPtr->worldId,
+        solverElem->Get<int>("island_threads"));
+  }
+  if (solverElem->HasElement("min_island_size"))
+  {
+    dWorldSetMinIslandSize(this->dataPtr->worldId,
+        solverElem->Get<int>("min_island_size"));
+  }
+
   // Set the physics update function
   this->SetStepType(this->dataPtr->stepType);
   if (this->dataPtr->physicsStepFunc == NULL)
@@ -380,7 +376,7 @@ void ODEPhysics::InitForThread()
 //////////////////////////////////////////////////
 void ODEPhysics::UpdateCollision()
 {
-  DIAG_TIMER_START("ODEPhysics::UpdateCollision");
+  GZ_TRACE_SPAN(span, "ODEPhysics::UpdateCollision");
 
   boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
   dJointGroupEmpty(this->dataPtr->contactGroup);
@@ -395,33 +391,142 @@ void ODEPhysics::UpdateCollision()
 
   // Do collision detection; this will add contacts to the contact group
   dSpaceCollide(this->dataPtr->spaceId, this, CollisionCallback);
-  DIAG_TIMER_LAP("ODEPhysics::UpdateCollision", "dSpaceCollide");
+  GZ_TRACE_LAP(span, "dSpaceCollide");
+
+  if (this->dataPtr->collisionArena)
+  {
+    this->CollideThreaded();
+    GZ_TRACE_LAP(span, "collideThreaded");
+  }
+  else
+  {
+    // Generate non-trimesh collisions.
+    for (i = 0; i < this->dataPtr->collidersCount; ++i)
+    {
+      this->Collide(this->dataPtr->colliders[i].first,
+          this->dataPtr->colliders[i].second,
+          this->dataPtr->contactCollisions);
+    }
+    GZ_TRACE_LAP(span, "collideShapes");
+
+    // Generate trimesh collision.
+    for (i = 0; i < this->dataPtr->trimeshCollidersCount; ++i)
+    {
+      ODECollision *collision1 = this->dataPtr->trimeshColliders[i].first;
+      ODECollision *collision2 = this->dataPtr->trimeshColliders[i].second;
+      this->Collide(collision1, collision2, this->dataPtr->contactCollisions);
+    }
+    GZ_TRACE_LAP(span, "collideTrimeshes");
+  }
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::CollideThreaded()
+{
+  for (auto &scratch : this->dataPtr->narrowPhaseScratch)
+    scratch.contacts.clear();
+
+  size_t shapeCount = this->dataPtr->collidersCount;
+  size_t count = shapeCount + this->dataPtr->trimeshCollidersCount;
+  this->dataPtr->narrowPhaseResults.resize(count);
 
-  // Generate non-trimesh collisions.
-  for (i = 0; i < this->dataPtr->collidersCount; ++i)
+  // Run dCollide for every pair on the pool. Each pair writes only its own
+  // result slot and the scratch buffer of the thread that ran it.
+  this->dataPtr->collisionArena->execute([this, shapeCount, count]()
   {
-    this->Collide(this->dataPtr->colliders[i].first,
-        this->dataPtr->colliders[i].second, this->dataPtr->contactCollisions);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, shapeCount, 8),
+        [this](const tbb::blocked_range<size_t> &_r)
+        {
+          this->NarrowPhaseRange(this->dataPtr->colliders, 0,
+              _r.begin(), _r.end(), false);
+        });
+
+    tbb::parallel_for(tbb::blocked_range<size_t>(shapeCount, count, 1),
+        [this, shapeCount](const tbb::blocked_range<size_t> &_r)
+        {
+          this->NarrowPhaseRange(this->dataPtr->trimeshColliders, shapeCount,
+              _r.begin(), _r.end(), false);
+        });
+  });
+
+  // Pairs with shapes that keep scratch data in the ODE geom (heightmaps)
+  // were skipped by the pool, run them here one at a time.
+  for (size_t i = 0; i < count; ++i)
+  {
+    if (!this->dataPtr->narrowPhaseResults[i].deferred)
+      continue;
+
+    if (i < shapeCount)
+      this->NarrowPhaseRange(this->dataPtr->colliders, 0, i, i + 1, true);
+    else
+    {
+      this->NarrowPhaseRange(this->dataPtr->trimeshColliders, shapeCount,
+          i, i + 1, true);
+    }
   }
-  DIAG_TIMER_LAP("ODEPhysics::UpdateCollision", "collideShapes");
 
-  // Generate trimesh collision.
-  // This must happen in this thread sequentially
-  for (i = 0; i < this->dataPtr->trimeshCollidersCount; ++i)
+  // Create the contact joints and contact manager entries in the same order
+  // as the single threaded narrow phase.
+  for (size_t i = 0; i < count; ++i)
+  {
+    const ODENarrowPhaseResult &result = this->dataPtr->narrowPhaseResults[i];
+    if (result.count == 0)
+      continue;
+
+    const std::pair<ODECollision*, ODECollision*> &pair = i < shapeCount ?
+      this->dataPtr->colliders[i] :
+      this->dataPtr->trimeshColliders[i - shapeCount];
+
+    this->AddContactJoints(pair.first, pair.second,
+        &(*result.contacts)[result.offset], result.count);
+  }
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::NarrowPhaseRange(
+    const std::vector<std::pair<ODECollision*, ODECollision*> > &_colliders,
+    size_t _resultOffset, size_t _begin, size_t _end, bool _inPhysicsThread)
+{
+  ODENarrowPhaseScratch &scratch = this->dataPtr->narrowPhaseScratch.local();
+
+  // Trimesh colliders keep their OPCODE caches in thread local storage,
+  // which has to be allocated by every thread that calls dCollide.
+  if (!scratch.odeDataAllocated)
   {
-    ODECollision *collision1 = this->dataPtr->trimeshColliders[i].first;
-    ODECollision *collision2 = this->dataPtr->trimeshColliders[i].second;
-    this->Collide(collision1, collision2, this->dataPtr->contactCollisions);
+    this->InitForThread();
+    scratch.odeDataAllocated = true;
   }
-  DIAG_TIMER_LAP("ODEPhysics::UpdateCollision", "collideTrimeshes");
 
-  DIAG_TIMER_STOP("ODEPhysics::UpdateCollision");
+  for (size_t i = _begin; i < _end; ++i)
+  {
+    ODECollision *collision1 = _colliders[i - _resultOffset].first;
+    ODECollision *collision2 = _colliders[i - _resultOffset].second;
+    ODENarrowPhaseResult &result = this->dataPtr->narrowPhaseResults[i];
+
+    result.count = 0;
+    result.deferred = !_inPhysicsThread &&
+      ((collision1->GetShapeType() & Base::HEIGHTMAP_SHAPE) ||
+       (collision2->GetShapeType() & Base::HEIGHTMAP_SHAPE));
+    if (result.deferred)
+      continue;
+
+    unsigned int numc = this->NarrowPhase(collision1, collision2,
+        scratch.contactCollisions);
+    if (numc == 0)
+      continue;
+
+    result.contacts = &scratch.contacts;
+    result.offset = scratch.contacts.size();
+    result.count = numc;
+    scratch.contacts.insert(scratch.contacts.end(),
+        scratch.contactCollisions, scratch.contactCollisions + numc);
+  }
 }
 
 //////////////////////////////////////////////////
 void ODEPhysics::UpdatePhysics()
 {
-  DIAG_TIMER_START("ODEPhysics::UpdatePhysics");
+  GZ_TRACE_SPAN(span, "ODEPhysics::UpdatePhysics");
 
   // need to lock, otherwise might conflict with world resetting
   {
@@ -463,8 +568,6 @@ void ODEPhysics::UpdatePhysics()
       }
     }
   }
-
-  DIAG_TIMER_STOP("ODEPhysics::UpdatePhysics");
 }
 
 //////////////////////////////////////////////////
@@ -749,6 +852,32 @@ void ODEPhysics::SetMaxContacts(unsigned int _maxContacts)
   this->sdf->GetElement("max_contacts")->GetValue()->Set(_maxContacts);
 }
 
+//////////////////////////////////////////////////
+void ODEPhysics::SetCollisionThreads(unsigned int _threads)
+{
+  boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+
+  sdf::ElementPtr odeElem = this->sdf->GetElement("ode");
+  if (odeElem->HasElement("collision_threads"))
+    odeElem->GetElement("collision_threads")->Set(_threads);
+
+  delete this->dataPtr->collisionArena;
+  this->dataPtr->collisionArena = NULL;
+  this->dataPtr->collisionThreads = _threads;
+
+  if (_threads > 1)
+  {
+    this->dataPtr->collisionArena =
+      new tbb::task_arena(static_cast<int>(_threads));
+  }
+}
+
+//////////////////////////////////////////////////
+unsigned int ODEPhysics::GetCollisionThreads() const
+{
+  return this->dataPtr->collisionThreads;
+}
+
 //////////////////////////////////////////////////
 void ODEPhysics::SetWorldStepSolverType(const std::string &_worldSolverType)
 {
@@ -902,6 +1031,8 @@ void ODEPhysics::SetStepType(const std::string &_type)
     this->dataPtr->physicsStepFunc = &dWorldQuickStep;
   else if (this->dataPtr->stepType == "world")
     this->dataPtr->physicsStepFunc = &dWorldStep;
+  else if (this->dataPtr->stepType == "parallel_quick")
+    this->dataPtr->physicsStepFunc = &dWorldParallelQuickStep;
   else
     gzerr << "Invalid step type[" << this->dataPtr->stepType
           << "]" << std::endl;
@@ -979,11 +1110,22 @@ void ODEPhysics::CollisionCallback(void *_data, dGeomID _o1, dGeomID _o2)
 //////////////////////////////////////////////////
 void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
                          dContactGeom *_contactCollisions)
+{
+  unsigned int numc = this->NarrowPhase(_collision1, _collision2,
+      _contactCollisions);
+
+  if (numc > 0)
+    this->AddContactJoints(_collision1, _collision2, _contactCollisions, numc);
+}
+
+//////////////////////////////////////////////////
+unsigned int ODEPhysics::NarrowPhase(ODECollision *_collision1,
+    ODECollision *_collision2, dContactGeom *_contactCollisions)
 {
   // Filter collisions based on collide bitmask.
   if ((_collision1->GetSurface()->collideBitmask &
         _collision2->GetSurface()->collideBitmask) == 0)
-    return;
+    return 0;
 
   // Filter collisions based on contact bitmask if collide_without_contact is
   // on.The bitmask is set mainly for speed improvements otherwise a collision
@@ -995,7 +1137,7 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
     if ((_collision1->GetSurface()->collideWithoutContactBitmask &
          _collision2->GetSurface()->collideWithoutContactBitmask) == 0)
     {
-      return;
+      return 0;
     }
   }
 
@@ -1012,9 +1154,8 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
   }*/
 
   unsigned int numc = 0;
-  dContact contact;
 
-  // maxCollide must less than the size of this->dataPtr->indices
+  // maxCollide must be less than MAX_CONTACT_JOINTS
   // Check the header
   unsigned int maxCollide = MAX_CONTACT_JOINTS;
 
@@ -1033,31 +1174,35 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
   numc = dCollide(_collision1->GetCollisionId(), _collision2->GetCollisionId(),
       MAX_COLLIDE_RETURNS, _contactCollisions, sizeof(_contactCollisions[0]));
 
-  // Return if no contacts.
-  if (numc == 0)
-    return;
-
-  // Store the indices of the contacts.
-  for (int i = 0; i < MAX_CONTACT_JOINTS; i++)
-    this->dataPtr->indices[i] = i;
-
   // Choose only the best contacts if too many were generated.
   if (numc > maxCollide)
   {
+    unsigned int deepest = maxCollide-1;
     double max = _contactCollisions[maxCollide-1].depth;
     for (unsigned int i = maxCollide; i < numc; ++i)
     {
       if (_contactCollisions[i].depth > max)
       {
         max = _contactCollisions[i].depth;
-        this->dataPtr->indices[maxCollide-1] = i;
+        deepest = i;
       }
     }
+    _contactCollisions[maxCollide-1] = _contactCollisions[deepest];
 
     // Make sure numc has the valid number of contacts.
     numc = maxCollide;
   }
 
+  return numc;
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::AddContactJoints(ODECollision *_collision1,
+    ODECollision *_collision2, const dContactGeom *_contacts,
+    unsigned int _count)
+{
+  dContact contact;
+
   // Set the contact surface parameter flags.
   contact.surface.mode = dContactBounce |
                          dContactMu2 |
@@ -1226,9 +1371,9 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
   }
 
   // Create a joint for each contact
-  for (unsigned int j = 0; j < numc; ++j)
+  for (unsigned int j = 0; j < _count; ++j)
   {
-    contact.geom = _contactCollisions[this->dataPtr->indices[j]];
+    contact.geom = _contacts[j];
 
     // Create the contact joint. This introduces the contact constraint to
     // ODE
@@ -1239,20 +1384,15 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
     if (contactFeedback && jointFeedback)
     {
       // Store the contact depth
-      contactFeedback->depths[j] =
-        _contactCollisions[this->dataPtr->indices[j]].depth;
+      contactFeedback->depths[j] = _contacts[j].depth;
 
       // Store the contact position
       contactFeedback->positions[j].Set(
-          _contactCollisions[this->dataPtr->indices[j]].pos[0],
-          _contactCollisions[this->dataPtr->indices[j]].pos[1],
-          _contactCollisions[this->dataPtr->indices[j]].pos[2]);
+          _contacts[j].pos[0], _contacts[j].pos[1], _contacts[j].pos[2]);
 
       // Store the contact normal
-      contactFeedback->normals[j].Set(
-          _contactCollisions[this->dataPtr->indices[j]].normal[0],
-          _contactCollisions[this->dataPtr->indices[j]].normal[1],
-          _contactCollisions[this->dataPtr->indices[j]].normal[2]);
+      contactFeedback->normals[j].Set(_contacts[j].normal[0],
+          _contacts[j].normal[1], _contacts[j].normal[2]);
 
       // Set the joint feedback.
       dJointSetFeedback(contactJoint, &(jointFeedback->feedbacks[j]));
@@ -1474,6 +1614,40 @@ bool ODEPhysics::SetParam(const std::string &_key, const boost::any &_value)
       dWorldSetQuickStepExtraFrictionIterations(this->dataPtr->worldId,
         boost::any_cast<int>(_value));
     }
+    else if (_key == "island_threads")
+    {
+      int value = boost::any_cast<int>(_value);
+
+      // The thread pool is replaced, so wait for the step using it.
+      boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+      if (odeElem->GetElement("solver")->HasElement("island_threads"))
+      {
+        odeElem->GetElement("solver")->GetElement("island_threads")->Set(
+            value);
+      }
+      dWorldSetIslandThreads(this->dataPtr->worldId, value);
+    }
+    else if (_key == "min_island_size")
+    {
+      int value = boost::any_cast<int>(_value);
+      boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+      if (odeElem->GetElement("solver")->HasElement("min_island_size"))
+      {
+        odeElem->GetElement("solver")->GetElement("min_island_size")->Set(
+            value);
+      }
+      dWorldSetMinIslandSize(this->dataPtr->worldId, value);
+    }
+    else if (_key == "collision_threads")
+    {
+      int value = boost::any_cast<int>(_value);
+      if (value < 0)
+      {
+        gzerr << "collision_threads must be non-negative" << std::endl;
+        return false;
+      }
+      this->SetCollisionThreads(static_cast<unsigned int>(value));
+    }
     else
     {
       return PhysicsEngine::SetParam(_key, _value);
@@ -1557,6 +1731,12 @@ bool ODEPhysics::GetParam(const std::string &_key, boost::any &_value) const
     _value = dWorldGetQuickStepWarmStartFactor(this->dataPtr->worldId);
   else if (_key == "extra_friction_iterations")
     _value = dWorldGetQuickStepExtraFrictionIterations(this->dataPtr->worldId);
+  else if (_key == "island_threads")
+    _value = dWorldGetIslandThreads(this->dataPtr->worldId);
+  else if (_key == "min_island_size")
+    _value = dWorldGetMinIslandSize(this->dataPtr->worldId);
+  else if (_key == "collision_threads")
+    _value = static_cast<int>(this->dataPtr->collisionThreads);
   else if (_key == "friction_model")
     _value = this->GetFrictionModel();
   else if (_key == "world_step_solver")
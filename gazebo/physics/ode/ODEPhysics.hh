@@ -21,6 +21,7 @@
 #include <tbb/concurrent_vector.h>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <boost/thread/thread.hpp>
 
@@ -266,12 +267,14 @@ namespace gazebo
       public: static World_Solver_Type
               ConvertWorldStepSolverType(const std::string &_solverType);
 
-      /// \brief Get the step type (quick, world).
+      /// \brief Get the step type (quick, world, parallel_quick).
       /// \return The step type.
       public: virtual std::string GetStepType() const;
 
-      /// \brief Set the step type (quick, world).
-      /// \param[in] _type The step type (quick or world).
+      /// \brief Set the step type (quick, world, parallel_quick).
+      /// "parallel_quick" uses the parallel_quickstep solver, which solves
+      /// batches of constraint rows that share no bodies on multiple threads.
+      /// \param[in] _type The step type (quick, world or parallel_quick).
       public: virtual void SetStepType(const std::string &_type);
 
 
@@ -282,6 +285,20 @@ namespace gazebo
       public: void Collide(ODECollision *_collision1, ODECollision *_collision2,
                            dContactGeom *_contactCollisions);
 
+      /// \brief Set the number of threads used by the narrow phase of
+      /// UpdateCollision. With two or more threads, dCollide runs
+      /// concurrently for all collision pairs and the contact joints are
+      /// created afterwards in the physics thread, in the same order as the
+      /// single threaded narrow phase.
+      /// \param[in] _threads Number of threads. Values less than 2 run the
+      /// narrow phase in the physics thread.
+      public: void SetCollisionThreads(unsigned int _threads);
+
+      /// \brief Get the number of threads used by the narrow phase.
+      /// \return Number of narrow phase threads.
+      /// \sa SetCollisionThreads
+      public: unsigned int GetCollisionThreads() const;
+
       /// \brief process joint feedbacks.
       /// \param[in] _feedback ODE Joint Contact feedback information.
       public: void ProcessJointFeedback(ODEJointFeedback *_feedback);
@@ -298,6 +315,48 @@ namespace gazebo
                                              dGeomID _o2);
 
 
+      /// \brief Generate contacts between two collision objects, without
+      /// creating contact joints. This function may be called concurrently
+      /// from multiple threads with different contact buffers.
+      /// \param[in] _collision1 First collision object.
+      /// \param[in] _collision2 Second collision object.
+      /// \param[out] _contactCollisions Array of MAX_COLLIDE_RETURNS contacts.
+      /// \return Number of contacts to keep, stored at the start of
+      /// _contactCollisions.
+      private: unsigned int NarrowPhase(ODECollision *_collision1,
+                   ODECollision *_collision2,
+                   dContactGeom *_contactCollisions);
+
+      /// \brief Create contact joints and contact manager entries for
+      /// contacts generated by NarrowPhase. Must be called from the physics
+      /// thread.
+      /// \param[in] _collision1 First collision object.
+      /// \param[in] _collision2 Second collision object.
+      /// \param[in] _contacts Contacts between the two collision objects.
+      /// \param[in] _count Number of elements in _contacts.
+      private: void AddContactJoints(ODECollision *_collision1,
+                   ODECollision *_collision2, const dContactGeom *_contacts,
+                   unsigned int _count);
+
+      /// \brief Multi-threaded version of the narrow phase.
+      /// \sa SetCollisionThreads
+      private: void CollideThreaded();
+
+      /// \brief Run NarrowPhase on a range of collision pairs, storing the
+      /// result of each pair in ODEPhysicsPrivate::narrowPhaseResults.
+      /// \param[in] _colliders Collision pairs.
+      /// \param[in] _resultOffset Index in narrowPhaseResults of the first
+      /// element of _colliders.
+      /// \param[in] _begin First result index to process.
+      /// \param[in] _end One past the last result index to process.
+      /// \param[in] _inPhysicsThread True when called from the physics
+      /// thread. Otherwise pairs that are unsafe to collide concurrently are
+      /// marked as deferred and skipped.
+      private: void NarrowPhaseRange(
+          const std::vector<std::pair<ODECollision*, ODECollision*> >
+          &_colliders, size_t _resultOffset, size_t _begin, size_t _end,
+          bool _inPhysicsThread);
+
       /// \brief Create a triangle mesh object collider.
       /// \param[in] _collision1 The first collision object.
       /// \param[in] _collision2 The second collision object.
@@ -18,6 +18,9 @@
 #ifndef _ODEPHYSICS_PRIVATE_HH_
 #define _ODEPHYSICS_PRIVATE_HH_
 
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/task_arena.h>
+
 #include <map>
 #include <string>
 #include <vector>
@@ -45,6 +48,41 @@ namespace gazebo
       public: dJointFeedback feedbacks[MAX_CONTACT_JOINTS];
     };
 
+    /// \brief Per thread scratch memory of the multi-threaded narrow phase.
+    class ODENarrowPhaseScratch
+    {
+      public: ODENarrowPhaseScratch() : odeDataAllocated(false) {}
+
+      /// \brief Output buffer for dCollide.
+      public: dContactGeom contactCollisions[MAX_COLLIDE_RETURNS];
+
+      /// \brief Contacts kept for all pairs processed by this thread.
+      public: std::vector<dContactGeom> contacts;
+
+      /// \brief True once ODE thread data has been allocated for this
+      /// thread.
+      public: bool odeDataAllocated;
+    };
+
+    /// \brief Result of the multi-threaded narrow phase for one pair.
+    class ODENarrowPhaseResult
+    {
+      public: ODENarrowPhaseResult()
+              : contacts(NULL), offset(0), count(0), deferred(false) {}
+
+      /// \brief Scratch buffer holding the contacts of this pair.
+      public: std::vector<dContactGeom> *contacts;
+
+      /// \brief Index of the first contact in the scratch buffer.
+      public: size_t offset;
+
+      /// \brief Number of contacts.
+      public: unsigned int count;
+
+      /// \brief True if this pair must be collided in the physics thread.
+      public: bool deferred;
+    };
+
     class ODEPhysicsPrivate
     {
       /// \brief Top-level world for all bodies
@@ -78,8 +116,20 @@ namespace gazebo
       /// \brief Array of contact collisions.
       public: dContactGeom contactCollisions[MAX_COLLIDE_RETURNS];
 
-      /// \brief Indices used during creation of contact joints.
-      public: int indices[MAX_CONTACT_JOINTS];
+      /// \brief Number of threads used by the narrow phase.
+      public: unsigned int collisionThreads;
+
+      /// \brief Thread pool for the narrow phase, NULL when the narrow
+      /// phase runs in the physics thread.
+      public: tbb::task_arena *collisionArena;
+
+      /// \brief Per thread narrow phase scratch memory.
+      public: tbb::enumerable_thread_specific<ODENarrowPhaseScratch>
+              narrowPhaseScratch;
+
+      /// \brief Narrow phase results, one per collision pair. Normal
+      /// colliders come first, followed by the trimesh colliders.
+      public: std::vector<ODENarrowPhaseResult> narrowPhaseResults;
 
       /// \brief Current index into the contactFeedbacks buffer
       public: unsigned int jointFeedbackIndex;
@@ -349,6 +349,131 @@ TEST_F(ODEPhysics_TEST, PhysicsMsgParam)
   PhysicsMsgParam();
 }
 
+/////////////////////////////////////////////////
+/// Test that the multi-threaded narrow phase gives the same result as the
+/// single threaded one.
+TEST_F(ODEPhysics_TEST, CollisionThreads)
+{
+  Load("worlds/stacks.world", true, "ode");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  ODEPhysicsPtr odePhysics = boost::static_pointer_cast<ODEPhysics>(
+      world->GetPhysicsEngine());
+  ASSERT_TRUE(odePhysics != NULL);
+  EXPECT_EQ(odePhysics->GetCollisionThreads(), 0u);
+
+  const unsigned int steps = 500;
+
+  // Single threaded reference
+  world->Step(steps);
+  std::vector<math::Pose> poses;
+  for (auto const &model : world->GetModels())
+    poses.push_back(model->GetWorldPose());
+  world->Reset();
+
+  EXPECT_TRUE(odePhysics->SetParam("collision_threads", 4));
+  EXPECT_EQ(boost::any_cast<int>(odePhysics->GetParam("collision_threads")),
+      4);
+  EXPECT_EQ(odePhysics->GetCollisionThreads(), 4u);
+  EXPECT_FALSE(odePhysics->SetParam("collision_threads", -1));
+
+  world->Step(steps);
+  physics::Model_V models = world->GetModels();
+  ASSERT_EQ(models.size(), poses.size());
+  for (unsigned int i = 0; i < models.size(); ++i)
+  {
+    math::Pose pose = models[i]->GetWorldPose();
+    EXPECT_NEAR(pose.pos.Distance(poses[i].pos), 0.0, 1e-6)
+      << models[i]->GetName();
+  }
+}
+
+/////////////////////////////////////////////////
+/// Test that stepping islands on a thread pool gives the same result as
+/// stepping them in the physics thread.
+TEST_F(ODEPhysics_TEST, IslandThreads)
+{
+  Load("worlds/shapes.world", true, "ode");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  PhysicsEnginePtr physics = world->GetPhysicsEngine();
+  ASSERT_TRUE(physics != NULL);
+  EXPECT_EQ(boost::any_cast<int>(physics->GetParam("island_threads")), 0);
+  EXPECT_EQ(boost::any_cast<int>(physics->GetParam("min_island_size")), 1);
+
+  const unsigned int steps = 500;
+
+  // Reference run in the physics thread
+  world->Step(steps);
+  std::vector<math::Pose> poses;
+  for (auto const &model : world->GetModels())
+    poses.push_back(model->GetWorldPose());
+
+  // Every island as a task of its own, then in batches of 2 bodies.
+  for (int minIslandSize = 1; minIslandSize <= 2; ++minIslandSize)
+  {
+    world->Reset();
+    EXPECT_TRUE(physics->SetParam("island_threads", 4));
+    EXPECT_TRUE(physics->SetParam("min_island_size", minIslandSize));
+    EXPECT_EQ(boost::any_cast<int>(physics->GetParam("island_threads")), 4);
+    EXPECT_EQ(boost::any_cast<int>(physics->GetParam("min_island_size")),
+        minIslandSize);
+
+    world->Step(steps);
+    physics::Model_V models = world->GetModels();
+    ASSERT_EQ(models.size(), poses.size());
+    for (unsigned int i = 0; i < models.size(); ++i)
+    {
+      EXPECT_NEAR(models[i]->GetWorldPose().pos.Distance(poses[i].pos),
+          0.0, 1e-6) << models[i]->GetName();
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+/// Test that the parallel_quick step type keeps stacked boxes at rest,
+/// close to where the serial quick step type leaves them.
+TEST_F(ODEPhysics_TEST, ParallelQuickStep)
+{
+  Load("worlds/stacks.world", true, "ode");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  ODEPhysicsPtr odePhysics = boost::static_pointer_cast<ODEPhysics>(
+      world->GetPhysicsEngine());
+  ASSERT_TRUE(odePhysics != NULL);
+  EXPECT_EQ(odePhysics->GetStepType(), "quick");
+
+  const unsigned int steps = 500;
+
+  // Serial quick step reference
+  world->Step(steps);
+  std::vector<math::Pose> poses;
+  for (auto const &model : world->GetModels())
+    poses.push_back(model->GetWorldPose());
+  world->Reset();
+
+  EXPECT_TRUE(odePhysics->SetParam("solver_type",
+      std::string("parallel_quick")));
+  EXPECT_EQ(odePhysics->GetStepType(), "parallel_quick");
+  EXPECT_EQ(boost::any_cast<std::string>(
+      odePhysics->GetParam("solver_type")), "parallel_quick");
+
+  // The parallel solver visits constraint rows in a different order, so
+  // only expect the stacks to settle in the same place.
+  world->Step(steps);
+  physics::Model_V models = world->GetModels();
+  ASSERT_EQ(models.size(), poses.size());
+  for (unsigned int i = 0; i < models.size(); ++i)
+  {
+    math::Pose pose = models[i]->GetWorldPose();
+    EXPECT_NEAR(pose.pos.Distance(poses[i].pos), 0.0, 1e-2)
+      << models[i]->GetName();
+  }
+}
+
 /////////////////////////////////////////////////
 /// Main
 int main(int argc, char **argv)
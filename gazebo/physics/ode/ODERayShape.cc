@@ -147,6 +147,12 @@ void ODERayShape::SetPoints(const math::Vector3 &_posStart,
                      this->globalStartPos.Distance(this->globalEndPos));
 }
 
+//////////////////////////////////////////////////
+dGeomID ODERayShape::GetODEId() const
+{
+  return this->geomId;
+}
+
 //////////////////////////////////////////////////
 void ODERayShape::UpdateCallback(void *_data, dGeomID _o1, dGeomID _o2)
 {
@@ -61,6 +61,10 @@ namespace gazebo
       public: virtual void SetPoints(const math::Vector3 &_posStart,
                                      const math::Vector3 &_posEnd);
 
+      /// \brief Get the ODE geom id of the ray.
+      /// \return The ODE geom id.
+      public: dGeomID GetODEId() const;
+
       /// \brief Ray-intersection callback.
       /// \param[in] _data Pointer to user data.
       /// \param[in] _o1 First geom to check for collisions.
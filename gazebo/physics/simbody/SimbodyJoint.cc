@@ -156,6 +156,14 @@ void SimbodyJoint::Reset()
   Joint::Reset();
 }
 
+//////////////////////////////////////////////////
+void SimbodyJoint::Fini()
+{
+  if (this->simbodyPhysics)
+    this->simbodyPhysics->InvalidatePoseSync();
+  Joint::Fini();
+}
+
 //////////////////////////////////////////////////
 void SimbodyJoint::CacheForceTorque()
 {
@@ -48,6 +48,9 @@ namespace gazebo
       // Documentation inherited.
       public: virtual void Reset();
 
+      // Documentation inherited.
+      public: virtual void Fini();
+
       // Documentation inherited.
       public: virtual LinkPtr GetJointLink(unsigned int _index) const;
 
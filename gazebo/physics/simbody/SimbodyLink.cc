@@ -113,6 +113,8 @@ void SimbodyLink::Init()
 void SimbodyLink::Fini()
 {
   event::Events::DisconnectWorldUpdateEnd(this->staticLinkConnection);
+  if (this->simbodyPhysics)
+    this->simbodyPhysics->InvalidatePoseSync();
   Link::Fini();
 }
 
@@ -15,6 +15,8 @@
  *
 */
 
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
 #include <string>
 
 #include "gazebo/physics/simbody/SimbodyTypes.hh"
@@ -85,6 +87,7 @@ SimbodyPhysics::SimbodyPhysics(WorldPtr _world)
       , contactStictionTransitionVelocity(0.0)
       , dynamicsWorld(NULL)
       , stepTimeDouble(0.0)
+      , poseSyncStale(true)
 {
   // Instantiate the Multibody System
   // Instantiate the Simbody Matter Subsystem
@@ -400,6 +403,86 @@ void SimbodyPhysics::InitModel(const physics::ModelPtr _model)
   }
 
   this->simbodyPhysicsInitialized = true;
+  this->InvalidatePoseSync();
+}
+
+//////////////////////////////////////////////////
+void SimbodyPhysics::InvalidatePoseSync()
+{
+  boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+  this->poseSyncStale = true;
+}
+
+//////////////////////////////////////////////////
+void SimbodyPhysics::BuildPoseSync()
+{
+  this->poseSyncLinks.clear();
+  this->poseSyncJoints.clear();
+
+  for (auto const &model : this->world->GetModels())
+  {
+    for (auto const &link : model->GetLinks())
+    {
+      SimbodyPoseSync sync;
+      sync.link = boost::static_pointer_cast<SimbodyLink>(link).get();
+      sync.changed = false;
+      sync.synced = false;
+      this->poseSyncLinks.push_back(sync);
+    }
+
+    for (auto const &joint : model->GetJoints())
+    {
+      this->poseSyncJoints.push_back(
+          boost::static_pointer_cast<SimbodyJoint>(joint).get());
+    }
+  }
+
+  this->poseSyncStale = false;
+}
+
+//////////////////////////////////////////////////
+void SimbodyPhysics::SyncPoses(const SimTK::State &_state)
+{
+  if (this->poseSyncStale)
+    this->BuildPoseSync();
+
+  // Reading the realized transforms doesn't modify the state, so links
+  // are copied concurrently, in chunks large enough to not pay for tasks
+  // in small worlds.
+  tbb::parallel_for(
+      tbb::blocked_range<size_t>(0, this->poseSyncLinks.size(), 128),
+      [&](const tbb::blocked_range<size_t> &_r)
+      {
+        for (size_t i = _r.begin(); i != _r.end(); ++i)
+        {
+          SimbodyPoseSync &sync = this->poseSyncLinks[i];
+          const SimTK::Transform &transform =
+            sync.link->masterMobod.getBodyTransform(_state);
+
+          sync.changed = !sync.synced ||
+            transform.p() != sync.transform.p() ||
+            transform.R() != sync.transform.R();
+          if (sync.changed)
+          {
+            sync.transform = transform;
+            sync.pose = SimbodyPhysics::Transform2Pose(transform);
+            sync.link->SetDirtyPose(sync.pose);
+            sync.synced = true;
+          }
+        }
+      });
+
+  // Only the links that moved update their world pose.
+  for (auto const &sync : this->poseSyncLinks)
+  {
+    if (sync.changed)
+      this->world->_AddDirty(sync.link);
+  }
+
+  // Realizing reaction forces modifies the state cache, so joints are
+  // done in this thread.
+  for (auto const &joint : this->poseSyncJoints)
+    joint->CacheForceTorque();
 }
 
 //////////////////////////////////////////////////
@@ -668,32 +751,7 @@ void SimbodyPhysics::UpdatePhysics()
   // this->lastUpdateTime = currTime;
 
   // pushing new entity pose into dirtyPoses for visualization
-  physics::Model_V models = this->world->GetModels();
-  for (physics::Model_V::iterator mi = models.begin();
-       mi != models.end(); ++mi)
-  {
-    physics::Link_V links = (*mi)->GetLinks();
-    for (physics::Link_V::iterator lx = links.begin();
-         lx != links.end(); ++lx)
-    {
-      physics::SimbodyLinkPtr simbodyLink =
-        boost::dynamic_pointer_cast<physics::SimbodyLink>(*lx);
-      math::Pose pose = SimbodyPhysics::Transform2Pose(
-        simbodyLink->masterMobod.getBodyTransform(s));
-      simbodyLink->SetDirtyPose(pose);
-      this->world->dataPtr->dirtyPoses.push_back(
-        boost::static_pointer_cast<Entity>(*lx).get());
-    }
-
-    physics::Joint_V joints = (*mi)->GetJoints();
-    for (physics::Joint_V::iterator jx = joints.begin();
-         jx != joints.end(); ++jx)
-    {
-      SimbodyJointPtr simbodyJoint =
-        boost::dynamic_pointer_cast<physics::SimbodyJoint>(*jx);
-      simbodyJoint->CacheForceTorque();
-    }
-  }
+  this->SyncPoses(s);
 
   // FIXME:  this needs to happen before forces are applied for the next step
   // FIXME:  but after we've gotten everything from current state
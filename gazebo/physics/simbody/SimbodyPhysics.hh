@@ -18,6 +18,7 @@
 #ifndef _SIMBODY_PHYSICS_HH
 #define _SIMBODY_PHYSICS_HH
 #include <string>
+#include <vector>
 
 #include <boost/thread/thread.hpp>
 #include <boost/thread/mutex.hpp>
@@ -38,6 +39,28 @@ namespace gazebo
     /// \addtogroup gazebo_physics_simbody Simbody Physics
     /// \{
 
+    class SimbodyJoint;
+
+    /// \brief A link whose pose is copied from its mobilized body after
+    /// each step.
+    class SimbodyPoseSync
+    {
+      /// \brief The link.
+      public: SimbodyLink *link;
+
+      /// \brief Body transform copied by the previous step.
+      public: SimTK::Transform transform;
+
+      /// \brief Pose of the transform.
+      public: math::Pose pose;
+
+      /// \brief True if the transform changed in the current step.
+      public: bool changed;
+
+      /// \brief True once the transform has been copied.
+      public: bool synced;
+    };
+
     /// \brief Simbody physics engine
     class GZ_PHYSICS_VISIBLE SimbodyPhysics : public PhysicsEngine
     {
@@ -60,6 +83,11 @@ namespace gazebo
       /// \param[in] _model Pointer to the model to add into Simbody.
       public: void InitModel(const physics::ModelPtr _model);
 
+      /// \brief Rebuild the list of links and joints synced after each
+      /// step before the next sync. Called when links or joints are
+      /// added or removed.
+      public: void InvalidatePoseSync();
+
       // Documentation inherited
       public: virtual void InitForThread();
 
@@ -197,6 +225,15 @@ namespace gazebo
         const SimTK::MultibodyGraphMaker &_mbgraph,
         const physics::ModelPtr _model);
 
+      /// \brief Rebuild the list of links and joints synced after each
+      /// step, from the models of the world.
+      private: void BuildPoseSync();
+
+      /// \brief Copy the body transforms to the links that moved, and
+      /// cache the joint reaction forces.
+      /// \param[in] _state State of the last step.
+      private: void SyncPoses(const SimTK::State &_state);
+
       /// \brief helper function for building SimbodySystem
       private: void AddCollisionsToLink(const physics::SimbodyLink *_link,
         SimTK::MobilizedBody &_mobod, SimTK::ContactCliqueId _modelClique);
@@ -276,6 +313,15 @@ namespace gazebo
       ///   SimTK::RungeKutta2Integrator(system)
       ///   SimTK::SemiExplicitEuler2Integrator(system)
       private: std::string integratorType;
+
+      /// \brief Links whose pose is copied after each step.
+      private: std::vector<SimbodyPoseSync> poseSyncLinks;
+
+      /// \brief Joints whose reaction forces are cached after each step.
+      private: std::vector<SimbodyJoint *> poseSyncJoints;
+
+      /// \brief True if poseSyncLinks and poseSyncJoints must be rebuilt.
+      private: bool poseSyncStale;
     };
   /// \}
   }
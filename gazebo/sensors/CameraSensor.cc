@@ -20,6 +20,9 @@
   #include <Winsock2.h>
 #endif
 
+#include <algorithm>
+#include <string>
+
 #include <boost/algorithm/string.hpp>
 #include <boost/bind.hpp>
 
@@ -52,6 +55,9 @@ CameraSensor::CameraSensor()
     : Sensor(sensors::IMAGE)
 {
   this->rendered = false;
+  this->compression = msgs::Image::NONE;
+  this->compressionQuality = 90;
+  this->encoding = false;
   this->connections.push_back(
       event::Events::ConnectRender(
         boost::bind(&CameraSensor::Render, this)));
@@ -60,6 +66,7 @@ CameraSensor::CameraSensor()
 //////////////////////////////////////////////////
 CameraSensor::~CameraSensor()
 {
+  this->encoders.wait();
 }
 
 //////////////////////////////////////////////////
@@ -84,6 +91,41 @@ void CameraSensor::Load(const std::string &_worldName)
   Sensor::Load(_worldName);
   this->imagePub = this->node->Advertise<msgs::ImageStamped>(
       this->GetTopic(), 50);
+
+  // Optional compression of the published images, for example:
+  // <compression><format>jpeg</format><quality>80</quality></compression>
+  sdf::ElementPtr cameraElem = this->sdf->GetElement("camera");
+  if (cameraElem->HasElement("compression"))
+  {
+    sdf::ElementPtr compressionElem = cameraElem->GetElement("compression");
+    this->SetCompression(compressionElem->Get<std::string>("format"),
+        compressionElem->Get<int>("quality"));
+  }
+}
+
+//////////////////////////////////////////////////
+bool CameraSensor::SetCompression(const std::string &_format,
+    const int _quality)
+{
+  std::string format = boost::to_lower_copy(_format);
+
+  this->compressionQuality = std::max(1, std::min(_quality, 100));
+  if (format == "png")
+    this->compression = msgs::Image::PNG;
+  else if (format == "jpeg" || format == "jpg")
+    this->compression = msgs::Image::JPEG;
+  else
+  {
+    this->compression = msgs::Image::NONE;
+    if (format != "none")
+    {
+      gzerr << "Unknown image compression[" << _format << "] for camera["
+            << this->GetScopedName() << "], images will not be compressed\n";
+      return false;
+    }
+  }
+
+  return true;
 }
 
 //////////////////////////////////////////////////
@@ -135,6 +177,23 @@ void CameraSensor::Init()
 
     this->camera->Init();
     this->camera->CreateRenderTexture(this->GetName() + "_RttTex");
+
+    // Make sure the pixel format can be compressed.
+    if (this->compression != msgs::Image::NONE)
+    {
+      unsigned char pixel[4] = {0, 0, 0, 0};
+      std::string encoded;
+      if (!common::Image::Encode(pixel, 1, 1,
+            common::Image::ConvertPixelFormat(this->camera->GetImageFormat()),
+            common::Image::PNG_CODEC, this->compressionQuality.load(),
+            encoded))
+      {
+        gzwarn << "Images of camera[" << this->GetScopedName() << "] with "
+               << "format[" << this->camera->GetImageFormat() << "] can't be "
+               << "compressed, publishing raw images.\n";
+        this->compression = msgs::Image::NONE;
+      }
+    }
     ignition::math::Pose3d cameraPose = this->pose;
     if (cameraSdf->HasElement("pose"))
       cameraPose = cameraSdf->Get<ignition::math::Pose3d>("pose") + cameraPose;
@@ -165,6 +224,9 @@ void CameraSensor::Init()
 //////////////////////////////////////////////////
 void CameraSensor::Fini()
 {
+  // Wait for the last compressed image to be published.
+  this->encoders.wait();
+
   this->imagePub.reset();
   Sensor::Fini();
 
@@ -198,28 +260,63 @@ bool CameraSensor::UpdateImpl(bool /*_force*/)
 
   this->camera->PostRender();
 
-  if (this->imagePub && this->imagePub->HasConnections())
+  // Skip the frame if the previous one is still being compressed.
+  msgs::Image::Compression frameCompression = this->compression;
+  if (this->imagePub && this->imagePub->HasConnections() &&
+      !(frameCompression != msgs::Image::NONE && this->encoding))
   {
-    msgs::ImageStamped msg;
-    msgs::Set(msg.mutable_time(), this->scene->GetSimTime());
-    msg.mutable_image()->set_width(this->camera->GetImageWidth());
-    msg.mutable_image()->set_height(this->camera->GetImageHeight());
-    msg.mutable_image()->set_pixel_format(common::Image::ConvertPixelFormat(
-          this->camera->GetImageFormat()));
-
-    msg.mutable_image()->set_step(this->camera->GetImageWidth() *
+    boost::shared_ptr<msgs::ImageStamped> msg(new msgs::ImageStamped);
+    msgs::Set(msg->mutable_time(), this->scene->GetSimTime());
+    msg->mutable_image()->set_width(this->camera->GetImageWidth());
+    msg->mutable_image()->set_height(this->camera->GetImageHeight());
+    msg->mutable_image()->set_pixel_format(
+        common::Image::ConvertPixelFormat(this->camera->GetImageFormat()));
+
+    msg->mutable_image()->set_step(this->camera->GetImageWidth() *
         this->camera->GetImageDepth());
-    msg.mutable_image()->set_data(this->camera->GetImageData(),
-        msg.image().width() * this->camera->GetImageDepth() *
-        msg.image().height());
+    msg->mutable_image()->set_data(this->camera->GetImageData(),
+        msg->image().width() * this->camera->GetImageDepth() *
+        msg->image().height());
 
-    this->imagePub->Publish(msg);
+    if (frameCompression == msgs::Image::NONE)
+      this->imagePub->Publish(*msg);
+    else
+    {
+      // The camera reuses its buffer for the next frame, so the raw data
+      // was copied above, and is compressed on a worker thread.
+      this->encoding = true;
+      this->encoders.run(boost::bind(&CameraSensor::EncodeAndPublish, this,
+            msg, frameCompression, this->compressionQuality.load()));
+    }
   }
 
   this->rendered = false;
   return true;
 }
 
+//////////////////////////////////////////////////
+void CameraSensor::EncodeAndPublish(
+    boost::shared_ptr<msgs::ImageStamped> _msg,
+    const msgs::Image::Compression _compression, const int _quality)
+{
+  msgs::Image *image = _msg->mutable_image();
+
+  std::string encoded;
+  if (common::Image::Encode(
+        reinterpret_cast<const unsigned char *>(image->data().data()),
+        image->width(), image->height(),
+        static_cast<common::Image::PixelFormat>(image->pixel_format()),
+        _compression == msgs::Image::JPEG ? common::Image::JPEG_CODEC :
+        common::Image::PNG_CODEC, _quality, encoded))
+  {
+    image->mutable_data()->swap(encoded);
+    image->set_compression(_compression);
+  }
+
+  this->imagePub->Publish(*_msg);
+  this->encoding = false;
+}
+
 //////////////////////////////////////////////////
 unsigned int CameraSensor::GetImageWidth() const
 {
@@ -17,6 +17,8 @@
 #ifndef _GAZEBO_CAMERASENSOR_HH_
 #define _GAZEBO_CAMERASENSOR_HH_
 
+#include <tbb/task_group.h>
+#include <atomic>
 #include <string>
 
 #include "gazebo/sensors/Sensor.hh"
@@ -93,9 +95,27 @@ namespace gazebo
       // Documentation inherited
       public: virtual bool IsActive();
 
+      /// \brief Set the compression of the published images. Images are
+      /// compressed off the render thread.
+      /// \param[in] _format Image format: "none", "png" or "jpeg".
+      /// \param[in] _quality JPEG quality, from 1 to 100.
+      /// \return False if the format is unknown, in which case the images
+      /// are not compressed.
+      public: bool SetCompression(const std::string &_format,
+                  const int _quality = 90);
+
       /// \brief Handle the render event.
       private: void Render();
 
+      /// \brief Compress an image and publish it. Runs on a worker thread.
+      /// \param[in] _msg Image message with raw data.
+      /// \param[in] _compression Compression of the image.
+      /// \param[in] _quality JPEG quality, from 1 to 100.
+      private: void EncodeAndPublish(
+                   boost::shared_ptr<msgs::ImageStamped> _msg,
+                   const msgs::Image::Compression _compression,
+                   const int _quality);
+
       /// \brief Pointer to the camera.
       private: rendering::CameraPtr camera;
 
@@ -104,6 +124,19 @@ namespace gazebo
 
       /// \brief True if the sensor was rendered.
       private: bool rendered;
+
+      /// \brief Compression of the published images.
+      private: std::atomic<msgs::Image::Compression> compression;
+
+      /// \brief JPEG quality of the published images, from 1 to 100.
+      private: std::atomic_int compressionQuality;
+
+      /// \brief True while an image is compressed. Frames rendered in the
+      /// meantime are not published, which keeps images in order.
+      private: std::atomic_bool encoding;
+
+      /// \brief Compresses images off the render thread.
+      private: tbb::task_group encoders;
     };
     /// \}
   }
@@ -20,11 +20,16 @@
   #include <Winsock2.h>
 #endif
 
+#include <algorithm>
+#include <cmath>
+#include <string>
+
 #include <ignition/math/Helpers.hh>
 #include <ignition/math/Rand.hh>
 
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
+#include "gazebo/math/Rand.hh"
 #include "gazebo/rendering/ogre_gazebo.h"
 #include "gazebo/rendering/Camera.hh"
 #include "gazebo/sensors/GaussianNoiseModel.hh"
@@ -84,6 +89,25 @@ namespace gazebo
 using namespace gazebo;
 using namespace sensors;
 
+/// \brief Number of samples generated at a time by ApplyBatchImpl. Must
+/// be even.
+static const size_t BatchBlockSize = 256;
+
+//////////////////////////////////////////////////
+/// \brief Counter-based random number generator. Returns the random number
+/// at a position of a stream, using the SplitMix64 mixing function.
+/// \param[in] _key Key of the stream.
+/// \param[in] _counter Position in the stream.
+/// \return Random 64 bit value.
+static inline uint64_t StreamValue(const uint64_t _key,
+    const uint64_t _counter)
+{
+  uint64_t z = _key + (_counter + 1) * 0x9E3779B97F4A7C15ULL;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
 //////////////////////////////////////////////////
 GaussianNoiseModel::GaussianNoiseModel()
   : Noise(Noise::GAUSSIAN),
@@ -91,8 +115,13 @@ GaussianNoiseModel::GaussianNoiseModel()
     stdDev(0.0),
     bias(0.0),
     precision(0.0),
-    quantized(false)
+    quantized(false),
+    streamId(0),
+    streamKey(0),
+    streamCounter(0),
+    streamGeneration(0)
 {
+  this->RestartStream();
 }
 
 //////////////////////////////////////////////////
@@ -163,6 +192,83 @@ double GaussianNoiseModel::ApplyImpl(double _in)
   return output;
 }
 
+//////////////////////////////////////////////////
+void GaussianNoiseModel::ApplyBatchImpl(double *_values, const size_t _count)
+{
+  // Restart the stream every time the seed is set, so that the noise only
+  // depends on the seed and the stream name.
+  if (math::Rand::GetSeedGeneration() != this->streamGeneration)
+    this->RestartStream();
+
+  double u1[BatchBlockSize / 2];
+  double u2[BatchBlockSize / 2];
+  double noise[BatchBlockSize];
+  const double offset = this->bias + this->mean;
+
+  for (size_t start = 0; start < _count; start += BatchBlockSize)
+  {
+    size_t n = std::min(BatchBlockSize, _count - start);
+    size_t pairs = (n + 1) / 2;
+
+    // Uniform samples in (0, 1]. Each one only depends on its position in
+    // the stream, so this loop has no dependency between iterations.
+    for (size_t i = 0; i < pairs; ++i)
+    {
+      uint64_t c = this->streamCounter + 2 * i;
+      u1[i] = ((StreamValue(this->streamKey, c) >> 11) + 1) *
+        (1.0 / 9007199254740992.0);
+      u2[i] = ((StreamValue(this->streamKey, c + 1) >> 11) + 1) *
+        (1.0 / 9007199254740992.0);
+    }
+    this->streamCounter += 2 * pairs;
+
+    // Box-Muller transform, two normal samples per pair of uniform samples
+    for (size_t i = 0; i < pairs; ++i)
+    {
+      double r = std::sqrt(-2.0 * std::log(u1[i]));
+      double theta = 2.0 * M_PI * u2[i];
+      noise[2 * i] = r * std::cos(theta);
+      noise[2 * i + 1] = r * std::sin(theta);
+    }
+
+    double *values = _values + start;
+    for (size_t i = 0; i < n; ++i)
+      values[i] += offset + this->stdDev * noise[i];
+
+    if (this->quantized)
+    {
+      // Apply this->precision
+      for (size_t i = 0; i < n; ++i)
+        values[i] = std::round(values[i] / this->precision) * this->precision;
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void GaussianNoiseModel::SetStreamName(const std::string &_name)
+{
+  // 64 bit FNV-1a hash, which doesn't depend on the standard library
+  this->streamId = 14695981039346656037ULL;
+  for (auto const c : _name)
+  {
+    this->streamId ^= static_cast<unsigned char>(c);
+    this->streamId *= 1099511628211ULL;
+  }
+
+  this->RestartStream();
+}
+
+//////////////////////////////////////////////////
+void GaussianNoiseModel::RestartStream()
+{
+  // Read the generation first, SetSeed changes it after the seed.
+  this->streamGeneration = math::Rand::GetSeedGeneration();
+  this->streamKey = StreamValue(
+      (static_cast<uint64_t>(math::Rand::GetSeed()) << 32) ^ this->streamId,
+      0);
+  this->streamCounter = 0;
+}
+
 //////////////////////////////////////////////////
 double GaussianNoiseModel::GetMean() const
 {
@@ -18,6 +18,7 @@
 #ifndef _GAZEBO_GAUSSIAN_NOISE_MODEL_HH_
 #define _GAZEBO_GAUSSIAN_NOISE_MODEL_HH_
 
+#include <stdint.h>
 #include <vector>
 #include <string>
 
@@ -57,6 +58,26 @@ namespace gazebo
         // Documentation inherited.
         public: double ApplyImpl(double _in);
 
+        /// \brief Apply noise to an array of input data values, in place.
+        /// The noise is drawn from a random number stream that belongs to
+        /// this noise model, instead of the shared generator used by
+        /// ApplyImpl. The stream restarts every time math::Rand::SetSeed is
+        /// called, so a given seed and stream name reproduce the same noise.
+        /// \sa SetStreamName
+        /// \param[in,out] _values Input data values, replaced by the data
+        /// with noise applied.
+        /// \param[in] _count Number of values.
+        public: virtual void ApplyBatchImpl(double *_values,
+                    const size_t _count);
+
+        /// \brief Set the identity of the random number stream used by
+        /// ApplyBatchImpl, and restart the stream. Noise models with the
+        /// same name and seed produce the same noise. Sensors name the
+        /// stream of each of their noise models after their scoped name and
+        /// the noise type. The name is empty by default.
+        /// \param[in] _name Name of the stream.
+        public: void SetStreamName(const std::string &_name);
+
         /// \brief Accessor for mean.
         /// \return Mean of Gaussian noise.
         public: double GetMean() const;
@@ -89,6 +110,22 @@ namespace gazebo
 
         /// \brief True if the type is GAUSSIAN_QUANTIZED
         protected: bool quantized;
+
+        /// \brief Restart the random number stream from the current seed.
+        private: void RestartStream();
+
+        /// \brief Hash of the stream name.
+        private: uint64_t streamId;
+
+        /// \brief Key of the random number stream used by ApplyBatchImpl.
+        private: uint64_t streamKey;
+
+        /// \brief Position of the next random number in the stream.
+        private: uint64_t streamCounter;
+
+        /// \brief Seed generation the stream was started with.
+        /// \sa math::Rand::GetSeedGeneration
+        private: uint32_t streamGeneration;
     };
 
     /// \class GaussianNoiseModel
@@ -20,6 +20,7 @@
   #include <Winsock2.h>
 #endif
 
+#include <vector>
 #include <boost/algorithm/string.hpp>
 #include <boost/bind.hpp>
 #include <boost/function.hpp>
@@ -611,6 +612,10 @@ bool GpuRaySensor::UpdateImpl(bool /*_force*/)
 
   bool add = scan->ranges_size() == 0;
 
+  auto noise = this->noises.find(GPU_RAY_NOISE);
+  std::vector<int> indices;
+  std::vector<double> ranges;
+
   // todo: add loop for vertical range count
   for (int j = 0; j < this->GetVerticalRayCount(); ++j)
   {
@@ -628,14 +633,16 @@ bool GpuRaySensor::UpdateImpl(bool /*_force*/)
       {
         range = -GZ_DBL_INF;
       }
-      else if (this->noises.find(GPU_RAY_NOISE) != this->noises.end())
+      else if (ignition::math::isnan(range))
       {
-        range = this->noises[GPU_RAY_NOISE]->Apply(range);
-        range = ignition::math::clamp(range,
-            this->GetRangeMin(), this->GetRangeMax());
+        range = this->GetRangeMax();
+      }
+      else if (noise != this->noises.end())
+      {
+        // Noise is applied below, to all the ranges at once
+        indices.push_back(index);
+        ranges.push_back(range);
       }
-
-      range = ignition::math::isnan(range) ? this->GetRangeMax() : range;
 
       if (add)
       {
@@ -651,6 +658,17 @@ bool GpuRaySensor::UpdateImpl(bool /*_force*/)
     }
   }
 
+  if (noise != this->noises.end())
+  {
+    noise->second->ApplyBatch(ranges.data(), ranges.size());
+
+    for (size_t i = 0; i < indices.size(); ++i)
+    {
+      scan->set_ranges(indices[i], ignition::math::clamp(ranges[i],
+            this->GetRangeMin(), this->GetRangeMax()));
+    }
+  }
+
   if (this->scanPub && this->scanPub->HasConnections())
     this->scanPub->Publish(this->laserMsg);
 
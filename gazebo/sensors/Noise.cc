@@ -129,6 +129,36 @@ double Noise::ApplyImpl(double _in)
   return _in;
 }
 
+//////////////////////////////////////////////////
+void Noise::ApplyBatch(double *_values, const size_t _count)
+{
+  if (this->type == NONE)
+    return;
+  else if (this->type == CUSTOM)
+  {
+    if (this->customNoiseCallback)
+    {
+      for (size_t i = 0; i < _count; ++i)
+        _values[i] = this->customNoiseCallback(_values[i]);
+    }
+    else
+    {
+      gzerr << "Custom noise callback function not set!"
+          << " Please call SetCustomNoiseCallback within a sensor plugin."
+          << std::endl;
+    }
+  }
+  else
+    this->ApplyBatchImpl(_values, _count);
+}
+
+//////////////////////////////////////////////////
+void Noise::ApplyBatchImpl(double *_values, const size_t _count)
+{
+  for (size_t i = 0; i < _count; ++i)
+    _values[i] = this->ApplyImpl(_values[i]);
+}
+
 //////////////////////////////////////////////////
 Noise::NoiseType Noise::GetNoiseType() const
 {
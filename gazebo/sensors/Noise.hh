@@ -88,6 +88,22 @@ namespace gazebo
       /// \return Data with noise applied.
       public: virtual double ApplyImpl(double _in);
 
+      /// \brief Apply noise to an array of input data values, in place.
+      /// This is faster than calling Apply for each value.
+      /// \param[in,out] _values Input data values, replaced by the data
+      /// with noise applied.
+      /// \param[in] _count Number of values.
+      public: void ApplyBatch(double *_values, const size_t _count);
+
+      /// \brief Apply noise to an array of input data values, in place.
+      /// This gets overriden by derived classes, and called by ApplyBatch.
+      /// The default implementation calls ApplyImpl for each value.
+      /// \param[in,out] _values Input data values, replaced by the data
+      /// with noise applied.
+      /// \param[in] _count Number of values.
+      public: virtual void ApplyBatchImpl(double *_values,
+                  const size_t _count);
+
       /// \brief Finalize the noise model
       public: virtual void Fini();
 
@@ -16,6 +16,8 @@
 */
 
 #include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
 
 #include <boost/accumulators/accumulators.hpp>
 #include <boost/accumulators/statistics/stats.hpp>
@@ -25,6 +27,7 @@
 
 #include <ignition/math/Rand.hh>
 
+#include "gazebo/math/Rand.hh"
 #include "gazebo/sensors/Noise.hh"
 #include "gazebo/sensors/GaussianNoiseModel.hh"
 #include "test/util.hh"
@@ -240,6 +243,136 @@ TEST_F(NoiseTest, ApplyGaussian)
   }
 }
 
+//////////////////////////////////////////////////
+// Test batched noise application
+TEST_F(NoiseTest, ApplyGaussianBatch)
+{
+  double mean = 10.0;
+  double stddev = 5.0;
+  std::vector<double> values(g_applyCount * 10, 42.0);
+
+  sensors::NoisePtr noise = sensors::NoiseFactory::NewNoiseModel(
+      NoiseSdf("gaussian", mean, stddev, 0.0, 0.0, 0));
+  noise->ApplyBatch(values.data(), values.size());
+
+  boost::accumulators::accumulator_set<double,
+    boost::accumulators::stats<boost::accumulators::tag::mean,
+                               boost::accumulators::tag::variance > > acc;
+  for (auto const value : values)
+    acc(value - 42.0);
+
+  // See comments in GaussianNoise function to explain these calculations.
+  double sampleStdDev = g_sigma*stddev / sqrt(values.size());
+  EXPECT_NEAR(boost::accumulators::mean(acc), mean, sampleStdDev);
+
+  double variance = stddev*stddev;
+  double sampleVariance2 = 2 * variance*variance / (values.size() - 1);
+  EXPECT_NEAR(boost::accumulators::variance(acc),
+              variance, g_sigma*sqrt(sampleVariance2));
+
+  // An odd count, and an empty batch
+  std::vector<double> odd(3, 0.0);
+  noise->ApplyBatch(odd.data(), odd.size());
+  EXPECT_NE(odd[0], odd[1]);
+  EXPECT_NE(odd[1], odd[2]);
+  noise->ApplyBatch(NULL, 0);
+
+  // A NONE noise model does not change the values
+  sensors::NoisePtr none = sensors::NoiseFactory::NewNoiseModel(
+      NoiseSdf("none", 0, 0, 0, 0, 0));
+  std::vector<double> noNoise(g_applyCount, 1.0);
+  none->ApplyBatch(noNoise.data(), noNoise.size());
+  for (auto const value : noNoise)
+    EXPECT_DOUBLE_EQ(value, 1.0);
+}
+
+//////////////////////////////////////////////////
+// Batched noise is reproducible with the same seed
+TEST_F(NoiseTest, ApplyGaussianBatchSeed)
+{
+  uint32_t seed = math::Rand::GetSeed();
+
+  sensors::GaussianNoiseModelPtr noise =
+    boost::dynamic_pointer_cast<sensors::GaussianNoiseModel>(
+        sensors::NoiseFactory::NewNoiseModel(
+          NoiseSdf("gaussian", 0.0, 1.0, 0.0, 0.0, 0)));
+  ASSERT_TRUE(noise != NULL);
+  sensors::GaussianNoiseModelPtr noise2 =
+    boost::dynamic_pointer_cast<sensors::GaussianNoiseModel>(
+        sensors::NoiseFactory::NewNoiseModel(
+          NoiseSdf("gaussian", 0.0, 1.0, 0.0, 0.0, 0)));
+  ASSERT_TRUE(noise2 != NULL);
+  noise->SetStreamName("sensor::1");
+  noise2->SetStreamName("sensor::2");
+
+  math::Rand::SetSeed(1234);
+  std::vector<double> first(g_applyCount, 0.0);
+  noise->ApplyBatch(first.data(), first.size());
+
+  // Each stream name has its own stream
+  std::vector<double> other(g_applyCount, 0.0);
+  noise2->ApplyBatch(other.data(), other.size());
+  EXPECT_NE(first, other);
+
+  // The stream continues on the next call
+  std::vector<double> second(g_applyCount, 0.0);
+  noise->ApplyBatch(second.data(), second.size());
+  EXPECT_NE(first, second);
+
+  // Setting the same seed again restarts the stream
+  math::Rand::SetSeed(1234);
+  std::vector<double> third(g_applyCount, 0.0);
+  noise->ApplyBatch(third.data(), third.size());
+  EXPECT_EQ(first, third);
+
+  // A noise model created later with the same name has the same stream
+  sensors::GaussianNoiseModelPtr noise3 =
+    boost::dynamic_pointer_cast<sensors::GaussianNoiseModel>(
+        sensors::NoiseFactory::NewNoiseModel(
+          NoiseSdf("gaussian", 0.0, 1.0, 0.0, 0.0, 0)));
+  ASSERT_TRUE(noise3 != NULL);
+  noise3->SetStreamName("sensor::1");
+  std::vector<double> same(g_applyCount, 0.0);
+  noise3->ApplyBatch(same.data(), same.size());
+  EXPECT_EQ(first, same);
+
+  // Another seed gives another stream
+  math::Rand::SetSeed(4321);
+  std::vector<double> fourth(g_applyCount, 0.0);
+  noise->ApplyBatch(fourth.data(), fourth.size());
+  EXPECT_NE(first, fourth);
+
+  math::Rand::SetSeed(seed);
+}
+
+//////////////////////////////////////////////////
+// Batched noise is rounded to the precision
+TEST_F(NoiseTest, ApplyGaussianBatchQuantized)
+{
+  double mean = 1.0;
+  double stddev = 2.0;
+  double precision = 0.3;
+  std::vector<double> values(g_applyCount * 10, 42.0);
+
+  sensors::NoisePtr noise = sensors::NoiseFactory::NewNoiseModel(
+      NoiseSdf("gaussian", mean, stddev, 0.0, 0.0, precision));
+  noise->ApplyBatch(values.data(), values.size());
+
+  boost::accumulators::accumulator_set<double,
+    boost::accumulators::stats<boost::accumulators::tag::mean> > acc;
+  for (auto const value : values)
+  {
+    double steps = value / precision;
+    EXPECT_NEAR(steps, std::round(steps), 1e-6);
+    acc(value - 42.0);
+  }
+
+  // Rounding adds at most half the precision to the mean
+  double sampleStdDev = g_sigma*stddev / sqrt(values.size());
+  EXPECT_NEAR(boost::accumulators::mean(acc), mean,
+      sampleStdDev + precision / 2);
+}
+
 TEST_F(NoiseTest, ApplyGaussianQuantized)
 {
   double mean, stddev, biasMean, biasStddev, precision;
@@ -371,6 +504,11 @@ TEST_F(NoiseTest, OnApplyNoise)
     double value = noise->Apply(i);
     EXPECT_DOUBLE_EQ(value, i*2);
   }
+
+  std::vector<double> values(100, 3.0);
+  noise->ApplyBatch(values.data(), values.size());
+  for (auto const value : values)
+    EXPECT_DOUBLE_EQ(value, 6.0);
 }
 
 /////////////////////////////////////////////////
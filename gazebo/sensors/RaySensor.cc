@@ -20,6 +20,9 @@
   #include <Winsock2.h>
 #endif
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
 #include <boost/algorithm/string.hpp>
 
 #include "gazebo/physics/World.hh"
@@ -373,36 +376,22 @@ bool RaySensor::UpdateImpl(bool /*_force*/)
   this->laserShape->Update();
   this->lastMeasurementTime = this->world->GetSimTime();
 
-  // moving this behind laserShape update
-  boost::mutex::scoped_lock lock(this->mutex);
-
-  msgs::Set(this->laserMsg.mutable_time(), this->lastMeasurementTime);
-
-  msgs::LaserScan *scan = this->laserMsg.mutable_scan();
-
-  // Store the latest laser scans into laserMsg
-  msgs::Set(scan->mutable_world_pose(),
-            this->pose + this->parentEntity->GetWorldPose().Ign());
-  scan->set_angle_min(this->AngleMin().Radian());
-  scan->set_angle_max(this->AngleMax().Radian());
-  scan->set_angle_step(this->GetAngleResolution());
-  scan->set_count(this->GetRangeCount());
-
-  scan->set_vertical_angle_min(this->VerticalAngleMin().Radian());
-  scan->set_vertical_angle_max(this->VerticalAngleMax().Radian());
-  scan->set_vertical_angle_step(this->GetVerticalAngleResolution());
-  scan->set_vertical_count(this->GetVerticalRangeCount());
-
-  scan->set_range_min(this->GetRangeMin());
-  scan->set_range_max(this->GetRangeMax());
-
-  scan->clear_ranges();
-  scan->clear_intensities();
-
   unsigned int rayCount = this->GetRayCount();
   unsigned int rangeCount = this->GetRangeCount();
   unsigned int verticalRayCount = this->GetVerticalRayCount();
   unsigned int verticalRangeCount = this->GetVerticalRangeCount();
+  double rangeMin = this->GetRangeMin();
+  double rangeMax = this->GetRangeMax();
+
+  // Read all the rays at once, and compute the scan without holding the
+  // sensor mutex
+  std::vector<double> rayRanges;
+  std::vector<double> rayRetros;
+  this->laserShape->GetRanges(rayRanges);
+  this->laserShape->GetRetros(rayRetros);
+
+  std::vector<double> ranges(verticalRangeCount * rangeCount);
+  std::vector<double> intensities(verticalRangeCount * rangeCount);
 
   // Interpolation: for every point in range count, compute interpolated value
   // using four bounding ray samples.
@@ -425,8 +414,6 @@ bool RaySensor::UpdateImpl(bool /*_force*/)
   double vb = 0, hb;
   // indices of ray samples
   int j1, j2, j3, j4;
-  // range values of ray samples
-  double r1, r2, r3, r4;
 
   // Check for the common case of vertical and horizontal resolution being 1,
   // which means that ray count == range count and we can do simple lookup
@@ -477,47 +464,87 @@ bool RaySensor::UpdateImpl(bool /*_force*/)
         j4 = hjb + vjb * rayCount;
 
         // range readings of 4 corners
-        r1 = this->GetLaserShape()->GetRange(j1);
-        r2 = this->GetLaserShape()->GetRange(j2);
-        r3 = this->GetLaserShape()->GetRange(j3);
-        r4 = this->GetLaserShape()->GetRange(j4);
-        range = (1-vb)*((1 - hb) * r1 + hb * r2)
-            + vb *((1 - hb) * r3 + hb * r4);
+        range = (1-vb)*((1 - hb) * rayRanges[j1] + hb * rayRanges[j2])
+            + vb *((1 - hb) * rayRanges[j3] + hb * rayRanges[j4]);
 
         // intensity is averaged
-        intensity = 0.25 * (this->GetLaserShape()->GetRetro(j1)
-            + this->GetLaserShape()->GetRetro(j2)
-            + this->GetLaserShape()->GetRetro(j3)
-            + this->GetLaserShape()->GetRetro(j4));
+        intensity = 0.25 * (rayRetros[j1] + rayRetros[j2] +
+            rayRetros[j3] + rayRetros[j4]);
       }
       else
       {
-        range = this->laserShape->GetRange(j * this->GetRayCount() + i);
-        intensity = this->laserShape->GetRetro(j * this->GetRayCount() + i);
+        range = rayRanges[j * rayCount + i];
+        intensity = rayRetros[j * rayCount + i];
       }
 
       // Mask ranges outside of min/max to +/- inf, as per REP 117
-      if (range >= this->GetRangeMax())
+      if (range >= rangeMax)
       {
         range = GZ_DBL_INF;
       }
-      else if (range <= this->GetRangeMin())
+      else if (range <= rangeMin)
       {
         range = -GZ_DBL_INF;
       }
-      else if (this->noises.find(RAY_NOISE) != this->noises.end())
+
+      ranges[j * rangeCount + i] = range;
+      intensities[j * rangeCount + i] = intensity;
+    }
+  }
+
+  // currently supports only one noise model per laser sensor
+  auto noise = this->noises.find(RAY_NOISE);
+  if (noise != this->noises.end())
+  {
+    // Apply the noise to all the ranges within min/max at once
+    std::vector<size_t> indices;
+    std::vector<double> inRange;
+    for (size_t i = 0; i < ranges.size(); ++i)
+    {
+      if (!std::isinf(ranges[i]))
       {
-        // currently supports only one noise model per laser sensor
-        range = this->noises[RAY_NOISE]->Apply(range);
-        range = ignition::math::clamp(range,
-            this->GetRangeMin(), this->GetRangeMax());
+        indices.push_back(i);
+        inRange.push_back(ranges[i]);
       }
+    }
 
-      scan->add_ranges(range);
-      scan->add_intensities(intensity);
+    noise->second->ApplyBatch(inRange.data(), inRange.size());
+
+    for (size_t i = 0; i < indices.size(); ++i)
+    {
+      ranges[indices[i]] =
+        ignition::math::clamp(inRange[i], rangeMin, rangeMax);
     }
   }
 
+  boost::mutex::scoped_lock lock(this->mutex);
+
+  msgs::Set(this->laserMsg.mutable_time(), this->lastMeasurementTime);
+
+  msgs::LaserScan *scan = this->laserMsg.mutable_scan();
+
+  // Store the latest laser scans into laserMsg
+  msgs::Set(scan->mutable_world_pose(),
+            this->pose + this->parentEntity->GetWorldPose().Ign());
+  scan->set_angle_min(this->AngleMin().Radian());
+  scan->set_angle_max(this->AngleMax().Radian());
+  scan->set_angle_step(this->GetAngleResolution());
+  scan->set_count(rangeCount);
+
+  scan->set_vertical_angle_min(this->VerticalAngleMin().Radian());
+  scan->set_vertical_angle_max(this->VerticalAngleMax().Radian());
+  scan->set_vertical_angle_step(this->GetVerticalAngleResolution());
+  scan->set_vertical_count(verticalRangeCount);
+
+  scan->set_range_min(rangeMin);
+  scan->set_range_max(rangeMax);
+
+  scan->mutable_ranges()->Resize(ranges.size(), 0.0);
+  std::copy(ranges.begin(), ranges.end(), scan->mutable_ranges()->begin());
+  scan->mutable_intensities()->Resize(intensities.size(), 0.0);
+  std::copy(intensities.begin(), intensities.end(),
+      scan->mutable_intensities()->begin());
+
   if (this->scanPub && this->scanPub->HasConnections())
     this->scanPub->Publish(this->laserMsg);
 
@@ -38,6 +38,7 @@
 #include "gazebo/rendering/Scene.hh"
 
 #include "gazebo/sensors/CameraSensor.hh"
+#include "gazebo/sensors/GaussianNoiseModel.hh"
 #include "gazebo/sensors/LogicalCameraSensor.hh"
 #include "gazebo/sensors/Noise.hh"
 #include "gazebo/sensors/Sensor.hh"
@@ -120,6 +121,19 @@ void Sensor::Init()
 {
   this->SetUpdateRate(this->sdf->Get<double>("update_rate"));
 
+  // Name the batched noise streams after the sensor and the noise type, so
+  // that they don't depend on the other noise models of the process.
+  for (auto &it : this->noises)
+  {
+    GaussianNoiseModelPtr gaussian =
+      boost::dynamic_pointer_cast<GaussianNoiseModel>(it.second);
+    if (gaussian)
+    {
+      gaussian->SetStreamName(
+          this->GetScopedName() + "::" + std::to_string(it.first));
+    }
+  }
+
   // Load the plugins
   if (this->sdf->HasElement("plugin"))
   {
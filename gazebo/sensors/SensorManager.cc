@@ -23,6 +23,8 @@
 #include <boost/bind.hpp>
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Time.hh"
+#include "gazebo/common/Trace.hh"
+#include "gazebo/msgs/msgs.hh"
 
 #include "gazebo/physics/PhysicsIface.hh"
 #include "gazebo/physics/PhysicsEngine.hh"
@@ -31,6 +33,8 @@
 #include "gazebo/sensors/SensorsIface.hh"
 #include "gazebo/sensors/SensorFactory.hh"
 #include "gazebo/sensors/SensorManager.hh"
+#include "gazebo/transport/Node.hh"
+#include "gazebo/transport/Publisher.hh"
 
 using namespace gazebo;
 using namespace sensors;
@@ -100,6 +104,8 @@ void SensorManager::Stop()
 //////////////////////////////////////////////////
 void SensorManager::Update(bool _force)
 {
+  std::vector<std::string> removeNames;
+  bool removeAll = false;
   {
     boost::recursive_mutex::scoped_lock lock(this->mutex);
 
@@ -118,45 +124,95 @@ void SensorManager::Update(bool _force)
     }
     this->initSensors.clear();
 
-    for (std::vector<std::string>::iterator iter = this->removeSensors.begin();
-         iter != this->removeSensors.end(); ++iter)
+    // Removing a sensor waits for its update to finish on a worker thread,
+    // so take the lists and remove the sensors without holding the mutex.
+    removeNames.swap(this->removeSensors);
+
+    if (this->removeAllSensors)
     {
-      GZ_ASSERT(!(*iter).empty(), "Remove sensor name is empty.");
+      this->initSensors.clear();
+      this->removeAllSensors = false;
+      removeAll = true;
+    }
+  }
 
-      bool removed = false;
-      for (SensorContainer_V::iterator iter2 = this->sensorContainers.begin();
-           iter2 != this->sensorContainers.end() && !removed; ++iter2)
-      {
-        GZ_ASSERT((*iter2) != NULL, "SensorContainer is NULL");
+  for (std::vector<std::string>::iterator iter = removeNames.begin();
+       iter != removeNames.end(); ++iter)
+  {
+    GZ_ASSERT(!(*iter).empty(), "Remove sensor name is empty.");
 
-        removed = (*iter2)->RemoveSensor(*iter);
-      }
+    bool removed = false;
+    for (SensorContainer_V::iterator iter2 = this->sensorContainers.begin();
+         iter2 != this->sensorContainers.end() && !removed; ++iter2)
+    {
+      GZ_ASSERT((*iter2) != NULL, "SensorContainer is NULL");
 
-      if (!removed)
-      {
-        gzerr << "RemoveSensor failed. The SensorManager's list of sensors "
-              << "changed during sensor removal. This is bad, and should "
-              << "never happen.\n";
-      }
+      removed = (*iter2)->RemoveSensor(*iter);
     }
-    this->removeSensors.clear();
 
-    if (this->removeAllSensors)
+    if (!removed)
     {
-      for (SensorContainer_V::iterator iter2 = this->sensorContainers.begin();
-          iter2 != this->sensorContainers.end(); ++iter2)
-      {
-        GZ_ASSERT((*iter2) != NULL, "SensorContainer is NULL");
-        (*iter2)->RemoveSensors();
-      }
-      this->initSensors.clear();
-      this->removeAllSensors = false;
+      gzerr << "RemoveSensor failed. The SensorManager's list of sensors "
+            << "changed during sensor removal. This is bad, and should "
+            << "never happen.\n";
+    }
+  }
+
+  if (removeAll)
+  {
+    for (SensorContainer_V::iterator iter2 = this->sensorContainers.begin();
+        iter2 != this->sensorContainers.end(); ++iter2)
+    {
+      GZ_ASSERT((*iter2) != NULL, "SensorContainer is NULL");
+      (*iter2)->RemoveSensors();
     }
   }
 
   // Only update if there are sensors
   if (this->sensorContainers[sensors::IMAGE]->sensors.size() > 0)
     this->sensorContainers[sensors::IMAGE]->Update(_force);
+
+  this->PublishStatistics();
+}
+
+//////////////////////////////////////////////////
+void SensorManager::PublishStatistics()
+{
+  common::Time wallTime = common::Time::GetWallTime();
+  if (wallTime - this->lastStatsTime < common::Time(1, 0))
+    return;
+  this->lastStatsTime = wallTime;
+
+  // Wait for a sensor, which tells the world the statistics belong to.
+  Sensor_V allSensors = this->GetSensors();
+  if (allSensors.empty())
+    return;
+
+  std::string worldName = allSensors.front()->GetWorldName();
+  if (!this->node)
+  {
+    this->node = transport::NodePtr(new transport::Node());
+    this->node->Init(worldName);
+    this->statsPub =
+      this->node->Advertise<msgs::SensorStatistics>("~/sensor_stats");
+  }
+
+  if (!this->statsPub->HasConnections())
+    return;
+
+  msgs::SensorStatistics msg;
+  msgs::Set(msg.mutable_sim_time(),
+      physics::get_world(worldName)->GetSimTime());
+
+  boost::recursive_mutex::scoped_lock lock(this->mutex);
+  for (SensorContainer_V::const_iterator iter = this->sensorContainers.begin();
+       iter != this->sensorContainers.end(); ++iter)
+  {
+    GZ_ASSERT((*iter) != NULL, "SensorContainer is NULL");
+    (*iter)->FillStatistics(msg);
+  }
+
+  this->statsPub->Publish(msg);
 }
 
 //////////////////////////////////////////////////
@@ -216,6 +272,11 @@ void SensorManager::Fini()
   delete this->simTimeEventHandler;
   this->simTimeEventHandler = NULL;
 
+  this->statsPub.reset();
+  if (this->node)
+    this->node->Fini();
+  this->node.reset();
+
   this->initialized = false;
 }
 
@@ -359,18 +420,27 @@ void SensorManager::RemoveSensors()
   this->removeAllSensors = true;
 }
 
+//////////////////////////////////////////////////
+SensorManager::SensorTiming::SensorTiming(SensorPtr _sensor)
+  : sensor(_sensor), busy(false), removed(false), finalized(false),
+    updateCount(0), overrunCount(0)
+{
+}
+
 //////////////////////////////////////////////////
 SensorManager::SensorContainer::SensorContainer()
 {
   this->stop = true;
   this->initialized = false;
   this->runThread = NULL;
+  this->wakeup = false;
 }
 
 //////////////////////////////////////////////////
 SensorManager::SensorContainer::~SensorContainer()
 {
   this->sensors.clear();
+  this->timings.clear();
 }
 
 //////////////////////////////////////////////////
@@ -391,20 +461,10 @@ void SensorManager::SensorContainer::Init()
 //////////////////////////////////////////////////
 void SensorManager::SensorContainer::Fini()
 {
-  boost::recursive_mutex::scoped_lock lock(this->mutex);
-
-  Sensor_V::iterator iter;
-
-  // Finialize each sensor in the current sensor vector
-  for (iter = this->sensors.begin(); iter != this->sensors.end(); ++iter)
-  {
-    GZ_ASSERT((*iter) != NULL, "Sensor is NULL");
-    (*iter)->Fini();
-  }
-
-  // Remove all the sensors from the current sensor vector.
-  this->sensors.clear();
+  // Finialize and remove all the sensors.
+  this->RemoveSensors();
 
+  boost::recursive_mutex::scoped_lock lock(this->mutex);
   this->initialized = false;
 }
 
@@ -421,7 +481,7 @@ void SensorManager::SensorContainer::Run()
 void SensorManager::SensorContainer::Stop()
 {
   this->stop = true;
-  this->runCondition.notify_all();
+  this->Wake();
   if (this->runThread)
   {
     // Note: calling interrupt seems to cause the thread to either block
@@ -441,104 +501,205 @@ void SensorManager::SensorContainer::RunLoop()
   physics::WorldPtr world = physics::get_world();
   GZ_ASSERT(world != NULL, "Pointer to World is NULL");
 
-  physics::PhysicsEnginePtr engine = world->GetPhysicsEngine();
-  GZ_ASSERT(engine != NULL, "Pointer to PhysicsEngine is NULL");
+  while (!this->stop)
+  {
+    bool pending = false;
+    common::Time eventTime;
 
-  engine->InitForThread();
+    {
+      boost::recursive_mutex::scoped_lock lock(this->mutex);
+      common::Time simTime = world->GetSimTime();
 
-  common::Time sleepTime, startTime, eventTime, diffTime;
-  double maxUpdateRate = 0;
+      // Hand every sensor that is due to a worker. A sensor is only in the
+      // schedule once, unless it was rescheduled by a world reset, in which
+      // case the stale entry no longer matches its next update time.
+      while (!this->schedule.empty() && this->schedule.top().first <= simTime)
+      {
+        ScheduleEntry entry = this->schedule.top();
+        this->schedule.pop();
+
+        SensorTimingPtr timing = entry.second;
+        if (timing->removed || timing->busy ||
+            timing->nextUpdate != entry.first)
+        {
+          continue;
+        }
+
+        timing->busy = true;
+        this->workers.run(boost::bind(
+              &SensorManager::SensorContainer::RunSensor, this, timing,
+              world));
+      }
+
+      if (!this->schedule.empty())
+      {
+        pending = true;
+        eventTime = this->schedule.top().first - simTime;
+      }
+    }
 
-  boost::mutex tmpMutex;
-  boost::mutex::scoped_lock lock2(tmpMutex);
+    boost::mutex::scoped_lock timingLock(g_sensorTimingMutex);
 
-  // Wait for a sensor to be added.
-  // Use a while loop since world resets will notify the runCondition.
-  while (this->sensors.empty())
-  {
-    this->runCondition.wait(lock2);
-    if (this->stop)
-      return;
+    // Sleep until the next sensor is due, or until a sensor is added,
+    // rescheduled or the world is reset.
+    // This if statement also helps prevent deadlock on osx during teardown.
+    if (!this->stop && !this->wakeup)
+    {
+      if (pending)
+      {
+        SensorManager::Instance()->simTimeEventHandler->AddRelativeEvent(
+            eventTime, &this->runCondition);
+      }
+      this->runCondition.wait(timingLock);
+    }
+    this->wakeup = false;
   }
 
+  this->workers.wait();
+}
+
+//////////////////////////////////////////////////
+void SensorManager::SensorContainer::RunSensor(SensorTimingPtr _timing,
+    physics::WorldPtr _world)
+{
+  // Any TBB worker thread may run a sensor, so make sure it can use the
+  // physics engine. This does nothing after the first call on a thread.
+  _world->GetPhysicsEngine()->InitForThread();
+
+  common::Time startTime = _world->GetSimTime();
+
+  this->UpdateSensor(_timing, false);
+
   {
     boost::recursive_mutex::scoped_lock lock(this->mutex);
+    _timing->busy = false;
 
-    // Get the minimum update rate from the sensors.
-    for (Sensor_V::iterator iter = this->sensors.begin();
-        iter != this->sensors.end() && !this->stop; ++iter)
+    // The first update of a sensor, and the first one after a world reset,
+    // have no due time.
+    if (_timing->nextUpdate > common::Time::Zero &&
+        startTime >= _timing->nextUpdate)
     {
-      GZ_ASSERT((*iter) != NULL, "Sensor is NULL");
-      maxUpdateRate = std::max((*iter)->GetUpdateRate(), maxUpdateRate);
+      _timing->lastLatency = startTime - _timing->nextUpdate;
+      _timing->maxLatency = std::max(_timing->maxLatency,
+          _timing->lastLatency);
+
+      // The update overran if it finished after the next one was due.
+      double rate = _timing->sensor->GetUpdateRate();
+      if (rate > 0 && _world->GetSimTime() >
+          _timing->nextUpdate + common::Time(1.0 / rate))
+      {
+        ++_timing->overrunCount;
+      }
     }
+
+    if (!_timing->removed)
+      this->Schedule(_timing, _world);
   }
 
-  // Calculate an appropriate sleep time.
-  if (maxUpdateRate > 0)
-    sleepTime.Set(1.0 / (maxUpdateRate));
-  else
-    sleepTime.Set(0, 1e6);
+  this->Wake();
+}
+
+//////////////////////////////////////////////////
+void SensorManager::SensorContainer::UpdateSensor(SensorTimingPtr _timing,
+    bool _force)
+{
+  common::Time duration;
+  bool updated = false;
 
-  while (!this->stop)
   {
-    // If all the sensors get deleted, wait here.
-    // Use a while loop since world resets will notify the runCondition.
-    while (this->sensors.empty())
-    {
-      this->runCondition.wait(lock2);
-      if (this->stop)
-        return;
-    }
+    boost::mutex::scoped_lock lock(_timing->updateMutex);
+    if (_timing->finalized)
+      return;
 
-    // Get the start time of the update.
-    startTime = world->GetSimTime();
+    GZ_TRACE_SCOPE("Sensor::Update");
 
-    this->Update(false);
+    common::Time lastUpdateTime = _timing->sensor->GetLastUpdateTime();
+    common::Time startTime = common::Time::GetWallTime();
 
-    // Compute the time it took to update the sensors.
-    // It's possible that the world time was reset during the Update. This
-    // would case a negative diffTime. Instead, just use a event time of zero
-    diffTime = std::max(common::Time::Zero, world->GetSimTime() - startTime);
+    _timing->sensor->Update(_force);
 
-    // Set the default sleep time
-    eventTime = std::max(common::Time::Zero, sleepTime - diffTime);
+    duration = common::Time::GetWallTime() - startTime;
+    updated = _timing->sensor->GetLastUpdateTime() != lastUpdateTime;
+  }
 
-    // Make sure update time is reasonable.
-    GZ_ASSERT(diffTime.sec < 1, "Took over 1.0 seconds to update a sensor.");
+  // Sensor::Update returns early if the sensor is not due yet, which
+  // should not count as an update.
+  if (!updated)
+    return;
 
-    // Make sure eventTime is not negative.
-    GZ_ASSERT(eventTime >= common::Time::Zero,
-        "Time to next sensor update is negative.");
+  boost::recursive_mutex::scoped_lock lock(this->mutex);
+  ++_timing->updateCount;
+  _timing->lastDuration = duration;
+  _timing->maxDuration = std::max(_timing->maxDuration, duration);
+  _timing->totalDuration += duration;
+}
 
-    boost::mutex::scoped_lock timingLock(g_sensorTimingMutex);
+//////////////////////////////////////////////////
+void SensorManager::SensorContainer::FiniSensor(SensorTimingPtr _timing)
+{
+  boost::mutex::scoped_lock lock(_timing->updateMutex);
+  if (!_timing->finalized)
+  {
+    _timing->sensor->Fini();
+    _timing->finalized = true;
+  }
+}
 
-    // Add an event to trigger when the appropriate simulation time has been
-    // reached.
-    SensorManager::Instance()->simTimeEventHandler->AddRelativeEvent(
-        eventTime, &this->runCondition);
+//////////////////////////////////////////////////
+void SensorManager::SensorContainer::Schedule(SensorTimingPtr _timing,
+    physics::WorldPtr _world)
+{
+  double rate = _timing->sensor->GetUpdateRate();
+  common::Time period;
+  if (rate > 0)
+    period.Set(1.0 / rate);
 
-    // This if statement helps prevent deadlock on osx during teardown.
-    if (!this->stop)
-    {
-      this->runCondition.wait(timingLock);
-    }
+  common::Time simTime = _world->GetSimTime();
+  common::Time stepSize(_world->GetPhysicsEngine()->GetMaxStepSize());
+
+  common::Time next = _timing->sensor->GetLastUpdateTime() + period;
+
+  // The sensor did not update, either because it is inactive or because
+  // it is already late. Check an active sensor again on the next physics
+  // step, and an inactive one once per update period.
+  if (next <= simTime)
+  {
+    if (_timing->sensor->IsActive())
+      next = simTime + stepSize;
+    else
+      next = simTime + std::max(period, stepSize);
   }
+
+  _timing->nextUpdate = next;
+  this->schedule.push(std::make_pair(next, _timing));
+}
+
+//////////////////////////////////////////////////
+void SensorManager::SensorContainer::Wake()
+{
+  boost::mutex::scoped_lock timingLock(g_sensorTimingMutex);
+  this->wakeup = true;
+  this->runCondition.notify_all();
 }
 
 //////////////////////////////////////////////////
 void SensorManager::SensorContainer::Update(bool _force)
 {
-  boost::recursive_mutex::scoped_lock lock(this->mutex);
+  std::vector<SensorTimingPtr> current;
+  {
+    boost::recursive_mutex::scoped_lock lock(this->mutex);
+    current = this->timings;
+  }
 
-  if (this->sensors.empty())
+  if (current.empty())
     gzlog << "Updating a sensor container without any sensors.\n";
 
   // Update all the sensors in this container.
-  for (Sensor_V::iterator iter = this->sensors.begin();
-       iter != this->sensors.end(); ++iter)
+  for (std::vector<SensorTimingPtr>::iterator iter = current.begin();
+       iter != current.end(); ++iter)
   {
-    GZ_ASSERT((*iter) != NULL, "Sensor is NULL");
-    (*iter)->Update(_force);
+    GZ_ASSERT((*iter)->sensor != NULL, "Sensor is NULL");
+    this->UpdateSensor(*iter, _force);
   }
 }
 
@@ -576,77 +737,144 @@ void SensorManager::SensorContainer::AddSensor(SensorPtr _sensor)
 
   {
     boost::recursive_mutex::scoped_lock lock(this->mutex);
+    SensorTimingPtr timing(new SensorTiming(_sensor));
     this->sensors.push_back(_sensor);
+    this->timings.push_back(timing);
+
+    // Due right away, the sensor decides whether it actually updates.
+    this->schedule.push(std::make_pair(timing->nextUpdate, timing));
   }
 
   // Tell the run loop that we have received a sensor
-  this->runCondition.notify_one();
+  this->Wake();
 }
 
 //////////////////////////////////////////////////
 bool SensorManager::SensorContainer::RemoveSensor(const std::string &_name)
 {
-  boost::recursive_mutex::scoped_lock lock(this->mutex);
+  SensorTimingPtr removed;
 
-  Sensor_V::iterator iter;
-
-  bool removed = false;
-
-  // Find the correct sensor based on name, and remove it.
-  for (iter = this->sensors.begin(); iter != this->sensors.end(); ++iter)
   {
-    GZ_ASSERT((*iter) != NULL, "Sensor is NULL");
+    boost::recursive_mutex::scoped_lock lock(this->mutex);
 
-    if ((*iter)->GetScopedName() == _name)
+    // Find the correct sensor based on name, and remove it.
+    for (size_t i = 0; i < this->sensors.size(); ++i)
     {
-      (*iter)->Fini();
-      this->sensors.erase(iter);
-      removed = true;
-      break;
+      GZ_ASSERT(this->sensors[i] != NULL, "Sensor is NULL");
+
+      if (this->sensors[i]->GetScopedName() == _name)
+      {
+        removed = this->timings[i];
+        removed->removed = true;
+        this->sensors.erase(this->sensors.begin() + i);
+        this->timings.erase(this->timings.begin() + i);
+        break;
+      }
     }
   }
 
-  return removed;
+  // Wait for a running update before finalizing the sensor.
+  if (removed)
+    FiniSensor(removed);
+
+  return removed != NULL;
 }
 
 //////////////////////////////////////////////////
 void SensorManager::SensorContainer::ResetLastUpdateTimes()
 {
-  boost::recursive_mutex::scoped_lock lock(this->mutex);
+  {
+    boost::recursive_mutex::scoped_lock lock(this->mutex);
 
-  Sensor_V::iterator iter;
+    // Rest last update times for all contained sensors.
+    for (Sensor_V::iterator iter = this->sensors.begin();
+         iter != this->sensors.end(); ++iter)
+    {
+      GZ_ASSERT((*iter) != NULL, "Sensor is NULL");
+      (*iter)->ResetLastUpdateTime();
+    }
 
-  // Rest last update times for all contained sensors.
-  for (iter = this->sensors.begin(); iter != this->sensors.end(); ++iter)
-  {
-    GZ_ASSERT((*iter) != NULL, "Sensor is NULL");
-    (*iter)->ResetLastUpdateTime();
+    // Simulation time went back, so every sensor is due again. Sensors
+    // that are updating are rescheduled when they finish.
+    this->schedule = std::priority_queue<ScheduleEntry,
+      std::vector<ScheduleEntry>, ScheduleOrder>();
+    for (std::vector<SensorTimingPtr>::iterator iter = this->timings.begin();
+         iter != this->timings.end(); ++iter)
+    {
+      if ((*iter)->busy)
+        continue;
+      (*iter)->nextUpdate = common::Time::Zero;
+      this->schedule.push(std::make_pair((*iter)->nextUpdate, *iter));
+    }
   }
 
   // Tell the run loop that world time has been reset.
-  this->runCondition.notify_one();
+  this->Wake();
 }
 
 //////////////////////////////////////////////////
 void SensorManager::SensorContainer::RemoveSensors()
 {
-  boost::recursive_mutex::scoped_lock lock(this->mutex);
+  std::vector<SensorTimingPtr> removed;
 
-  Sensor_V::iterator iter;
+  {
+    boost::recursive_mutex::scoped_lock lock(this->mutex);
 
-  // Remove all the sensors
-  for (iter = this->sensors.begin(); iter != this->sensors.end(); ++iter)
+    // Remove all the sensors
+    removed.swap(this->timings);
+    for (std::vector<SensorTimingPtr>::iterator iter = removed.begin();
+         iter != removed.end(); ++iter)
+    {
+      (*iter)->removed = true;
+    }
+    this->sensors.clear();
+  }
+
+  // Finalize each sensor once its running update is done.
+  for (std::vector<SensorTimingPtr>::iterator iter = removed.begin();
+       iter != removed.end(); ++iter)
   {
-    GZ_ASSERT((*iter) != NULL, "Sensor is NULL");
-    (*iter)->Fini();
+    FiniSensor(*iter);
   }
+}
 
-  this->sensors.clear();
+//////////////////////////////////////////////////
+void SensorManager::SensorContainer::FillStatistics(
+    msgs::SensorStatistics &_msg) const
+{
+  boost::recursive_mutex::scoped_lock lock(this->mutex);
+
+  for (std::vector<SensorTimingPtr>::const_iterator iter =
+       this->timings.begin(); iter != this->timings.end(); ++iter)
+  {
+    const SensorTiming &timing = **iter;
+    msgs::SensorStatistics::Sensor *sensorMsg = _msg.add_sensor();
+
+    sensorMsg->set_name(timing.sensor->GetScopedName());
+    sensorMsg->set_update_rate(timing.sensor->GetUpdateRate());
+    sensorMsg->set_update_count(timing.updateCount);
+    sensorMsg->set_overrun_count(timing.overrunCount);
+    msgs::Set(sensorMsg->mutable_last_duration(), timing.lastDuration);
+    msgs::Set(sensorMsg->mutable_max_duration(), timing.maxDuration);
+
+    common::Time mean;
+    if (timing.updateCount > 0)
+    {
+      mean.Set(timing.totalDuration.Double() /
+          static_cast<double>(timing.updateCount));
+    }
+    msgs::Set(sensorMsg->mutable_mean_duration(), mean);
+
+    msgs::Set(sensorMsg->mutable_last_latency(), timing.lastLatency);
+    msgs::Set(sensorMsg->mutable_max_latency(), timing.maxLatency);
+  }
 }
 
 //////////////////////////////////////////////////
 void SensorManager::ImageSensorContainer::Update(bool _force)
 {
+  GZ_TRACE_SCOPE("ImageSensorContainer::Update");
+
   event::Events::preRender();
 
   // Tell all the cameras to render
@@ -17,17 +17,24 @@
 #ifndef _GAZEBO_SENSORMANAGER_HH_
 #define _GAZEBO_SENSORMANAGER_HH_
 
+#include <stdint.h>
+#include <tbb/task_group.h>
 #include <boost/thread.hpp>
 #include <string>
+#include <utility>
 #include <vector>
 #include <list>
+#include <queue>
 
 #include <sdf/sdf.hh>
 
 #include "gazebo/physics/PhysicsTypes.hh"
 #include "gazebo/common/SingletonT.hh"
+#include "gazebo/common/Time.hh"
 #include "gazebo/common/UpdateInfo.hh"
+#include "gazebo/msgs/MessageTypes.hh"
 #include "gazebo/sensors/SensorTypes.hh"
+#include "gazebo/transport/TransportTypes.hh"
 #include "gazebo/util/system.hh"
 
 namespace gazebo
@@ -156,6 +163,86 @@ namespace gazebo
       /// \param[in] _sensor Pointer to a sensor to add.
       private: void AddSensor(SensorPtr _sensor);
 
+      /// \brief Publish the update statistics of all the sensors, at most
+      /// once per second of wall time.
+      private: void PublishStatistics();
+
+      /// \cond
+      /// \brief Scheduling state and update statistics of a sensor in a
+      /// SensorContainer.
+      private: class SensorTiming
+               {
+                 /// \brief Constructor
+                 /// \param[in] _sensor The sensor.
+                 public: explicit SensorTiming(SensorPtr _sensor);
+
+                 /// \brief The sensor.
+                 public: SensorPtr sensor;
+
+                 /// \brief Simulation time at which the sensor is due.
+                 public: common::Time nextUpdate;
+
+                 /// \brief True while a worker updates the sensor.
+                 public: bool busy;
+
+                 /// \brief True once the sensor is removed from its
+                 /// container. Guarded by the container mutex.
+                 public: bool removed;
+
+                 /// \brief True once the sensor is finalized. Guarded by
+                 /// updateMutex.
+                 public: bool finalized;
+
+                 /// \brief Held while the sensor is updated, so that it is
+                 /// not finalized during an update.
+                 public: boost::mutex updateMutex;
+
+                 /// \brief Number of updates.
+                 public: uint64_t updateCount;
+
+                 /// \brief Number of updates that did not finish before the
+                 /// next update was due.
+                 public: uint64_t overrunCount;
+
+                 /// \brief Wall time spent in the last update.
+                 public: common::Time lastDuration;
+
+                 /// \brief Longest wall time spent in an update.
+                 public: common::Time maxDuration;
+
+                 /// \brief Total wall time spent in updates.
+                 public: common::Time totalDuration;
+
+                 /// \brief Simulation time between when the last update was
+                 /// due and when it started.
+                 public: common::Time lastLatency;
+
+                 /// \brief Longest latency of an update.
+                 public: common::Time maxLatency;
+               };
+
+      /// \brief Shared pointer to a SensorTiming.
+      private: typedef boost::shared_ptr<SensorTiming> SensorTimingPtr;
+
+      /// \brief An entry in the schedule of a SensorContainer: the
+      /// simulation time at which a sensor is due, and the sensor.
+      private: typedef std::pair<common::Time, SensorTimingPtr> ScheduleEntry;
+
+      /// \brief Orders the schedule so that the earliest entry is on top.
+      private: class ScheduleOrder
+               {
+                 /// \brief Is an entry due later than another?
+                 /// \param[in] _a First entry.
+                 /// \param[in] _b Second entry.
+                 /// \return True if _a is due after _b.
+                 public: bool operator()(const ScheduleEntry &_a,
+                             const ScheduleEntry &_b) const
+                         {
+                           return _a.first > _b.first;
+                         }
+               };
+      /// \endcond
+
       /// \cond
       /// \brief A container for sensors of a specific type. This is used to
       /// separate sensors which rely on the rendering engine from those
@@ -210,10 +297,44 @@ namespace gazebo
                  /// \brief Reset last update times in all sensors.
                  public: void ResetLastUpdateTimes();
 
-                 /// \brief A loop to update the sensor. Used by the
-                 /// runThread.
+                 /// \brief Add the update statistics of the sensors to a
+                 /// message.
+                 /// \param[out] _msg Message to fill.
+                 public: void FillStatistics(msgs::SensorStatistics &_msg)
+                         const;
+
+                 /// \brief A loop that hands the sensors that are due to
+                 /// worker threads. Used by the runThread.
                  private: void RunLoop();
 
+                 /// \brief Update a sensor on a worker thread, then schedule
+                 /// its next update.
+                 /// \param[in] _timing The sensor to update.
+                 /// \param[in] _world The world of the sensor.
+                 private: void RunSensor(SensorTimingPtr _timing,
+                                         physics::WorldPtr _world);
+
+                 /// \brief Update a sensor and record how long it took.
+                 /// \param[in] _timing The sensor to update.
+                 /// \param[in] _force True to force the sensor to update.
+                 private: void UpdateSensor(SensorTimingPtr _timing,
+                                            bool _force);
+
+                 /// \brief Finalize a sensor once no update is running.
+                 /// The mutex must not be locked.
+                 /// \param[in] _timing The sensor to finalize.
+                 private: static void FiniSensor(SensorTimingPtr _timing);
+
+                 /// \brief Add the next update of a sensor to the schedule.
+                 /// The mutex must be locked.
+                 /// \param[in] _timing The sensor.
+                 /// \param[in] _world The world of the sensor.
+                 private: void Schedule(SensorTimingPtr _timing,
+                                        physics::WorldPtr _world);
+
+                 /// \brief Wake up the run loop.
+                 private: void Wake();
+
                  /// \brief The set of sensors to maintain.
                  public: Sensor_V sensors;
 
@@ -230,9 +351,25 @@ namespace gazebo
                  /// \brief A mutex to manage access to the sensors vector.
                  private: mutable boost::recursive_mutex mutex;
 
-                 /// \brief Condition used to block the RunLoop if no
-                 /// sensors are present.
+                 /// \brief Condition used to block the RunLoop until a
+                 /// sensor is due.
                  private: boost::condition_variable runCondition;
+
+                 /// \brief Scheduling state of each sensor, in the same
+                 /// order as the sensors vector.
+                 private: std::vector<SensorTimingPtr> timings;
+
+                 /// \brief Sensors ordered by the simulation time at which
+                 /// they are due.
+                 private: std::priority_queue<ScheduleEntry,
+                          std::vector<ScheduleEntry>, ScheduleOrder> schedule;
+
+                 /// \brief Worker threads that update the sensors.
+                 private: tbb::task_group workers;
+
+                 /// \brief True when the run loop must check the schedule
+                 /// again before it waits.
+                 private: bool wakeup;
                };
       /// \endcond
 
@@ -278,6 +415,15 @@ namespace gazebo
 
       /// \brief Pointer to the sim time event handler.
       private: SimTimeEventHandler *simTimeEventHandler;
+
+      /// \brief Transport node used to publish the sensor statistics.
+      private: transport::NodePtr node;
+
+      /// \brief Publisher of the sensor statistics.
+      private: transport::PublisherPtr statsPub;
+
+      /// \brief Wall time at which the statistics were last published.
+      private: common::Time lastStatsTime;
     };
     /// \}
   }
@@ -23,6 +23,23 @@
 using namespace gazebo;
 class SensorManager_TEST : public ServerFixture
 {
+  /// \brief Callback for sensor statistics.
+  /// \param[in] _msg Sensor statistics message.
+  public: void OnStats(ConstSensorStatisticsPtr &_msg)
+          {
+            boost::mutex::scoped_lock lock(this->statsMutex);
+            this->stats = *_msg;
+            ++this->statsCount;
+          }
+
+  /// \brief Last sensor statistics received.
+  public: msgs::SensorStatistics stats;
+
+  /// \brief Number of sensor statistics messages received.
+  public: int statsCount = 0;
+
+  /// \brief Protects the statistics.
+  public: boost::mutex statsMutex;
 };
 
 /////////////////////////////////////////////////
@@ -159,6 +176,46 @@ TEST_F(SensorManager_TEST, InitRemove)
   printf("Done done\n");
 }
 
+/////////////////////////////////////////////////
+/// \brief Test that the sensor update statistics are published.
+TEST_F(SensorManager_TEST, Statistics)
+{
+  Load("worlds/test_camera_laser.world");
+  sensors::SensorManager *mgr = sensors::SensorManager::Instance();
+
+  transport::SubscriberPtr sub = this->node->Subscribe("~/sensor_stats",
+      &SensorManager_TEST::OnStats, this);
+
+  // Statistics are published at most once per second, wait for two
+  // messages so that the sensors have been updated.
+  int i = 0;
+  while (i < 50)
+  {
+    {
+      boost::mutex::scoped_lock lock(this->statsMutex);
+      if (this->statsCount >= 2)
+        break;
+    }
+    common::Time::MSleep(100);
+    ++i;
+  }
+  EXPECT_LT(i, 50);
+
+  boost::mutex::scoped_lock lock(this->statsMutex);
+  EXPECT_EQ(this->stats.sensor_size(),
+      static_cast<int>(mgr->GetSensors().size()));
+
+  for (int s = 0; s < this->stats.sensor_size(); ++s)
+  {
+    const msgs::SensorStatistics::Sensor &sensorStats = this->stats.sensor(s);
+    EXPECT_GT(sensorStats.update_count(), 0u) << sensorStats.name();
+    EXPECT_LE(msgs::Convert(sensorStats.last_duration()),
+              msgs::Convert(sensorStats.max_duration()));
+    EXPECT_LE(msgs::Convert(sensorStats.last_latency()),
+              msgs::Convert(sensorStats.max_latency()));
+  }
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
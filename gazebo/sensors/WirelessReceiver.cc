@@ -24,7 +24,6 @@
 
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/sensors/SensorFactory.hh"
-#include "gazebo/sensors/SensorManager.hh"
 #include "gazebo/sensors/WirelessReceiver.hh"
 #include "gazebo/sensors/WirelessTransmitter.hh"
 #include "gazebo/transport/Node.hh"
@@ -108,33 +107,33 @@ bool WirelessReceiver::UpdateImpl(bool /*_force*/)
       this->pose + this->parentEntity.lock()->GetWorldPose().Ign();
 
   ignition::math::Pose3d myPos = this->referencePose;
-  Sensor_V sensors = SensorManager::Instance()->GetSensors();
-  for (Sensor_V::iterator it = sensors.begin(); it != sensors.end(); ++it)
+  std::vector<WirelessTransmitterPtr> transmitters =
+      WirelessTransmitter::GetTransmitters(this->GetWorldName());
+  for (auto const &transmitter : transmitters)
   {
-    if ((*it)->GetType() == "wireless_transmitter")
+    txFreq = transmitter->GetFreq();
+
+    // Discard if the frequency received is out of our frequency range
+    if ((txFreq < this->GetMinFreqFiltered()) ||
+        (txFreq > this->GetMaxFreqFiltered()))
     {
-      boost::shared_ptr<gazebo::sensors::WirelessTransmitter> transmitter =
-          boost::static_pointer_cast<WirelessTransmitter>(*it);
-
-      txFreq = transmitter->GetFreq();
-      rxPower = transmitter->SignalStrength(myPos, this->GetGain());
-
-      // Discard if the frequency received is out of our frequency range,
-      // or if the received signal strengh is lower than the sensivity
-      if ((txFreq < this->GetMinFreqFiltered()) ||
-          (txFreq > this->GetMaxFreqFiltered()) ||
-          (rxPower < this->GetSensitivity()))
-      {
-        continue;
-      }
-
-      txEssid = transmitter->GetESSID();
-
-      msgs::WirelessNode *wirelessNode = msg.add_node();
-      wirelessNode->set_essid(txEssid);
-      wirelessNode->set_frequency(txFreq);
-      wirelessNode->set_signal_level(rxPower);
+      continue;
     }
+
+    rxPower = transmitter->SignalStrength(myPos, this->GetGain());
+
+    // Discard if the received signal strengh is lower than the sensivity
+    if (rxPower < this->GetSensitivity())
+    {
+      continue;
+    }
+
+    txEssid = transmitter->GetESSID();
+
+    msgs::WirelessNode *wirelessNode = msg.add_node();
+    wirelessNode->set_essid(txEssid);
+    wirelessNode->set_frequency(txFreq);
+    wirelessNode->set_signal_level(rxPower);
   }
   if (msg.node_size() > 0)
   {
@@ -20,7 +20,14 @@
   #include <Winsock2.h>
 #endif
 
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <map>
+#include <tuple>
+#include <vector>
 #include <ignition/math/Rand.hh>
+#include <ignition/math/Vector2.hh>
 
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/physics/physics.hh"
@@ -41,9 +48,175 @@ const double WirelessTransmitter::ModelStdDesv = 6.0;
 const double WirelessTransmitter::Step = 1.0;
 const double WirelessTransmitter::MaxRadius = 10.0;
 
+/// \brief Maximum number of cached obstacle checks per transmitter.
+static const size_t MaxObstacleCacheSize = 10000;
+
+/// \brief Receiver positions closer than this share a cached obstacle
+/// check (m).
+static const double ObstacleCacheResolution = 0.01;
+
+/////////////////////////////////////////////////
+/// \brief Get the obstacle cache key of a receiver position.
+/// \param[in] _pos Receiver position.
+/// \return The position rounded to multiples of ObstacleCacheResolution.
+static std::tuple<int64_t, int64_t, int64_t> ObstacleCacheKey(
+    const ignition::math::Vector3d &_pos)
+{
+  return std::make_tuple(
+      static_cast<int64_t>(std::round(_pos.X() / ObstacleCacheResolution)),
+      static_cast<int64_t>(std::round(_pos.Y() / ObstacleCacheResolution)),
+      static_cast<int64_t>(std::round(_pos.Z() / ObstacleCacheResolution)));
+}
+
+/// \brief Maximum number of snapshot generations whose changes are kept.
+/// Transmitters that fall further behind clear their whole cache.
+static const size_t MaxObstacleChanges = 64;
+
+/// \brief Obstacles of a world, shared by the transmitters of the world so
+/// that the models are scanned once per world iteration.
+class ObstacleSnapshot
+{
+  /// \brief Constructor
+  public: ObstacleSnapshot() : iteration(0), generation(0) {}
+
+  /// \brief World the snapshot was taken from.
+  public: boost::weak_ptr<physics::World> world;
+
+  /// \brief World iteration of the snapshot.
+  public: uint32_t iteration;
+
+  /// \brief Changed every time the snapshot finds changed models. Unique
+  /// across all the snapshots of the process.
+  public: uint64_t generation;
+
+  /// \brief Link world poses and bounding box of each model, indexed by
+  /// model id.
+  public: std::map<uint32_t, std::pair<
+          std::vector<ignition::math::Pose3d>, math::Box> > models;
+
+  /// \brief Bounding boxes of the space that models moved out of and
+  /// into, for each of the last generations. Each entry is indexed by the
+  /// generation it changed, the next entry or the current generation
+  /// being the generation it led to.
+  public: std::deque<std::pair<uint64_t, std::vector<math::Box> > > changes;
+};
+
+/// \brief Last obstacle snapshot generation.
+static uint64_t g_obstacleGeneration = 0;
+
+/// \brief Obstacle snapshots indexed by the name of their world.
+static std::map<std::string, ObstacleSnapshot> g_obstacleSnapshots;
+
+/// \brief Protects g_obstacleSnapshots.
+static boost::mutex g_obstacleSnapshotsMutex;
+
+/////////////////////////////////////////////////
+/// \brief Scan the models of a world if it has stepped since the snapshot
+/// was taken. Must be called with g_obstacleSnapshotsMutex locked.
+/// \param[in] _world The world.
+/// \param[in,out] _snapshot Snapshot of the world.
+static void UpdateObstacleSnapshot(const physics::WorldPtr &_world,
+    ObstacleSnapshot &_snapshot)
+{
+  // Models only move when the world steps. A new world, with the same name
+  // as an old one, starts from scratch.
+  uint32_t iterations = _world->GetIterations();
+  if (_snapshot.world.lock() == _world && iterations == _snapshot.iteration)
+    return;
+
+  if (_snapshot.world.lock() != _world)
+  {
+    _snapshot.world = _world;
+    _snapshot.models.clear();
+    _snapshot.changes.clear();
+    _snapshot.generation = ++g_obstacleGeneration;
+  }
+  _snapshot.iteration = iterations;
+
+  // Bounding boxes of the space that models moved out of and into
+  std::vector<math::Box> changed;
+
+  std::map<uint32_t, std::pair<std::vector<ignition::math::Pose3d>,
+      math::Box> > models;
+  {
+    // Static models are obstacles too, and can still be moved by clients.
+    // Compare every link, since links move relative to their model.
+    boost::recursive_mutex::scoped_lock lock(*(_world->GetPhysicsEngine()->
+        GetPhysicsUpdateMutex()));
+
+    for (auto const &model : _world->GetModels())
+    {
+      auto &entry = models[model->GetId()];
+      for (auto const &link : model->GetLinks())
+        entry.first.push_back(link->GetWorldPose().Ign());
+      entry.second = model->GetBoundingBox();
+
+      auto iter = _snapshot.models.find(model->GetId());
+      if (iter == _snapshot.models.end())
+      {
+        changed.push_back(entry.second);
+        continue;
+      }
+
+      if (iter->second.first != entry.first ||
+          !(iter->second.second == entry.second))
+      {
+        changed.push_back(iter->second.second);
+        changed.push_back(entry.second);
+      }
+      _snapshot.models.erase(iter);
+    }
+  }
+
+  // The models left have been removed from the world
+  for (auto const &model : _snapshot.models)
+    changed.push_back(model.second.second);
+  _snapshot.models.swap(models);
+
+  if (changed.empty())
+    return;
+
+  _snapshot.changes.push_back(std::make_pair(_snapshot.generation, changed));
+  _snapshot.generation = ++g_obstacleGeneration;
+  if (_snapshot.changes.size() > MaxObstacleChanges)
+    _snapshot.changes.pop_front();
+}
+
+/// \brief Transmitters indexed by the name of their world.
+static std::map<std::string,
+    std::vector<boost::weak_ptr<WirelessTransmitter> > > g_transmitters;
+
+/// \brief Protects g_transmitters.
+static boost::mutex g_transmittersMutex;
+
+/////////////////////////////////////////////////
+/// \brief Compute the received power of the propagation model.
+/// \param[in] _tx The transmitter.
+/// \param[in] _distance Distance between transmitter and receiver.
+/// \param[in] _obstacle True if there are obstacles in between.
+/// \param[in] _rxGain Receiver gain value
+/// \return Received power (dBm).
+static double ReceivedPower(const WirelessTransmitter &_tx,
+    const double _distance,
+    const bool _obstacle, const double _rxGain)
+{
+  // Compute the value of n depending on the obstacles between Tx and Rx
+  double n = _obstacle ? WirelessTransmitter::NObstacle :
+    WirelessTransmitter::NEmpty;
+
+  double distance = std::max(1.0, _distance);
+  double x = std::abs(ignition::math::Rand::DblNormal(0.0,
+        WirelessTransmitter::ModelStdDesv));
+  double wavelength = common::SpeedOfLight / (_tx.GetFreq() * 1000000);
+
+  // Hata-Okumara propagation model
+  return _tx.GetPower() + _tx.GetGain() + _rxGain - x +
+      20 * log10(wavelength) - 20 * log10(4 * M_PI) - 10 * n * log10(distance);
+}
+
 /////////////////////////////////////////////////
 WirelessTransmitter::WirelessTransmitter()
-: WirelessTransceiver()
+: WirelessTransceiver(), obstacleCacheGeneration(0)
 {
   this->active = false;
   this->visualize = false;
@@ -90,6 +263,59 @@ void WirelessTransmitter::Init()
   // between the transmitter and a given point.
   this->testRay = boost::dynamic_pointer_cast<RayShape>(
       world->GetPhysicsEngine()->CreateShape("ray", CollisionPtr()));
+
+  // Let the receivers find this transmitter
+  boost::mutex::scoped_lock lock(g_transmittersMutex);
+  g_transmitters[this->GetWorldName()].push_back(
+      boost::dynamic_pointer_cast<WirelessTransmitter>(shared_from_this()));
+}
+
+//////////////////////////////////////////////////
+void WirelessTransmitter::Fini()
+{
+  bool last = false;
+  {
+    boost::mutex::scoped_lock lock(g_transmittersMutex);
+    auto &transmitters = g_transmitters[this->GetWorldName()];
+    transmitters.erase(std::remove_if(transmitters.begin(),
+          transmitters.end(),
+          [this](const boost::weak_ptr<WirelessTransmitter> &_tx)
+          {
+            WirelessTransmitterPtr tx = _tx.lock();
+            return !tx || tx.get() == this;
+          }), transmitters.end());
+    last = transmitters.empty();
+  }
+
+  // The last transmitter of a world drops the obstacle snapshot
+  if (last)
+  {
+    boost::mutex::scoped_lock lock(g_obstacleSnapshotsMutex);
+    g_obstacleSnapshots.erase(this->GetWorldName());
+  }
+
+  WirelessTransceiver::Fini();
+}
+
+//////////////////////////////////////////////////
+std::vector<WirelessTransmitterPtr> WirelessTransmitter::GetTransmitters(
+    const std::string &_worldName)
+{
+  std::vector<WirelessTransmitterPtr> result;
+
+  boost::mutex::scoped_lock lock(g_transmittersMutex);
+  auto iter = g_transmitters.find(_worldName);
+  if (iter != g_transmitters.end())
+  {
+    for (auto const &tx : iter->second)
+    {
+      WirelessTransmitterPtr transmitter = tx.lock();
+      if (transmitter)
+        result.push_back(transmitter);
+    }
+  }
+
+  return result;
 }
 
 //////////////////////////////////////////////////
@@ -101,10 +327,9 @@ bool WirelessTransmitter::UpdateImpl(bool /*_force*/)
   if (this->visualize)
   {
     msgs::PropagationGrid msg;
-    ignition::math::Pose3d pos;
-    ignition::math::Pose3d worldPose;
-    double strength;
-    msgs::PropagationParticle *p;
+    std::vector<ignition::math::Pose3d> worldPoses;
+    std::vector<ignition::math::Vector2d> gridPoints;
+    std::vector<double> strengths;
 
     // Iterate using a rectangular grid, but only choose the points within
     // a circunference of radius MaxRadius
@@ -112,25 +337,30 @@ bool WirelessTransmitter::UpdateImpl(bool /*_force*/)
     {
       for (double y = -this->MaxRadius; y <= this->MaxRadius; y += this->Step)
       {
-        pos.Set(x, y, 0.0, 0, 0, 0);
-
-        worldPose = pos + this->referencePose;
+        ignition::math::Pose3d worldPose =
+          ignition::math::Pose3d(x, y, 0.0, 0, 0, 0) + this->referencePose;
 
         if (this->referencePose.Pos().Distance(worldPose.Pos()) <=
             this->MaxRadius)
         {
-          // For the propagation model assume the receiver antenna has the same
-          // gain as the transmitter
-          strength = this->SignalStrength(worldPose, this->GetGain());
-
-          // Add a new particle to the grid
-          p = msg.add_particle();
-          p->set_x(x);
-          p->set_y(y);
-          p->set_signal_level(strength);
+          worldPoses.push_back(worldPose);
+          gridPoints.push_back(ignition::math::Vector2d(x, y));
         }
       }
     }
+
+    // For the propagation model assume the receiver antenna has the same
+    // gain as the transmitter
+    this->SignalStrengths(worldPoses, this->GetGain(), strengths);
+
+    // Add a new particle to the grid for each point
+    for (size_t i = 0; i < gridPoints.size(); ++i)
+    {
+      msgs::PropagationParticle *p = msg.add_particle();
+      p->set_x(gridPoints[i].X());
+      p->set_y(gridPoints[i].Y());
+      p->set_signal_level(strengths[i]);
+    }
     this->pub->Publish(msg);
   }
 
@@ -162,43 +392,157 @@ double WirelessTransmitter::SignalStrength(
     const ignition::math::Pose3d &_receiver,
     const double _rxGain)
 {
-  std::string entityName;
-  double dist;
-  ignition::math::Vector3d end = _receiver.Pos();
+  std::vector<double> strengths;
+  this->SignalStrengths(
+      std::vector<ignition::math::Pose3d>(1, _receiver), _rxGain, strengths);
+  return strengths[0];
+}
+
+/////////////////////////////////////////////////
+void WirelessTransmitter::SignalStrengths(
+    const std::vector<ignition::math::Pose3d> &_receivers,
+    const double _rxGain, std::vector<double> &_strengths)
+{
   ignition::math::Vector3d start = this->referencePose.Pos();
+  std::vector<bool> obstacles(_receivers.size(), false);
 
-  // Avoid computing the intersection of coincident points
-  // This prevents an assertion in bullet (issue #849)
-  if (start == end)
   {
-    end.Z() += 0.00001;
-  }
+    boost::mutex::scoped_lock cacheLock(this->obstacleCacheMutex);
 
-  // Acquire the mutex for avoiding race condition with the physics engine
-  boost::recursive_mutex::scoped_lock lock(*(world->GetPhysicsEngine()->
-      GetPhysicsUpdateMutex()));
+    // The cached checks are only valid for the same transmitter position
+    if (start != this->obstacleCacheStart ||
+        this->obstacleCache.size() > MaxObstacleCacheSize)
+    {
+      this->obstacleCache.clear();
+      this->obstacleCacheStart = start;
+    }
+    this->UpdateObstacleCache();
 
-  // Compute the value of n depending on the obstacles between Tx and Rx
-  double n = NEmpty;
+    // Find the receivers that need a new obstacle check
+    std::vector<size_t> uncached;
+    for (size_t i = 0; i < _receivers.size(); ++i)
+    {
+      auto iter = this->obstacleCache.find(
+          ObstacleCacheKey(_receivers[i].Pos()));
+      if (iter != this->obstacleCache.end())
+        obstacles[i] = iter->second;
+      else
+        uncached.push_back(i);
+    }
 
-  // Looking for obstacles between start and end points
-  this->testRay->SetPoints(start, end);
-  this->testRay->GetIntersection(dist, entityName);
+    if (!uncached.empty())
+    {
+      // Acquire the mutex for avoiding race condition with the physics
+      // engine, once for all the rays.
+      boost::recursive_mutex::scoped_lock lock(*(world->GetPhysicsEngine()->
+          GetPhysicsUpdateMutex()));
 
-  // ToDo: The ray intersects with my own collision model. Fix it.
-  if (entityName != "")
+      for (auto const i : uncached)
+      {
+        std::string entityName;
+        double dist;
+        ignition::math::Vector3d end = _receivers[i].Pos();
+        auto key = ObstacleCacheKey(end);
+
+        // Avoid computing the intersection of coincident points
+        // This prevents an assertion in bullet (issue #849)
+        if (start == end)
+        {
+          end.Z() += 0.00001;
+        }
+
+        // Looking for obstacles between start and end points
+        this->testRay->SetPoints(start, end);
+        this->testRay->GetIntersection(dist, entityName);
+
+        // ToDo: The ray intersects with my own collision model. Fix it.
+        obstacles[i] = entityName != "";
+        this->obstacleCache[key] = obstacles[i];
+      }
+    }
+  }
+
+  _strengths.resize(_receivers.size());
+  for (size_t i = 0; i < _receivers.size(); ++i)
   {
-    n = NObstacle;
+    _strengths[i] = ReceivedPower(*this,
+        this->referencePose.Pos().Distance(_receivers[i].Pos()),
+        obstacles[i], _rxGain);
   }
+}
 
-  double distance = std::max(1.0,
-      this->referencePose.Pos().Distance(_receiver.Pos()));
-  double x = std::abs(ignition::math::Rand::DblNormal(0.0, ModelStdDesv));
-  double wavelength = common::SpeedOfLight / (this->GetFreq() * 1000000);
+/////////////////////////////////////////////////
+void WirelessTransmitter::UpdateObstacleCache()
+{
+  // Bounding boxes of the space that models moved out of and into since
+  // the last update
+  std::vector<math::Box> changed;
+  bool clear = false;
+  {
+    boost::mutex::scoped_lock lock(g_obstacleSnapshotsMutex);
+    ObstacleSnapshot &snapshot = g_obstacleSnapshots[this->GetWorldName()];
+    UpdateObstacleSnapshot(this->world, snapshot);
+
+    if (snapshot.generation == this->obstacleCacheGeneration)
+      return;
+
+    // Collect the changes since the generation of the cache. Clear
+    // everything if they have been dropped, or if the cache was made from
+    // another snapshot.
+    auto iter = std::find_if(snapshot.changes.begin(), snapshot.changes.end(),
+        [this](const std::pair<uint64_t, std::vector<math::Box> > &_change)
+        {
+          return _change.first == this->obstacleCacheGeneration;
+        });
+    clear = iter == snapshot.changes.end();
+    for (; iter != snapshot.changes.end(); ++iter)
+      changed.insert(changed.end(), iter->second.begin(), iter->second.end());
+    this->obstacleCacheGeneration = snapshot.generation;
+  }
 
-  // Hata-Okumara propagation model
-  double rxPower = this->GetPower() + this->GetGain() + _rxGain - x +
-      20 * log10(wavelength) - 20 * log10(4 * M_PI) - 10 * n * log10(distance);
+  if (clear)
+  {
+    this->obstacleCache.clear();
+    return;
+  }
+
+  if (changed.empty())
+    return;
 
-  return rxPower;
+  // Remove the checks whose ray passes through a changed box. The
+  // bounding box of the ray, grown by the key resolution, is used as a
+  // conservative test.
+  const ignition::math::Vector3d &start = this->obstacleCacheStart;
+  const ignition::math::Vector3d margin(ObstacleCacheResolution,
+      ObstacleCacheResolution, ObstacleCacheResolution);
+  for (auto iter = this->obstacleCache.begin();
+       iter != this->obstacleCache.end();)
+  {
+    ignition::math::Vector3d end(std::get<0>(iter->first),
+        std::get<1>(iter->first), std::get<2>(iter->first));
+    end *= ObstacleCacheResolution;
+    ignition::math::Vector3d rayMin = ignition::math::Vector3d(
+        std::min(start.X(), end.X()), std::min(start.Y(), end.Y()),
+        std::min(start.Z(), end.Z())) - margin;
+    ignition::math::Vector3d rayMax = ignition::math::Vector3d(
+        std::max(start.X(), end.X()), std::max(start.Y(), end.Y()),
+        std::max(start.Z(), end.Z())) + margin;
+
+    bool intersects = false;
+    for (auto const &box : changed)
+    {
+      if (rayMin.X() <= box.max.x && rayMax.X() >= box.min.x &&
+          rayMin.Y() <= box.max.y && rayMax.Y() >= box.min.y &&
+          rayMin.Z() <= box.max.z && rayMax.Z() >= box.min.z)
+      {
+        intersects = true;
+        break;
+      }
+    }
+
+    if (intersects)
+      this->obstacleCache.erase(iter++);
+    else
+      ++iter;
+  }
 }
@@ -17,7 +17,12 @@
 #ifndef _GAZEBO_WIRELESS_TRANSMITTER_HH_
 #define _GAZEBO_WIRELESS_TRANSMITTER_HH_
 
+#include <map>
 #include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <boost/thread/mutex.hpp>
 #include "gazebo/physics/physics.hh"
 #include "gazebo/sensors/WirelessTransceiver.hh"
 #include "gazebo/transport/TransportTypes.hh"
@@ -61,6 +66,16 @@ namespace gazebo
       // Documentation inherited
       public: virtual void Init();
 
+      // Documentation inherited
+      public: virtual void Fini();
+
+      /// \brief Get the transmitters that have been initialized in a world.
+      /// Receivers use this instead of searching all the sensors.
+      /// \param[in] _worldName Name of the world.
+      /// \return The transmitters in the world.
+      public: static std::vector<WirelessTransmitterPtr> GetTransmitters(
+          const std::string &_worldName);
+
       /// \brief Returns the Service Set Identifier (network name).
       /// \return Service Set Identifier (network name).
       public: std::string GetESSID() const;
@@ -85,6 +100,23 @@ namespace gazebo
       public: double SignalStrength(const ignition::math::Pose3d &_receiver,
           const double _rxGain);
 
+      /// \brief Returns the signal strength at several points (dBm).
+      /// The obstacle checks that are not cached are done together, while
+      /// holding the physics update mutex once.
+      /// \param[in] _receivers Poses of the receivers.
+      /// \param[in] _rxGain Receiver gain value
+      /// \param[out] _strengths Signal strength at each receiver (dBm).
+      public: void SignalStrengths(
+          const std::vector<ignition::math::Pose3d> &_receivers,
+          const double _rxGain, std::vector<double> &_strengths);
+
+      /// \brief Remove the cached obstacle checks for the rays that a model
+      /// has moved into or out of since the last call. The models are
+      /// scanned once per world iteration for all the transmitters of the
+      /// world, so a model moved while the world is paused is seen when the
+      /// world steps. Must be called with the cache mutex locked.
+      private: void UpdateObstacleCache();
+
       /// \brief Size of the grid used for visualization.
       private: static const double Step;
 
@@ -101,6 +133,22 @@ namespace gazebo
       // \brief Ray used to test for collisions when placing entities
       private: physics::RayShapePtr testRay;
 
+      /// \brief Result of the obstacle check between the transmitter and
+      /// a receiver position, indexed by the receiver position rounded to
+      /// multiples of ObstacleCacheResolution.
+      private: std::map<std::tuple<int64_t, int64_t, int64_t>, bool>
+               obstacleCache;
+
+      /// \brief Transmitter position of the cached obstacle checks.
+      private: ignition::math::Vector3d obstacleCacheStart;
+
+      /// \brief Generation of the world's obstacle snapshot when the
+      /// obstacle cache was last updated.
+      private: uint64_t obstacleCacheGeneration;
+
+      /// \brief Protects the obstacle cache.
+      private: boost::mutex obstacleCacheMutex;
+
       // \brief When true it will publish the propagation grid to be used
       // by the transmitter visual layer
       private: bool visualize;
@@ -24,6 +24,9 @@ class WirelessTransmitter_TEST : public ServerFixture
     public: WirelessTransmitter_TEST();
     public: void TestCreateWirelessTransmitter();
     public: void TestSignalStrength();
+    public: void TestSignalStrengths();
+    public: void TestObstacleCache();
+    public: void TestGetTransmitters();
     public: void TestUpdateImpl();
     public: void TestUpdateImplNoVisual();
     public: void TestInvalidFreq();
@@ -159,6 +162,138 @@ void WirelessTransmitter_TEST::TestSignalStrength()
   EXPECT_NEAR(signStrengthAvg, -62.0, this->tx->ModelStdDesv);
 }
 
+/////////////////////////////////////////////////
+/// \brief Test the batched signal strength function
+void WirelessTransmitter_TEST::TestSignalStrengths()
+{
+  int samples = 100;
+  ignition::math::Pose3d rxPose(
+      ignition::math::Vector3d(3.0, 3.0, 0.055),
+      ignition::math::Quaterniond(0, 0, 0));
+  std::vector<ignition::math::Pose3d> rxPoses(samples, rxPose);
+  std::vector<double> strengths;
+
+  this->tx->Update(true);
+
+  // The first call checks for obstacles, and the second one uses the
+  // cached checks. Both must follow the propagation model.
+  for (int i = 0; i < 2; ++i)
+  {
+    this->tx->SignalStrengths(rxPoses, tx->GetGain(), strengths);
+    ASSERT_EQ(strengths.size(), rxPoses.size());
+
+    double signStrengthAvg = 0.0;
+    for (auto const strength : strengths)
+      signStrengthAvg += strength;
+    signStrengthAvg /= samples;
+
+    EXPECT_NEAR(signStrengthAvg, -62.0, this->tx->ModelStdDesv);
+  }
+
+  this->tx->SignalStrengths(std::vector<ignition::math::Pose3d>(),
+      tx->GetGain(), strengths);
+  EXPECT_TRUE(strengths.empty());
+}
+
+/////////////////////////////////////////////////
+/// \brief Average signal strength at a receiver pose.
+/// \param[in] _tx Transmitter.
+/// \param[in] _rxPose Pose of the receiver.
+/// \return Average of 100 samples (dBm).
+static double AverageSignalStrength(sensors::WirelessTransmitterPtr _tx,
+    const ignition::math::Pose3d &_rxPose)
+{
+  int samples = 100;
+  std::vector<double> strengths;
+  _tx->SignalStrengths(std::vector<ignition::math::Pose3d>(samples, _rxPose),
+      _tx->GetGain(), strengths);
+
+  double signStrengthAvg = 0.0;
+  for (auto const strength : strengths)
+    signStrengthAvg += strength;
+  return signStrengthAvg / samples;
+}
+
+/////////////////////////////////////////////////
+/// \brief Test that cached obstacle checks are discarded when an obstacle
+/// moves or is removed
+void WirelessTransmitter_TEST::TestObstacleCache()
+{
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  ignition::math::Pose3d rxPose(
+      ignition::math::Vector3d(5.0, 0.0, 0.055),
+      ignition::math::Quaterniond(0, 0, 0));
+
+  // A second transmitter, which shares the obstacle snapshot of the world
+  // but skips checking for obstacles during most of the changes.
+  SpawnWirelessTransmitterSensor("tx2", "wirelessTransmitter2",
+      ignition::math::Vector3d(0.0, 0.3, 0.055),
+      ignition::math::Vector3d::Zero, "GzTest2", 2442.0, 14.5, 2.6, false);
+  sensors::WirelessTransmitterPtr tx2 =
+    boost::static_pointer_cast<sensors::WirelessTransmitter>(
+        sensors::SensorManager::Instance()->GetSensor("wirelessTransmitter2"));
+  ASSERT_TRUE(tx2 != NULL);
+  ignition::math::Pose3d rxPose2(
+      ignition::math::Vector3d(5.0, 0.3, 0.055),
+      ignition::math::Quaterniond(0, 0, 0));
+
+  this->tx->Update(true);
+  tx2->Update(true);
+  double clear = AverageSignalStrength(this->tx, rxPose);
+  double clear2 = AverageSignalStrength(tx2, rxPose2);
+
+  // A static box between the transmitter and the receiver
+  SpawnBox("wall", math::Vector3(0.5, 2, 1), math::Vector3(2.5, 0, 0.5),
+      math::Vector3::Zero, true);
+  physics::ModelPtr wall = world->GetModel("wall");
+  ASSERT_TRUE(wall != NULL);
+  common::Time::MSleep(100);
+
+  double blocked = AverageSignalStrength(this->tx, rxPose);
+  EXPECT_LT(blocked, clear - 20);
+  EXPECT_LT(AverageSignalStrength(tx2, rxPose2), clear2 - 20);
+
+  // Moving the static box out of the way clears the obstacle
+  wall->SetWorldPose(math::Pose(2.5, 5, 0.5, 0, 0, 0));
+  common::Time::MSleep(100);
+  EXPECT_NEAR(AverageSignalStrength(this->tx, rxPose), clear,
+      this->tx->ModelStdDesv);
+
+  // Removing a box also clears the obstacle
+  SpawnBox("box", math::Vector3(0.5, 2, 1), math::Vector3(2.5, 0, 0.5),
+      math::Vector3::Zero);
+  ASSERT_TRUE(world->GetModel("box") != NULL);
+  common::Time::MSleep(100);
+  EXPECT_LT(AverageSignalStrength(this->tx, rxPose), clear - 20);
+
+  RemoveModel("box");
+  for (int i = 0; i < 100 && world->GetModel("box"); ++i)
+    common::Time::MSleep(10);
+  ASSERT_TRUE(world->GetModel("box") == NULL);
+  common::Time::MSleep(100);
+  EXPECT_NEAR(AverageSignalStrength(this->tx, rxPose), clear,
+      this->tx->ModelStdDesv);
+
+  // The second transmitter catches up with all the changes at once
+  EXPECT_NEAR(AverageSignalStrength(tx2, rxPose2), clear2,
+      tx2->ModelStdDesv);
+}
+
+/////////////////////////////////////////////////
+/// \brief Test the registry of transmitters
+void WirelessTransmitter_TEST::TestGetTransmitters()
+{
+  std::vector<sensors::WirelessTransmitterPtr> transmitters =
+    sensors::WirelessTransmitter::GetTransmitters("default");
+  ASSERT_EQ(transmitters.size(), 1u);
+  EXPECT_EQ(transmitters[0], this->tx);
+
+  EXPECT_TRUE(
+      sensors::WirelessTransmitter::GetTransmitters("no_world").empty());
+}
+
 /////////////////////////////////////////////////
 /// \brief Callback executed for every propagation grid message received
 void WirelessTransmitter_TEST::TxMsg(const ConstPropagationGridPtr &_msg)
@@ -254,6 +389,24 @@ TEST_F(WirelessTransmitter_TEST, TestSignalStrength)
   TestSignalStrength();
 }
 
+/////////////////////////////////////////////////
+TEST_F(WirelessTransmitter_TEST, TestSignalStrengths)
+{
+  TestSignalStrengths();
+}
+
+/////////////////////////////////////////////////
+TEST_F(WirelessTransmitter_TEST, TestObstacleCache)
+{
+  TestObstacleCache();
+}
+
+/////////////////////////////////////////////////
+TEST_F(WirelessTransmitter_TEST, TestGetTransmitters)
+{
+  TestGetTransmitters();
+}
+
 /////////////////////////////////////////////////
 TEST_F(WirelessTransmitter_TEST, TestUpdateImpl)
 {
@@ -337,7 +337,15 @@ void ServerFixture::OnPose(ConstPosesStampedPtr &_msg)
   boost::mutex::scoped_lock lock(this->receiveMutex);
   for (int i = 0; i < _msg->pose_size(); ++i)
   {
-    this->poses[_msg->pose(i).name()] = msgs::ConvertIgn(_msg->pose(i));
+    const msgs::Pose &pose = _msg->pose(i);
+
+    // Compact pose messages only carry the name the first time.
+    if (pose.has_name())
+      this->poseNames[pose.id()] = pose.name();
+    else if (this->poseNames.find(pose.id()) == this->poseNames.end())
+      continue;
+
+    this->poses[this->poseNames[pose.id()]] = msgs::ConvertIgn(pose);
   }
 }
 
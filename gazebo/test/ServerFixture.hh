@@ -666,6 +666,10 @@ namespace gazebo
     /// \brief Map of received poses.
     protected: std::map<std::string, math::Pose> poses;
 
+    /// \brief Names of the entities in received poses, by id. Used when
+    /// the world publishes compact pose messages.
+    protected: std::map<uint32_t, std::string> poseNames;
+
     /// \brief Mutex to protect data structures that store messages.
     protected: boost::mutex receiveMutex;
 
@@ -39,6 +39,13 @@ std::string CallbackHelper::GetMsgType() const
   return std::string();
 }
 
+/////////////////////////////////////////////////
+bool CallbackHelper::HandleSerializedData(const SerializedMsgPtr &_newdata,
+    boost::function<void(uint32_t)> _cb, uint32_t _id)
+{
+  return this->HandleData(*_newdata, _cb, _id);
+}
+
 /////////////////////////////////////////////////
 bool CallbackHelper::GetLatching() const
 {
@@ -63,6 +63,19 @@ namespace gazebo
       public: virtual bool HandleData(const std::string &_newdata,
                   boost::function<void(uint32_t)> _cb, uint32_t _id) = 0;
 
+      /// \brief Process new incoming data held in a shared buffer. The
+      /// default implementation forwards to HandleData. Subclasses that
+      /// keep the data after returning should override this function to
+      /// hold a reference to the buffer instead of copying it.
+      /// \param[in] _newdata Incoming serialized data to be processed
+      /// \param[in] _cb If non-null, callback to be invoked which signals
+      /// that transmission is complete.
+      /// \param[in] _id ID associated with the message data.
+      /// \return true if successfully processed; false otherwise
+      public: virtual bool HandleSerializedData(
+                  const SerializedMsgPtr &_newdata,
+                  boost::function<void(uint32_t)> _cb, uint32_t _id);
+
       /// \brief Process new incoming message
       /// \param[in] _newMsg Incoming message to be processed
       /// \return true if successfully processed; false otherwise
@@ -45,12 +45,14 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <algorithm>
 
 #include <boost/bind.hpp>
 #include <boost/function.hpp>
 #include <boost/lexical_cast.hpp>
 
 #include "gazebo/common/Console.hh"
+#include "gazebo/common/Trace.hh"
 #include "gazebo/msgs/msgs.hh"
 
 #include "gazebo/transport/IOManager.hh"
@@ -65,6 +67,10 @@ extern void dummy_callback_fn(uint32_t);
 unsigned int Connection::idCounter = 0;
 IOManager *Connection::iomanager = NULL;
 
+/// \brief Maximum number of messages gathered into one write. Each message
+/// is two buffers, and asio hands at most 64 buffers to a single writev.
+static const size_t kMaxWriteBatch = 32;
+
 // Version 1.52 of boost has an address::is_unspecfied function, but
 // Version 1.46.1 (installed on ubuntu) does not. So this helper function
 // is stolen from adress::is_unspecified function in boost v1.52.
@@ -92,6 +98,7 @@ Connection::Connection()
     iomanager = new IOManager();
 
   this->socket = new boost::asio::ip::tcp::socket(iomanager->GetIO());
+  this->strand = new boost::asio::io_service::strand(iomanager->GetIO());
 
   iomanager->IncCount();
   this->id = idCounter++;
@@ -101,6 +108,8 @@ Connection::Connection()
   this->connectError = false;
   this->writeQueue.clear();
   this->writeCount = 0;
+  this->writeBatch = 0;
+  this->flushPending = false;
 
   this->localURI = std::string("http://") + this->GetLocalHostname() + ":" +
                    boost::lexical_cast<std::string>(this->GetLocalPort());
@@ -127,6 +136,10 @@ Connection::~Connection()
 
   this->Shutdown();
 
+  // The strand must go before the io_service it belongs to.
+  delete this->strand;
+  this->strand = NULL;
+
   if (iomanager)
   {
     iomanager->DecCount();
@@ -303,35 +316,99 @@ void Connection::EnqueueMsg(const std::string &_buffer,
     return;
   }
 
-  snprintf(this->headerBuffer, HEADER_LENGTH + 1, "%08x",
-      static_cast<unsigned int>(_buffer.size()));
+  // The caller keeps its buffer, so the queue needs its own copy.
+  this->EnqueueMsg(SerializedMsgPtr(new std::string(_buffer)), _cb, _id,
+      _force);
+}
+
+//////////////////////////////////////////////////
+void Connection::EnqueueMsg(const SerializedMsgPtr &_buffer,
+    boost::function<void(uint32_t)> _cb, uint32_t _id, bool _force)
+{
+  // Don't enqueue empty messages
+  if (!_buffer || _buffer->empty() || !this->IsOpen())
+    return;
 
   {
     boost::recursive_mutex::scoped_lock lock(this->writeMutex);
 
-    if (this->writeQueue.empty() ||
-        (this->writeCount > 0 && this->writeQueue.size() == 1) ||
-        (this->writeQueue.back().size()+_buffer.size() > 4096))
-      this->writeQueue.push_back(std::string(headerBuffer) + _buffer);
-    else
-      this->writeQueue.back() += std::string(headerBuffer) + _buffer;
-    this->callbacks.push_back(std::make_pair(_cb, _id));
+    snprintf(this->headerBuffer, HEADER_LENGTH + 1, "%08x",
+        static_cast<unsigned int>(_buffer->size()));
+
+    this->writeQueue.push_back(ConnectionWriteBuffer());
+    ConnectionWriteBuffer &msg = this->writeQueue.back();
+    msg.header.assign(this->headerBuffer, HEADER_LENGTH);
+    msg.payload = _buffer;
+    msg.cb = _cb;
+    msg.id = _id;
+  }
+
+  this->FlushWriteQueue(_force);
+}
+
+//////////////////////////////////////////////////
+void Connection::EnqueuePrefixedMsg(char _prefix,
+    const SerializedMsgPtr &_buffer, boost::function<void(uint32_t)> _cb,
+    uint32_t _id)
+{
+  if (!_buffer || !this->IsOpen())
+    return;
+
+  {
+    boost::recursive_mutex::scoped_lock lock(this->writeMutex);
+
+    snprintf(this->headerBuffer, HEADER_LENGTH + 1, "%08x",
+        static_cast<unsigned int>(_buffer->size() + 1));
+
+    this->writeQueue.push_back(ConnectionWriteBuffer());
+    ConnectionWriteBuffer &msg = this->writeQueue.back();
+    msg.header.reserve(HEADER_LENGTH + 1);
+    msg.header.assign(this->headerBuffer, HEADER_LENGTH);
+    msg.header.push_back(_prefix);
+    msg.payload = _buffer;
+    msg.cb = _cb;
+    msg.id = _id;
   }
 
+  this->FlushWriteQueue(false);
+}
+
+//////////////////////////////////////////////////
+void Connection::FlushWriteQueue(bool _force)
+{
   if (_force)
   {
     this->ProcessWriteQueue();
+    return;
   }
-  else
+
+  // Start the write from the strand right away. Only one flush is posted
+  // at a time, later messages are picked up by it or by OnWrite.
+  boost::recursive_mutex::scoped_lock lock(this->writeMutex);
+  if (!this->flushPending && this->writeCount == 0)
   {
-    // Tell the connection manager that it needs to update
-    ConnectionManager::Instance()->TriggerUpdate();
+    this->flushPending = true;
+    this->strand->post(boost::bind(&Connection::OnFlush,
+          shared_from_this()));
   }
 }
 
+//////////////////////////////////////////////////
+void Connection::OnFlush()
+{
+  {
+    boost::recursive_mutex::scoped_lock lock(this->writeMutex);
+    this->flushPending = false;
+  }
+
+  this->ProcessWriteQueue();
+}
+
 /////////////////////////////////////////////////
 void Connection::ProcessWriteQueue(bool _blocking)
 {
+  GZ_TRACE_SCOPE("Connection::ProcessWriteQueue");
+
   boost::recursive_mutex::scoped_lock lock(this->writeMutex);
 
   if (!this->IsOpen())
@@ -348,37 +425,29 @@ void Connection::ProcessWriteQueue(bool _blocking)
 
   this->writeCount++;
 
-  // Write the serialized data to the socket. We use
-  // "gather-write" to send both the head and the data in
-  // a single write operation
+  // Gather the headers and payloads of the queued messages into a single
+  // write operation, without copying them.
+  this->writeBatch = std::min(this->writeQueue.size(), kMaxWriteBatch);
+  std::vector<boost::asio::const_buffer> buffers;
+  buffers.reserve(this->writeBatch * 2);
+  for (size_t i = 0; i < this->writeBatch; ++i)
+  {
+    const ConnectionWriteBuffer &msg = this->writeQueue[i];
+    buffers.push_back(boost::asio::buffer(msg.header));
+    buffers.push_back(boost::asio::buffer(*msg.payload));
+  }
+
   if (!_blocking)
   {
-    this->callbackIndex = this->callbacks.size();
-    boost::asio::async_write(*this->socket,
-        boost::asio::buffer(this->writeQueue.front().c_str(),
-          this->writeQueue.front().size()),
-          boost::bind(&Connection::OnWrite, shared_from_this(),
-            boost::asio::placeholders::error));
+    boost::asio::async_write(*this->socket, buffers,
+          this->strand->wrap(boost::bind(&Connection::OnWrite,
+              shared_from_this(), boost::asio::placeholders::error)));
   }
   else
   {
-    try
-    {
-      boost::asio::write(*this->socket,
-          boost::asio::buffer(this->writeQueue.front().c_str(),
-            this->writeQueue.front().size()));
-    }
-    catch(...)
-    {
-      this->Shutdown();
-    }
-
-    // Call the callback, in not NULL
-    if (!this->callbacks.front().first.empty())
-      this->callbacks.front().first(this->callbacks.front().second);
-
-    this->writeQueue.pop_front();
-    this->writeCount--;
+    boost::system::error_code error;
+    boost::asio::write(*this->socket, buffers, error);
+    this->OnWrite(error);
   }
 }
 
@@ -400,18 +469,17 @@ void Connection::OnWrite(const boost::system::error_code &_e)
   {
     boost::recursive_mutex::scoped_lock lock(this->writeMutex);
 
-    for (unsigned int i = 0; i < this->callbackIndex; ++i)
+    // Close() may have already emptied the queue.
+    size_t count = std::min(this->writeBatch, this->writeQueue.size());
+    for (size_t i = 0; i < count; ++i)
     {
-      if (!this->callbacks.empty())
-      {
-        if (!this->callbacks.front().first.empty())
-          this->callbacks.front().first(this->callbacks.front().second);
-        this->callbacks.pop_front();
-      }
+      const ConnectionWriteBuffer &msg = this->writeQueue.front();
+      if (!msg.cb.empty())
+        msg.cb(msg.id);
+      this->writeQueue.pop_front();
     }
 
-    if (!this->writeQueue.empty())
-      this->writeQueue.pop_front();
+    this->writeBatch = 0;
     this->writeCount--;
   }
 
@@ -420,6 +488,11 @@ void Connection::OnWrite(const boost::system::error_code &_e)
     // It will reach this point if the remote connection disconnects.
     this->Shutdown();
   }
+  else
+  {
+    // Write whatever was queued during this write.
+    this->ProcessWriteQueue();
+  }
 }
 
 //////////////////////////////////////////////////
@@ -484,7 +557,6 @@ void Connection::Close()
 
   boost::recursive_mutex::scoped_lock lock2(this->writeMutex);
   this->writeQueue.clear();
-  this->callbacks.clear();
 }
 
 //////////////////////////////////////////////////
@@ -36,6 +36,7 @@
 #include "gazebo/common/Event.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Exception.hh"
+#include "gazebo/transport/TransportTypes.hh"
 #include "gazebo/util/system.hh"
 
 #define HEADER_LENGTH 8
@@ -81,6 +82,33 @@ namespace gazebo
       /// \brief The data to send to the boost function pointer
       private: std::string data;
     };
+
+    /// \brief A message in a connection's write queue. The header and
+    /// the shared payload are handed to the socket as separate buffers of
+    /// a gather write, so the payload is never copied into the queue.
+    class GZ_TRANSPORT_VISIBLE ConnectionWriteBuffer
+    {
+      /// \brief Get the number of bytes to write.
+      /// \return Size of the header plus the size of the payload.
+      public: size_t Size() const
+              {
+                return this->header.size() +
+                  (this->payload ? this->payload->size() : 0);
+              }
+
+      /// \brief Message header, the size of the message in ASCII hex,
+      /// followed by a prefix of the payload if there is one.
+      public: std::string header;
+
+      /// \brief Shared message data written after the header.
+      public: SerializedMsgPtr payload;
+
+      /// \brief If non-null, called once the message has been written.
+      public: boost::function<void(uint32_t)> cb;
+
+      /// \brief ID passed to the callback.
+      public: uint32_t id;
+    };
     /// \endcond
 
     /// \addtogroup gazebo_transport Transport
@@ -167,6 +195,30 @@ namespace gazebo
       /// to the socket, otherwise just enqueue the data for asynchronous write
       public: void EnqueueMsg(const std::string &_buffer, bool _force = false);
 
+      /// \brief Write shared data to the socket. The buffer is referenced
+      /// by the write queue rather than copied into it.
+      /// \param[in] _buffer Data to write
+      /// \param[in] _cb If non-null, callback to be invoked after
+      /// transmission is complete.
+      /// \param[in] _id ID associated with the message data.
+      /// \param[in] _force If true, block until the data has been written
+      /// to the socket, otherwise just enqueue the data for asynchronous write
+      public: void EnqueueMsg(const SerializedMsgPtr &_buffer,
+                  boost::function<void(uint32_t)> _cb, uint32_t _id,
+                  bool _force = false);
+
+      /// \brief Write shared data to the socket behind a one byte prefix.
+      /// The prefix is written with the header, so the buffer is neither
+      /// copied into the write queue nor into a prefixed message.
+      /// \param[in] _prefix Byte written before the data.
+      /// \param[in] _buffer Data to write
+      /// \param[in] _cb If non-null, callback to be invoked after
+      /// transmission is complete.
+      /// \param[in] _id ID associated with the message data.
+      public: void EnqueuePrefixedMsg(char _prefix,
+                  const SerializedMsgPtr &_buffer,
+                  boost::function<void(uint32_t)> _cb, uint32_t _id);
+
       /// \brief Get the local URI
       /// \return The local URI
       public: std::string GetLocalURI() const;
@@ -330,9 +382,19 @@ namespace gazebo
       public: void DisconnectShutdown(event::ConnectionPtr _subscriber)
               {this->shutdown.Disconnect(_subscriber);}
 
-      /// \brief Handle on-write callbacks
+      /// \brief Write the queued messages, if no write is in progress.
+      /// Consecutive messages are gathered into a single write.
+      /// \param[in] _blocking If true, write synchronously.
       public: void ProcessWriteQueue(bool _blocking = false);
 
+      /// \brief Either write the queue immediately, or post a write to
+      /// the connection's strand.
+      /// \param[in] _force If true, write the queue immediately.
+      private: void FlushWriteQueue(bool _force);
+
+      /// \brief Write the queue from the strand, after a FlushWriteQueue.
+      private: void OnFlush();
+
       /// \brief Get the ID of the connection.
       /// \return The connection's unique ID.
       public: unsigned int GetId() const;
@@ -389,12 +451,18 @@ namespace gazebo
       private: boost::asio::ip::tcp::acceptor *acceptor;
 
       /// \brief Outgoing data queue
-      private: std::deque<std::string> writeQueue;
+      private: std::deque<ConnectionWriteBuffer> writeQueue;
 
-      /// \brief List of callbacks, paired with writeQueue. The callbacks
-      /// are used to notify a publisher when a message is successfully sent.
-      private: std::deque<
-               std::pair<boost::function<void(uint32_t)>, uint32_t> > callbacks;
+      /// \brief Serializes the write handlers of this connection.
+      private: boost::asio::io_service::strand *strand;
+
+      /// \brief True if a write has been posted to the strand and has not
+      /// run yet.
+      private: bool flushPending;
+
+      /// \brief Number of messages at the front of writeQueue that are
+      /// part of the write in progress.
+      private: size_t writeBatch;
 
       /// \brief Mutex to protect new connections.
       private: boost::mutex connectMutex;
@@ -465,10 +533,6 @@ namespace gazebo
       /// \brief Used to prevent too many log messages.
       private: bool dropMsgLogged;
 
-      /// \brief Index into the callbacks buffer that marks the last
-      /// async_write.
-      private: unsigned int callbackIndex;
-
       /// \brief True if the connection is open.
       private: bool isOpen;
     };
@@ -69,6 +69,7 @@ ConnectionManager::ConnectionManager()
   this->initialized = false;
   this->stop = false;
   this->stopped = true;
+  this->updatePending = false;
 
   this->serverConn = NULL;
 
@@ -243,7 +244,10 @@ void ConnectionManager::Fini()
 //////////////////////////////////////////////////
 void ConnectionManager::Stop()
 {
-  this->stop = true;
+  {
+    boost::mutex::scoped_lock lock(this->updateMutex);
+    this->stop = true;
+  }
   this->updateCondition.notify_all();
   if (this->initialized)
     while (this->stopped == false)
@@ -272,9 +276,6 @@ void ConnectionManager::RunUpdate()
     }
   }
 
-  if (this->masterConn)
-    this->masterConn->ProcessWriteQueue();
-
   // Use TBB to process nodes. Need more testing to see if this makes
   // a difference.
   // TopicManagerProcessTask *task = new(tbb::task::allocate_root())
@@ -287,11 +288,12 @@ void ConnectionManager::RunUpdate()
     endIter = this->connections.end();
   }
 
+  // Connections write their own queues, only the closed ones are
+  // removed here.
   while (iter != endIter)
   {
     if ((*iter)->IsOpen())
     {
-      (*iter)->ProcessWriteQueue();
       ++iter;
     }
     else
@@ -305,15 +307,21 @@ void ConnectionManager::RunUpdate()
 //////////////////////////////////////////////////
 void ConnectionManager::Run()
 {
-  boost::mutex::scoped_lock lock(this->updateMutex);
-
   this->stopped = false;
 
   while (!this->stop && this->masterConn && this->masterConn->IsOpen())
   {
     this->RunUpdate();
-    this->updateCondition.timed_wait(lock,
-       boost::posix_time::milliseconds(100));
+
+    // Sleep until the next trigger. Triggers that arrived during the
+    // update are not lost, and the timeout only checks the master.
+    boost::mutex::scoped_lock lock(this->updateMutex);
+    if (!this->updatePending && !this->stop)
+    {
+      this->updateCondition.timed_wait(lock,
+          boost::posix_time::milliseconds(100));
+    }
+    this->updatePending = false;
   }
   this->RunUpdate();
 
@@ -487,6 +495,11 @@ void ConnectionManager::OnRead(ConnectionPtr _connection,
     SubscriptionTransportPtr subLink(new SubscriptionTransport());
     subLink->Init(_connection, sub.latching());
 
+    // A subscriber on this host may have created a shared memory buffer.
+    // If it can't be opened the data is sent through the connection.
+    if (sub.has_shm_name())
+      subLink->InitShm(sub.shm_name());
+
     // Connect the publisher to this transport mechanism
     TopicManager::Instance()->ConnectPubToSub(sub.topic(), subLink);
   }
@@ -701,5 +714,9 @@ ConnectionPtr ConnectionManager::FindConnection(const std::string &_host,
 //////////////////////////////////////////////////
 void ConnectionManager::TriggerUpdate()
 {
+  {
+    boost::mutex::scoped_lock lock(this->updateMutex);
+    this->updatePending = true;
+  }
   this->updateCondition.notify_all();
 }
@@ -163,6 +163,9 @@ namespace gazebo
       /// \brief Mutex for updateCondition
       private: boost::mutex updateMutex;
 
+      /// \brief True if an update was triggered since the last one ran.
+      private: bool updatePending;
+
       private: ConnectionPtr masterConn;
       private: Connection *serverConn;
 
@@ -16,9 +16,11 @@
 */
 
 #include <gtest/gtest.h>
+#include <boost/bind.hpp>
 #include <string>
 #include <stdlib.h>
 
+#include "gazebo/common/Time.hh"
 #include "gazebo/transport/Connection.hh"
 #include "test/util.hh"
 
@@ -50,6 +52,71 @@ TEST_F(Connection, IPWhiteList)
     setenv("GAZEBO_IP_WHITE_LIST", ipEnv, 1);
 }
 
+/////////////////////////////////////////////////
+/// \brief Number of messages whose write has completed.
+int g_sentCount = 0;
+
+/// \brief Connection accepted by the server.
+transport::ConnectionPtr g_accepted;
+
+/////////////////////////////////////////////////
+void OnSent(uint32_t /*_id*/)
+{
+  ++g_sentCount;
+}
+
+/////////////////////////////////////////////////
+void OnAccept(transport::ConnectionPtr _conn)
+{
+  g_accepted = _conn;
+}
+
+/////////////////////////////////////////////////
+/// \brief Create the message with the given index.
+/// \param[in] _index Index of the message.
+/// \return Every third message is large, the others are small.
+std::string TestMessage(int _index)
+{
+  return std::string(_index % 3 ? 10 + _index : 100000 + _index,
+      'a' + _index % 26);
+}
+
+/////////////////////////////////////////////////
+// Queued messages, small and large, are gathered into writes and received
+// whole and in order.
+TEST_F(Connection, GatherWrite)
+{
+  transport::Connection *server = new transport::Connection();
+  server->Listen(0, boost::bind(&OnAccept, _1));
+
+  transport::ConnectionPtr client(new transport::Connection());
+  ASSERT_TRUE(client->Connect("127.0.0.1", server->GetLocalPort()));
+
+  for (int i = 0; i < 100 && !g_accepted; ++i)
+    common::Time::MSleep(10);
+  ASSERT_TRUE(g_accepted != NULL);
+
+  const int count = 200;
+  for (int i = 0; i < count; ++i)
+    client->EnqueueMsg(TestMessage(i), boost::bind(&OnSent, _1), i);
+
+  for (int i = 0; i < count; ++i)
+  {
+    std::string data;
+    EXPECT_TRUE(g_accepted->Read(data));
+    EXPECT_EQ(TestMessage(i), data);
+  }
+
+  for (int i = 0; i < 100 && g_sentCount < count; ++i)
+    common::Time::MSleep(10);
+  EXPECT_EQ(count, g_sentCount);
+
+  g_accepted.reset();
+  client.reset();
+  delete server;
+}
+
+/////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,187 @@
+/*
+ * Copyright (C) 2015 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef _GAZEBO_TRANSPORT_MPSCQUEUE_HH_
+#define _GAZEBO_TRANSPORT_MPSCQUEUE_HH_
+
+#include <atomic>
+
+namespace gazebo
+{
+  namespace transport
+  {
+    /// \addtogroup gazebo_transport
+    /// \{
+
+    /// \class MPSCQueue MPSCQueue.hh transport/transport.hh
+    /// \brief An unbounded, lock-free, multiple producer, single consumer
+    /// FIFO queue. Any thread may push, but only one thread at a time may
+    /// pop or check for emptiness.
+    ///
+    /// A push is one atomic exchange. An item becomes visible to the
+    /// consumer only once its push has returned, so a producer that
+    /// signals the consumer after pushing never signals too early.
+    ///
+    /// Links popped by the consumer are kept in a pool and reused by later
+    /// pushes, so a queue that has reached its working size no longer
+    /// allocates.
+    template<typename T>
+    class MPSCQueue
+    {
+      /// \brief Constructor
+      public: MPSCQueue()
+              : head(new Item), tail(head.load()), pool(NULL)
+              {
+              }
+
+      /// \brief Destructor. Discards the items left in the queue.
+      public: ~MPSCQueue()
+              {
+                T value;
+                while (this->Pop(value))
+                {
+                }
+                delete this->tail;
+
+                Item *item = this->pool.load();
+                while (item)
+                {
+                  Item *next = item->next.load(std::memory_order_relaxed);
+                  delete item;
+                  item = next;
+                }
+              }
+
+      /// \brief Add an item at the back of the queue. May be called from
+      /// any thread.
+      /// \param[in] _value The item.
+      public: void Push(const T &_value)
+              {
+                Item *item = this->Allocate();
+                item->value = _value;
+                Item *prev = this->head.exchange(item,
+                    std::memory_order_acq_rel);
+                prev->next.store(item, std::memory_order_release);
+              }
+
+      /// \brief Remove the item at the front of the queue. Consumer only.
+      /// \param[out] _value The item.
+      /// \return False if the queue is empty.
+      public: bool Pop(T &_value)
+              {
+                Item *next = this->tail->next.load(std::memory_order_acquire);
+                if (!next)
+                  return false;
+
+                // The popped item becomes the new sentinel.
+                _value = next->value;
+                next->value = T();
+                this->Release(this->tail, this->tail);
+                this->tail = next;
+                return true;
+              }
+
+      /// \brief Is the queue empty? Consumer only.
+      /// \return True if there is no item to pop.
+      public: bool Empty() const
+              {
+                return !this->tail->next.load(std::memory_order_acquire);
+              }
+
+      /// \brief Prevent copies.
+      private: MPSCQueue(const MPSCQueue &);
+
+      /// \brief Prevent assignment.
+      private: MPSCQueue &operator=(const MPSCQueue &);
+
+      /// \brief A link of the queue.
+      private: class Item
+               {
+                 /// \brief Constructor
+                 public: Item() : next(NULL) {}
+
+                 /// \brief Next item, toward the head.
+                 public: std::atomic<Item*> next;
+
+                 /// \brief The item, empty in the sentinel.
+                 public: T value;
+               };
+
+      /// \brief Take a link from the pool, or allocate one if the pool is
+      /// empty. May be called from any thread.
+      ///
+      /// The pool is only ever emptied as a whole, never popped one link
+      /// at a time, so a link cannot be taken twice when it is released
+      /// and taken again while another producer is preempted.
+      /// \return An unlinked item.
+      private: Item *Allocate()
+               {
+                 Item *item = this->pool.exchange(NULL,
+                     std::memory_order_acquire);
+                 if (!item)
+                   return new Item;
+
+                 Item *rest = item->next.load(std::memory_order_relaxed);
+                 item->next.store(NULL, std::memory_order_relaxed);
+                 if (rest)
+                 {
+                   // Give the other links back. This usually finds the
+                   // pool still empty and needs no walk.
+                   Item *expected = NULL;
+                   if (!this->pool.compare_exchange_strong(expected, rest,
+                         std::memory_order_release, std::memory_order_relaxed))
+                   {
+                     Item *last = rest;
+                     while (Item *next =
+                         last->next.load(std::memory_order_relaxed))
+                     {
+                       last = next;
+                     }
+                     this->Release(rest, last);
+                   }
+                 }
+                 return item;
+               }
+
+      /// \brief Put a chain of links into the pool. May be called from any
+      /// thread.
+      /// \param[in] _first First link of the chain.
+      /// \param[in] _last Last link of the chain.
+      private: void Release(Item *_first, Item *_last)
+               {
+                 Item *top = this->pool.load(std::memory_order_relaxed);
+                 do
+                 {
+                   _last->next.store(top, std::memory_order_relaxed);
+                 }
+                 while (!this->pool.compare_exchange_weak(top, _first,
+                       std::memory_order_release, std::memory_order_relaxed));
+               }
+
+      /// \brief Last item pushed. Shared by the producers.
+      private: std::atomic<Item*> head;
+
+      /// \brief Sentinel in front of the next item to pop. Consumer only.
+      private: Item *tail;
+
+      /// \brief Stack of unused links, linked through Item::next.
+      private: std::atomic<Item*> pool;
+    };
+    /// \}
+  }
+}
+#endif
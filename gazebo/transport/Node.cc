@@ -23,6 +23,7 @@
 
 #include <boost/algorithm/string.hpp>
 #include <boost/bind.hpp>
+#include "gazebo/common/Trace.hh"
 #include "gazebo/transport/TransportIface.hh"
 #include "gazebo/transport/Node.hh"
 
@@ -35,6 +36,7 @@ extern void dummy_callback_fn(uint32_t);
 
 /////////////////////////////////////////////////
 Node::Node()
+  : readyCount(0), processing(false)
 {
   this->id = idCounter++;
   this->topicNamespace = "";
@@ -72,7 +74,12 @@ void Node::Fini()
 
   {
     boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
-    this->callbacks.clear();
+    for (std::map<std::string, TopicQueuePtr>::iterator iter =
+         this->topicQueues.begin(); iter != this->topicQueues.end(); ++iter)
+    {
+      iter->second->ClearCallbacks();
+    }
+    this->topicQueues.clear();
   }
 }
 
@@ -163,158 +170,145 @@ void Node::ProcessPublishers()
 /////////////////////////////////////////////////
 bool Node::HandleData(const std::string &_topic, const std::string &_msg)
 {
-  boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
-  this->incomingMsgs[_topic].push_back(_msg);
-  ConnectionManager::Instance()->TriggerUpdate();
+  return this->HandleData(_topic, SerializedMsgPtr(new std::string(_msg)));
+}
+
+/////////////////////////////////////////////////
+bool Node::HandleData(const std::string &_topic, const SerializedMsgPtr &_msg)
+{
+  TopicQueuePtr queue = this->FindTopicQueue(_topic);
+  if (queue)
+    return this->HandleData(queue, _msg);
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool Node::HandleData(const TopicQueuePtr &_queue,
+    const SerializedMsgPtr &_msg)
+{
+  if (_queue->Push(_msg))
+    this->ScheduleTopicQueue(_queue);
   return true;
 }
 
 /////////////////////////////////////////////////
 bool Node::HandleMessage(const std::string &_topic, MessagePtr _msg)
 {
-  boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
-  this->incomingMsgsLocal[_topic].push_back(_msg);
-  ConnectionManager::Instance()->TriggerUpdate();
+  TopicQueuePtr queue = this->FindTopicQueue(_topic);
+  if (queue)
+    return this->HandleMessage(queue, _msg);
   return true;
 }
 
 /////////////////////////////////////////////////
-void Node::ProcessIncoming()
+bool Node::HandleMessage(const TopicQueuePtr &_queue, MessagePtr _msg)
 {
-  boost::recursive_mutex::scoped_lock lock(this->processIncomingMutex);
+  if (_queue->Push(_msg))
+    this->ScheduleTopicQueue(_queue);
+  return true;
+}
 
-  if (!this->initialized ||
-      (this->incomingMsgs.empty() && this->incomingMsgsLocal.empty()))
-    return;
+/////////////////////////////////////////////////
+void Node::ScheduleTopicQueue(const TopicQueuePtr &_queue)
+{
+  // Only the first message since the last dispatch of the topic gets
+  // here, so the connection manager is woken once per topic.
+  this->readyQueues.Push(_queue);
+  this->readyCount.fetch_add(1);
+  ConnectionManager::Instance()->TriggerUpdate();
+}
 
-  Callback_M::iterator cbIter;
-  Callback_L::iterator liter;
+/////////////////////////////////////////////////
+TopicQueuePtr Node::GetTopicQueue(const std::string &_topic)
+{
+  boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
 
-  // For each topic
-  {
-    std::list<std::string>::iterator msgIter;
-    std::map<std::string, std::list<std::string> >::iterator inIter;
-    std::map<std::string, std::list<std::string> >::iterator endIter;
+  TopicQueuePtr &queue = this->topicQueues[_topic];
+  if (!queue)
+    queue.reset(new TopicQueue(_topic));
+  return queue;
+}
 
-    boost::recursive_mutex::scoped_lock lock2(this->incomingMutex);
-    inIter = this->incomingMsgs.begin();
-    endIter = this->incomingMsgs.end();
+/////////////////////////////////////////////////
+TopicQueuePtr Node::FindTopicQueue(const std::string &_topic) const
+{
+  boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
 
-    for (; inIter != endIter; ++inIter)
-    {
-      // Find the callbacks for the topic
-      cbIter = this->callbacks.find(inIter->first);
-      if (cbIter != this->callbacks.end())
-      {
-        std::list<std::string>::iterator msgInIter;
-        std::list<std::string>::iterator msgEndIter;
-
-        msgInIter = inIter->second.begin();
-        msgEndIter = inIter->second.end();
-
-        // For each message in the buffer
-        for (msgIter = msgInIter; msgIter != msgEndIter; ++msgIter)
-        {
-          // Send the message to all callbacks
-          for (liter = cbIter->second.begin();
-              liter != cbIter->second.end(); ++liter)
-          {
-            (*liter)->HandleData(*msgIter,
-                boost::bind(&dummy_callback_fn, _1), 0);
-          }
-        }
-      }
-    }
+  std::map<std::string, TopicQueuePtr>::const_iterator iter =
+    this->topicQueues.find(_topic);
+  if (iter != this->topicQueues.end())
+    return iter->second;
+  return TopicQueuePtr();
+}
 
-    this->incomingMsgs.clear();
-  }
+/////////////////////////////////////////////////
+void Node::SetLatestOnly(const std::string &_topic, bool _latestOnly)
+{
+  this->GetTopicQueue(this->DecodeTopicName(_topic))->SetLatestOnly(
+      _latestOnly);
+}
 
-  {
-    std::list<MessagePtr>::iterator msgIter;
-    std::map<std::string, std::list<MessagePtr> >::iterator inIter;
-    std::map<std::string, std::list<MessagePtr> >::iterator endIter;
+/////////////////////////////////////////////////
+void Node::ProcessIncoming()
+{
+  GZ_TRACE_SCOPE("Node::ProcessIncoming");
 
-    boost::recursive_mutex::scoped_lock lock2(this->incomingMutex);
-    inIter = this->incomingMsgsLocal.begin();
-    endIter = this->incomingMsgsLocal.end();
+  if (!this->initialized)
+    return;
 
-    for (; inIter != endIter; ++inIter)
+  // The ready queues have a single consumer. A thread that finds another
+  // one dispatching leaves the work to it. The dispatching thread checks
+  // the count after it stops, so that a queue scheduled while it was
+  // stopping is not left behind.
+  while (this->readyCount.load() > 0)
+  {
+    bool expected = false;
+    if (!this->processing.compare_exchange_strong(expected, true))
+      return;
+
+    // User callbacks run without any node lock held.
+    bool popped = false;
+    TopicQueuePtr queue;
+    while (this->readyQueues.Pop(queue))
     {
-      // Find the callbacks for the topic
-      cbIter = this->callbacks.find(inIter->first);
-      if (cbIter != this->callbacks.end())
-      {
-        std::list<MessagePtr>::iterator msgInIter;
-        std::list<MessagePtr>::iterator msgEndIter;
-
-        msgInIter = inIter->second.begin();
-        msgEndIter = inIter->second.end();
-
-        // For each message in the buffer
-        for (msgIter = msgInIter; msgIter != msgEndIter; ++msgIter)
-        {
-          // Send the message to all callbacks
-          for (liter = cbIter->second.begin();
-              liter != cbIter->second.end(); ++liter)
-          {
-            (*liter)->HandleMessage(*msgIter);
-          }
-        }
-      }
+      popped = true;
+      this->readyCount.fetch_sub(1);
+      queue->Dispatch();
     }
+    queue.reset();
+
+    this->processing.store(false);
 
-    this->incomingMsgsLocal.clear();
+    // A count with nothing to pop belongs to a push that is still being
+    // linked. Its producer triggers another update once the link is
+    // visible, so spinning here would only burn this thread.
+    if (!popped)
+      return;
   }
 }
 
 //////////////////////////////////////////////////
 void Node::InsertLatchedMsg(const std::string &_topic, const std::string &_msg)
 {
-  // Find the callbacks for the topic
-  Callback_M::iterator cbIter = this->callbacks.find(_topic);
-
-  if (cbIter != this->callbacks.end())
-  {
-    // Send the message to all callbacks
-    for (Callback_L::iterator liter = cbIter->second.begin();
-         liter != cbIter->second.end(); ++liter)
-    {
-      if ((*liter)->GetLatching())
-      {
-        (*liter)->HandleData(_msg, boost::bind(&dummy_callback_fn, _1), 0);
-        (*liter)->SetLatching(false);
-      }
-    }
-  }
+  TopicQueuePtr queue = this->FindTopicQueue(_topic);
+  if (queue)
+    queue->InsertLatchedMsg(_msg);
 }
 
 //////////////////////////////////////////////////
 void Node::InsertLatchedMsg(const std::string &_topic, MessagePtr _msg)
 {
-  // Find the callbacks for the topic
-  Callback_M::iterator cbIter = this->callbacks.find(_topic);
-
-  if (cbIter != this->callbacks.end())
-  {
-    // Send the message to all callbacks
-    for (Callback_L::iterator liter = cbIter->second.begin();
-         liter != cbIter->second.end(); ++liter)
-    {
-      if ((*liter)->GetLatching())
-      {
-        (*liter)->HandleMessage(_msg);
-        (*liter)->SetLatching(false);
-      }
-    }
-  }
+  TopicQueuePtr queue = this->FindTopicQueue(_topic);
+  if (queue)
+    queue->InsertLatchedMsg(_msg);
 }
 
 /////////////////////////////////////////////////
 std::string Node::GetMsgType(const std::string &_topic) const
 {
-  Callback_M::const_iterator iter = this->callbacks.find(_topic);
-  if (iter != this->callbacks.end() && !iter->second.empty())
-    return iter->second.front()->GetMsgType();
+  TopicQueuePtr queue = this->FindTopicQueue(_topic);
+  if (queue)
+    return queue->GetMsgType();
 
   return std::string();
 }
@@ -322,9 +316,9 @@ std::string Node::GetMsgType(const std::string &_topic) const
 /////////////////////////////////////////////////
 bool Node::HasLatchedSubscriber(const std::string &_topic) const
 {
-  Callback_M::const_iterator iter = this->callbacks.find(_topic);
-  if (iter != this->callbacks.end())
-    return iter->second.front()->GetLatching();
+  TopicQueuePtr queue = this->FindTopicQueue(_topic);
+  if (queue)
+    return queue->HasLatchedCallback();
 
   return false;
 }
@@ -335,24 +329,8 @@ void Node::RemoveCallback(const std::string &_topic, unsigned int _id)
   if (!this->initialized)
     return;
 
-  boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
-
-  // Find the topic list in the map.
-  Callback_M::iterator iter = this->callbacks.find(_topic);
-
-  if (iter != this->callbacks.end())
-  {
-    Callback_L::iterator liter;
-
-    // Find the callback with the correct ID and remove it.
-    for (liter = iter->second.begin(); liter != iter->second.end(); ++liter)
-    {
-      if ((*liter)->GetId() == _id)
-      {
-        (*liter).reset();
-        iter->second.erase(liter);
-        break;
-      }
-    }
-  }
+  // The queue stays in place, since publications keep a pointer to it.
+  TopicQueuePtr queue = this->FindTopicQueue(_topic);
+  if (queue)
+    queue->RemoveCallback(_id);
 }
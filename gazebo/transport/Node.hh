@@ -21,13 +21,16 @@
 #include <tbb/task.h>
 #include <boost/bind.hpp>
 #include <boost/enable_shared_from_this.hpp>
+#include <atomic>
 #include <map>
 #include <list>
 #include <string>
 #include <vector>
 
+#include "gazebo/transport/MPSCQueue.hh"
 #include "gazebo/transport/TransportTypes.hh"
 #include "gazebo/transport/TopicManager.hh"
+#include "gazebo/transport/TopicQueue.hh"
 #include "gazebo/util/system.hh"
 
 namespace gazebo
@@ -182,16 +185,14 @@ namespace gazebo
         std::string decodedTopic = this->DecodeTopicName(_topic);
         ops.template Init<M>(decodedTopic, shared_from_this(), _latching);
 
-        {
-          boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
-          this->callbacks[decodedTopic].push_back(CallbackHelperPtr(
-                new CallbackHelperT<M>(boost::bind(_fp, _obj, _1), _latching)));
-        }
+        CallbackHelperPtr helper(
+            new CallbackHelperT<M>(boost::bind(_fp, _obj, _1), _latching));
+        this->GetTopicQueue(decodedTopic)->AddCallback(helper);
 
         SubscriberPtr result =
           transport::TopicManager::Instance()->Subscribe(ops);
 
-        result->SetCallbackId(this->callbacks[decodedTopic].back()->GetId());
+        result->SetCallbackId(helper->GetId());
 
         return result;
       }
@@ -211,16 +212,13 @@ namespace gazebo
         std::string decodedTopic = this->DecodeTopicName(_topic);
         ops.template Init<M>(decodedTopic, shared_from_this(), _latching);
 
-        {
-          boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
-          this->callbacks[decodedTopic].push_back(
-              CallbackHelperPtr(new CallbackHelperT<M>(_fp, _latching)));
-        }
+        CallbackHelperPtr helper(new CallbackHelperT<M>(_fp, _latching));
+        this->GetTopicQueue(decodedTopic)->AddCallback(helper);
 
         SubscriberPtr result =
           transport::TopicManager::Instance()->Subscribe(ops);
 
-        result->SetCallbackId(this->callbacks[decodedTopic].back()->GetId());
+        result->SetCallbackId(helper->GetId());
 
         return result;
       }
@@ -241,16 +239,14 @@ namespace gazebo
         std::string decodedTopic = this->DecodeTopicName(_topic);
         ops.Init(decodedTopic, shared_from_this(), _latching);
 
-        {
-          boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
-          this->callbacks[decodedTopic].push_back(CallbackHelperPtr(
-                new RawCallbackHelper(boost::bind(_fp, _obj, _1))));
-        }
+        CallbackHelperPtr helper(
+            new RawCallbackHelper(boost::bind(_fp, _obj, _1)));
+        this->GetTopicQueue(decodedTopic)->AddCallback(helper);
 
         SubscriberPtr result =
           transport::TopicManager::Instance()->Subscribe(ops);
 
-        result->SetCallbackId(this->callbacks[decodedTopic].back()->GetId());
+        result->SetCallbackId(helper->GetId());
 
         return result;
       }
@@ -269,16 +265,13 @@ namespace gazebo
         std::string decodedTopic = this->DecodeTopicName(_topic);
         ops.Init(decodedTopic, shared_from_this(), _latching);
 
-        {
-          boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
-          this->callbacks[decodedTopic].push_back(
-              CallbackHelperPtr(new RawCallbackHelper(_fp)));
-        }
+        CallbackHelperPtr helper(new RawCallbackHelper(_fp));
+        this->GetTopicQueue(decodedTopic)->AddCallback(helper);
 
         SubscriberPtr result =
           transport::TopicManager::Instance()->Subscribe(ops);
 
-        result->SetCallbackId(this->callbacks[decodedTopic].back()->GetId());
+        result->SetCallbackId(helper->GetId());
 
         return result;
       }
@@ -290,12 +283,50 @@ namespace gazebo
       public: bool HandleData(const std::string &_topic,
                               const std::string &_msg);
 
+      /// \brief Handle incoming data held in a shared buffer. The buffer
+      /// is queued without being copied.
+      /// \param[in] _topic Topic for which the data was received
+      /// \param[in] _msg The message that was received
+      /// \return true if the message was handled successfully, false otherwise
+      public: bool HandleData(const std::string &_topic,
+                              const SerializedMsgPtr &_msg);
+
+      /// \brief Handle incoming data for a topic queue returned by
+      /// GetTopicQueue. The data is queued without a lookup or a lock.
+      /// \param[in] _queue Queue of the topic.
+      /// \param[in] _msg The message that was received
+      /// \return true if the message was handled successfully, false otherwise
+      public: bool HandleData(const TopicQueuePtr &_queue,
+                              const SerializedMsgPtr &_msg);
+
       /// \brief Handle incoming msg.
       /// \param[in] _topic Topic for which the data was received
       /// \param[in] _msg The message that was received
       /// \return true if the message was handled successfully, false otherwise
       public: bool HandleMessage(const std::string &_topic, MessagePtr _msg);
 
+      /// \brief Handle incoming msg for a topic queue returned by
+      /// GetTopicQueue. The message is queued without a lookup or a lock.
+      /// \param[in] _queue Queue of the topic.
+      /// \param[in] _msg The message that was received
+      /// \return true if the message was handled successfully, false otherwise
+      public: bool HandleMessage(const TopicQueuePtr &_queue,
+                                 MessagePtr _msg);
+
+      /// \brief Get the queue of incoming messages of a topic, creating
+      /// it if needed. Publications resolve it once per subscribed node.
+      /// \param[in] _topic Name of the topic.
+      /// \return The queue of the topic.
+      public: TopicQueuePtr GetTopicQueue(const std::string &_topic);
+
+      /// \brief Set whether only the latest message of a topic is passed
+      /// to the callbacks. Messages superseded before the node processed
+      /// them are dropped. Useful for state topics, where a slow
+      /// subscriber only needs the most recent value.
+      /// \param[in] _topic Name of the topic.
+      /// \param[in] _latestOnly True to keep only the latest message.
+      public: void SetLatestOnly(const std::string &_topic, bool _latestOnly);
+
       /// \brief Add a latched message to the node for publication.
       ///
       /// This is called when a subscription is connected to a
@@ -332,21 +363,35 @@ namespace gazebo
       private: static unsigned int idCounter;
       private: unsigned int id;
 
-      private: typedef std::list<CallbackHelperPtr> Callback_L;
-      private: typedef std::map<std::string, Callback_L> Callback_M;
-      private: Callback_M callbacks;
-      private: std::map<std::string, std::list<std::string> > incomingMsgs;
+      /// \brief Find the queue of a topic.
+      /// \param[in] _topic Name of the topic.
+      /// \return The queue, or NULL if the topic has no queue.
+      private: TopicQueuePtr FindTopicQueue(const std::string &_topic) const;
+
+      /// \brief Add a queue that has new messages to the ready queues.
+      /// \param[in] _queue The queue.
+      private: void ScheduleTopicQueue(const TopicQueuePtr &_queue);
+
+      /// \brief Queues of the subscribed topics, by topic name.
+      private: std::map<std::string, TopicQueuePtr> topicQueues;
+
+      /// \brief Topic queues that have new messages.
+      private: MPSCQueue<TopicQueuePtr> readyQueues;
+
+      /// \brief Number of pushes to readyQueues that have not been popped.
+      /// It is briefly negative when a push is popped before it is
+      /// counted.
+      private: std::atomic<int> readyCount;
 
-      /// \brief List of newly arrive messages
-      private: std::map<std::string, std::list<MessagePtr> > incomingMsgsLocal;
+      /// \brief True while a thread dispatches the ready queues. Only one
+      /// thread may pop them.
+      private: std::atomic<bool> processing;
 
       private: boost::mutex publisherMutex;
       private: boost::mutex publisherDeleteMutex;
-      private: boost::recursive_mutex incomingMutex;
 
-      /// \brief make sure we don't call ProcessingIncoming simultaneously
-      /// from separate threads.
-      private: boost::recursive_mutex processIncomingMutex;
+      /// \brief Guards topicQueues.
+      private: mutable boost::recursive_mutex incomingMutex;
 
       private: bool initialized;
     };
@@ -29,7 +29,8 @@ unsigned int Publication::idCounter = 0;
 
 //////////////////////////////////////////////////
 Publication::Publication(const std::string &_topic, const std::string &_msgType)
-  : topic(_topic), msgType(_msgType), locallyAdvertised(false)
+  : topic(_topic), msgType(_msgType), locallyAdvertised(false),
+    subscriptionGeneration(0)
 {
   this->id = idCounter++;
 }
@@ -44,18 +45,35 @@ Publication::~Publication()
 //////////////////////////////////////////////////
 void Publication::AddSubscription(const NodePtr &_node)
 {
-  std::list<NodePtr>::iterator iter, endIter;
+  ++this->subscriptionGeneration;
 
+  // A removal queued by an earlier Node::Fini must not drop this newer
+  // subscription when RemoveNodes runs.
   {
-    boost::mutex::scoped_lock lock(this->nodeMutex);
-    endIter = this->nodes.end();
-    iter = std::find(this->nodes.begin(), this->nodes.end(), _node);
+    boost::mutex::scoped_lock removeLock(this->nodeRemoveMutex);
+    this->removeNodes.remove(_node->GetId());
   }
 
-  if (iter == endIter)
   {
     boost::mutex::scoped_lock lock(this->nodeMutex);
-    this->nodes.push_back(_node);
+
+    NodeQueue_L::iterator iter;
+    for (iter = this->nodes.begin(); iter != this->nodes.end(); ++iter)
+    {
+      if (iter->first == _node)
+        break;
+    }
+
+    // Resolve the node's queue for the topic here, so that publishing
+    // needs no lookup on the node. The node may have cleared its queues
+    // since it last subscribed, so an existing entry is resolved again.
+    if (iter == this->nodes.end())
+    {
+      this->nodes.push_back(
+          std::make_pair(_node, _node->GetTopicQueue(this->topic)));
+    }
+    else
+      iter->second = _node->GetTopicQueue(this->topic);
   }
 
   boost::mutex::scoped_lock lock(this->callbackMutex);
@@ -82,16 +100,26 @@ void Publication::AddSubscription(const CallbackHelperPtr _callback)
   if (iter == this->callbacks.end())
   {
     this->callbacks.push_back(_callback);
+    ++this->subscriptionGeneration;
 
     if (_callback->GetLatching())
     {
-      // Send latched messages to the subscription.
+      // Send latched messages to the subscription. Remote subscriptions
+      // share the serialized buffer of the latched message.
       for (std::map<uint32_t, MessagePtr>::iterator pubIter =
           this->prevMsgs.begin(); pubIter != this->prevMsgs.end(); ++pubIter)
       {
         if (pubIter->second)
         {
-          _callback->HandleMessage(pubIter->second);
+          if (_callback->IsLocal())
+          {
+            _callback->HandleMessage(pubIter->second);
+          }
+          else
+          {
+            _callback->HandleSerializedData(this->Serialize(pubIter->second),
+                boost::bind(&dummy_callback_fn, _1), 0);
+          }
         }
       }
       _callback->SetLatching(false);
@@ -100,10 +128,15 @@ void Publication::AddSubscription(const CallbackHelperPtr _callback)
 }
 
 //////////////////////////////////////////////////
-void Publication::SetPrevMsg(uint32_t _pubId, MessagePtr _msg)
+void Publication::SetPrevMsg(uint32_t _pubId, MessagePtr _msg,
+    SerializedMsgPtr _data)
 {
   boost::mutex::scoped_lock lock(this->callbackMutex);
   this->prevMsgs[_pubId] = _msg;
+  if (_data)
+    this->prevMsgData[_pubId] = _data;
+  else
+    this->prevMsgData.erase(_pubId);
 }
 
 //////////////////////////////////////////////////
@@ -128,7 +161,8 @@ void Publication::AddTransport(const PublicationTransportPtr &_publink)
   // Don't add a duplicate transport
   if (add)
   {
-    _publink->AddCallback(boost::bind(&Publication::LocalPublish, this, _1));
+    _publink->AddSerializedCallback(
+        boost::bind(&Publication::LocalPublishShared, this, _1));
     this->transports.push_back(_publink);
   }
 }
@@ -179,11 +213,11 @@ void Publication::RemoveSubscription(const NodePtr &_node)
     return;
   }
 
-  std::list<NodePtr>::iterator iter;
+  NodeQueue_L::iterator iter;
 
   for (iter = this->nodes.begin(); iter != this->nodes.end(); ++iter)
   {
-    if ((*iter)->GetId() == _node->GetId())
+    if (iter->first->GetId() == _node->GetId())
     {
       this->nodes.erase(iter);
       break;
@@ -238,7 +272,14 @@ void Publication::RemoveSubscription(const std::string &_host,
 //////////////////////////////////////////////////
 void Publication::LocalPublish(const std::string &_data)
 {
-  std::list<NodePtr>::iterator iter, endIter;
+  // Copy the data once, and share it with all the local subscribers.
+  this->LocalPublishShared(SerializedMsgPtr(new std::string(_data)));
+}
+
+//////////////////////////////////////////////////
+void Publication::LocalPublishShared(const SerializedMsgPtr &_data)
+{
+  NodeQueue_L::iterator iter, endIter;
 
   {
     boost::mutex::scoped_lock lock(this->nodeMutex);
@@ -247,7 +288,7 @@ void Publication::LocalPublish(const std::string &_data)
     endIter = this->nodes.end();
     while (iter != endIter)
     {
-      if ((*iter)->HandleData(this->topic, _data))
+      if (iter->first->HandleData(iter->second, _data))
         ++iter;
       else
         this->nodes.erase(iter++);
@@ -267,7 +308,7 @@ void Publication::LocalPublish(const std::string &_data)
     {
       if ((*cbIter)->IsLocal())
       {
-        if ((*cbIter)->HandleData(_data,
+        if ((*cbIter)->HandleSerializedData(_data,
               boost::bind(&dummy_callback_fn, _1), 0))
           ++cbIter;
         else
@@ -281,10 +322,10 @@ void Publication::LocalPublish(const std::string &_data)
 
 //////////////////////////////////////////////////
 int Publication::Publish(MessagePtr _msg, boost::function<void(uint32_t)> _cb,
-    uint32_t _id)
+    uint32_t _id, SerializedMsgPtr _data)
 {
   int result = 0;
-  std::list<NodePtr>::iterator iter, endIter;
+  NodeQueue_L::iterator iter, endIter;
 
   {
     boost::mutex::scoped_lock lock(this->nodeMutex);
@@ -293,7 +334,7 @@ int Publication::Publish(MessagePtr _msg, boost::function<void(uint32_t)> _cb,
     endIter = this->nodes.end();
     while (iter != endIter)
     {
-      if ((*iter)->HandleMessage(this->topic, _msg))
+      if (iter->first->HandleMessage(iter->second, _msg))
         ++iter;
       else
         this->nodes.erase(iter++);
@@ -310,14 +351,15 @@ int Publication::Publish(MessagePtr _msg, boost::function<void(uint32_t)> _cb,
 
     if (!this->callbacks.empty())
     {
-      std::string data;
-      _msg->SerializeToString(&data);
+      // Serialize once. All subscribers, and the latched message slot,
+      // share the same buffer.
+      SerializedMsgPtr data = _data ? _data : this->Serialize(_msg);
       std::list<CallbackHelperPtr>::iterator cbIter;
       cbIter = this->callbacks.begin();
 
       while (cbIter != this->callbacks.end())
       {
-        if ((*cbIter)->HandleData(data, _cb, _id))
+        if ((*cbIter)->HandleSerializedData(data, _cb, _id))
         {
           ++result;
           ++cbIter;
@@ -366,6 +408,12 @@ unsigned int Publication::GetNodeCount() const
   return this->nodes.size();
 }
 
+//////////////////////////////////////////////////
+unsigned int Publication::GetSubscriptionGeneration() const
+{
+  return this->subscriptionGeneration;
+}
+
 //////////////////////////////////////////////////
 unsigned int Publication::GetRemoteSubscriptionCount()
 {
@@ -423,7 +471,7 @@ void Publication::RemoveNodes()
 
   // Remove queued nodes.
   {
-    std::list<NodePtr>::iterator nodeIter;
+    NodeQueue_L::iterator nodeIter;
 
     for (std::list<unsigned int>::iterator iter = this->removeNodes.begin();
         iter != this->removeNodes.end(); ++iter)
@@ -432,7 +480,7 @@ void Publication::RemoveNodes()
       for (nodeIter = this->nodes.begin(); nodeIter != this->nodes.end();
           ++nodeIter)
       {
-        if ((*nodeIter)->GetId() == (*iter))
+        if (nodeIter->first->GetId() == (*iter))
         {
           this->nodes.erase(nodeIter);
           break;
@@ -494,3 +542,44 @@ MessagePtr Publication::GetPrevMsg(uint32_t _pubId)
   else
     return MessagePtr();
 }
+
+//////////////////////////////////////////////////
+SerializedMsgPtr Publication::GetPrevMsgData(uint32_t _pubId)
+{
+  boost::mutex::scoped_lock lock(this->callbackMutex);
+
+  std::map<uint32_t, MessagePtr>::iterator iter = this->prevMsgs.find(_pubId);
+  if (iter == this->prevMsgs.end() || !iter->second)
+    return SerializedMsgPtr();
+
+  return this->Serialize(iter->second);
+}
+
+//////////////////////////////////////////////////
+SerializedMsgPtr Publication::Serialize(MessagePtr _msg)
+{
+  // A message that is also a latched message only needs to be serialized
+  // once. There is normally only one publisher per topic.
+  std::map<uint32_t, MessagePtr>::iterator iter;
+  for (iter = this->prevMsgs.begin(); iter != this->prevMsgs.end(); ++iter)
+  {
+    if (iter->second == _msg)
+      break;
+  }
+
+  if (iter != this->prevMsgs.end())
+  {
+    std::map<uint32_t, SerializedMsgPtr>::iterator dataIter =
+      this->prevMsgData.find(iter->first);
+    if (dataIter != this->prevMsgData.end())
+      return dataIter->second;
+  }
+
+  boost::shared_ptr<std::string> data(new std::string);
+  _msg->SerializeToString(data.get());
+
+  if (iter != this->prevMsgs.end())
+    this->prevMsgData[iter->first] = data;
+
+  return data;
+}
@@ -18,6 +18,7 @@
 #ifndef _PUBLICATION_HH_
 #define _PUBLICATION_HH_
 
+#include <atomic>
 #include <utility>
 #include <boost/function.hpp>
 #include <boost/shared_ptr.hpp>
@@ -93,6 +94,12 @@ namespace gazebo
       /// \return The number of nodes
       public: unsigned int GetNodeCount() const;
 
+      /// \brief Get a counter that increases every time a subscription is
+      /// added, including a subscription of a node that already subscribes
+      /// to the topic.
+      /// \return The number of subscriptions added so far.
+      public: unsigned int GetSubscriptionGeneration() const;
+
       /// \brief Get the number of remote subscriptions
       /// \return The number of remote subscriptions
       public: unsigned int GetRemoteSubscriptionCount();
@@ -111,15 +118,24 @@ namespace gazebo
       /// \param[in] _data The data to be published
       public: void LocalPublish(const std::string &_data);
 
+      /// \brief Publish data to local subscribers without copying it.
+      /// \param[in] _data The data to be published. It must not be
+      /// modified after this call.
+      public: void LocalPublishShared(const SerializedMsgPtr &_data);
+
       /// \brief Publish data to remote subscribers
       /// \param[in] _msg Message to be published
       /// \param[in] _cb Callback to be invoked after publishing
       /// is completed
+      /// \param[in] _id ID of the message, passed to _cb.
+      /// \param[in] _data _msg serialized, NULL to serialize it when it
+      /// is needed.
       /// \return Number of remote subscribers that will receive the
       /// message.
       public: int Publish(MessagePtr _msg,
                   boost::function<void(uint32_t)> _cb,
-                  uint32_t _id);
+                  uint32_t _id,
+                  SerializedMsgPtr _data = SerializedMsgPtr());
 
       /// \brief Remove a publisher.
       /// \param[in] _pub Pointer to publisher object to remove.
@@ -128,7 +144,10 @@ namespace gazebo
       /// \brief Set the previous message for a publisher.
       /// \param[in] _pubId ID of the publisher.
       /// \param[in] _msg The previous message.
-      public: void SetPrevMsg(uint32_t _pubId, MessagePtr _msg);
+      /// \param[in] _data _msg serialized, NULL to serialize it when it
+      /// is needed.
+      public: void SetPrevMsg(uint32_t _pubId, MessagePtr _msg,
+                  SerializedMsgPtr _data = SerializedMsgPtr());
 
       /// \brief Get a previous message for a publisher.
       /// \param[in] _pubId ID of the publisher.
@@ -136,6 +155,14 @@ namespace gazebo
       /// previous message.
       public: MessagePtr GetPrevMsg(uint32_t _pubId);
 
+      /// \brief Get the serialized form of a publisher's previous message.
+      /// The message is serialized at most once, and the buffer is shared
+      /// with every remote subscriber that received it.
+      /// \param[in] _pubId ID of the publisher.
+      /// \return Pointer to the serialized previous message. NULL if there
+      /// is no previous message.
+      public: SerializedMsgPtr GetPrevMsgData(uint32_t _pubId);
+
       /// \brief Add a transport
       /// \param[in] _publink Pointer to publication transport object to
       /// be added
@@ -154,6 +181,13 @@ namespace gazebo
       /// \brief Remove nodes that have been marked for removal
       private: void RemoveNodes();
 
+      /// \brief Get the serialized form of a message, reusing the buffer
+      /// cached for a latched message if the message is latched. The
+      /// callbackMutex must be locked by the caller.
+      /// \param[in] _msg The message to serialize.
+      /// \return Pointer to the serialized message.
+      private: SerializedMsgPtr Serialize(MessagePtr _msg);
+
       /// \brief Unique if of the publication.
       private: unsigned int id;
 
@@ -169,8 +203,12 @@ namespace gazebo
       /// \brief Remote nodes that receieve messages.
       private: std::list<CallbackHelperPtr> callbacks;
 
+      /// \brief A local node and its queue for the topic.
+      private: typedef std::list<std::pair<NodePtr, TopicQueuePtr> >
+               NodeQueue_L;
+
       /// \brief Local nodes that recieve messages.
-      private: std::list<NodePtr> nodes;
+      private: NodeQueue_L nodes;
 
       /// \brief List of node IDs to remove from nodes list.
       private: std::list<unsigned int> removeNodes;
@@ -187,6 +225,9 @@ namespace gazebo
       /// \brief True if the publication is advertised in the same process.
       private: bool locallyAdvertised;
 
+      /// \brief Number of subscriptions added so far.
+      private: std::atomic<unsigned int> subscriptionGeneration;
+
       /// \brief Mutex to protect the list of nodes.
       private: mutable boost::mutex nodeMutex;
 
@@ -198,6 +239,10 @@ namespace gazebo
 
       /// \brief Publishers and their last messages.
       private: std::map<uint32_t, MessagePtr> prevMsgs;
+
+      /// \brief Publishers and their last messages in serialized form.
+      /// An entry is only present once the message has been serialized.
+      private: std::map<uint32_t, SerializedMsgPtr> prevMsgData;
     };
     /// \}
   }
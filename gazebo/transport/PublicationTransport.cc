@@ -21,8 +21,14 @@
   #include <Winsock2.h>
 #endif
 
+#ifndef _WIN32
+  #include <unistd.h>
+#endif
+
+#include <stdlib.h>
 #include <boost/bind.hpp>
 #include <boost/function.hpp>
+#include <boost/lexical_cast.hpp>
 #include "gazebo/transport/TopicManager.hh"
 #include "gazebo/transport/ConnectionManager.hh"
 #include "gazebo/transport/PublicationTransport.hh"
@@ -32,6 +38,17 @@ using namespace transport;
 
 int PublicationTransport::counter = 0;
 
+/// \brief Message types that are large enough to benefit from shared memory.
+static const char *ShmMsgTypes[] =
+{
+  "gazebo.msgs.Image",
+  "gazebo.msgs.ImageStamped",
+  "gazebo.msgs.ImagesStamped",
+  "gazebo.msgs.LaserScanStamped",
+  "gazebo.msgs.PointCloud",
+  NULL
+};
+
 /////////////////////////////////////////////////
 PublicationTransport::PublicationTransport(const std::string &_topic,
                                            const std::string &_msgType)
@@ -71,6 +88,10 @@ void PublicationTransport::Init(const ConnectionPtr &_conn, bool _latched)
   sub.set_port(this->connection->GetLocalPort());
   sub.set_latching(_latched);
 
+  std::string shmName = this->CreateShm();
+  if (!shmName.empty())
+    sub.set_shm_name(shmName);
+
   this->connection->EnqueueMsg(msgs::Package("sub", sub));
 
   // Put this in PublicationTransportPtr
@@ -87,6 +108,13 @@ void PublicationTransport::AddCallback(
   this->callback = cb_;
 }
 
+/////////////////////////////////////////////////
+void PublicationTransport::AddSerializedCallback(
+    const boost::function<void(const SerializedMsgPtr &)> &_cb)
+{
+  this->serializedCallback = _cb;
+}
+
 /////////////////////////////////////////////////
 void PublicationTransport::OnPublish(const std::string &_data)
 {
@@ -95,12 +123,88 @@ void PublicationTransport::OnPublish(const std::string &_data)
     this->connection->AsyncRead(
         boost::bind(&PublicationTransport::OnPublish, this, _1));
 
-    if (!_data.empty())
+    if (_data.empty() || (!this->callback && !this->serializedCallback))
+      return;
+
+    // Copy the data once, into the buffer given to the subscribers.
+    boost::shared_ptr<std::string> data;
+
+    // The publisher attaches to the shared memory buffer before sending
+    // any data. From then on each frame says where the data is.
+    if (this->shm && this->shm->Attached())
+    {
+      if (_data[0] == GZ_SHM_FRAME_BUFFER)
+      {
+        data.reset(new std::string);
+        if (!this->shm->Read(*data))
+          return;
+      }
+      else if (_data[0] == GZ_SHM_FRAME_INLINE)
+        data.reset(new std::string(_data, 1));
+      else
+        return;
+    }
+    else if (!this->serializedCallback)
+    {
+      (this->callback)(_data);
+      return;
+    }
+    else
+      data.reset(new std::string(_data));
+
+    if (this->serializedCallback)
+      (this->serializedCallback)(data);
+    else
+      (this->callback)(*data);
+  }
+}
+
+/////////////////////////////////////////////////
+std::string PublicationTransport::CreateShm()
+{
+  if (!ShmBuffer::IsSupported())
+    return std::string();
+
+  bool largeType = false;
+  for (unsigned int i = 0; ShmMsgTypes[i] != NULL && !largeType; ++i)
+    largeType = this->msgType == ShmMsgTypes[i];
+
+  // Only use shared memory if the publisher is on this host.
+  if (!largeType || this->connection->GetRemoteAddress() !=
+      this->connection->GetLocalAddress())
+  {
+    return std::string();
+  }
+
+  size_t sizeMB = 16;
+  char *sizeEnv = getenv("GAZEBO_SHM_SIZE");
+  if (sizeEnv)
+  {
+    try
+    {
+      sizeMB = boost::lexical_cast<size_t>(sizeEnv);
+    }
+    catch(...)
     {
-      if (this->callback)
-        (this->callback)(_data);
+      gzwarn << "Invalid GAZEBO_SHM_SIZE[" << sizeEnv << "]\n";
     }
   }
+
+  if (sizeMB == 0)
+    return std::string();
+
+  std::string name;
+#ifndef _WIN32
+  name = "/gazebo-" + boost::lexical_cast<std::string>(getpid()) + "-" +
+    boost::lexical_cast<std::string>(this->id);
+#endif
+
+  ShmBufferPtr buffer(new ShmBuffer());
+  if (!buffer->Create(name, sizeMB * 1024 * 1024))
+    return std::string();
+
+  this->shm = buffer;
+  return name;
 }
 
 /////////////////////////////////////////////////
@@ -23,6 +23,7 @@
 #include <string>
 
 #include "gazebo/transport/Connection.hh"
+#include "gazebo/transport/ShmBuffer.hh"
 #include "gazebo/common/Event.hh"
 #include "gazebo/util/system.hh"
 
@@ -37,6 +38,15 @@ namespace gazebo
     /// transport/transport.hh
     /// \brief Reads data from a remote advertiser, and passes the data
     /// along to local subscribers
+    ///
+    /// \remarks
+    ///  When the advertiser runs on the same host, image, laser scan and
+    ///  point cloud data is received through a shared memory buffer
+    ///  instead of the socket. The advertiser falls back to the socket if
+    ///  it can't open the buffer.
+    ///  Environment Variables:
+    ///   - GAZEBO_SHM_SIZE: Size of each shared memory buffer in megabytes.
+    /// The default is 16. Set to 0 to disable shared memory transport.
     class GZ_TRANSPORT_VISIBLE PublicationTransport
     {
       /// \brief Constructor
@@ -62,6 +72,13 @@ namespace gazebo
       public: void AddCallback(
                   const boost::function<void(const std::string &)> &_cb);
 
+      /// \brief Add a callback that takes ownership of the received data.
+      /// It is used instead of the callback set by AddCallback, and saves
+      /// a copy of every message.
+      /// \param[in] _cb The callback to be added
+      public: void AddSerializedCallback(
+                  const boost::function<void(const SerializedMsgPtr &)> &_cb);
+
       /// \brief Get the underlying connection
       /// \return Pointer to the underlying connection
       public: const ConnectionPtr GetConnection() const;
@@ -78,6 +95,12 @@ namespace gazebo
       /// \param[in] _data Data to be published.
       private: void OnPublish(const std::string &_data);
 
+      /// \brief Create a shared memory buffer for the publisher, if the
+      /// publisher is on this host and the message type is large.
+      /// \return Name of the buffer, or an empty string if no buffer was
+      /// created.
+      private: std::string CreateShm();
+
       /// \brief The topic for this publication transport.
       private: std::string topic;
 
@@ -90,11 +113,20 @@ namespace gazebo
       /// \brief Callback used when OnPublish is called.
       private: boost::function<void (const std::string &)> callback;
 
+      /// \brief Callback used when OnPublish is called, that takes the
+      /// received data.
+      private: boost::function<void (const SerializedMsgPtr &)>
+               serializedCallback;
+
       /// \brief Counter to give the publication transport a unique id.
       private: static int counter;
 
       /// \brief The unique id for the publication transport.
       private: int id;
+
+      /// \brief Shared memory buffer used by a publisher on this host.
+      private: ShmBufferPtr shm;
+
     };
     /// \}
   }
@@ -64,6 +64,21 @@ bool Publisher::HasConnections() const
        this->publication->GetNodeCount() > 0));
 }
 
+//////////////////////////////////////////////////
+unsigned int Publisher::GetSubscriptionGeneration() const
+{
+  if (!this->publication)
+    return 0;
+
+  return this->publication->GetSubscriptionGeneration();
+}
+
+//////////////////////////////////////////////////
+bool Publisher::HasSerializedConnections() const
+{
+  return this->publication && this->publication->GetCallbackCount() > 0;
+}
+
 //////////////////////////////////////////////////
 void Publisher::WaitForConnection() const
 {
@@ -90,6 +105,29 @@ bool Publisher::WaitForConnection(const common::Time &_timeout) const
 //////////////////////////////////////////////////
 void Publisher::PublishImpl(const google::protobuf::Message &_message,
                             bool _block)
+{
+  if (!this->CanPublish(_message))
+    return;
+
+  // Save the latest message
+  MessagePtr msgPtr(_message.New());
+  msgPtr->CopyFrom(_message);
+
+  this->QueueMessage(msgPtr, SerializedMsgPtr(), _block);
+}
+
+//////////////////////////////////////////////////
+void Publisher::Publish(MessagePtr _message, SerializedMsgPtr _data,
+                        bool _block)
+{
+  if (!_message || !this->CanPublish(*_message))
+    return;
+
+  this->QueueMessage(_message, _data, _block);
+}
+
+//////////////////////////////////////////////////
+bool Publisher::CanPublish(const google::protobuf::Message &_message)
 {
   if (_message.GetTypeName() != this->msgType)
     gzthrow("Invalid message type\n");
@@ -99,7 +137,7 @@ void Publisher::PublishImpl(const google::protobuf::Message &_message,
     gzerr << "Publishing an uninitialized message on topic[" <<
       this->topic << "]. Required field [" <<
       _message.InitializationErrorString() << "] missing.\n";
-    return;
+    return false;
   }
 
   // Check if a throttling rate has been set
@@ -113,23 +151,26 @@ void Publisher::PublishImpl(const google::protobuf::Message &_message,
         (this->currentTime - this->prevPublishTime).Double() <
         this->updatePeriod)
     {
-      return;
+      return false;
     }
 
     // Set the previous time a message was published
     this->prevPublishTime = this->currentTime;
   }
 
-  // Save the latest message
-  MessagePtr msgPtr(_message.New());
-  msgPtr->CopyFrom(_message);
+  return true;
+}
 
-  this->publication->SetPrevMsg(this->id, msgPtr);
+//////////////////////////////////////////////////
+void Publisher::QueueMessage(MessagePtr _message, SerializedMsgPtr _data,
+                             bool _block)
+{
+  this->publication->SetPrevMsg(this->id, _message, _data);
 
   {
     boost::mutex::scoped_lock lock(this->mutex);
 
-    this->messages.push_back(msgPtr);
+    this->messages.push_back(std::make_pair(_message, _data));
 
     if (this->messages.size() > this->queueLimit)
     {
@@ -162,7 +203,7 @@ void Publisher::PublishImpl(const google::protobuf::Message &_message,
 //////////////////////////////////////////////////
 void Publisher::SendMessage()
 {
-  std::list<MessagePtr> localBuffer;
+  std::list<std::pair<MessagePtr, SerializedMsgPtr> > localBuffer;
   std::list<uint32_t> localIds;
 
   {
@@ -188,12 +229,13 @@ void Publisher::SendMessage()
     std::list<uint32_t>::iterator pubIter = localIds.begin();
 
     // Send all the current messages
-    for (std::list<MessagePtr>::iterator iter = localBuffer.begin();
+    for (auto iter = localBuffer.begin();
         iter != localBuffer.end(); ++iter, ++pubIter)
     {
       // Send the latest message.
-      this->pubIds[*pubIter] = this->publication->Publish(*iter,
-          boost::bind(&Publisher::OnPublishComplete, this, _1), *pubIter);
+      this->pubIds[*pubIter] = this->publication->Publish(iter->first,
+          boost::bind(&Publisher::OnPublishComplete, this, _1), *pubIter,
+          iter->second);
 
       if (this->pubIds[*pubIter] <= 0)
         this->pubIds.erase(*pubIter);
@@ -273,9 +315,9 @@ std::string Publisher::GetPrevMsg() const
   std::string result;
   if (this->publication)
   {
-    MessagePtr msg = this->publication->GetPrevMsg(this->id);
-    if (msg)
-      msg->SerializeToString(&result);
+    SerializedMsgPtr data = this->publication->GetPrevMsgData(this->id);
+    if (data)
+      result = *data;
   }
 
   return result;
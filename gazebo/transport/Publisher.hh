@@ -26,6 +26,7 @@
 #include <string>
 #include <list>
 #include <map>
+#include <utility>
 
 #include "gazebo/common/Time.hh"
 #include "gazebo/transport/TransportTypes.hh"
@@ -58,6 +59,17 @@ namespace gazebo
       /// \return true if there are any connections, false otherwise
       public: bool HasConnections() const;
 
+      /// \brief Get a counter that increases every time a subscription to
+      /// the topic is added. A new subscription of a node that already
+      /// subscribes to the topic also increases it.
+      /// \return The number of subscriptions added so far.
+      public: unsigned int GetSubscriptionGeneration() const;
+
+      /// \brief Are there any subscribers that receive the message
+      /// serialized, such as subscribers in other processes?
+      /// \return True if a published message will be serialized.
+      public: bool HasSerializedConnections() const;
+
       /// \brief Block until a connection has been established with this
       ///        publisher
       public: void WaitForConnection() const;
@@ -89,6 +101,17 @@ namespace gazebo
               void Publish(M _message, bool _block = false)
               { this->PublishImpl(_message, _block); }
 
+      /// \brief Publish a message that may be shared with other
+      /// publishers. The message is not copied, so it must not be modified
+      /// after this call.
+      /// \param[in] _message Message to be published.
+      /// \param[in] _data _message serialized, used instead of serializing
+      /// the message again. May be NULL.
+      /// \param[in] _block Whether to block until the message is actually
+      /// written out
+      public: void Publish(MessagePtr _message, SerializedMsgPtr _data,
+                  bool _block = false);
+
       /// \brief Get the number of outgoing messages
       /// \return The number of outgoing messages
       public: unsigned int GetOutgoingCount() const;
@@ -127,6 +150,20 @@ namespace gazebo
       private: void PublishImpl(const google::protobuf::Message &_message,
                                 bool _block);
 
+      /// \brief Check the type of a message, and whether the update rate
+      /// allows publishing it now.
+      /// \param[in] _message Message to be published.
+      /// \return True if the message can be published.
+      private: bool CanPublish(const google::protobuf::Message &_message);
+
+      /// \brief Queue a message for publication.
+      /// \param[in] _message Message to be published.
+      /// \param[in] _data _message serialized, may be NULL.
+      /// \param[in] _block Whether to block until the message is actually
+      /// written out.
+      private: void QueueMessage(MessagePtr _message, SerializedMsgPtr _data,
+                                 bool _block);
+
       /// \brief Callback when a publish is completed
       /// \param[in] _id ID associated with the publication.
       private: void OnPublishComplete(uint32_t _id);
@@ -149,8 +186,9 @@ namespace gazebo
       /// was produced.
       private: bool queueLimitWarned;
 
-      /// \brief List of messages to publish.
-      private: std::list<MessagePtr> messages;
+      /// \brief List of messages to publish, with their serialized data
+      /// when it was given to Publish.
+      private: std::list<std::pair<MessagePtr, SerializedMsgPtr> > messages;
 
       /// \brief For mutual exclusion.
       private: mutable boost::mutex mutex;
@@ -0,0 +1,317 @@
+/*
+ * Copyright (C) 2015 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef _WIN32
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+#include <errno.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <new>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/transport/ShmBuffer.hh"
+
+using namespace gazebo;
+using namespace transport;
+
+/// \brief Value used to check that a mapped region is a ShmBuffer.
+static const uint32_t SHM_BUFFER_MAGIC = 0x475a5348;
+
+/// \brief Size of the length prefix of each message in the ring.
+static const size_t SHM_LENGTH_SIZE = sizeof(uint32_t);
+
+namespace gazebo
+{
+  namespace transport
+  {
+    /// \cond
+    /// \brief Header placed at the start of the shared memory region.
+    /// Head and tail count bytes since the start of the stream; the ring
+    /// offset is the count modulo the capacity.
+    class ShmBufferHeader
+    {
+      /// \brief Bytes written by the producer.
+      public: std::atomic<uint64_t> head;
+
+      /// \brief Bytes consumed by the consumer.
+      public: std::atomic<uint64_t> tail;
+
+      /// \brief Number of bytes available for messages.
+      public: uint64_t capacity;
+
+      /// \brief Non-zero once a writer has opened the buffer.
+      public: std::atomic<uint32_t> attached;
+
+      /// \brief Set to SHM_BUFFER_MAGIC once the header is initialized.
+      public: uint32_t magic;
+    };
+    /// \endcond
+  }
+}
+
+//////////////////////////////////////////////////
+ShmBuffer::ShmBuffer()
+  : header(NULL), data(NULL), mappedSize(0), owner(false)
+{
+}
+
+//////////////////////////////////////////////////
+ShmBuffer::~ShmBuffer()
+{
+  if (this->owner)
+    this->Unlink();
+  this->Close();
+}
+
+//////////////////////////////////////////////////
+bool ShmBuffer::IsSupported()
+{
+#ifdef _WIN32
+  return false;
+#else
+  return std::atomic<uint64_t>().is_lock_free();
+#endif
+}
+
+//////////////////////////////////////////////////
+bool ShmBuffer::Create(const std::string &_name, size_t _capacity)
+{
+#ifdef _WIN32
+  return false;
+#else
+  this->Close();
+
+  if (!IsSupported() || _capacity <= SHM_LENGTH_SIZE)
+    return false;
+
+  int fd = shm_open(_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0)
+  {
+    gzerr << "Unable to create shared memory buffer[" << _name << "]: "
+          << strerror(errno) << "\n";
+    return false;
+  }
+
+  size_t size = sizeof(ShmBufferHeader) + _capacity;
+  if (ftruncate(fd, size) != 0)
+  {
+    gzerr << "Unable to size shared memory buffer[" << _name << "]: "
+          << strerror(errno) << "\n";
+    close(fd);
+    shm_unlink(_name.c_str());
+    return false;
+  }
+
+  void *addr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (addr == MAP_FAILED)
+  {
+    gzerr << "Unable to map shared memory buffer[" << _name << "]: "
+          << strerror(errno) << "\n";
+    shm_unlink(_name.c_str());
+    return false;
+  }
+
+  this->name = _name;
+  this->owner = true;
+  this->mappedSize = size;
+  this->header = new (addr) ShmBufferHeader;
+  this->header->head.store(0);
+  this->header->tail.store(0);
+  this->header->capacity = _capacity;
+  this->header->attached.store(0);
+  this->header->magic = SHM_BUFFER_MAGIC;
+  this->data = static_cast<char *>(addr) + sizeof(ShmBufferHeader);
+
+  return true;
+#endif
+}
+
+//////////////////////////////////////////////////
+bool ShmBuffer::Open(const std::string &_name)
+{
+#ifdef _WIN32
+  return false;
+#else
+  this->Close();
+
+  if (!IsSupported())
+    return false;
+
+  int fd = shm_open(_name.c_str(), O_RDWR, 0600);
+  if (fd < 0)
+    return false;
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 ||
+      static_cast<size_t>(st.st_size) <= sizeof(ShmBufferHeader))
+  {
+    close(fd);
+    return false;
+  }
+
+  size_t size = st.st_size;
+  void *addr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (addr == MAP_FAILED)
+    return false;
+
+  ShmBufferHeader *hdr = static_cast<ShmBufferHeader *>(addr);
+  if (hdr->magic != SHM_BUFFER_MAGIC ||
+      hdr->capacity != size - sizeof(ShmBufferHeader))
+  {
+    munmap(addr, size);
+    return false;
+  }
+
+  this->name = _name;
+  this->owner = false;
+  this->mappedSize = size;
+  this->header = hdr;
+  this->data = static_cast<char *>(addr) + sizeof(ShmBufferHeader);
+  this->header->attached.store(1, std::memory_order_release);
+
+  // The creator and this process hold the only mappings that will ever be
+  // needed. Without a name, the memory is freed once both unmap it, even
+  // if no message is ever sent.
+  shm_unlink(_name.c_str());
+
+  return true;
+#endif
+}
+
+//////////////////////////////////////////////////
+void ShmBuffer::Unlink()
+{
+#ifndef _WIN32
+  // A writer that attached has already removed the name.
+  if (this->owner && !this->name.empty() && !this->Attached())
+    shm_unlink(this->name.c_str());
+#endif
+  this->owner = false;
+}
+
+//////////////////////////////////////////////////
+void ShmBuffer::Close()
+{
+#ifndef _WIN32
+  if (this->header)
+    munmap(this->header, this->mappedSize);
+#endif
+  this->header = NULL;
+  this->data = NULL;
+  this->mappedSize = 0;
+}
+
+//////////////////////////////////////////////////
+bool ShmBuffer::Write(const std::string &_data)
+{
+  if (!this->header)
+    return false;
+
+  uint64_t capacity = this->header->capacity;
+  uint64_t head = this->header->head.load(std::memory_order_relaxed);
+  uint64_t tail = this->header->tail.load(std::memory_order_acquire);
+
+  uint64_t required = SHM_LENGTH_SIZE + _data.size();
+  if (required > capacity - (head - tail))
+    return false;
+
+  uint32_t length = static_cast<uint32_t>(_data.size());
+  this->CopyIn(head, reinterpret_cast<const char *>(&length), SHM_LENGTH_SIZE);
+  this->CopyIn(head + SHM_LENGTH_SIZE, _data.data(), _data.size());
+
+  this->header->head.store(head + required, std::memory_order_release);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool ShmBuffer::Read(std::string &_data)
+{
+  if (!this->header)
+    return false;
+
+  uint64_t tail = this->header->tail.load(std::memory_order_relaxed);
+  uint64_t head = this->header->head.load(std::memory_order_acquire);
+
+  if (head - tail < SHM_LENGTH_SIZE)
+    return false;
+
+  uint32_t length = 0;
+  this->CopyOut(tail, reinterpret_cast<char *>(&length), SHM_LENGTH_SIZE);
+  if (head - tail < SHM_LENGTH_SIZE + length)
+  {
+    gzerr << "Corrupt shared memory buffer[" << this->name << "]\n";
+    return false;
+  }
+
+  _data.resize(length);
+  if (length > 0)
+    this->CopyOut(tail + SHM_LENGTH_SIZE, &_data[0], length);
+
+  this->header->tail.store(tail + SHM_LENGTH_SIZE + length,
+      std::memory_order_release);
+  return true;
+}
+
+//////////////////////////////////////////////////
+void ShmBuffer::CopyIn(uint64_t _pos, const char *_data, size_t _size)
+{
+  size_t capacity = this->header->capacity;
+  size_t offset = _pos % capacity;
+  size_t first = std::min(_size, capacity - offset);
+
+  memcpy(this->data + offset, _data, first);
+  if (first < _size)
+    memcpy(this->data, _data + first, _size - first);
+}
+
+//////////////////////////////////////////////////
+void ShmBuffer::CopyOut(uint64_t _pos, char *_data, size_t _size) const
+{
+  size_t capacity = this->header->capacity;
+  size_t offset = _pos % capacity;
+  size_t first = std::min(_size, capacity - offset);
+
+  memcpy(_data, this->data + offset, first);
+  if (first < _size)
+    memcpy(_data + first, this->data, _size - first);
+}
+
+//////////////////////////////////////////////////
+bool ShmBuffer::Attached() const
+{
+  return this->header &&
+    this->header->attached.load(std::memory_order_acquire) != 0;
+}
+
+//////////////////////////////////////////////////
+std::string ShmBuffer::GetName() const
+{
+  return this->name;
+}
+
+//////////////////////////////////////////////////
+size_t ShmBuffer::GetCapacity() const
+{
+  return this->header ? this->header->capacity : 0;
+}
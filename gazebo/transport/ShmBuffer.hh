@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2015 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef _GAZEBO_TRANSPORT_SHMBUFFER_HH_
+#define _GAZEBO_TRANSPORT_SHMBUFFER_HH_
+
+#include <stdint.h>
+#include <boost/shared_ptr.hpp>
+#include <string>
+
+#include "gazebo/util/system.hh"
+
+/// \brief First byte of a frame on a connection that uses a shared memory
+/// buffer, when the message data is in the buffer.
+#define GZ_SHM_FRAME_BUFFER 's'
+
+/// \brief First byte of a frame on a connection that uses a shared memory
+/// buffer, when the message data follows in the frame because the buffer
+/// was full.
+#define GZ_SHM_FRAME_INLINE 'd'
+
+namespace gazebo
+{
+  namespace transport
+  {
+    /// \addtogroup gazebo_transport
+    /// \{
+
+    /// \cond
+    /// \brief Layout of the shared memory region. Defined in ShmBuffer.cc.
+    class ShmBufferHeader;
+    /// \endcond
+
+    /// \class ShmBuffer ShmBuffer.hh transport/transport.hh
+    /// \brief A single producer, single consumer ring buffer of messages
+    /// in POSIX shared memory. It is used to pass message data between a
+    /// publisher and a subscriber that run on the same host, without
+    /// copying the data through a socket.
+    ///
+    /// The subscriber creates the buffer and is the only reader. The
+    /// publisher opens the buffer by name and is the only writer.
+    class GZ_TRANSPORT_VISIBLE ShmBuffer
+    {
+      /// \brief Constructor
+      public: ShmBuffer();
+
+      /// \brief Destructor. Unmaps the buffer, and removes its name if
+      /// this buffer created it.
+      public: virtual ~ShmBuffer();
+
+      /// \brief Create a new shared memory buffer.
+      /// \param[in] _name Name of the buffer. Must start with a '/'.
+      /// \param[in] _capacity Number of bytes available for messages.
+      /// \return True if the buffer was created.
+      public: bool Create(const std::string &_name, size_t _capacity);
+
+      /// \brief Open a shared memory buffer created by another process,
+      /// and mark it as attached. The name of the buffer is removed, since
+      /// both processes have mapped it, so it does not outlive them.
+      /// \param[in] _name Name of the buffer.
+      /// \return True if the buffer was opened.
+      public: bool Open(const std::string &_name);
+
+      /// \brief Remove the name of the buffer. Processes that have already
+      /// mapped the buffer can keep using it.
+      public: void Unlink();
+
+      /// \brief Append a message to the buffer.
+      /// \param[in] _data Message data.
+      /// \return False if there is not enough free space for the message.
+      public: bool Write(const std::string &_data);
+
+      /// \brief Remove the oldest message from the buffer.
+      /// \param[out] _data Message data.
+      /// \return False if the buffer is empty.
+      public: bool Read(std::string &_data);
+
+      /// \brief Has a writer opened this buffer?
+      /// \return True if a writer has opened the buffer.
+      public: bool Attached() const;
+
+      /// \brief Get the name of the buffer.
+      /// \return Name of the buffer.
+      public: std::string GetName() const;
+
+      /// \brief Get the number of bytes available for messages.
+      /// \return The buffer capacity.
+      public: size_t GetCapacity() const;
+
+      /// \brief Is shared memory supported on this platform?
+      /// \return True if shared memory buffers can be used.
+      public: static bool IsSupported();
+
+      /// \brief Unmap the buffer.
+      private: void Close();
+
+      /// \brief Copy data into the ring, wrapping around the end.
+      /// \param[in] _pos Position, in bytes since the start of the stream.
+      /// \param[in] _data Data to copy.
+      /// \param[in] _size Number of bytes to copy.
+      private: void CopyIn(uint64_t _pos, const char *_data, size_t _size);
+
+      /// \brief Copy data out of the ring, wrapping around the end.
+      /// \param[in] _pos Position, in bytes since the start of the stream.
+      /// \param[out] _data Destination of the data.
+      /// \param[in] _size Number of bytes to copy.
+      private: void CopyOut(uint64_t _pos, char *_data, size_t _size) const;
+
+      /// \brief Name of the buffer.
+      private: std::string name;
+
+      /// \brief Header at the start of the mapped region.
+      private: ShmBufferHeader *header;
+
+      /// \brief Start of the message data in the mapped region.
+      private: char *data;
+
+      /// \brief Size of the mapped region.
+      private: size_t mappedSize;
+
+      /// \brief True if this object created the buffer and owns its name.
+      private: bool owner;
+    };
+
+    /// \def ShmBufferPtr
+    /// \brief Shared_ptr to ShmBuffer
+    typedef boost::shared_ptr<ShmBuffer> ShmBufferPtr;
+    /// \}
+  }
+}
+#endif
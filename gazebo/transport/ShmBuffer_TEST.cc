@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2015 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <boost/lexical_cast.hpp>
+#include <boost/thread.hpp>
+#include <string>
+
+#include "gazebo/transport/ShmBuffer.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class ShmBuffer : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Get a shared memory name that is unique to this test process.
+std::string ShmName(const std::string &_suffix)
+{
+  return "/gazebo-test-" + boost::lexical_cast<std::string>(getpid()) +
+    "-" + _suffix;
+}
+
+/////////////////////////////////////////////////
+TEST_F(ShmBuffer, CreateOpen)
+{
+  if (!transport::ShmBuffer::IsSupported())
+    return;
+
+  std::string name = ShmName("open");
+
+  transport::ShmBuffer reader;
+  EXPECT_FALSE(reader.Attached());
+  ASSERT_TRUE(reader.Create(name, 1024));
+  EXPECT_EQ(reader.GetName(), name);
+  EXPECT_EQ(reader.GetCapacity(), 1024u);
+  EXPECT_FALSE(reader.Attached());
+
+  // The name is already in use
+  transport::ShmBuffer other;
+  EXPECT_FALSE(other.Create(name, 1024));
+
+  transport::ShmBuffer writer;
+  ASSERT_TRUE(writer.Open(name));
+  EXPECT_TRUE(reader.Attached());
+  EXPECT_EQ(writer.GetCapacity(), 1024u);
+
+  // The writer removed the name once it was attached, existing mappings
+  // remain valid.
+  transport::ShmBuffer late;
+  EXPECT_FALSE(late.Open(name));
+  reader.Unlink();
+
+  std::string data;
+  EXPECT_FALSE(reader.Read(data));
+  EXPECT_TRUE(writer.Write("hello"));
+  EXPECT_TRUE(reader.Read(data));
+  EXPECT_EQ(data, "hello");
+  EXPECT_FALSE(reader.Read(data));
+}
+
+/////////////////////////////////////////////////
+TEST_F(ShmBuffer, WrapAndFull)
+{
+  if (!transport::ShmBuffer::IsSupported())
+    return;
+
+  std::string name = ShmName("wrap");
+
+  transport::ShmBuffer reader;
+  transport::ShmBuffer writer;
+  ASSERT_TRUE(reader.Create(name, 100));
+  ASSERT_TRUE(writer.Open(name));
+
+  // Messages of varying size wrap around the end of the ring.
+  std::string data;
+  for (unsigned int i = 0; i < 500; ++i)
+  {
+    std::string msg(i % 60, 'a' + i % 26);
+    EXPECT_TRUE(writer.Write(msg));
+    EXPECT_TRUE(reader.Read(data));
+    EXPECT_EQ(data, msg);
+  }
+
+  // Each message uses four bytes for its length.
+  EXPECT_TRUE(writer.Write(std::string(96, 'x')));
+  EXPECT_FALSE(writer.Write("x"));
+  EXPECT_TRUE(reader.Read(data));
+  EXPECT_EQ(data.size(), 96u);
+
+  // Too large for the buffer.
+  EXPECT_FALSE(writer.Write(std::string(97, 'x')));
+}
+
+/////////////////////////////////////////////////
+void WriteMessages(transport::ShmBuffer *_writer, unsigned int _count)
+{
+  for (unsigned int i = 0; i < _count; ++i)
+  {
+    std::string msg(i % 500, static_cast<char>(i));
+    while (!_writer->Write(msg))
+      boost::this_thread::yield();
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(ShmBuffer, Threaded)
+{
+  if (!transport::ShmBuffer::IsSupported())
+    return;
+
+  std::string name = ShmName("threaded");
+
+  transport::ShmBuffer reader;
+  transport::ShmBuffer writer;
+  ASSERT_TRUE(reader.Create(name, 4096));
+  ASSERT_TRUE(writer.Open(name));
+
+  const unsigned int count = 10000;
+  boost::thread thread(boost::bind(&WriteMessages, &writer, count));
+
+  std::string data;
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    while (!reader.Read(data))
+      boost::this_thread::yield();
+    ASSERT_EQ(data, std::string(i % 500, static_cast<char>(i)));
+  }
+
+  thread.join();
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -50,12 +50,24 @@ void SubscriptionTransport::Init(ConnectionPtr _conn, bool _latching)
   this->latching = _latching;
 }
 
+//////////////////////////////////////////////////
+bool SubscriptionTransport::InitShm(const std::string &_name)
+{
+  ShmBufferPtr buffer(new ShmBuffer());
+  if (!buffer->Open(_name))
+    return false;
+
+  this->shm = buffer;
+  return true;
+}
+
 //////////////////////////////////////////////////
 bool SubscriptionTransport::HandleMessage(MessagePtr _newMsg)
 {
-  std::string data;
-  _newMsg->SerializeToString(&data);
-  return this->HandleData(data, boost::bind(&dummy_callback_fn, _1), 0);
+  boost::shared_ptr<std::string> data(new std::string);
+  _newMsg->SerializeToString(data.get());
+  return this->HandleSerializedData(data,
+      boost::bind(&dummy_callback_fn, _1), 0);
 }
 
 //////////////////////////////////////////////////
@@ -65,7 +77,30 @@ bool SubscriptionTransport::HandleData(const std::string &_newdata,
   bool result = false;
   if (this->connection->IsOpen())
   {
-    this->connection->EnqueueMsg(_newdata, _cb, _id);
+    if (this->shm)
+      this->EnqueueShm(_newdata, SerializedMsgPtr(), _cb, _id);
+    else
+      this->connection->EnqueueMsg(_newdata, _cb, _id);
+    result = true;
+  }
+  else
+    this->connection.reset();
+
+  return result;
+}
+
+//////////////////////////////////////////////////
+bool SubscriptionTransport::HandleSerializedData(
+    const SerializedMsgPtr &_newdata,
+    boost::function<void(uint32_t)> _cb, uint32_t _id)
+{
+  bool result = false;
+  if (this->connection->IsOpen())
+  {
+    if (this->shm)
+      this->EnqueueShm(*_newdata, _newdata, _cb, _id);
+    else
+      this->connection->EnqueueMsg(_newdata, _cb, _id);
     result = true;
   }
   else
@@ -74,6 +109,31 @@ bool SubscriptionTransport::HandleData(const std::string &_newdata,
   return result;
 }
 
+//////////////////////////////////////////////////
+void SubscriptionTransport::EnqueueShm(const std::string &_data,
+    const SerializedMsgPtr &_shared, boost::function<void(uint32_t)> _cb,
+    uint32_t _id)
+{
+  // Every message in the buffer is signaled by the same one byte frame.
+  static const SerializedMsgPtr bufferFrame(
+      new std::string(1, GZ_SHM_FRAME_BUFFER));
+
+  boost::mutex::scoped_lock lock(this->shmMutex);
+
+  if (this->shm->Write(_data))
+  {
+    this->connection->EnqueueMsg(bufferFrame, _cb, _id);
+  }
+  else
+  {
+    // The subscriber is not keeping up, or the message is larger than the
+    // buffer. Send the data through the connection.
+    this->connection->EnqueuePrefixedMsg(GZ_SHM_FRAME_INLINE,
+        _shared ? _shared : SerializedMsgPtr(new std::string(_data)),
+        _cb, _id);
+  }
+}
+
 //////////////////////////////////////////////////
 const ConnectionPtr &SubscriptionTransport::GetConnection() const
 {
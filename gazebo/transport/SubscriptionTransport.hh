@@ -23,6 +23,7 @@
 
 #include "Connection.hh"
 #include "CallbackHelper.hh"
+#include "ShmBuffer.hh"
 #include "gazebo/util/system.hh"
 
 namespace gazebo
@@ -50,6 +51,13 @@ namespace gazebo
       /// don't latch
       public: void Init(ConnectionPtr _conn, bool _latching);
 
+      /// \brief Send message data through a shared memory buffer created
+      /// by the subscriber. The connection is then only used to signal
+      /// new messages, and to send messages that don't fit in the buffer.
+      /// \param[in] _name Name of the shared memory buffer.
+      /// \return True if the buffer was opened.
+      public: bool InitShm(const std::string &_name);
+
       /// \brief Output a message to a connection
       /// \param[in] _newdata The message to be handled
       /// \return true if the message was handled successfully, false otherwise
@@ -59,6 +67,11 @@ namespace gazebo
       public: virtual bool HandleData(const std::string &_newdata,
                   boost::function<void(uint32_t)> _cb, uint32_t _id);
 
+      // Documentation inherited
+      public: virtual bool HandleSerializedData(
+                  const SerializedMsgPtr &_newdata,
+                  boost::function<void(uint32_t)> _cb, uint32_t _id);
+
       // Documentation inherited
       public: virtual bool HandleMessage(MessagePtr _newMsg);
 
@@ -71,7 +84,26 @@ namespace gazebo
       /// is tied to a  remote connection
       public: virtual bool IsLocal() const;
 
+      /// \brief Write message data to the shared memory buffer, and
+      /// signal the subscriber.
+      /// \param[in] _data Message data.
+      /// \param[in] _shared _data if it is already shared, sent inline
+      /// without a copy when the buffer is full. May be NULL.
+      /// \param[in] _cb If non-null, callback to be invoked after
+      /// transmission is complete.
+      /// \param[in] _id ID associated with the message data.
+      private: void EnqueueShm(const std::string &_data,
+                   const SerializedMsgPtr &_shared,
+                   boost::function<void(uint32_t)> _cb, uint32_t _id);
+
       private: ConnectionPtr connection;
+
+      /// \brief Shared memory buffer, if the subscriber is on this host.
+      private: ShmBufferPtr shm;
+
+      /// \brief Keeps the order of messages in the shared memory buffer
+      /// and on the connection the same.
+      private: boost::mutex shmMutex;
     };
     /// \}
   }
@@ -25,6 +25,7 @@
 #include <tbb/blocked_range.h>
 
 #include <boost/function.hpp>
+#include "gazebo/common/Trace.hh"
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/transport/Node.hh"
 #include "gazebo/transport/Publication.hh"
@@ -153,6 +154,8 @@ void TopicManager::AddNodeToProcess(NodePtr _ptr)
 //////////////////////////////////////////////////
 void TopicManager::ProcessNodes(bool _onlyOut)
 {
+  GZ_TRACE_SCOPE("TopicManager::ProcessNodes");
+
   {
     boost::mutex::scoped_lock lock(this->processNodesMutex);
     for (boost::unordered_set<NodePtr>::iterator iter =
@@ -0,0 +1,196 @@
+/*
+ * Copyright (C) 2015 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <boost/bind.hpp>
+
+#include "gazebo/transport/TopicQueue.hh"
+
+using namespace gazebo;
+using namespace transport;
+
+extern void dummy_callback_fn(uint32_t);
+
+//////////////////////////////////////////////////
+TopicQueue::TopicQueue(const std::string &_topic)
+  : topic(_topic), scheduled(false), latestOnly(false)
+{
+}
+
+//////////////////////////////////////////////////
+TopicQueue::~TopicQueue()
+{
+}
+
+//////////////////////////////////////////////////
+std::string TopicQueue::GetTopic() const
+{
+  return this->topic;
+}
+
+//////////////////////////////////////////////////
+void TopicQueue::AddCallback(CallbackHelperPtr _callback)
+{
+  boost::recursive_mutex::scoped_lock lock(this->callbackMutex);
+  this->callbacks.push_back(_callback);
+}
+
+//////////////////////////////////////////////////
+void TopicQueue::RemoveCallback(unsigned int _id)
+{
+  boost::recursive_mutex::scoped_lock lock(this->callbackMutex);
+
+  for (std::vector<CallbackHelperPtr>::iterator iter =
+       this->callbacks.begin(); iter != this->callbacks.end(); ++iter)
+  {
+    if ((*iter)->GetId() == _id)
+    {
+      this->callbacks.erase(iter);
+      break;
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void TopicQueue::ClearCallbacks()
+{
+  boost::recursive_mutex::scoped_lock lock(this->callbackMutex);
+  this->callbacks.clear();
+}
+
+//////////////////////////////////////////////////
+std::string TopicQueue::GetMsgType() const
+{
+  boost::recursive_mutex::scoped_lock lock(this->callbackMutex);
+  if (!this->callbacks.empty())
+    return this->callbacks.front()->GetMsgType();
+
+  return std::string();
+}
+
+//////////////////////////////////////////////////
+bool TopicQueue::HasLatchedCallback() const
+{
+  boost::recursive_mutex::scoped_lock lock(this->callbackMutex);
+  return !this->callbacks.empty() && this->callbacks.front()->GetLatching();
+}
+
+//////////////////////////////////////////////////
+void TopicQueue::SetLatestOnly(bool _latestOnly)
+{
+  this->latestOnly.store(_latestOnly);
+}
+
+//////////////////////////////////////////////////
+bool TopicQueue::GetLatestOnly() const
+{
+  return this->latestOnly.load();
+}
+
+//////////////////////////////////////////////////
+bool TopicQueue::Push(const SerializedMsgPtr &_msg)
+{
+  TopicQueueMsg msg;
+  msg.data = _msg;
+  this->msgs.Push(msg);
+  return !this->scheduled.exchange(true);
+}
+
+//////////////////////////////////////////////////
+bool TopicQueue::Push(MessagePtr _msg)
+{
+  TopicQueueMsg msg;
+  msg.msg = _msg;
+  this->msgs.Push(msg);
+  return !this->scheduled.exchange(true);
+}
+
+//////////////////////////////////////////////////
+void TopicQueue::Dispatch()
+{
+  // Messages pushed from now on schedule the queue again. The exchange
+  // also makes the messages pushed before it visible here.
+  this->scheduled.exchange(false);
+
+  boost::recursive_mutex::scoped_lock lock(this->callbackMutex);
+
+  // Callbacks may unsubscribe while they run, so iterate over a copy.
+  std::vector<CallbackHelperPtr> targets(this->callbacks);
+
+  TopicQueueMsg msg;
+  if (this->latestOnly.load())
+  {
+    TopicQueueMsg latest;
+    while (this->msgs.Pop(msg))
+      latest = msg;
+
+    if (latest.data || latest.msg)
+      this->Deliver(targets, latest);
+  }
+  else
+  {
+    while (this->msgs.Pop(msg))
+      this->Deliver(targets, msg);
+  }
+}
+
+//////////////////////////////////////////////////
+void TopicQueue::Deliver(const std::vector<CallbackHelperPtr> &_callbacks,
+    const TopicQueueMsg &_msg)
+{
+  for (std::vector<CallbackHelperPtr>::const_iterator iter =
+       _callbacks.begin(); iter != _callbacks.end(); ++iter)
+  {
+    if (_msg.data)
+    {
+      (*iter)->HandleSerializedData(_msg.data,
+          boost::bind(&dummy_callback_fn, _1), 0);
+    }
+    else
+      (*iter)->HandleMessage(_msg.msg);
+  }
+}
+
+//////////////////////////////////////////////////
+void TopicQueue::InsertLatchedMsg(const std::string &_msg)
+{
+  boost::recursive_mutex::scoped_lock lock(this->callbackMutex);
+
+  for (std::vector<CallbackHelperPtr>::iterator iter =
+       this->callbacks.begin(); iter != this->callbacks.end(); ++iter)
+  {
+    if ((*iter)->GetLatching())
+    {
+      (*iter)->HandleData(_msg, boost::bind(&dummy_callback_fn, _1), 0);
+      (*iter)->SetLatching(false);
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void TopicQueue::InsertLatchedMsg(MessagePtr _msg)
+{
+  boost::recursive_mutex::scoped_lock lock(this->callbackMutex);
+
+  for (std::vector<CallbackHelperPtr>::iterator iter =
+       this->callbacks.begin(); iter != this->callbacks.end(); ++iter)
+  {
+    if ((*iter)->GetLatching())
+    {
+      (*iter)->HandleMessage(_msg);
+      (*iter)->SetLatching(false);
+    }
+  }
+}
@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2015 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef _GAZEBO_TRANSPORT_TOPICQUEUE_HH_
+#define _GAZEBO_TRANSPORT_TOPICQUEUE_HH_
+
+#include <boost/thread/recursive_mutex.hpp>
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "gazebo/transport/CallbackHelper.hh"
+#include "gazebo/transport/MPSCQueue.hh"
+#include "gazebo/transport/TransportTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace transport
+  {
+    /// \addtogroup gazebo_transport
+    /// \{
+
+    /// \cond
+    /// \brief An incoming message. Remote messages are serialized, local
+    /// messages are not.
+    class TopicQueueMsg
+    {
+      /// \brief Serialized message, or NULL.
+      public: SerializedMsgPtr data;
+
+      /// \brief Local message, or NULL.
+      public: MessagePtr msg;
+    };
+    /// \endcond
+
+    /// \class TopicQueue TopicQueue.hh transport/transport.hh
+    /// \brief The incoming messages and the callbacks of a node for one
+    /// topic.
+    ///
+    /// Publications resolve the queue once, when the node subscribes, and
+    /// push to it without locking. The node dispatches the queue from a
+    /// single thread. Only the callbacks are guarded by a mutex, which is
+    /// specific to the topic.
+    class GZ_TRANSPORT_VISIBLE TopicQueue
+    {
+      /// \brief Constructor
+      /// \param[in] _topic Name of the topic.
+      public: explicit TopicQueue(const std::string &_topic);
+
+      /// \brief Destructor
+      public: virtual ~TopicQueue();
+
+      /// \brief Get the name of the topic.
+      /// \return Name of the topic.
+      public: std::string GetTopic() const;
+
+      /// \brief Add a callback.
+      /// \param[in] _callback The callback.
+      public: void AddCallback(CallbackHelperPtr _callback);
+
+      /// \brief Remove a callback. Waits for a dispatch of the topic in
+      /// progress on another thread.
+      /// \param[in] _id Id of the callback.
+      public: void RemoveCallback(unsigned int _id);
+
+      /// \brief Remove all the callbacks.
+      public: void ClearCallbacks();
+
+      /// \brief Get the message type of the first callback.
+      /// \return The message type, empty if there is no callback.
+      public: std::string GetMsgType() const;
+
+      /// \brief Is the first callback latching?
+      /// \return True if the first callback is latching.
+      public: bool HasLatchedCallback() const;
+
+      /// \brief Set whether only the latest queued message is dispatched.
+      /// \param[in] _latestOnly True to drop the messages that were
+      /// superseded before the queue was dispatched.
+      public: void SetLatestOnly(bool _latestOnly);
+
+      /// \brief Get whether only the latest queued message is dispatched.
+      /// \return True if superseded messages are dropped.
+      public: bool GetLatestOnly() const;
+
+      /// \brief Queue a serialized message. May be called from any thread.
+      /// \param[in] _msg The message.
+      /// \return True if the queue was idle, and must be scheduled for
+      /// dispatch.
+      public: bool Push(const SerializedMsgPtr &_msg);
+
+      /// \brief Queue a local message. May be called from any thread.
+      /// \param[in] _msg The message.
+      /// \return True if the queue was idle, and must be scheduled for
+      /// dispatch.
+      public: bool Push(MessagePtr _msg);
+
+      /// \brief Send the queued messages to the callbacks. Must only be
+      /// called from one thread at a time.
+      public: void Dispatch();
+
+      /// \brief Send a latched message to the latching callbacks, which
+      /// then stop latching.
+      /// \param[in] _msg The serialized message.
+      public: void InsertLatchedMsg(const std::string &_msg);
+
+      /// \brief Send a latched message to the latching callbacks, which
+      /// then stop latching.
+      /// \param[in] _msg The message.
+      public: void InsertLatchedMsg(MessagePtr _msg);
+
+      /// \brief Send a message to callbacks.
+      /// \param[in] _callbacks The callbacks.
+      /// \param[in] _msg The message.
+      private: static void Deliver(
+                   const std::vector<CallbackHelperPtr> &_callbacks,
+                   const TopicQueueMsg &_msg);
+
+      /// \brief Name of the topic.
+      private: std::string topic;
+
+      /// \brief The callbacks.
+      private: std::vector<CallbackHelperPtr> callbacks;
+
+      /// \brief Guards the callbacks, and is held during a dispatch.
+      private: mutable boost::recursive_mutex callbackMutex;
+
+      /// \brief Incoming messages.
+      private: MPSCQueue<TopicQueueMsg> msgs;
+
+      /// \brief True if the queue is waiting for a dispatch.
+      private: std::atomic<bool> scheduled;
+
+      /// \brief True if only the latest message is dispatched.
+      private: std::atomic<bool> latestOnly;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,229 @@
+/*
+ * Copyright (C) 2015 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+#include <string>
+#include <vector>
+
+#include "gazebo/transport/MPSCQueue.hh"
+#include "gazebo/transport/TopicQueue.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class TopicQueue : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Collects the messages a callback receives.
+class Receiver
+{
+  /// \brief Callback
+  /// \param[in] _data Message data.
+  public: void OnData(const std::string &_data)
+          {
+            this->received.push_back(_data);
+          }
+
+  /// \brief Messages received.
+  public: std::vector<std::string> received;
+};
+
+/////////////////////////////////////////////////
+/// \brief Push numbered messages to a queue.
+/// \param[in] _queue The queue.
+/// \param[in] _prefix Prefix of the messages.
+/// \param[in] _count Number of messages.
+/// \param[out] _schedules Number of pushes that found the queue idle.
+void PushMessages(transport::TopicQueue *_queue, const std::string &_prefix,
+    int _count, int *_schedules)
+{
+  for (int i = 0; i < _count; ++i)
+  {
+    if (_queue->Push(transport::SerializedMsgPtr(
+            new std::string(_prefix + std::to_string(i)))))
+    {
+      ++(*_schedules);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(TopicQueue, MPSCQueue)
+{
+  transport::MPSCQueue<int> queue;
+  EXPECT_TRUE(queue.Empty());
+
+  int value = 0;
+  EXPECT_FALSE(queue.Pop(value));
+
+  for (int i = 0; i < 10; ++i)
+    queue.Push(i);
+  EXPECT_FALSE(queue.Empty());
+
+  for (int i = 0; i < 10; ++i)
+  {
+    EXPECT_TRUE(queue.Pop(value));
+    EXPECT_EQ(i, value);
+  }
+  EXPECT_TRUE(queue.Empty());
+}
+
+/////////////////////////////////////////////////
+/// \brief Push increasing numbers, tagged with a producer id.
+/// \param[in] _queue The queue.
+/// \param[in] _id Producer id.
+/// \param[in] _count Number of items.
+void PushNumbers(transport::MPSCQueue<int> *_queue, int _id, int _count)
+{
+  for (int i = 0; i < _count; ++i)
+    _queue->Push(_id * _count + i);
+}
+
+/////////////////////////////////////////////////
+// Links are recycled while producers push and the consumer pops.
+TEST_F(TopicQueue, MPSCQueueReuse)
+{
+  const int producers = 4;
+  const int count = 20000;
+  transport::MPSCQueue<int> queue;
+
+  std::vector<boost::thread *> threads;
+  for (int i = 0; i < producers; ++i)
+  {
+    threads.push_back(new boost::thread(
+          boost::bind(&PushNumbers, &queue, i, count)));
+  }
+
+  // Items of each producer arrive in order.
+  std::vector<int> last(producers, -1);
+  int popped = 0;
+  int value = 0;
+  while (popped < producers * count)
+  {
+    if (!queue.Pop(value))
+    {
+      boost::this_thread::yield();
+      continue;
+    }
+    int id = value / count;
+    ASSERT_GE(id, 0);
+    ASSERT_LT(id, producers);
+    EXPECT_GT(value % count, last[id]);
+    last[id] = value % count;
+    ++popped;
+  }
+  EXPECT_TRUE(queue.Empty());
+
+  for (auto thread : threads)
+  {
+    thread->join();
+    delete thread;
+  }
+
+  for (int i = 0; i < producers; ++i)
+    EXPECT_EQ(count - 1, last[i]);
+}
+
+/////////////////////////////////////////////////
+// Messages from several producers are all dispatched, in order for each
+// producer.
+TEST_F(TopicQueue, Dispatch)
+{
+  transport::TopicQueue queue("/test/topic");
+  EXPECT_EQ("/test/topic", queue.GetTopic());
+  EXPECT_TRUE(queue.GetMsgType().empty());
+
+  Receiver receiver;
+  transport::CallbackHelperPtr helper(new transport::RawCallbackHelper(
+        boost::bind(&Receiver::OnData, &receiver, _1)));
+  queue.AddCallback(helper);
+  EXPECT_EQ("raw", queue.GetMsgType());
+  EXPECT_FALSE(queue.HasLatchedCallback());
+
+  const int count = 1000;
+  int schedules1 = 0;
+  int schedules2 = 0;
+  boost::thread thread1(boost::bind(&PushMessages, &queue, "a", count,
+        &schedules1));
+  boost::thread thread2(boost::bind(&PushMessages, &queue, "b", count,
+        &schedules2));
+  thread1.join();
+  thread2.join();
+
+  // The queue is scheduled once until it is dispatched.
+  EXPECT_EQ(1, schedules1 + schedules2);
+
+  queue.Dispatch();
+  ASSERT_EQ(2u * count, receiver.received.size());
+
+  int nextA = 0;
+  int nextB = 0;
+  for (auto const &msg : receiver.received)
+  {
+    if (msg[0] == 'a')
+      EXPECT_EQ("a" + std::to_string(nextA++), msg);
+    else
+      EXPECT_EQ("b" + std::to_string(nextB++), msg);
+  }
+  EXPECT_EQ(count, nextA);
+  EXPECT_EQ(count, nextB);
+
+  // A push after the dispatch schedules the queue again.
+  EXPECT_TRUE(queue.Push(transport::SerializedMsgPtr(new std::string("c"))));
+
+  // Removed callbacks no longer receive messages.
+  queue.RemoveCallback(helper->GetId());
+  queue.Dispatch();
+  EXPECT_EQ(2u * count, receiver.received.size());
+}
+
+/////////////////////////////////////////////////
+// Only the latest message is dispatched when the topic keeps the latest
+// message only.
+TEST_F(TopicQueue, LatestOnly)
+{
+  transport::TopicQueue queue("/test/topic");
+  EXPECT_FALSE(queue.GetLatestOnly());
+  queue.SetLatestOnly(true);
+  EXPECT_TRUE(queue.GetLatestOnly());
+
+  Receiver receiver;
+  queue.AddCallback(transport::CallbackHelperPtr(
+        new transport::RawCallbackHelper(
+          boost::bind(&Receiver::OnData, &receiver, _1))));
+
+  int schedules = 0;
+  PushMessages(&queue, "a", 100, &schedules);
+  EXPECT_EQ(1, schedules);
+
+  queue.Dispatch();
+  ASSERT_EQ(1u, receiver.received.size());
+  EXPECT_EQ("a99", receiver.received[0]);
+
+  // Nothing is dispatched without new messages.
+  queue.Dispatch();
+  EXPECT_EQ(1u, receiver.received.size());
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
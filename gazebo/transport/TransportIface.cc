@@ -162,6 +162,7 @@ void transport::pause_incoming(bool _pause)
 /////////////////////////////////////////////////
 void on_response(ConstResponsePtr &_msg)
 {
+  boost::mutex::scoped_lock lock(requestMutex);
   if (g_requests.empty() || g_stopped)
     return;
 
@@ -176,7 +177,6 @@ void on_response(ConstResponsePtr &_msg)
   if (iter == g_requests.end())
     return;
 
-  boost::mutex::scoped_lock lock(requestMutex);
   boost::shared_ptr<msgs::Response> response(new msgs::Response);
   response->CopyFrom(*_msg);
   g_responses.push_back(response);
@@ -191,13 +191,26 @@ void transport::get_topic_namespaces(std::list<std::string> &_namespaces)
 }
 
 /////////////////////////////////////////////////
-boost::shared_ptr<msgs::Response> transport::request(
+/// \brief Send a request and wait for its response.
+/// \param[in] _worldName The name of the world.
+/// \param[in] _request The type request.
+/// \param[in] _data Data string.
+/// \param[in] _timeout Maximum time to wait, NULL to wait forever.
+/// \return The response, NULL on timeout.
+static boost::shared_ptr<msgs::Response> Request(
     const std::string &_worldName, const std::string &_request,
-    const std::string &_data)
+    const std::string &_data, const common::Time *_timeout)
 {
+  common::Time deadline;
+  if (_timeout)
+    deadline = common::Time::GetWallTime() + *_timeout;
+
   msgs::Request *request = msgs::CreateRequest(_request, _data);
 
-  g_requests.push_back(request);
+  {
+    boost::mutex::scoped_lock lock(requestMutex);
+    g_requests.push_back(request);
+  }
 
   NodePtr node = NodePtr(new Node());
   node->Init(_worldName);
@@ -205,19 +218,34 @@ boost::shared_ptr<msgs::Response> transport::request(
   SubscriberPtr responseSub = node->Subscribe("~/response", &on_response);
 
   PublisherPtr requestPub = node->Advertise<msgs::Request>("~/request");
-  requestPub->WaitForConnection();
+  bool connected = true;
+  if (_timeout)
+    connected = requestPub->WaitForConnection(*_timeout);
+  else
+    requestPub->WaitForConnection();
 
   boost::mutex::scoped_lock lock(requestMutex);
-  requestPub->Publish(*request, true);
+  if (connected)
+    requestPub->Publish(*request, true);
 
   boost::shared_ptr<msgs::Response> response;
   std::list<boost::shared_ptr<msgs::Response> >::iterator iter;
 
-  bool valid = false;
+  bool valid = !connected;
   while (!valid && !g_stopped)
   {
     // Wait for a response
-    g_responseCondition.wait(lock);
+    if (!_timeout)
+      g_responseCondition.wait(lock);
+    else
+    {
+      common::Time remaining = deadline - common::Time::GetWallTime();
+      if (remaining <= common::Time::Zero)
+        break;
+      g_responseCondition.timed_wait(lock,
+          boost::posix_time::milliseconds(
+            static_cast<int64_t>(remaining.Double() * 1000) + 1));
+    }
 
     for (iter = g_responses.begin(); iter != g_responses.end(); ++iter)
     {
@@ -231,6 +259,9 @@ boost::shared_ptr<msgs::Response> transport::request(
     }
   }
 
+  g_requests.remove(request);
+  lock.unlock();
+
   requestPub.reset();
   responseSub.reset();
   node.reset();
@@ -239,6 +270,22 @@ boost::shared_ptr<msgs::Response> transport::request(
   return response;
 }
 
+/////////////////////////////////////////////////
+boost::shared_ptr<msgs::Response> transport::request(
+    const std::string &_worldName, const std::string &_request,
+    const std::string &_data)
+{
+  return Request(_worldName, _request, _data, NULL);
+}
+
+/////////////////////////////////////////////////
+boost::shared_ptr<msgs::Response> transport::request(
+    const std::string &_worldName, const std::string &_request,
+    const std::string &_data, const common::Time &_timeout)
+{
+  return Request(_worldName, _request, _data, &_timeout);
+}
+
 /////////////////////////////////////////////////
 void transport::requestNoReply(const std::string &_worldName,
                                const std::string &_request,
@@ -22,6 +22,7 @@
 #include <list>
 #include <map>
 
+#include "gazebo/common/Time.hh"
 #include "gazebo/transport/TransportTypes.hh"
 #include "gazebo/transport/SubscribeOptions.hh"
 #include "gazebo/transport/Node.hh"
@@ -103,6 +104,21 @@ namespace gazebo
                                               const std::string &_request,
                                               const std::string &_data = "");
 
+    /// \brief Send a request and receive a response. This call blocks
+    /// until a response is received or the timeout elapses.
+    /// \param[in] _worldName The name of the world to which the request
+    /// should be sent
+    /// \param[in] _request The type request.
+    /// \param[in] _data Data string.
+    /// \param[in] _timeout Maximum time to wait for the world to connect
+    /// and respond.
+    /// \return The response to the request, NULL on timeout.
+    GZ_TRANSPORT_VISIBLE
+    boost::shared_ptr<msgs::Response> request(const std::string &_worldName,
+                                              const std::string &_request,
+                                              const std::string &_data,
+                                              const common::Time &_timeout);
+
     /// \brief Send a request and don't wait for a response. This is
     /// non-blocking.
     /// \param[in] _worldName The name of the world to which the request
@@ -18,6 +18,7 @@
 #define _TRANSPORT_TYPES_HH_
 
 #include <boost/shared_ptr.hpp>
+#include <string>
 // avoid collision from Mac OS X's ConditionalMacros.h
 // see gazebo issue #1289
 #ifdef __MACH__
@@ -39,11 +40,18 @@ namespace gazebo
     class Subscriber;
     class SubscriptionTransport;
     class Node;
+    class TopicQueue;
 
     /// \def MessagePtr
     /// \brief Shared_ptr to protobuf message
     typedef boost::shared_ptr<google::protobuf::Message> MessagePtr;
 
+    /// \def SerializedMsgPtr
+    /// \brief Shared_ptr to an immutable serialized message. A message is
+    /// serialized once per publish and the buffer is shared by every
+    /// subscriber, connection write queue and latched message slot.
+    typedef boost::shared_ptr<const std::string> SerializedMsgPtr;
+
     /// \def PublisherPtr
     /// \brief Shared_ptr to Publisher object
     typedef boost::shared_ptr<Publisher> PublisherPtr;
@@ -67,6 +75,10 @@ namespace gazebo
     /// \def SubscriptionTransportPtr
     /// \brief Shared_ptr to SubscriptionTransportPtr
     typedef boost::shared_ptr<SubscriptionTransport> SubscriptionTransportPtr;
+
+    /// \def TopicQueuePtr
+    /// \brief Shared_ptr to TopicQueue object
+    typedef boost::shared_ptr<TopicQueue> TopicQueuePtr;
   }
 }
 
@@ -20,6 +20,9 @@
   #include <Winsock2.h>
 #endif
 
+#include <algorithm>
+#include <fstream>
+
 #include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/iostreams/filter/bzip2.hpp>
@@ -37,16 +40,49 @@
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Base64.hh"
+#include "gazebo/msgs/msgs.hh"
 #include "gazebo/util/LogRecord.hh"
 #include "gazebo/util/LogPlay.hh"
 
 using namespace gazebo;
 using namespace util;
 
+/// \brief Read an unsigned integer stored in little endian order.
+/// \param[in] _data Pointer to the first byte.
+/// \return The value.
+template<typename T>
+static T ReadLittleEndian(const char *_data)
+{
+  T value = 0;
+  for (unsigned int i = 0; i < sizeof(T); ++i)
+    value |= static_cast<T>(static_cast<unsigned char>(_data[i])) << (8 * i);
+  return value;
+}
+
+/// \brief Get the index of the first entry in a chunk.
+/// \param[in] _entries Entries of a log file.
+/// \param[in] _chunk Index of the chunk.
+/// \return Index of the first entry in _chunk or a later chunk.
+static uint64_t FirstEntryOfChunk(const std::vector<LogPlayEntry> &_entries,
+    const unsigned int _chunk)
+{
+  auto iter = std::lower_bound(_entries.begin(), _entries.end(), _chunk,
+      [](const LogPlayEntry &_entry, const unsigned int _c)
+      {
+        return _entry.chunk < _c;
+      });
+  return iter - _entries.begin();
+}
+
 /////////////////////////////////////////////////
 LogPlay::LogPlay()
 {
   this->logStartXml = NULL;
+  this->chunkIndex = 0;
+  this->chunkEntries = 0;
+  this->entriesIndexed = false;
+  this->indexedChunks = 0;
+  this->indexXml = NULL;
 }
 
 /////////////////////////////////////////////////
@@ -66,24 +102,46 @@ void LogPlay::Open(const std::string &_logFile)
   if (boost::filesystem::is_directory(path))
     gzthrow("Invalid logfile [" + _logFile + "]. This is a directory.");
 
-  // Parse the log file
-  if (!this->xmlDoc.LoadFile(_logFile))
-    gzthrow("Unable to parse log file[" << _logFile << "]");
+  // Close a previously opened log file.
+  this->logStartXml = NULL;
+  this->xmlDoc.Clear();
+  if (this->binaryFile.is_open())
+    this->binaryFile.close();
+  this->binaryChunks.clear();
+  this->chunkIndex = 0;
+  this->chunkEntries = 0;
+  this->entries.clear();
+  this->entriesIndexed = false;
+  this->indexedChunks = 0;
+  this->indexXml = NULL;
+  this->indexSimTime = common::Time::Zero;
+  this->currentChunk.clear();
+  this->encoding.clear();
 
-  // Get the gazebo_log element
-  this->logStartXml = this->xmlDoc.FirstChildElement("gazebo_log");
+  if (IsBinary(_logFile))
+  {
+    this->OpenBinary(_logFile);
+  }
+  else
+  {
+    // Parse the log file
+    if (!this->xmlDoc.LoadFile(_logFile))
+      gzthrow("Unable to parse log file[" << _logFile << "]");
 
-  if (!this->logStartXml)
-    gzthrow("Log file is missing the <gazebo_log> element");
+    // Get the gazebo_log element
+    this->logStartXml = this->xmlDoc.FirstChildElement("gazebo_log");
 
-  // Store the filename for future use.
-  this->filename = _logFile;
+    if (!this->logStartXml)
+      gzthrow("Log file is missing the <gazebo_log> element");
 
-  // Read in the header.
-  this->ReadHeader();
+    // Store the filename for future use.
+    this->filename = _logFile;
 
-  this->logCurrXml = this->logStartXml;
-  this->encoding.clear();
+    // Read in the header.
+    this->ReadHeader(this->logStartXml->FirstChildElement("header"));
+
+    this->logCurrXml = this->logStartXml;
+  }
 
   // Extract the start/end log times from the log.
   this->ReadLogTimes();
@@ -123,16 +181,149 @@ bool LogPlay::HasIterations() const
 
 
 /////////////////////////////////////////////////
-void LogPlay::ReadHeader()
+bool LogPlay::IsBinary(const std::string &_logFile)
+{
+  std::ifstream file(_logFile.c_str(), std::ios::binary);
+  char magic[GZ_LOG_MAGIC_LENGTH];
+  return file.read(magic, GZ_LOG_MAGIC_LENGTH) &&
+    std::string(magic, GZ_LOG_MAGIC_LENGTH) == GZ_LOG_BINARY_MAGIC;
+}
+
+/////////////////////////////////////////////////
+void LogPlay::OpenBinary(const std::string &_logFile)
+{
+  try
+  {
+    this->binaryFile.open(_logFile);
+  }
+  catch(std::exception &_e)
+  {
+    gzthrow("Unable to map log file[" << _logFile << "]: " << _e.what());
+  }
+
+  const char *data = this->binaryFile.data();
+  uint64_t size = this->binaryFile.size();
+  uint64_t pos = GZ_LOG_MAGIC_LENGTH;
+
+  if (size < pos + sizeof(uint32_t))
+  {
+    this->binaryFile.close();
+    gzthrow("Log file[" << _logFile << "] has no header");
+  }
+
+  uint32_t headerSize = ReadLittleEndian<uint32_t>(data + pos);
+  pos += sizeof(uint32_t);
+  if (size < pos + headerSize)
+  {
+    this->binaryFile.close();
+    gzthrow("Log file[" << _logFile << "] has a truncated header");
+  }
+
+  TiXmlDocument headerDoc;
+  headerDoc.Parse(std::string(data + pos, headerSize).c_str());
+  pos += headerSize;
+
+  // Store the filename for future use.
+  this->filename = _logFile;
+
+  try
+  {
+    this->ReadHeader(headerDoc.FirstChildElement("header"));
+  }
+  catch(...)
+  {
+    this->binaryFile.close();
+    throw;
+  }
+
+  this->ReadBinaryIndex(pos);
+}
+
+/////////////////////////////////////////////////
+void LogPlay::ReadBinaryIndex(uint64_t _firstChunk)
+{
+  const char *data = this->binaryFile.data();
+  uint64_t size = this->binaryFile.size();
+
+  this->binaryChunks.clear();
+
+  // The index footer is two integers followed by the index magic.
+  uint64_t footerSize = 2 * sizeof(uint64_t) + GZ_LOG_MAGIC_LENGTH;
+  if (size >= _firstChunk + footerSize + 1 &&
+      std::string(data + size - GZ_LOG_MAGIC_LENGTH, GZ_LOG_MAGIC_LENGTH) ==
+      GZ_LOG_INDEX_MAGIC)
+  {
+    uint64_t count = ReadLittleEndian<uint64_t>(data + size - footerSize);
+    uint64_t indexStart = ReadLittleEndian<uint64_t>(
+        data + size - footerSize + sizeof(uint64_t));
+
+    bool valid = indexStart >= _firstChunk &&
+      indexStart + 1 + count * sizeof(uint64_t) + footerSize == size &&
+      data[indexStart] == GZ_LOG_INDEX_TAG;
+
+    for (uint64_t i = 0; valid && i < count; ++i)
+    {
+      uint64_t offset = ReadLittleEndian<uint64_t>(
+          data + indexStart + 1 + i * sizeof(uint64_t));
+      valid = offset >= _firstChunk &&
+        offset + 1 + sizeof(uint32_t) <= indexStart &&
+        data[offset] == GZ_LOG_CHUNK_TAG;
+      this->binaryChunks.push_back(offset);
+    }
+
+    if (valid)
+      return;
+
+    this->binaryChunks.clear();
+    gzwarn << "Invalid chunk index in log file[" << this->filename << "]. "
+           << "Scanning the file for chunks.\n";
+  }
+  else
+  {
+    gzwarn << "Log file[" << this->filename << "] has no chunk index, it "
+           << "may not have been closed properly. Scanning the file for "
+           << "chunks.\n";
+  }
+
+  // Walk the chunk records. A truncated chunk at the end of the file is
+  // ignored.
+  uint64_t pos = _firstChunk;
+  while (pos + 1 + sizeof(uint32_t) <= size && data[pos] == GZ_LOG_CHUNK_TAG)
+  {
+    uint32_t length = ReadLittleEndian<uint32_t>(data + pos + 1);
+    if (pos + 1 + sizeof(uint32_t) + length > size)
+      break;
+
+    this->binaryChunks.push_back(pos);
+    pos += 1 + sizeof(uint32_t) + length;
+  }
+}
+
+/////////////////////////////////////////////////
+bool LogPlay::GetBinaryChunk(unsigned int _index, std::string &_data)
+{
+  if (_index >= this->binaryChunks.size())
+    return false;
+
+  const char *data = this->binaryFile.data() + this->binaryChunks[_index];
+  uint32_t length = ReadLittleEndian<uint32_t>(data + 1);
+  _data.assign(data + 1 + sizeof(uint32_t), length);
+  this->encoding = "bin";
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+void LogPlay::ReadHeader(TiXmlElement *_headerXml)
 {
   this->randSeed = ignition::math::Rand::Seed();
-  TiXmlElement *headerXml, *childXml;
+  TiXmlElement *headerXml = _headerXml;
+  TiXmlElement *childXml;
 
   this->logVersion.clear();
   this->gazeboVersion.clear();
 
-  // Get the header element
-  headerXml = this->logStartXml->FirstChildElement("header");
+  // Check the header element
   if (!headerXml)
     gzthrow("Log file has no header");
 
@@ -188,9 +379,12 @@ void LogPlay::ReadLogTimes()
   this->GetChunk(1, chunk);
 
   // Find the first <sim_time> of the log.
+  msgs::WorldState msg;
   auto from = chunk.find(kStartDelim);
   auto to = chunk.find(kEndDelim, from + kStartDelim.size());
-  if (from != std::string::npos && to != std::string::npos)
+  if (this->GetStateMsg(chunk, false, msg))
+    this->logStartTime = msgs::Convert(msg.sim_time());
+  else if (from != std::string::npos && to != std::string::npos)
   {
     auto length = to - from - kStartDelim.size();
     std::string startTime = chunk.substr(from + kStartDelim.size(), length);
@@ -210,7 +404,9 @@ void LogPlay::ReadLogTimes()
   to = chunk.rfind(kEndDelim);
   from = chunk.rfind(kStartDelim, to - 1);
 
-  if (from != std::string::npos && to != std::string::npos)
+  if (this->GetStateMsg(chunk, true, msg))
+    this->logEndTime = msgs::Convert(msg.sim_time());
+  else if (from != std::string::npos && to != std::string::npos)
   {
     auto length = to - from - kStartDelim.size();
     std::string endTime = chunk.substr(from + kStartDelim.size(), length);
@@ -244,9 +440,15 @@ bool LogPlay::ReadIterations()
   this->GetChunk(1, chunk);
 
   // Find the first <iterations> of the log.
+  msgs::WorldState msg;
   auto from = chunk.find(kStartDelim);
   auto to = chunk.find(kEndDelim, from + kStartDelim.size());
-  if (from != std::string::npos && to != std::string::npos)
+  if (this->GetStateMsg(chunk, false, msg) && msg.has_iterations())
+  {
+    this->initialIterations = msg.iterations();
+    return true;
+  }
+  else if (from != std::string::npos && to != std::string::npos)
   {
     auto length = to - from - kStartDelim.size();
     std::string iterations = chunk.substr(from + kStartDelim.size(), length);
@@ -266,7 +468,7 @@ bool LogPlay::ReadIterations()
 /////////////////////////////////////////////////
 bool LogPlay::IsOpen() const
 {
-  return this->logStartXml != NULL;
+  return this->logStartXml != NULL || this->binaryFile.is_open();
 }
 
 /////////////////////////////////////////////////
@@ -322,53 +524,146 @@ uintmax_t LogPlay::GetFileSize() const
 /////////////////////////////////////////////////
 bool LogPlay::Step(std::string &_data)
 {
-  std::lock_guard<std::mutex> lock(this->mutex);
+  bool binary;
+  return this->Step(_data, binary);
+}
 
-  std::string startMarker = "<sdf ";
-  std::string endMarker = "</sdf>";
-  size_t start = this->currentChunk.find(startMarker);
-  size_t end = this->currentChunk.find(endMarker);
+/////////////////////////////////////////////////
+bool LogPlay::Step(std::string &_data, bool &_binary)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
 
-  if (start == std::string::npos || end == std::string::npos)
+  size_t start, length, next;
+  while (!this->NextEntry(this->currentChunk, 0, start, length, next,
+        _binary))
   {
     this->currentChunk.clear();
 
-    if (this->logCurrXml == this->logStartXml)
-      this->logCurrXml = this->logStartXml->FirstChildElement("chunk");
-    else if (this->logCurrXml)
+    if (this->binaryFile.is_open())
     {
-      this->logCurrXml = this->logCurrXml->NextSiblingElement("chunk");
+      // Stop if there are no more chunks
+      if (!this->GetBinaryChunk(this->chunkIndex, this->currentChunk))
+        return false;
     }
     else
-      return false;
+    {
+      if (this->logCurrXml == this->logStartXml)
+        this->logCurrXml = this->logStartXml->FirstChildElement("chunk");
+      else if (this->logCurrXml)
+      {
+        this->logCurrXml = this->logCurrXml->NextSiblingElement("chunk");
+      }
+      else
+        return false;
+
+      // Stop if there are no more chunks
+      if (!this->logCurrXml)
+        return false;
+
+      if (!this->GetChunkData(this->logCurrXml, this->currentChunk))
+      {
+        gzerr << "Unable to decode log file\n";
+        return false;
+      }
+    }
+
+    ++this->chunkIndex;
+    this->chunkEntries = 0;
+  }
+
+  _data = this->currentChunk.substr(start, length);
+
+  this->currentChunk.erase(0, next);
+  ++this->chunkEntries;
+
+  return true;
+}
 
-    // Stop if there are no more chunks
-    if (!this->logCurrXml)
+/////////////////////////////////////////////////
+bool LogPlay::NextEntry(const std::string &_chunk, const size_t _offset,
+    size_t &_start, size_t &_length, size_t &_next, bool &_binary) const
+{
+  // States stored as messages only appear in binary log files.
+  if (this->binaryFile.is_open() && _offset < _chunk.size() &&
+      _chunk[_offset] == GZ_LOG_STATE_TAG)
+  {
+    _start = _offset + 1 + sizeof(uint32_t);
+    if (_start > _chunk.size())
       return false;
 
-    if (!this->GetChunkData(this->logCurrXml, this->currentChunk))
-    {
-      gzerr << "Unable to decode log file\n";
+    _length = ReadLittleEndian<uint32_t>(_chunk.data() + _offset + 1);
+    if (_length > _chunk.size() - _start)
       return false;
-    }
 
-    start = this->currentChunk.find(startMarker);
-    end = this->currentChunk.find(endMarker);
+    _next = _start + _length;
+    _binary = true;
+    return true;
   }
 
-  _data = this->currentChunk.substr(start, end+endMarker.size()-start);
-
-  this->currentChunk.erase(0, end + endMarker.size());
+  const std::string startMarker = "<sdf ";
+  const std::string endMarker = "</sdf>";
+  _start = _chunk.find(startMarker, _offset);
+  size_t end = _chunk.find(endMarker, _offset);
+  if (_start == std::string::npos || end == std::string::npos)
+    return false;
 
+  _next = end + endMarker.size();
+  _length = _next - _start;
+  _binary = false;
   return true;
 }
 
+/////////////////////////////////////////////////
+bool LogPlay::GetStateMsg(const std::string &_chunk, const bool _last,
+    msgs::WorldState &_msg) const
+{
+  size_t offset = 0;
+  size_t start, length, next;
+  bool binary;
+  bool found = false;
+  size_t entryStart = 0;
+  size_t entryLength = 0;
+  bool entryBinary = false;
+
+  while (this->NextEntry(_chunk, offset, start, length, next, binary))
+  {
+    found = true;
+    entryStart = start;
+    entryLength = length;
+    entryBinary = binary;
+
+    if (!_last)
+      break;
+    offset = next;
+  }
+
+  return found && entryBinary &&
+    _msg.ParseFromArray(_chunk.data() + entryStart,
+        static_cast<int>(entryLength));
+}
+
 /////////////////////////////////////////////////
 bool LogPlay::Rewind()
 {
   std::lock_guard<std::mutex> lock(this->mutex);
 
   this->currentChunk.clear();
+
+  // The first chunk only contains the world description, so the next
+  // step starts at the second chunk.
+  this->chunkIndex = 1;
+  this->chunkEntries = 0;
+
+  if (this->binaryFile.is_open())
+  {
+    if (this->binaryChunks.empty())
+    {
+      gzerr << "Unable to jump to the beginning of the log file\n";
+      return false;
+    }
+    return true;
+  }
+
   this->logCurrXml = this->logStartXml->FirstChildElement("chunk");
   if (!logCurrXml)
   {
@@ -379,9 +674,220 @@ bool LogPlay::Rewind()
   return true;
 }
 
+/////////////////////////////////////////////////
+uint64_t LogPlay::GetEntryCount()
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  while (this->IndexNextChunk());
+  return this->entries.size();
+}
+
+/////////////////////////////////////////////////
+uint64_t LogPlay::GetPosition()
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+
+  if (this->chunkIndex == 0)
+    return 0;
+
+  // The position is counted from the entries of the chunks before the
+  // current one.
+  while (this->indexedChunks < this->chunkIndex && this->IndexNextChunk());
+
+  // Step() moves to the next chunk once the current one has no more
+  // entries.
+  size_t start, length, next;
+  bool binary;
+  if (!this->NextEntry(this->currentChunk, 0, start, length, next, binary))
+    return FirstEntryOfChunk(this->entries, this->chunkIndex);
+
+  return FirstEntryOfChunk(this->entries, this->chunkIndex - 1) +
+    this->chunkEntries;
+}
+
+/////////////////////////////////////////////////
+bool LogPlay::SetPosition(const uint64_t _entry)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  while (_entry >= this->entries.size() && this->IndexNextChunk());
+
+  if (_entry >= this->entries.size())
+    return false;
+
+  const LogPlayEntry &entry = this->entries[_entry];
+  this->currentChunk.clear();
+
+  if (this->binaryFile.is_open())
+  {
+    if (!this->GetBinaryChunk(entry.chunk, this->currentChunk))
+      return false;
+  }
+  else
+  {
+    TiXmlElement *xml = this->logStartXml->FirstChildElement("chunk");
+    for (unsigned int i = 0; xml && i < entry.chunk; ++i)
+      xml = xml->NextSiblingElement("chunk");
+
+    if (!this->GetChunkData(xml, this->currentChunk))
+    {
+      gzerr << "Unable to decode log file\n";
+      return false;
+    }
+    this->logCurrXml = xml;
+  }
+
+  this->currentChunk.erase(0, entry.offset);
+  this->chunkIndex = entry.chunk + 1;
+  this->chunkEntries = _entry - FirstEntryOfChunk(this->entries, entry.chunk);
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+uint64_t LogPlay::FindEntry(const common::Time &_time)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  while ((this->entries.empty() || this->entries.back().simTime < _time) &&
+      this->IndexNextChunk());
+
+  if (this->entries.empty())
+    return 0;
+
+  auto iter = std::lower_bound(this->entries.begin(), this->entries.end(),
+      _time, [](const LogPlayEntry &_entry, const common::Time &_t)
+      {
+        return _entry.simTime < _t;
+      });
+
+  if (iter == this->entries.end())
+    return this->entries.size() - 1;
+
+  return iter - this->entries.begin();
+}
+
+/////////////////////////////////////////////////
+std::vector<uint64_t> LogPlay::GetModelChangeEntries(const uint64_t _first,
+    const uint64_t _last)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  while (this->entries.size() < _last && this->IndexNextChunk());
+
+  std::vector<uint64_t> result;
+  for (uint64_t i = _first; i < std::min(_last,
+        static_cast<uint64_t>(this->entries.size())); ++i)
+  {
+    if (this->entries[i].modelChanges)
+      result.push_back(i);
+  }
+
+  return result;
+}
+
+/////////////////////////////////////////////////
+bool LogPlay::IndexNextChunk()
+{
+  if (this->entriesIndexed || !this->IsOpen())
+    return false;
+
+  const std::string endMarker = "</sdf>";
+  const std::string timeStart = "<sim_time>";
+  const std::string timeEnd = "</sim_time>";
+  const std::string insertions = "<insertions>";
+  const std::string deletions = "<deletions>";
+
+  // Decoding a chunk changes the encoding reported by GetEncoding().
+  std::string prevEncoding = this->encoding;
+
+  const unsigned int chunk = this->indexedChunks;
+  std::string data;
+  bool found;
+  if (this->binaryFile.is_open())
+    found = this->GetBinaryChunk(chunk, data);
+  else
+  {
+    if (chunk == 0)
+      this->indexXml = this->logStartXml->FirstChildElement("chunk");
+
+    found = this->indexXml != NULL;
+    if (found && !this->GetChunkData(this->indexXml, data))
+    {
+      gzerr << "Unable to decode log file\n";
+      found = false;
+    }
+
+    if (found)
+      this->indexXml = this->indexXml->NextSiblingElement("chunk");
+  }
+
+  this->encoding = prevEncoding;
+
+  if (!found)
+  {
+    this->entriesIndexed = true;
+    return false;
+  }
+
+  // Locate the entries the same way as Step(). Entries without a
+  // <sim_time>, such as the world description, use the time of the
+  // previous entry.
+  size_t offset = 0;
+  size_t nextInsertion = data.find(insertions);
+  size_t nextDeletion = data.find(deletions);
+  size_t start, length, next;
+  bool binary;
+  while (this->NextEntry(data, offset, start, length, next, binary))
+  {
+    LogPlayEntry entry;
+    entry.chunk = chunk;
+    entry.offset = offset;
+    entry.modelChanges = false;
+
+    if (binary)
+    {
+      msgs::WorldState msg;
+      if (msg.ParseFromArray(data.data() + start, static_cast<int>(length)))
+      {
+        if (msg.has_sim_time())
+          this->indexSimTime = msgs::Convert(msg.sim_time());
+        entry.modelChanges =
+          msg.insertion_size() > 0 || msg.deletion_size() > 0;
+      }
+    }
+    else
+    {
+      size_t end = next - endMarker.size();
+
+      size_t from = data.find(timeStart, start);
+      size_t to = data.find(timeEnd, start);
+      if (from < to && to < end)
+      {
+        std::stringstream ss(data.substr(from + timeStart.size(),
+              to - from - timeStart.size()));
+        ss >> this->indexSimTime;
+      }
+
+      if (nextInsertion < start)
+        nextInsertion = data.find(insertions, start);
+      if (nextDeletion < start)
+        nextDeletion = data.find(deletions, start);
+      entry.modelChanges = nextInsertion < end || nextDeletion < end;
+    }
+    entry.simTime = this->indexSimTime;
+
+    this->entries.push_back(entry);
+    offset = next;
+  }
+
+  ++this->indexedChunks;
+  return true;
+}
+
 /////////////////////////////////////////////////
 bool LogPlay::GetChunk(unsigned int _index, std::string &_data)
 {
+  if (this->binaryFile.is_open())
+    return this->GetBinaryChunk(_index, _data);
+
   unsigned int count = 0;
   TiXmlElement *xml = this->logStartXml->FirstChildElement("chunk");
 
@@ -471,6 +977,9 @@ std::string LogPlay::GetEncoding() const
 /////////////////////////////////////////////////
 unsigned int LogPlay::GetChunkCount() const
 {
+  if (this->binaryFile.is_open())
+    return this->binaryChunks.size();
+
   unsigned int count = 0;
   TiXmlElement *xml = this->logStartXml->FirstChildElement("chunk");
 
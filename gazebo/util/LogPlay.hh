@@ -18,13 +18,16 @@
 #define _GAZEBO_LOGPLAY_HH_
 
 #include <tinyxml.h>
+#include <boost/iostreams/device/mapped_file.hpp>
 
 #include <list>
 #include <mutex>
 #include <string>
+#include <vector>
 
 #include "gazebo/common/SingletonT.hh"
 #include "gazebo/common/Time.hh"
+#include "gazebo/msgs/msgs.hh"
 #include "gazebo/util/system.hh"
 
 namespace gazebo
@@ -34,6 +37,23 @@ namespace gazebo
     /// \addtogroup gazebo_physics
     /// \{
 
+    /// \internal
+    /// \brief Location of a state entry in a log file.
+    class LogPlayEntry
+    {
+      /// \brief Index of the chunk that contains the entry.
+      public: unsigned int chunk;
+
+      /// \brief Offset of the entry in the chunk data.
+      public: size_t offset;
+
+      /// \brief Simulation time of the entry.
+      public: common::Time simTime;
+
+      /// \brief True if the entry inserts or deletes models.
+      public: bool modelChanges;
+    };
+
     /// \class Logplay Logplay.hh util/util.hh
     /// \brief Open and playback log files that were recorded using LogRecord.
     ///
@@ -43,6 +63,18 @@ namespace gazebo
     /// World using the Play functions. Replay involves reading and applying
     /// state information to a World.
     ///
+    /// Log files recorded with the "bin" encoding are memory mapped, and
+    /// their chunks are located through the chunk index, so opening them
+    /// does not require reading the whole file. Their world states are
+    /// stored as msgs::WorldState messages instead of SDF, see
+    /// Step(std::string &, bool &).
+    ///
+    /// Every state entry in a log file holds the state of all the models,
+    /// so it can be used as a keyframe. The first time an entry is looked
+    /// up by position or time, an index with the location and simulation
+    /// time of every entry is built. It is then possible to jump to any
+    /// entry without stepping through the ones before it.
+    ///
     /// \sa LogRecord, State
     class GZ_UTIL_VISIBLE LogPlay : public SingletonT<LogPlay>
     {
@@ -100,14 +132,53 @@ namespace gazebo
       public: uintmax_t GetFileSize() const;
 
       /// \brief Step through the open log file.
-      /// \param[out] _data Data from next entry in the log file.
+      /// \param[out] _data Data from next entry in the log file. The states
+      /// of log files with the "bin" encoding are not SDF, use
+      /// Step(std::string &, bool &) to tell them apart.
       public: bool Step(std::string &_data);
 
+      /// \brief Step through the open log file.
+      /// \param[out] _data Data from next entry in the log file.
+      /// \param[out] _binary True if _data is a serialized msgs::WorldState,
+      /// as stored in log files with the "bin" encoding. False if _data is
+      /// SDF.
+      /// \return False if there are no more entries.
+      public: bool Step(std::string &_data, bool &_binary);
+
       /// \brief Jump to the beginning of the log file. The next step() call
       /// will return the first data "chunk".
       /// \return True If the function succeed or false otherwise.
       public: bool Rewind();
 
+      /// \brief Get the number of state entries in the open log file.
+      /// \return Number of entries that Step() returns after Open().
+      public: uint64_t GetEntryCount();
+
+      /// \brief Get the position in the open log file.
+      /// \return Index of the entry that the next call to Step() returns.
+      public: uint64_t GetPosition();
+
+      /// \brief Move to a state entry. The next call to Step() returns
+      /// this entry.
+      /// \param[in] _entry Index of the entry.
+      /// \return True if the entry exists.
+      public: bool SetPosition(const uint64_t _entry);
+
+      /// \brief Find the first state entry recorded at or after a
+      /// simulation time.
+      /// \param[in] _time Simulation time.
+      /// \return Index of the entry, or the index of the last entry if the
+      /// log ends before _time.
+      public: uint64_t FindEntry(const common::Time &_time);
+
+      /// \brief Get the state entries that insert or delete models.
+      /// \param[in] _first Index of the first entry to check.
+      /// \param[in] _last Index one past the last entry to check.
+      /// \return Indexes of the entries in [_first, _last) that insert or
+      /// delete models.
+      public: std::vector<uint64_t> GetModelChangeEntries(const uint64_t _first,
+                  const uint64_t _last);
+
       /// \brief Get the number of chunks (steps) in the open log file.
       /// \return The number of recorded states in the log file.
       public: unsigned int GetChunkCount() const;
@@ -146,7 +217,58 @@ namespace gazebo
       private: bool GetChunkData(TiXmlElement *_xml, std::string &_data);
 
       /// \brief Read the header from the log file.
-      private: void ReadHeader();
+      /// \param[in] _headerXml The <header> element.
+      private: void ReadHeader(TiXmlElement *_headerXml);
+
+      /// \brief Check if a file uses the "bin" log encoding.
+      /// \param[in] _logFile Path to the file.
+      /// \return True if the file starts with GZ_LOG_BINARY_MAGIC.
+      private: static bool IsBinary(const std::string &_logFile);
+
+      /// \brief Open a log file that uses the "bin" encoding.
+      /// \param[in] _logFile Path to the file.
+      /// \throws Exception When the file is not a valid binary log.
+      private: void OpenBinary(const std::string &_logFile);
+
+      /// \brief Read the chunk index of a binary log file. If the file has
+      /// no valid index, the chunks are found by scanning the file.
+      /// \param[in] _firstChunk File offset of the first chunk.
+      private: void ReadBinaryIndex(uint64_t _firstChunk);
+
+      /// \brief Get data for a chunk of a binary log file.
+      /// \param[in] _index Index of the chunk.
+      /// \param[out] _data Storage for the chunk's data.
+      /// \return True if the _index was valid.
+      private: bool GetBinaryChunk(unsigned int _index, std::string &_data);
+
+      /// \brief Locate a state entry in chunk data.
+      /// \param[in] _chunk Chunk data.
+      /// \param[in] _offset Offset in _chunk where the search starts.
+      /// \param[out] _start Offset of the entry data.
+      /// \param[out] _length Length of the entry data.
+      /// \param[out] _next Offset after the entry.
+      /// \param[out] _binary True if the entry is a serialized
+      /// msgs::WorldState, false if it is SDF.
+      /// \return False if there are no more entries.
+      private: bool NextEntry(const std::string &_chunk, const size_t _offset,
+                   size_t &_start, size_t &_length, size_t &_next,
+                   bool &_binary) const;
+
+      /// \brief Decode the first or the last entry of a chunk, if the entry
+      /// is a serialized msgs::WorldState.
+      /// \param[in] _chunk Chunk data.
+      /// \param[in] _last True for the last entry, false for the first.
+      /// \param[out] _msg The decoded state.
+      /// \return False if the entry is SDF or could not be decoded.
+      private: bool GetStateMsg(const std::string &_chunk, const bool _last,
+                   msgs::WorldState &_msg) const;
+
+      /// \brief Add the entries of the next chunk that is not indexed yet
+      /// to the index of state entries. The index is built only as far as
+      /// it is needed, so that a seek near the start of a long log doesn't
+      /// decode the whole file. The mutex must be locked.
+      /// \return False if every chunk has been indexed.
+      private: bool IndexNextChunk();
 
       /// \brief Update the internal variables that keep track of the times
       /// where the log started and finished (simulation time).
@@ -165,6 +287,35 @@ namespace gazebo
       /// \brief Current position in the log file.
       private: TiXmlElement *logCurrXml;
 
+      /// \brief Memory mapped log file with "bin" encoding.
+      private: boost::iostreams::mapped_file_source binaryFile;
+
+      /// \brief File offset of each chunk in a binary log file.
+      private: std::vector<uint64_t> binaryChunks;
+
+      /// \brief Index of the next chunk to step through.
+      private: unsigned int chunkIndex;
+
+      /// \brief Number of entries returned by Step() from the current
+      /// chunk.
+      private: unsigned int chunkEntries;
+
+      /// \brief Location of the state entries of the chunks indexed so
+      /// far.
+      private: std::vector<LogPlayEntry> entries;
+
+      /// \brief True if every chunk has been indexed.
+      private: bool entriesIndexed;
+
+      /// \brief Number of chunks in the entries index.
+      private: unsigned int indexedChunks;
+
+      /// \brief Next chunk to index in a log file with XML encoding.
+      private: TiXmlElement *indexXml;
+
+      /// \brief Simulation time of the last indexed entry.
+      private: common::Time indexSimTime;
+
       /// \brief Name of the log file.
       private: std::string filename;
 
@@ -17,10 +17,14 @@
 
 #include <gtest/gtest.h>
 #include <boost/filesystem.hpp>
+#include <fstream>
 #include <string>
+#include <vector>
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Time.hh"
+#include "gazebo/msgs/msgs.hh"
 #include "gazebo/util/LogPlay.hh"
+#include "gazebo/util/LogRecord.hh"
 #include "test_config.h"
 #include "test/util.hh"
 
@@ -178,6 +182,272 @@ TEST_F(LogPlay_TEST, Rewind)
   EXPECT_EQ(entry, firstEntry);
 }
 
+/////////////////////////////////////////////////
+/// \brief Test random access to the log entries.
+TEST_F(LogPlay_TEST, Seek)
+{
+  gazebo::util::LogPlay *player = gazebo::util::LogPlay::Instance();
+
+  // Open a correct log file.
+  boost::filesystem::path logFilePath(TEST_PATH);
+  logFilePath /= boost::filesystem::path("logs");
+  logFilePath /= boost::filesystem::path("state.log");
+
+  EXPECT_NO_THROW(player->Open(logFilePath.string()));
+  EXPECT_EQ(player->GetPosition(), 0u);
+
+  // Read all the entries in order.
+  std::vector<std::string> entries;
+  std::string entry;
+  while (player->Step(entry))
+    entries.push_back(entry);
+
+  EXPECT_EQ(player->GetEntryCount(), entries.size());
+  EXPECT_EQ(player->GetPosition(), entries.size());
+
+  // Jump around the log file.
+  for (auto const index : {5u, 3000u, 1u, 0u, 1500u})
+  {
+    ASSERT_LT(index, entries.size());
+    EXPECT_TRUE(player->SetPosition(index));
+    EXPECT_EQ(player->GetPosition(), index);
+    EXPECT_TRUE(player->Step(entry));
+    EXPECT_EQ(entry, entries[index]);
+    EXPECT_EQ(player->GetPosition(), index + 1);
+  }
+  EXPECT_FALSE(player->SetPosition(entries.size()));
+
+  // Rewind goes back to the first state.
+  EXPECT_TRUE(player->Rewind());
+  EXPECT_EQ(player->GetPosition(), 1u);
+
+  // Find entries by simulation time.
+  EXPECT_EQ(player->FindEntry(player->GetLogStartTime()), 1u);
+  EXPECT_EQ(player->FindEntry(player->GetLogEndTime()), entries.size() - 1);
+  EXPECT_EQ(player->FindEntry(
+      player->GetLogEndTime() + gazebo::common::Time(10, 0)),
+      entries.size() - 1);
+
+  // This log file does not insert or delete models.
+  EXPECT_TRUE(player->GetModelChangeEntries(0, entries.size()).empty());
+
+  // The index is built as far as it is needed, seek again after opening
+  // the file before anything else is indexed.
+  EXPECT_NO_THROW(player->Open(logFilePath.string()));
+  EXPECT_EQ(player->FindEntry(player->GetLogStartTime()), 1u);
+  for (auto const index : {5u, 1500u, 3u, 3000u})
+  {
+    EXPECT_TRUE(player->SetPosition(index));
+    EXPECT_EQ(player->GetPosition(), index);
+    EXPECT_TRUE(player->Step(entry));
+    EXPECT_EQ(entry, entries[index]);
+  }
+  EXPECT_EQ(player->GetEntryCount(), entries.size());
+}
+
+/////////////////////////////////////////////////
+/// \brief Log a simulation time for every update.
+/// \param[out] _stream Stream that receives the log data.
+/// \return True if data was logged.
+static bool LogSimTime(std::ostringstream &_stream)
+{
+  static int count = 0;
+  _stream << "<sdf version='1.5'><state world_name='default'>"
+          << "<sim_time>" << count++ << " 0</sim_time>"
+          << "</state></sdf>";
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Record and play back a binary log file.
+TEST_F(LogPlay_TEST, Binary)
+{
+  gazebo::util::LogRecord *recorder = gazebo::util::LogRecord::Instance();
+  gazebo::util::LogPlay *player = gazebo::util::LogPlay::Instance();
+
+  boost::filesystem::path logPath = boost::filesystem::temp_directory_path();
+  logPath /= boost::filesystem::unique_path("gazebo-log-%%%%-%%%%");
+
+  recorder->Init("test");
+  recorder->Add("default", "state.log", &LogSimTime);
+  EXPECT_TRUE(recorder->Start("bin", logPath.string()));
+  EXPECT_EQ(recorder->GetEncoding(), "bin");
+
+  // Record a few chunks.
+  for (int i = 0; i < 5; ++i)
+  {
+    recorder->Notify();
+    gazebo::common::Time::MSleep(100);
+  }
+
+  recorder->Stop();
+  int i = 0;
+  while (!recorder->IsReadyToStart())
+  {
+    gazebo::common::Time::MSleep(100);
+    if ((++i % 50) == 0)
+      gzdbg << "Waiting for recorder->IsReadyToStart()" << std::endl;
+  }
+
+  std::string filename = recorder->GetFilename("default");
+  EXPECT_NO_THROW(player->Open(filename));
+  EXPECT_TRUE(player->IsOpen());
+  EXPECT_EQ(player->GetEncoding(), "bin");
+  EXPECT_GE(player->GetChunkCount(), 2u);
+
+  // Each chunk is stored as it was logged.
+  std::string chunk;
+  for (unsigned int c = 0; c < player->GetChunkCount(); ++c)
+  {
+    EXPECT_TRUE(player->GetChunk(c, chunk));
+    EXPECT_NE(chunk.find("<sim_time>"), std::string::npos);
+  }
+  EXPECT_FALSE(player->GetChunk(player->GetChunkCount(), chunk));
+  EXPECT_LT(player->GetLogStartTime(), player->GetLogEndTime());
+
+  // Drop the chunk index, as if the recording had not been stopped.
+  // The chunks are still found by scanning the file.
+  unsigned int count = player->GetChunkCount();
+  std::string data;
+  {
+    std::ifstream in(filename.c_str(), std::ios::binary);
+    data.assign(std::istreambuf_iterator<char>(in),
+        std::istreambuf_iterator<char>());
+  }
+  ASSERT_GT(data.size(), sizeof(uint64_t) + GZ_LOG_MAGIC_LENGTH);
+  uint64_t indexStart = 0;
+  size_t footer = data.size() - sizeof(uint64_t) - GZ_LOG_MAGIC_LENGTH;
+  for (unsigned int b = 0; b < sizeof(uint64_t); ++b)
+  {
+    indexStart |= static_cast<uint64_t>(
+        static_cast<unsigned char>(data[footer + b])) << (8 * b);
+  }
+  ASSERT_LT(indexStart, data.size());
+  EXPECT_EQ(data[indexStart], GZ_LOG_INDEX_TAG);
+  std::string truncated = logPath.string() + "/truncated.log";
+  {
+    std::ofstream out(truncated.c_str(), std::ios::binary);
+    out << data.substr(0, indexStart);
+  }
+
+  EXPECT_NO_THROW(player->Open(truncated));
+  EXPECT_TRUE(player->IsOpen());
+  EXPECT_EQ(player->GetChunkCount(), count);
+
+  boost::filesystem::remove_all(logPath);
+}
+
+/////////////////////////////////////////////////
+/// \brief Log a world description, and then two states per update, the
+/// way the World does with the "bin" encoding. State n is recorded at
+/// simulation time n and iteration n, and state 2 deletes a model.
+/// \param[out] _stream Stream that receives the log data.
+/// \return True if data was logged.
+static bool LogStateMsgs(std::ostringstream &_stream)
+{
+  static int count = 0;
+  if (count == 0)
+    _stream << "<sdf version='1.5'><world name='default'/></sdf>";
+
+  for (int i = 0; i < 2 && count > 0; ++i)
+  {
+    gazebo::msgs::WorldState msg;
+    msg.set_world_name("default");
+    gazebo::msgs::Set(msg.mutable_sim_time(), gazebo::common::Time(count, 0));
+    msg.set_iterations(count);
+    if (count == 2)
+      msg.add_deletion("box");
+
+    gazebo::util::LogRecord::AppendState(msg, _stream);
+    ++count;
+  }
+
+  if (count == 0)
+    ++count;
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Record and play back states stored as messages in a binary log
+/// file.
+TEST_F(LogPlay_TEST, BinaryStates)
+{
+  gazebo::util::LogRecord *recorder = gazebo::util::LogRecord::Instance();
+  gazebo::util::LogPlay *player = gazebo::util::LogPlay::Instance();
+
+  boost::filesystem::path logPath = boost::filesystem::temp_directory_path();
+  logPath /= boost::filesystem::unique_path("gazebo-log-%%%%-%%%%");
+
+  recorder->Init("test");
+  recorder->Add("default", "state.log", &LogStateMsgs);
+  EXPECT_TRUE(recorder->Start("bin", logPath.string()));
+
+  for (int i = 0; i < 5; ++i)
+  {
+    recorder->Notify();
+    gazebo::common::Time::MSleep(100);
+  }
+
+  recorder->Stop();
+  int i = 0;
+  while (!recorder->IsReadyToStart())
+  {
+    gazebo::common::Time::MSleep(100);
+    if ((++i % 50) == 0)
+      gzdbg << "Waiting for recorder->IsReadyToStart()" << std::endl;
+  }
+
+  EXPECT_NO_THROW(player->Open(recorder->GetFilename("default")));
+  EXPECT_TRUE(player->IsOpen());
+
+  // The log times and iterations are read from the messages.
+  EXPECT_EQ(player->GetLogStartTime(), gazebo::common::Time(1, 0));
+  EXPECT_TRUE(player->HasIterations());
+  EXPECT_EQ(player->GetInitialIterations(), 1u);
+
+  // The world description is SDF, and every state is a message.
+  std::string data;
+  bool binary = true;
+  EXPECT_TRUE(player->Step(data, binary));
+  EXPECT_FALSE(binary);
+  EXPECT_NE(data.find("<world name='default'/>"), std::string::npos);
+
+  uint64_t states = 0;
+  while (player->Step(data, binary))
+  {
+    ++states;
+    EXPECT_TRUE(binary);
+
+    gazebo::msgs::WorldState msg;
+    ASSERT_TRUE(msg.ParseFromString(data));
+    EXPECT_EQ(msg.world_name(), "default");
+    EXPECT_EQ(msg.iterations(), states);
+  }
+  ASSERT_GE(states, 4u);
+  EXPECT_EQ(player->GetLogEndTime(),
+      gazebo::common::Time(static_cast<int32_t>(states), 0));
+
+  // The index of the entries is built from the messages too.
+  EXPECT_EQ(player->GetEntryCount(), states + 1);
+  EXPECT_EQ(player->FindEntry(gazebo::common::Time(3, 0)), 3u);
+
+  std::vector<uint64_t> changes =
+    player->GetModelChangeEntries(0, states + 1);
+  ASSERT_EQ(changes.size(), 1u);
+  EXPECT_EQ(changes[0], 2u);
+
+  EXPECT_TRUE(player->SetPosition(3));
+  EXPECT_TRUE(player->Step(data, binary));
+  EXPECT_TRUE(binary);
+  gazebo::msgs::WorldState msg;
+  ASSERT_TRUE(msg.ParseFromString(data));
+  EXPECT_EQ(msg.iterations(), 3u);
+  EXPECT_EQ(player->GetPosition(), 4u);
+
+  boost::filesystem::remove_all(logPath);
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
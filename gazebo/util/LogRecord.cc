@@ -57,6 +57,16 @@
 using namespace gazebo;
 using namespace util;
 
+/// \brief Append an unsigned integer to a buffer in little endian order.
+/// \param[in,out] _buffer Buffer to append to.
+/// \param[in] _value Value to append.
+template<typename T>
+static void AppendLittleEndian(std::string &_buffer, T _value)
+{
+  for (unsigned int i = 0; i < sizeof(T); ++i)
+    _buffer.push_back(static_cast<char>((_value >> (8 * i)) & 0xFF));
+}
+
 //////////////////////////////////////////////////
 LogRecord::LogRecord()
 {
@@ -166,9 +176,12 @@ bool LogRecord::Start(const std::string &_encoding, const std::string &_path)
   if (!boost::filesystem::exists(this->logCompletePath))
     boost::filesystem::create_directories(logCompletePath);
 
-  if (_encoding != "bz2" && _encoding != "txt" && _encoding != "zlib")
+  if (_encoding != "bz2" && _encoding != "txt" && _encoding != "zlib" &&
+      _encoding != "bin")
+  {
     gzthrow("Invalid log encoding[" + _encoding +
-            "]. Must be one of [bz2, zlib, txt]");
+            "]. Must be one of [bz2, zlib, txt, bin]");
+  }
 
   this->encoding = _encoding;
 
@@ -222,6 +235,17 @@ const std::string &LogRecord::GetEncoding() const
   return this->encoding;
 }
 
+//////////////////////////////////////////////////
+void LogRecord::AppendState(const msgs::WorldState &_msg,
+    std::ostream &_stream)
+{
+  std::string entry;
+  entry.push_back(GZ_LOG_STATE_TAG);
+  AppendLittleEndian(entry, static_cast<uint32_t>(_msg.ByteSize()));
+  _msg.AppendToString(&entry);
+  _stream.write(entry.data(), entry.size());
+}
+
 //////////////////////////////////////////////////
 void LogRecord::Fini()
 {
@@ -553,6 +577,7 @@ LogRecord::Log::Log(LogRecord *_parent, const std::string &_relativeFilename,
 {
   this->parent = _parent;
   this->logCB = _logCB;
+  this->bytesWritten = 0;
 
   this->relativeFilename = _relativeFilename;
 }
@@ -572,9 +597,18 @@ unsigned int LogRecord::Log::Update()
   if (this->logCB(stream))
   {
     std::string data = stream.str();
-    if (!data.empty())
+    if (!data.empty() && this->encoding == "bin")
+    {
+      // Binary chunks are stored without compression or escaping, and
+      // indexed by their offset in the file.
+      this->chunkOffsets.push_back(this->bytesWritten + this->buffer.size());
+      this->buffer.push_back(GZ_LOG_CHUNK_TAG);
+      AppendLittleEndian(this->buffer, static_cast<uint32_t>(data.size()));
+      this->buffer.append(data);
+    }
+    else if (!data.empty())
     {
-      const std::string &encodingLocal = this->parent->GetEncoding();
+      const std::string &encodingLocal = this->encoding;
 
       this->buffer.append("<chunk encoding='");
       this->buffer.append(encodingLocal);
@@ -657,8 +691,26 @@ void LogRecord::Log::Stop()
     this->Update();
     this->Write();
 
-    std::string xmlEnd = "</gazebo_log>";
-    this->logFile.write(xmlEnd.c_str(), xmlEnd.size());
+    if (this->encoding == "bin")
+    {
+      // Write the chunk index.
+      std::string index;
+      index.reserve(1 + (this->chunkOffsets.size() + 2) * sizeof(uint64_t) +
+          GZ_LOG_MAGIC_LENGTH);
+      index.push_back(GZ_LOG_INDEX_TAG);
+      for (auto const &offset : this->chunkOffsets)
+        AppendLittleEndian(index, offset);
+      AppendLittleEndian(index,
+          static_cast<uint64_t>(this->chunkOffsets.size()));
+      AppendLittleEndian(index, this->bytesWritten);
+      index.append(GZ_LOG_INDEX_MAGIC, GZ_LOG_MAGIC_LENGTH);
+      this->logFile.write(index.c_str(), index.size());
+    }
+    else
+    {
+      std::string xmlEnd = "</gazebo_log>";
+      this->logFile.write(xmlEnd.c_str(), xmlEnd.size());
+    }
 
     this->logFile.close();
   }
@@ -677,16 +729,29 @@ void LogRecord::Log::Start(const boost::filesystem::path &_path)
     gzlog << "Filename [" + this->completePath.string() + "], already exists."
           << " The log file will be overwritten.\n";
 
+  this->encoding = this->parent->GetEncoding();
+  this->bytesWritten = 0;
+  this->chunkOffsets.clear();
+
   std::ostringstream stream;
-  stream << "<?xml version='1.0'?>\n"
-         << "<gazebo_log>\n"
-         << "<header>\n"
+  stream << "<header>\n"
          << "<log_version>" << GZ_LOG_VERSION << "</log_version>\n"
          << "<gazebo_version>" << GAZEBO_VERSION_FULL << "</gazebo_version>\n"
          << "<rand_seed>" << ignition::math::Rand::Seed() << "</rand_seed>\n"
          << "</header>\n";
+  std::string header = stream.str();
 
-  this->buffer.append(stream.str());
+  if (this->encoding == "bin")
+  {
+    this->buffer.append(GZ_LOG_BINARY_MAGIC, GZ_LOG_MAGIC_LENGTH);
+    AppendLittleEndian(this->buffer, static_cast<uint32_t>(header.size()));
+    this->buffer.append(header);
+  }
+  else
+  {
+    this->buffer.append("<?xml version='1.0'?>\n<gazebo_log>\n");
+    this->buffer.append(header);
+  }
 }
 
 //////////////////////////////////////////////////
@@ -720,6 +785,7 @@ void LogRecord::Log::Write()
   // Write out the contents of the buffer.
   this->logFile.write(this->buffer.c_str(), this->buffer.size());
   this->logFile.flush();
+  this->bytesWritten += this->buffer.size();
 
   // Clear the buffer.
   this->buffer.clear();
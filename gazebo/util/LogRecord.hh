@@ -25,6 +25,7 @@
 #include <fstream>
 #include <string>
 #include <map>
+#include <vector>
 #include <boost/thread.hpp>
 #include <boost/archive/iterators/base64_from_binary.hpp>
 #include <boost/archive/iterators/insert_linebreaks.hpp>
@@ -42,6 +43,26 @@
 
 #define GZ_LOG_VERSION "1.0"
 
+/// \brief Magic bytes at the start of a log file with "bin" encoding.
+#define GZ_LOG_BINARY_MAGIC "GZLOGBIN"
+
+/// \brief Magic bytes at the end of a log file with "bin" encoding, when
+/// the file has a chunk index.
+#define GZ_LOG_INDEX_MAGIC "GZLOGIDX"
+
+/// \brief Length of GZ_LOG_BINARY_MAGIC and GZ_LOG_INDEX_MAGIC.
+#define GZ_LOG_MAGIC_LENGTH 8
+
+/// \brief Tag that starts each chunk record in a "bin" log file.
+#define GZ_LOG_CHUNK_TAG 'C'
+
+/// \brief Tag that starts the chunk index in a "bin" log file.
+#define GZ_LOG_INDEX_TAG 'I'
+
+/// \brief Tag that starts each state entry stored as a message in the
+/// chunk data of a "bin" log file.
+#define GZ_LOG_STATE_TAG 'S'
+
 namespace gazebo
 {
   namespace util
@@ -65,6 +86,23 @@ namespace gazebo
     /// The LogRecord is updated at the start of each simulation step. This
     /// guarantees that all data is stored.
     ///
+    /// The "bin" encoding stores chunks uncompressed in a binary file that
+    /// does not need to be parsed as XML:
+    ///   - GZ_LOG_BINARY_MAGIC
+    ///   - uint32 header length, followed by the XML <header> element
+    ///   - For each chunk: GZ_LOG_CHUNK_TAG, uint32 length, chunk data
+    ///   - GZ_LOG_INDEX_TAG, uint64 file offset of each chunk, uint64 chunk
+    ///     count, uint64 file offset of the index tag, GZ_LOG_INDEX_MAGIC
+    ///
+    /// The chunk data holds SDF text entries, as with the other encodings,
+    /// or state entries written with LogRecord::AppendState. The World logs
+    /// its states that way, so that playback doesn't have to parse SDF. A
+    /// state entry is GZ_LOG_STATE_TAG, uint32 length, and a serialized
+    /// msgs::WorldState.
+    ///
+    /// All integers are little endian. The index is written when logging
+    /// stops. LogPlay rebuilds it if the file was not closed properly.
+    ///
     /// \sa Logplay, State
     class GZ_UTIL_VISIBLE LogRecord : public SingletonT<LogRecord>
     {
@@ -134,16 +172,24 @@ namespace gazebo
       public: bool GetRunning() const;
 
       /// \brief Start the logger.
-      /// \param[in] _encoding The type of encoding (txt, zlib, or bz2).
+      /// \param[in] _encoding The type of encoding (txt, zlib, bz2, or bin).
       /// \param[in] _path Path in which to store log files.
       public: bool Start(const std::string &_encoding="zlib",
                   const std::string &_path="");
 
       /// \brief Get the encoding used.
-      /// \return Either [txt, zlib, or bz2], where txt is plain txt and bz2
-      /// and zlib are compressed data with Base64 encoding.
+      /// \return Either [txt, zlib, bz2, or bin], where txt is plain txt, bz2
+      /// and zlib are compressed data with Base64 encoding, and bin is an
+      /// indexed binary file.
       public: const std::string &GetEncoding() const;
 
+      /// \brief Append a state entry to the data of a log object, for log
+      /// files with the "bin" encoding.
+      /// \param[in] _msg State of the world.
+      /// \param[out] _stream Stream that receives the log data.
+      public: static void AppendState(const msgs::WorldState &_msg,
+                  std::ostream &_stream);
+
       /// \brief Get the filename for a log object.
       /// \param[in] _name Name of the log object.
       /// \return Filename, empty string if not found.
@@ -272,6 +318,16 @@ namespace gazebo
         /// \brief Relative log filename.
         public: std::string relativeFilename;
 
+        /// \brief Encoding used since the log was started.
+        public: std::string encoding;
+
+        /// \brief Number of bytes written to the log file.
+        public: uint64_t bytesWritten;
+
+        /// \brief File offset of each chunk, used to write the index of a
+        /// binary log file.
+        public: std::vector<uint64_t> chunkOffsets;
+
         /// \brief Complete file path.
         private: boost::filesystem::path completePath;
       };
@@ -168,6 +168,83 @@ TEST_F(CameraSensor, FillMsg)
   EXPECT_EQ(cameraMsg.far_clip(), cam->GetFarClip());
 }
 
+/////////////////////////////////////////////////
+/// \brief Last image message received by OnImage.
+boost::shared_ptr<const msgs::ImageStamped> imageMsg;
+
+/////////////////////////////////////////////////
+void OnImage(ConstImageStampedPtr &_msg)
+{
+  boost::mutex::scoped_lock lock(mutex);
+  imageMsg = _msg;
+}
+
+/////////////////////////////////////////////////
+TEST_F(CameraSensor, Compression)
+{
+  Load("worlds/empty_test.world");
+
+  // Make sure the render engine is available.
+  if (rendering::RenderEngine::Instance()->GetRenderPathType() ==
+      rendering::RenderEngine::NONE)
+  {
+    gzerr << "No rendering engine, unable to run camera test\n";
+    return;
+  }
+
+  std::string modelName = "camera_model";
+  std::string cameraName = "camera_sensor";
+  unsigned int width  = 320;
+  unsigned int height = 240;
+  double updateRate = 10;
+  math::Pose setPose(
+      math::Vector3(-5, 0, 5), math::Quaternion(0, GZ_DTOR(15), 0));
+  SpawnCamera(modelName, cameraName, setPose.pos,
+      setPose.rot.GetAsEuler(), width, height, updateRate);
+  sensors::SensorPtr sensor = sensors::get_sensor(cameraName);
+  sensors::CameraSensorPtr camSensor =
+    boost::dynamic_pointer_cast<sensors::CameraSensor>(sensor);
+  ASSERT_TRUE(camSensor != NULL);
+
+  EXPECT_FALSE(camSensor->SetCompression("bmp"));
+  EXPECT_TRUE(camSensor->SetCompression("jpeg", 80));
+
+  transport::SubscriberPtr sub = this->node->Subscribe(
+      camSensor->GetTopic(), &OnImage);
+
+  // Wait for a compressed image
+  boost::shared_ptr<const msgs::ImageStamped> msg;
+  for (int i = 0; i < 300; ++i)
+  {
+    {
+      boost::mutex::scoped_lock lock(mutex);
+      if (imageMsg && imageMsg->image().compression() == msgs::Image::JPEG)
+        msg = imageMsg;
+    }
+    if (msg)
+      break;
+    common::Time::MSleep(10);
+  }
+  ASSERT_TRUE(msg != NULL);
+
+  // The size and format describe the decoded image
+  const msgs::Image &image = msg->image();
+  EXPECT_EQ(width, image.width());
+  EXPECT_EQ(height, image.height());
+  EXPECT_LT(image.data().size(), width * height * 3);
+
+  std::string decoded;
+  EXPECT_TRUE(common::Image::Decode(image.data(), image.width(),
+        image.height(),
+        static_cast<common::Image::PixelFormat>(image.pixel_format()),
+        decoded));
+  EXPECT_EQ(width * height * 3, decoded.size());
+
+  sub.reset();
+  boost::mutex::scoped_lock lock(mutex);
+  imageMsg.reset();
+}
+
 /////////////////////////////////////////////////
 TEST_F(CameraSensor, UnlimitedTest)
 {
@@ -36,6 +36,7 @@ class LaserTest : public ServerFixture,
   public: void LaserUnitNoise(const std::string &_physicsEngine);
   public: void LaserVertical(const std::string &_physicsEngine);
   public: void LaserScanResolution(const std::string &_physicsEngine);
+  public: void LaserManyRays(const std::string &_physicsEngine);
 };
 
 void LaserTest::Stationary_EmptyWorld(const std::string &_physicsEngine)
@@ -595,6 +596,96 @@ TEST_P(LaserTest, LaserNoise)
   LaserUnitNoise(GetParam());
 }
 
+/////////////////////////////////////////////////
+void LaserTest::LaserManyRays(const std::string &_physicsEngine)
+{
+  if (_physicsEngine == "simbody")
+  {
+    gzerr << "Abort test since simbody does not support ray sensor, "
+          << "Please see issue #867.\n";
+    return;
+  }
+
+  if (_physicsEngine == "dart")
+  {
+    gzerr << "Abort test since dart does not support ray shape and sensor, "
+          << "Please see issue #911. "
+          << "(https://bitbucket.org/osrf/gazebo/issue/911).\n";
+    return;
+  }
+
+  // Test a dense ray sensor, with many more rays than a ray packet, against
+  // a box and a sphere.
+  Load("worlds/empty.world", true, _physicsEngine);
+
+  std::string modelName = "ray_model";
+  std::string raySensorName = "ray_sensor";
+  double vMinAngle = -0.1;
+  double vMaxAngle = 0.1;
+  double maxRange = 5.0;
+  unsigned int samples = 1000;
+  unsigned int vSamples = 16;
+  double vAngleStep = (vMaxAngle - vMinAngle) / (vSamples-1);
+  math::Vector3 testPos(0.25, 0, 0.5);
+
+  SpawnRaySensor(modelName, raySensorName, testPos, math::Vector3::Zero,
+      -M_PI/2.0, M_PI/2.0, vMinAngle, vMaxAngle, 0.0, maxRange, 0.02,
+      samples, vSamples, 1, 1);
+
+  // box in front of ray sensor, sphere on its left
+  SpawnBox("box_01", math::Vector3(1, 1, 1), math::Vector3(1, 0, 0.5),
+      math::Vector3::Zero);
+  SpawnSphere("sphere_01", math::Vector3(0.25, 2, 0.5), math::Vector3::Zero);
+
+  sensors::RaySensorPtr raySensor =
+    boost::dynamic_pointer_cast<sensors::RaySensor>(
+        sensors::get_sensor(raySensorName));
+  ASSERT_TRUE(raySensor != NULL);
+
+  raySensor->Init();
+  raySensor->Update(true);
+
+  physics::MultiRayShapePtr shape = raySensor->GetLaserShape();
+  ASSERT_TRUE(shape != NULL);
+  ASSERT_EQ(samples * vSamples, static_cast<unsigned int>(
+        raySensor->GetRayCount() * raySensor->GetVerticalRayCount()));
+
+  // The batched accessors match the per ray accessors
+  std::vector<double> ranges;
+  std::vector<double> retros;
+  shape->GetRanges(ranges);
+  shape->GetRetros(retros);
+  ASSERT_EQ(samples * vSamples, ranges.size());
+  ASSERT_EQ(samples * vSamples, retros.size());
+  for (unsigned int i = 0; i < ranges.size(); ++i)
+  {
+    EXPECT_DOUBLE_EQ(shape->GetRange(i), ranges[i]);
+    EXPECT_DOUBLE_EQ(shape->GetRetro(i), retros[i]);
+  }
+
+  unsigned int mid = samples / 2;
+  double angle = vMinAngle;
+  for (unsigned int j = 0; j < vSamples; ++j)
+  {
+    // The box is hit straight ahead
+    EXPECT_NEAR(raySensor->GetRange(j*samples + mid), 0.25 / cos(angle),
+        LASER_TOL);
+
+    // The sphere is hit on the left
+    EXPECT_LT(raySensor->GetRange(j*samples + samples-1), 2.0);
+
+    // Nothing is on the right
+    EXPECT_DOUBLE_EQ(raySensor->GetRange(j*samples), GZ_DBL_INF);
+
+    angle += vAngleStep;
+  }
+}
+
+TEST_P(LaserTest, LaserManyRays)
+{
+  LaserManyRays(GetParam());
+}
+
 INSTANTIATE_TEST_CASE_P(PhysicsEngines, LaserTest, PHYSICS_ENGINE_VALUES);
 
 int main(int argc, char **argv)
@@ -34,6 +34,11 @@ class PhysicsLinkTest : public ServerFixture,
   /// \param[in] _physicsEngine Type of physics engine to use.
   public: void AddForce(const std::string &_physicsEngine);
 
+  /// \brief Test that link poses follow the physics engine bodies as
+  /// models are inserted and removed.
+  /// \param[in] _physicsEngine Type of physics engine to use.
+  public: void PoseSync(const std::string &_physicsEngine);
+
   /// \brief Use AddLinkForce on the given direction and then the opposite
   /// direction so they cancel out.
   /// \param[in] _world World pointer.
@@ -726,6 +731,47 @@ void PhysicsLinkTest::SetVelocity(const std::string &_physicsEngine)
   EXPECT_NEAR(rpy.z, 0.0, g_tolerance);
 }
 
+/////////////////////////////////////////////////
+void PhysicsLinkTest::PoseSync(const std::string &_physicsEngine)
+{
+  Load("worlds/blank.world", true, _physicsEngine);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  math::Vector3 size(1, 1, 1);
+  math::Vector3 pos0(0, 0, 10);
+  SpawnBox("static_box", size, math::Vector3(5, 0, 0), math::Vector3::Zero,
+      true);
+  SpawnBox("box1", size, pos0, math::Vector3::Zero);
+  SpawnBox("box2", size, pos0 + math::Vector3(2, 0, 0), math::Vector3::Zero);
+
+  physics::ModelPtr staticBox = world->GetModel("static_box");
+  physics::ModelPtr box2 = world->GetModel("box2");
+  ASSERT_TRUE(staticBox != NULL);
+  ASSERT_TRUE(box2 != NULL);
+
+  // Falling links move, static links stay where they are.
+  world->Step(100);
+  double z = box2->GetWorldPose().pos.z;
+  EXPECT_LT(z, pos0.z);
+  EXPECT_EQ(staticBox->GetWorldPose().pos, math::Vector3(5, 0, 0));
+
+  // Remove a model, the others keep following their bodies.
+  world->RemoveModel("box1");
+  EXPECT_TRUE(world->GetModel("box1") == NULL);
+  world->Step(100);
+  EXPECT_LT(box2->GetWorldPose().pos.z, z);
+
+  // A model inserted afterwards is synced too.
+  SpawnBox("box3", size, pos0 + math::Vector3(-2, 0, 0),
+      math::Vector3::Zero);
+  physics::ModelPtr box3 = world->GetModel("box3");
+  ASSERT_TRUE(box3 != NULL);
+  world->Step(100);
+  EXPECT_LT(box3->GetWorldPose().pos.z, pos0.z);
+  EXPECT_EQ(staticBox->GetWorldPose().pos, math::Vector3(5, 0, 0));
+}
+
 /////////////////////////////////////////////////
 TEST_P(PhysicsLinkTest, AddForce)
 {
@@ -762,6 +808,12 @@ TEST_P(PhysicsLinkTest, SetVelocity)
   SetVelocity(GetParam());
 }
 
+/////////////////////////////////////////////////
+TEST_P(PhysicsLinkTest, PoseSync)
+{
+  PoseSync(GetParam());
+}
+
 INSTANTIATE_TEST_CASE_P(PhysicsEngines, PhysicsLinkTest,
                         PHYSICS_ENGINE_VALUES);
 
@@ -148,6 +148,48 @@ TEST_F(TransportTest, DirectPublish)
   ASSERT_GT(timeout, 0) << "Not received a message in 10 seconds";
 }
 
+/////////////////////////////////////////////////
+bool g_resubscribeMsg = false;
+void ReceiveResubscribeMsg(ConstGzStringPtr &/*_msg*/)
+{
+  g_resubscribeMsg = true;
+}
+
+/////////////////////////////////////////////////
+// A node that is finalized and initialized again must receive messages on
+// a topic it subscribes to again.
+TEST_F(TransportTest, ResubscribeAfterFini)
+{
+  Load("worlds/empty.world");
+
+  transport::NodePtr pubNode(new transport::Node());
+  pubNode->Init();
+  transport::PublisherPtr pub =
+    pubNode->Advertise<msgs::GzString>("~/resubscribe");
+
+  transport::NodePtr node(new transport::Node());
+  node->Init();
+  transport::SubscriberPtr sub =
+    node->Subscribe("~/resubscribe", &ReceiveStringMsg4);
+
+  sub.reset();
+  node->Fini();
+  node->Init();
+
+  g_resubscribeMsg = false;
+  sub = node->Subscribe("~/resubscribe", &ReceiveResubscribeMsg);
+
+  msgs::GzString msg;
+  msg.set_data("resubscribe");
+  for (int i = 0; i < 100 && !g_resubscribeMsg; ++i)
+  {
+    pub->Publish(msg);
+    common::Time::MSleep(10);
+  }
+
+  EXPECT_TRUE(g_resubscribeMsg);
+}
+
 /////////////////////////////////////////////////
 void SinglePub()
 {
@@ -410,6 +452,43 @@ TEST_F(TransportTest, IfaceGetAdvertisedTopics)
   EXPECT_TRUE(topicMap.find("gazebo.msgs.PosesStamped") != topicMap.end());
 }
 
+/////////////////////////////////////////////////
+// A large message is serialized once and the latched copy is shared.
+TEST_F(TransportTest, LargePrevMsg)
+{
+  Load("worlds/empty.world");
+
+  transport::NodePtr node = transport::NodePtr(new transport::Node());
+  node->Init();
+
+  g_stringMsg = false;
+  transport::SubscriberPtr sub = node->Subscribe("~/large",
+      &ReceiveStringMsg);
+  transport::PublisherPtr pub = node->Advertise<msgs::GzString>("~/large");
+  EXPECT_TRUE(pub->GetPrevMsg().empty());
+
+  msgs::GzString msg;
+  msg.set_data(std::string(1024*1024, 'x'));
+  pub->Publish(msg, true);
+
+  int i = 0;
+  while (!g_stringMsg && i < 100)
+  {
+    common::Time::MSleep(10);
+    ++i;
+  }
+  EXPECT_LT(i, 100);
+
+  std::string data = msg.SerializeAsString();
+  EXPECT_EQ(pub->GetPrevMsg(), data);
+  EXPECT_EQ(pub->GetPrevMsg(), data);
+
+  // Publishing a new message replaces the cached serialized data.
+  msg.set_data("small");
+  pub->Publish(msg, true);
+  EXPECT_EQ(pub->GetPrevMsg(), msg.SerializeAsString());
+}
+
 /////////////////////////////////////////////////
 // Test error cases
 TEST_F(TransportTest, Errors)
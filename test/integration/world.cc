@@ -242,6 +242,244 @@ TEST_F(WorldTest, RemoveModelUnPaused)
   EXPECT_FALSE(boxModel != NULL);
 }
 
+/////////////////////////////////////////////////
+TEST_F(WorldTest, EntityLookup)
+{
+  Load("worlds/shapes.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  physics::ModelPtr boxModel = world->GetModel("box");
+  ASSERT_TRUE(boxModel != NULL);
+  physics::LinkPtr boxLink = boxModel->GetLink("link");
+  ASSERT_TRUE(boxLink != NULL);
+
+  // Scoped names
+  EXPECT_EQ(world->GetByName("box"), boxModel);
+  EXPECT_EQ(world->GetEntity("box::link"), boxLink);
+  EXPECT_TRUE(world->GetModel("box::link") == NULL);
+
+  // Unscoped names are still found
+  EXPECT_TRUE(world->GetByName("link") != NULL);
+
+  // Ids
+  EXPECT_EQ(world->GetModelById(boxModel->GetId()), boxModel);
+  EXPECT_EQ(boxModel->GetLinkById(boxLink->GetId()), boxLink);
+  EXPECT_TRUE(world->GetModelById(boxLink->GetId()) == NULL);
+
+  // Renamed entities are found by their new name only
+  boxModel->SetName("renamed_box");
+  EXPECT_EQ(world->GetModel("renamed_box"), boxModel);
+  EXPECT_TRUE(world->GetModel("box") == NULL);
+
+  // Removed entities are not found
+  world->RemoveModel("renamed_box");
+  EXPECT_TRUE(world->GetModel("renamed_box") == NULL);
+  EXPECT_TRUE(world->GetEntity("box::link") == NULL);
+}
+
+/////////////////////////////////////////////////
+TEST_F(WorldTest, PartialStateLoad)
+{
+  Load("worlds/shapes.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  physics::ModelPtr boxModel = world->GetModel("box");
+  physics::ModelPtr sphereModel = world->GetModel("sphere");
+  ASSERT_TRUE(boxModel != NULL);
+  ASSERT_TRUE(sphereModel != NULL);
+
+  physics::WorldState state(world);
+  math::Pose spherePose = state.GetModelState("sphere").GetPose();
+
+  // Move both models, but only reload the box.
+  math::Pose boxPose(1, 2, 3, 0, 0, 0);
+  boxModel->SetWorldPose(boxPose);
+  sphereModel->SetWorldPose(math::Pose(4, 5, 6, 0, 0, 0));
+
+  physics::Model_V models;
+  models.push_back(boxModel);
+  EXPECT_TRUE(state.Load(world, models));
+  EXPECT_EQ(state.GetModelState("box").GetPose(), boxPose);
+  EXPECT_EQ(state.GetModelState("sphere").GetPose(), spherePose);
+  EXPECT_EQ(state.GetModelStateCount(), world->GetModelCount());
+
+  // A model without a state can't be reloaded on its own.
+  physics::WorldState emptyState;
+  EXPECT_FALSE(emptyState.Load(world, models));
+  EXPECT_EQ(emptyState.GetModelStateCount(), 0u);
+}
+
+/////////////////////////////////////////////////
+boost::mutex g_poseMutex;
+std::vector<msgs::Pose> g_boxPoses;
+uint32_t g_boxId = 0;
+
+/////////////////////////////////////////////////
+void OnPoses(ConstPosesStampedPtr &_msg)
+{
+  boost::mutex::scoped_lock lock(g_poseMutex);
+  for (int i = 0; i < _msg->pose_size(); ++i)
+  {
+    if (_msg->pose(i).id() == g_boxId)
+      g_boxPoses.push_back(_msg->pose(i));
+  }
+}
+
+/////////////////////////////////////////////////
+// Wait for a pose of the box to be received after stepping the world once.
+bool WaitForBoxPose(physics::WorldPtr _world, msgs::Pose &_pose)
+{
+  {
+    boost::mutex::scoped_lock lock(g_poseMutex);
+    g_boxPoses.clear();
+  }
+  _world->Step(1);
+
+  for (unsigned int i = 0; i < 100; ++i)
+  {
+    {
+      boost::mutex::scoped_lock lock(g_poseMutex);
+      if (!g_boxPoses.empty())
+      {
+        _pose = g_boxPoses.back();
+        return true;
+      }
+    }
+    common::Time::MSleep(10);
+  }
+  return false;
+}
+
+/////////////////////////////////////////////////
+TEST_F(WorldTest, CompactPoseMsgs)
+{
+  Load("worlds/shapes.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  physics::ModelPtr boxModel = world->GetModel("box");
+  ASSERT_TRUE(boxModel != NULL);
+  g_boxId = boxModel->GetId();
+
+  EXPECT_FALSE(world->CompactPoseMsgs());
+  world->SetCompactPoseMsgs(true);
+  EXPECT_TRUE(world->CompactPoseMsgs());
+
+  transport::SubscriberPtr sub =
+    this->node->Subscribe("~/pose/local/info", &OnPoses);
+
+  // The first pose published in compact mode carries the name.
+  msgs::Pose pose;
+  boxModel->SetWorldPose(math::Pose(1, 2, 0.5, 0, 0, 0));
+  ASSERT_TRUE(WaitForBoxPose(world, pose));
+  EXPECT_TRUE(pose.has_name());
+  EXPECT_EQ(pose.name(), "box");
+
+  // Later poses only carry the id.
+  boxModel->SetWorldPose(math::Pose(3, 4, 0.5, 0, 0, 0));
+  ASSERT_TRUE(WaitForBoxPose(world, pose));
+  EXPECT_FALSE(pose.has_name());
+  EXPECT_EQ(msgs::ConvertIgn(pose).Pos(), ignition::math::Vector3d(3, 4, 0.5));
+
+  // A new subscriber receives the names again.
+  transport::NodePtr lateNode(new transport::Node());
+  lateNode->Init();
+  transport::SubscriberPtr lateSub =
+    lateNode->Subscribe("~/pose/info", &OnPoses);
+  boxModel->SetWorldPose(math::Pose(4, 4, 0.5, 0, 0, 0));
+  ASSERT_TRUE(WaitForBoxPose(world, pose));
+  EXPECT_EQ(pose.name(), "box");
+
+  // Only the id is sent once the new subscriber has the names.
+  boxModel->SetWorldPose(math::Pose(3, 4, 0.5, 0, 0, 0));
+  ASSERT_TRUE(WaitForBoxPose(world, pose));
+  EXPECT_FALSE(pose.has_name());
+
+  // Names are sent again when compact mode is disabled.
+  world->SetCompactPoseMsgs(false);
+  boxModel->SetWorldPose(math::Pose(5, 6, 0.5, 0, 0, 0));
+  ASSERT_TRUE(WaitForBoxPose(world, pose));
+  EXPECT_EQ(pose.name(), "box");
+}
+
+/////////////////////////////////////////////////
+std::vector<msgs::Pose> g_lateBoxPoses;
+
+/////////////////////////////////////////////////
+void OnLatePoses(ConstPosesStampedPtr &_msg)
+{
+  boost::mutex::scoped_lock lock(g_poseMutex);
+  for (int i = 0; i < _msg->pose_size(); ++i)
+  {
+    if (_msg->pose(i).id() == g_boxId)
+      g_lateBoxPoses.push_back(_msg->pose(i));
+  }
+}
+
+/////////////////////////////////////////////////
+// A subscriber that joins while a model is idle gets the model's name when
+// the model moves later.
+TEST_F(WorldTest, CompactPoseMsgsLateSubscriber)
+{
+  Load("worlds/shapes.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  physics::ModelPtr boxModel = world->GetModel("box");
+  ASSERT_TRUE(boxModel != NULL);
+  physics::ModelPtr sphereModel = world->GetModel("sphere");
+  ASSERT_TRUE(sphereModel != NULL);
+  g_boxId = boxModel->GetId();
+
+  world->SetCompactPoseMsgs(true);
+  transport::SubscriberPtr sub =
+    this->node->Subscribe("~/pose/local/info", &OnPoses);
+
+  // Send the box name to the first subscriber.
+  msgs::Pose pose;
+  boxModel->SetWorldPose(math::Pose(1, 2, 0.5, 0, 0, 0));
+  ASSERT_TRUE(WaitForBoxPose(world, pose));
+  EXPECT_EQ(pose.name(), "box");
+  boxModel->SetWorldPose(math::Pose(3, 4, 0.5, 0, 0, 0));
+  ASSERT_TRUE(WaitForBoxPose(world, pose));
+  EXPECT_FALSE(pose.has_name());
+
+  // A subscriber joins while only the sphere moves.
+  transport::NodePtr lateNode(new transport::Node());
+  lateNode->Init();
+  transport::SubscriberPtr lateSub =
+    lateNode->Subscribe("~/pose/info", &OnLatePoses);
+  for (unsigned int i = 0; i < 5; ++i)
+  {
+    sphereModel->SetWorldPose(math::Pose(i, -2, 0.5, 0, 0, 0));
+    world->Step(1);
+  }
+
+  // The box moves after the subscriber joined.
+  boxModel->SetWorldPose(math::Pose(5, 6, 0.5, 0, 0, 0));
+  world->Step(1);
+
+  // The late subscriber has received the box name by the time it receives
+  // the new box pose.
+  bool received = false;
+  bool named = false;
+  for (unsigned int i = 0; i < 100 && !received; ++i)
+  {
+    common::Time::MSleep(10);
+    boost::mutex::scoped_lock lock(g_poseMutex);
+    for (auto const &p : g_lateBoxPoses)
+    {
+      named = named || p.name() == "box";
+      received = received ||
+        msgs::ConvertIgn(p).Pos() == ignition::math::Vector3d(5, 6, 0.5);
+    }
+  }
+  EXPECT_TRUE(received);
+  EXPECT_TRUE(named);
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
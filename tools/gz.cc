@@ -912,6 +912,112 @@ void StatsCommand::CB(ConstWorldStatisticsPtr &_msg)
         percent, simTime.Double(), realTime.Double(), paused);
 }
 
+/////////////////////////////////////////////////
+TraceCommand::TraceCommand()
+  : Command("trace", "Record a timing trace of a running gzserver instance.")
+{
+  // Options that are visible to the user through help.
+  this->visibleOptions.add_options()
+    ("world-name,w", po::value<std::string>(), "World name.")
+    ("duration,d", po::value<double>(), "Duration (seconds) to record.")
+    ("output,o", po::value<std::string>()->default_value("gazebo_trace.json"),
+     "Output file.")
+    ("timeout,t", po::value<double>()->default_value(30),
+     "Seconds to wait for gzserver to respond.");
+}
+
+/////////////////////////////////////////////////
+void TraceCommand::HelpDetailed()
+{
+  std::cerr <<
+    "\tRecord the timing of the simulation steps, physics, sensors and\n"
+    "\ttransport of gzserver, until the duration elapses or Ctrl-C is\n"
+    "\tpressed. The trace is written in the Chrome trace event format,\n"
+    "\twhich chrome://tracing and https://ui.perfetto.dev open. If a name\n"
+    "\tfor the world, option -w, is not specified, the first world found\n"
+    "\ton the Gazebo master will be used.\n"
+    << std::endl;
+}
+
+/////////////////////////////////////////////////
+bool TraceCommand::RunImpl()
+{
+  std::string worldName;
+  if (this->vm.count("world-name"))
+    worldName = this->vm["world-name"].as<std::string>();
+
+  std::string filename = this->vm["output"].as<std::string>();
+  common::Time timeout(this->vm["timeout"].as<double>());
+
+  // gzserver publishes the trace on its own topic, after responding to
+  // trace_stop.
+  transport::NodePtr node(new transport::Node());
+  node->Init(worldName);
+  transport::SubscriberPtr sub = node->Subscribe("~/trace",
+      &TraceCommand::OnTrace, this);
+
+  boost::shared_ptr<msgs::Response> response =
+    transport::request(worldName, "trace_start", "", timeout);
+  if (!response)
+  {
+    std::cerr << "No response from gzserver.\n";
+    return false;
+  }
+
+  std::cout << "Recording a trace, press Ctrl-C to stop.\n";
+
+  {
+    boost::mutex::scoped_lock lock(this->sigMutex);
+    if (this->vm.count("duration"))
+    {
+      this->sigCondition.timed_wait(lock,
+          boost::posix_time::milliseconds(static_cast<int64_t>(
+              this->vm["duration"].as<double>() * 1000)));
+    }
+    else
+      this->sigCondition.wait(lock);
+  }
+
+  response = transport::request(worldName, "trace_stop", "", timeout);
+
+  boost::shared_ptr<const msgs::GzString> msg;
+  if (response)
+  {
+    boost::mutex::scoped_lock lock(this->traceMutex);
+    if (!this->trace)
+    {
+      this->traceCondition.timed_wait(lock, boost::posix_time::milliseconds(
+            static_cast<int64_t>(timeout.Double() * 1000)));
+    }
+    msg = this->trace;
+  }
+
+  if (!msg)
+  {
+    std::cerr << "Unable to get the trace from gzserver.\n";
+    return false;
+  }
+
+  std::ofstream out(filename.c_str(), std::ios::out | std::ios::binary);
+  if (!out)
+  {
+    std::cerr << "Unable to open file[" << filename << "]\n";
+    return false;
+  }
+  out << msg->data();
+
+  std::cout << "Trace written to " << filename << std::endl;
+  return true;
+}
+
+/////////////////////////////////////////////////
+void TraceCommand::OnTrace(ConstGzStringPtr &_msg)
+{
+  boost::mutex::scoped_lock lock(this->traceMutex);
+  this->trace = _msg;
+  this->traceCondition.notify_all();
+}
+
 /////////////////////////////////////////////////
 SDFCommand::SDFCommand()
   : Command("sdf",
@@ -1233,6 +1339,7 @@ int main(int argc, char **argv)
   g_commandMap["topic"] = new TopicCommand();
   g_commandMap["log"] = new LogCommand();
   g_commandMap["sdf"] = new SDFCommand();
+  g_commandMap["trace"] = new TraceCommand();
   g_commandMap["debug"] = new DebugCommand();
 
   // Get the command name
@@ -201,6 +201,32 @@ namespace gazebo
     private: std::list<common::Time> realTimes;
   };
 
+  /// \brief Trace command
+  class TraceCommand : public Command
+  {
+    /// \brief Constructor
+    public: TraceCommand();
+
+    // Documentation inherited
+    public: virtual void HelpDetailed();
+
+    // Documentation inherited
+    protected: virtual bool RunImpl();
+
+    /// \brief Callback for the trace published by gzserver.
+    /// \param[in] _msg The trace.
+    private: void OnTrace(ConstGzStringPtr &_msg);
+
+    /// \brief Protects trace.
+    private: boost::mutex traceMutex;
+
+    /// \brief Notified when the trace is received.
+    private: boost::condition_variable traceCondition;
+
+    /// \brief The trace received from gzserver.
+    private: boost::shared_ptr<const msgs::GzString> trace;
+  };
+
   /// \brief SDF command
   class SDFCommand : public Command
   {
@@ -529,14 +529,28 @@ void StateFilter::Init(const std::string &_filter)
 }
 
 /////////////////////////////////////////////////
-std::string StateFilter::Filter(const std::string &_stateString)
+std::string StateFilter::Filter(const std::string &_stateString,
+    bool _binary)
 {
   gazebo::physics::WorldState state;
 
   // Read and parse the state information
-  g_stateSdf->ClearElements();
-  sdf::readString(_stateString, g_stateSdf);
-  state.Load(g_stateSdf);
+  if (_binary)
+  {
+    gazebo::msgs::WorldState msg;
+    if (!msg.ParseFromString(_stateString))
+    {
+      std::cerr << "Unable to decode a state in the log file.\n";
+      return std::string();
+    }
+    state.Load(msg);
+  }
+  else
+  {
+    g_stateSdf->ClearElements();
+    sdf::readString(_stateString, g_stateSdf);
+    state.Load(g_stateSdf);
+  }
 
   std::ostringstream result;
 
@@ -728,8 +742,11 @@ void LogCommand::Info(const std::string &_filename)
       }
     }
 
-      // Get the last chunk for the endTime
-    if (play->GetChunkCount() > 1)
+      // Get the last chunk for the endTime. The states of "bin" log files
+      // are not SDF, and LogPlay already read their end time.
+    if (play->GetEncoding() == "bin")
+      endTime = play->GetLogEndTime();
+    else if (play->GetChunkCount() > 1)
     {
       std::string stateString;
       play->GetChunk(play->GetChunkCount()-1, stateString);
@@ -793,10 +810,11 @@ void LogCommand::Echo(const std::string &_filter, bool _raw,
   filter.Init(_filter);
 
   unsigned int i = 0;
-  while (play->Step(stateString))
+  bool binary;
+  while (play->Step(stateString, binary))
   {
     if (i > 0)
-      stateString = filter.Filter(stateString);
+      stateString = filter.Filter(stateString, binary);
     else if (i == 0 && _raw)
       stateString.clear();
 
@@ -834,10 +852,11 @@ void LogCommand::Step(const std::string &_filter, bool _raw,
   filter.Init(_filter);
 
   unsigned int i = 0;
-  while (play->Step(stateString) && c != 'q')
+  bool binary;
+  while (play->Step(stateString, binary) && c != 'q')
   {
     if (i > 0)
-      stateString = filter.Filter(stateString);
+      stateString = filter.Filter(stateString, binary);
     else if (i == 0 && _raw)
       stateString.clear();
 
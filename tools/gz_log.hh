@@ -169,8 +169,12 @@ namespace gazebo
 
     /// \brief Perform filtering
     /// \param[in] _stateString The string to filter.
+    /// \param[in] _binary True if _stateString is a serialized
+    /// msgs::WorldState from a log file with the "bin" encoding, false if
+    /// it is SDF.
     /// \return Filtered string
-    public: std::string Filter(const std::string &_stateString);
+    public: std::string Filter(const std::string &_stateString,
+                bool _binary = false);
 
     /// \brief Filter for a model.
     private: ModelFilter filter;